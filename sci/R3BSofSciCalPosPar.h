@@ -35,11 +35,11 @@ class R3BSofSciCalPosPar : public FairParGenericSet
     void printParams();
 
     /** Accessor functions **/
-    const Int_t GetNumDets() { return fNumDets; }
-    const Int_t GetNumParamsPerDet() { return fNumParamsPerDet; }
-    const Int_t GetNumParams() { return fNumParams; }
+    const Int_t GetNumDets() const { return fNumDets; }
+    const Int_t GetNumParamsPerDet() const { return fNumParamsPerDet; }
+    const Int_t GetNumParams() const { return fNumParams; }
     TArrayF* GetAllParams() { return fAllParams; }
-    Float_t GetParam(Int_t rank) { return (Float_t)fAllParams->GetAt(rank); }
+    Float_t GetParam(Int_t rank) const { return (Float_t)fAllParams->GetAt(rank); }
 
     void SetNumDets(Int_t ndets) { fNumDets = ndets; }
     void SetNumParamsPerDet(Int_t nparsperdet) { fNumParamsPerDet = nparsperdet; }
@@ -35,20 +35,20 @@ class R3BSofSciCalTofPar : public FairParGenericSet
     void printParams();
 
     /** Accessor functions **/
-    const Int_t GetNumDets() { return fNumDets; }
-    const Int_t GetDetIdCaveC() { return fDetIdCaveC; }
-    const Int_t GetDetIdS2() { return fDetIdS2; }
-    const Int_t GetDetIdS8() { return fDetIdS8; }
+    const Int_t GetNumDets() const { return fNumDets; }
+    const Int_t GetDetIdCaveC() const { return fDetIdCaveC; }
+    const Int_t GetDetIdS2() const { return fDetIdS2; }
+    const Int_t GetDetIdS8() const { return fDetIdS8; }
 
     TArrayF* GetAllParams_Tof2InvV_FromS2() { return fTof2InvV_FromS2; }
     TArrayF* GetAllParams_Tof2InvV_FromS8() { return fTof2InvV_FromS8; }
     TArrayF* GetAllParams_FlightLength_FromS2() { return fFlightLength_FromS2; }
     TArrayF* GetAllParams_FlightLength_FromS8() { return fFlightLength_FromS8; }
 
-    Float_t GetTof2InvV_FromS2(Int_t rank) { return (Float_t)fTof2InvV_FromS2->GetAt(rank); };
-    Float_t GetTof2InvV_FromS8(Int_t rank) { return (Float_t)fTof2InvV_FromS8->GetAt(rank); };
-    Float_t GetFlightLength_FromS2(Int_t rank) { return (Float_t)fFlightLength_FromS2->GetAt(rank); }
-    Float_t GetFlightLength_FromS8(Int_t rank) { return (Float_t)fFlightLength_FromS8->GetAt(rank); }
+    Float_t GetTof2InvV_FromS2(Int_t rank) const { return (Float_t)fTof2InvV_FromS2->GetAt(rank); };
+    Float_t GetTof2InvV_FromS8(Int_t rank) const { return (Float_t)fTof2InvV_FromS8->GetAt(rank); };
+    Float_t GetFlightLength_FromS2(Int_t rank) const { return (Float_t)fFlightLength_FromS2->GetAt(rank); }
+    Float_t GetFlightLength_FromS8(Int_t rank) const { return (Float_t)fFlightLength_FromS8->GetAt(rank); }
 
     void SetNumDets(Int_t ndets) { fNumDets = ndets; }
     void SetDetIdCaveC(Int_t id) { fDetIdCaveC = id; }
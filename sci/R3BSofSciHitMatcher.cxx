@@ -0,0 +1,112 @@
+// REMINDER : RawPos = TrawRIGHT - TrawLEFT
+//            RawTof = Traw(stop) - Traw(start) + Tref(start) - Tref(stop)
+// Both expressions are evaluated exactly as in R3BSofSciTcal2SingleTcal.
+// Since every floating point operation is monotonic, RawPos is non-increasing
+// with TrawLEFT and RawTof is non-increasing with Traw(start): once the times
+// are sorted, the hits passing a gate form a contiguous range, which is found
+// by binary search with the very same comparisons as the nested loops.
+#include "R3BSofSciHitMatcher.h"
+
+#include <algorithm>
+
+R3BSofSciHitMatcher::R3BSofSciHitMatcher()
+    : fStopRef(0.)
+    , fStartRight(-1)
+    , fStartLeft(-1)
+    , fStopRight(-1)
+    , fStopLeft(-1)
+{
+}
+
+R3BSofSciHitMatcher::~R3BSofSciHitMatcher() {}
+
+void R3BSofSciHitMatcher::SelectPairs(const Double_t* tR,
+                                      Int_t nR,
+                                      const Double_t* tL,
+                                      Int_t nL,
+                                      Double_t posMin,
+                                      Double_t posMax,
+                                      std::vector<Pair>& pairs)
+{
+    pairs.clear();
+    if (nR <= 0 || nL <= 0)
+        return;
+
+    fSortedLeft.clear();
+    for (Int_t l = 0; l < nL; l++)
+        fSortedLeft.emplace_back(tL[l], l);
+    std::sort(fSortedLeft.begin(), fSortedLeft.end());
+
+    for (Int_t r = 0; r < nR; r++)
+    {
+        const Double_t tRight = tR[r];
+        // RawPos > posMax for the earliest left hits
+        auto first = std::partition_point(fSortedLeft.begin(),
+                                          fSortedLeft.end(),
+                                          [tRight, posMax](const std::pair<Double_t, Int_t>& hit)
+                                          { return (tRight - hit.first) > posMax; });
+        // RawPos < posMin for the latest left hits
+        auto last = std::partition_point(first,
+                                         fSortedLeft.end(),
+                                         [tRight, posMin](const std::pair<Double_t, Int_t>& hit)
+                                         { return !((tRight - hit.first) < posMin); });
+        for (auto it = first; it != last; ++it)
+            pairs.push_back({ 0.5 * (tRight + tL[it->second]), r, it->second });
+    }
+}
+
+void R3BSofSciHitMatcher::SetStop(const Double_t* tR,
+                                  Int_t nR,
+                                  const Double_t* tL,
+                                  Int_t nL,
+                                  Double_t tRef,
+                                  Double_t posMin,
+                                  Double_t posMax)
+{
+    SelectPairs(tR, nR, tL, nL, posMin, posMax, fStop);
+    fStopRef = tRef;
+}
+
+UInt_t R3BSofSciHitMatcher::MatchStart(const Double_t* tR,
+                                       Int_t nR,
+                                       const Double_t* tL,
+                                       Int_t nL,
+                                       Double_t tRef,
+                                       Double_t posMin,
+                                       Double_t posMax,
+                                       Double_t tofMin,
+                                       Double_t tofMax)
+{
+    UInt_t nMatch = 0;
+    if (fStop.empty())
+        return nMatch;
+
+    SelectPairs(tR, nR, tL, nL, posMin, posMax, fStart);
+    if (fStart.empty())
+        return nMatch;
+    std::sort(fStart.begin(), fStart.end(), [](const Pair& a, const Pair& b) { return a.time < b.time; });
+
+    const Double_t stopRef = fStopRef;
+    for (const Pair& stop : fStop)
+    {
+        const Double_t tStop = stop.time;
+        // RawTof > tofMax for the earliest start times
+        auto first = std::partition_point(fStart.begin(),
+                                          fStart.end(),
+                                          [tStop, tRef, stopRef, tofMax](const Pair& start)
+                                          { return !((tStop - start.time + tRef - stopRef) <= tofMax); });
+        // RawTof < tofMin for the latest start times
+        auto last = std::partition_point(first,
+                                         fStart.end(),
+                                         [tStop, tRef, stopRef, tofMin](const Pair& start)
+                                         { return tofMin <= (tStop - start.time + tRef - stopRef); });
+        if (first == last)
+            continue;
+        nMatch += last - first;
+        fStartRight = (last - 1)->right;
+        fStartLeft = (last - 1)->left;
+        fStopRight = stop.right;
+        fStopLeft = stop.left;
+    }
+    return nMatch;
+}
@@ -0,0 +1,80 @@
+// *** *************************************************************** *** //
+// ***                  R3BSofSciHitMatcher                            *** //
+// *** ---> select the (Right, Left) hits of a start detector and of   *** //
+// ***      the cave C stop detector fulfilling the RawPos and RawTof  *** //
+// ***      gates, using sorted hit times and window-bounded sweeps    *** //
+// *** *************************************************************** *** //
+
+#ifndef R3BSOFSCI_HITMATCHER
+#define R3BSOFSCI_HITMATCHER
+
+#include "Rtypes.h"
+
+#include <utility>
+#include <vector>
+
+class R3BSofSciHitMatcher
+{
+  public:
+    // --- Default constructor --- //
+    R3BSofSciHitMatcher();
+
+    // --- Destructor --- //
+    virtual ~R3BSofSciHitMatcher();
+
+    // --- Keep the (Right, Left) combinations of the stop detector with posMin <= RawPos <= posMax --- //
+    void SetStop(const Double_t* tR,
+                 Int_t nR,
+                 const Double_t* tL,
+                 Int_t nL,
+                 Double_t tRef,
+                 Double_t posMin,
+                 Double_t posMax);
+
+    // --- Number of start-stop combinations fulfilling the RawPos gate of the start detector --- //
+    // --- and tofMin <= RawTof <= tofMax, where RawTof is computed as in Tcal2SingleTcal     --- //
+    UInt_t MatchStart(const Double_t* tR,
+                      Int_t nR,
+                      const Double_t* tL,
+                      Int_t nL,
+                      Double_t tRef,
+                      Double_t posMin,
+                      Double_t posMax,
+                      Double_t tofMin,
+                      Double_t tofMax);
+
+    // --- Hits of the selected combination, meaningful if MatchStart returned exactly 1 --- //
+    Int_t GetStartRight() const { return fStartRight; }
+    Int_t GetStartLeft() const { return fStartLeft; }
+    Int_t GetStopRight() const { return fStopRight; }
+    Int_t GetStopLeft() const { return fStopLeft; }
+
+  private:
+    struct Pair
+    {
+        Double_t time; // 0.5 * (TrawRIGHT + TrawLEFT)
+        Int_t right;
+        Int_t left;
+    };
+
+    void SelectPairs(const Double_t* tR,
+                     Int_t nR,
+                     const Double_t* tL,
+                     Int_t nL,
+                     Double_t posMin,
+                     Double_t posMax,
+                     std::vector<Pair>& pairs);
+
+    // Working buffers, kept between events to avoid reallocation
+    std::vector<std::pair<Double_t, Int_t>> fSortedLeft;
+    std::vector<Pair> fStop;
+    std::vector<Pair> fStart;
+    Double_t fStopRef;
+
+    Int_t fStartRight;
+    Int_t fStartLeft;
+    Int_t fStopRight;
+    Int_t fStopLeft;
+};
+
+#endif // R3BSOFSCI_HITMATCHER
@@ -2,6 +2,7 @@
 #include "FairLogger.h"
 #include "FairRootManager.h"
 #include "FairRuntimeDb.h"
+#include "R3BEventHeader.h"
 
 // SofSci headers
 #include "R3BSofSciMapped2Tcal.h"
@@ -15,6 +16,7 @@ R3BSofSciMapped2Tcal::R3BSofSciMapped2Tcal()
     , fNevent(0)
     , fTcal(NULL)
     , fMapped(NULL)
+    , fHeader(NULL)
     , fTcalPar(NULL)
     , fOnline(kFALSE)
 {
@@ -26,6 +28,7 @@ R3BSofSciMapped2Tcal::R3BSofSciMapped2Tcal(const char* name, Int_t iVerbose)
     , fNevent(0)
     , fTcal(NULL)
     , fMapped(NULL)
+    , fHeader(NULL)
     , fTcalPar(NULL)
     , fOnline(kFALSE)
 {
@@ -78,6 +81,10 @@ InitStatus R3BSofSciMapped2Tcal::Init()
         return kFATAL;
     }
 
+    fHeader = (R3BEventHeader*)rm->GetObject("EventHeader.");
+    if (!fHeader)
+        fHeader = (R3BEventHeader*)rm->GetObject("R3BEventHeader");
+
     // Input data
     fMapped = (TClonesArray*)rm->GetObject("SofSciMappedData");
     if (!fMapped)
@@ -99,53 +106,41 @@ InitStatus R3BSofSciMapped2Tcal::Init()
         rm->Register("SofSciTcalData", "SofSci", fTcal, kFALSE);
     }
 
+    // Lookup tables for the conversion of the fine and coarse times
+    if (!fTcalPar->FillTimeTables())
+    {
+        LOG(error) << "R3BSofSciMapped2Tcal::Init() Couldn't build the time tables from the Tcal parameters";
+        return kFATAL;
+    }
+
     return kSUCCESS;
 }
 
 InitStatus R3BSofSciMapped2Tcal::ReInit()
 {
     SetParContainers();
+    if (!fTcalPar->FillTimeTables())
+    {
+        LOG(error) << "R3BSofSciMapped2Tcal::ReInit() Couldn't build the time tables from the Tcal parameters";
+        return kFATAL;
+    }
     return kSUCCESS;
 }
 
 void R3BSofSciMapped2Tcal::Exec(Option_t* option)
 {
-    UInt_t det;
-    UInt_t ch;
-    UInt_t tf;
-    UInt_t tc;
-    Double_t tns = 0.0;
-
     // Reset entries in output arrays, local arrays
     Reset();
 
-    // Loop over the entries of the Mapped TClonesArray
+    // Gather the Mapped hits and calculate all the times in ns in one pass
+    // the fine time is spread uniformly within its bin, reproducible for a given (event, hit)
     Int_t nHitsPerEvent_SofSci = fMapped->GetEntries();
-    for (Int_t ihit = 0; ihit < nHitsPerEvent_SofSci; ihit++)
-    {
-        R3BSofSciMappedData* hit = (R3BSofSciMappedData*)fMapped->At(ihit);
-        if (!hit)
-            continue;
-        det = hit->GetDetector();
-        ch = hit->GetPmt();
-        tf = hit->GetTimeFine();
-        tc = hit->GetTimeCoarse();
-
-        if ((det < 1) || (det > fTcalPar->GetNumDetectors()))
-        {
-            LOG(info) << "R3BSofSciMapped2Tcal::Exec() : In SofSciMappedData, iDet = " << det
-                      << "is out of range, item skipped ";
-            continue;
-        }
-        if ((ch < 1) || (ch > fTcalPar->GetNumChannels()))
-        {
-            LOG(info) << "R3BSofSciMapped2Tcal::Exec() : In SofSciMappedData, iCh = " << ch
-                      << "is out of range, item skipped ";
-            continue;
-        }
-        tns = CalculateTimeNs(det, ch, tf, tc);
-        AddTcalData(det, ch, tns, tc);
-    }
+    fBatch.Gather<R3BSofSciMappedData>(
+        fMapped, fTcalPar->GetNumDetectors(), fTcalPar->GetNumChannels(), "R3BSofSciMapped2Tcal");
+    fBatch.Convert(fTcalPar, fRandom, fHeader ? fHeader->GetEventno() : fNevent);
+
+    for (Int_t i = 0; i < fBatch.GetNumHits(); i++)
+        AddTcalData(fBatch.GetDetector(i), fBatch.GetChannel(i), fBatch.GetTimeNs(i), fBatch.GetTimeCoarse(i));
 
     if (nHitsPerEvent_SofSci != fTcal->GetEntries())
         LOG(warn) << "R3BSofSciMapped2Tcal::Exec() mismatch between TClonesArray entries ";
@@ -162,33 +157,6 @@ void R3BSofSciMapped2Tcal::Reset()
         fTcal->Clear();
 }
 
-// -----   Private method to calculate the time in ns  --------------------------
-Double_t R3BSofSciMapped2Tcal::CalculateTimeNs(UShort_t iDet, UShort_t iCh, UInt_t iTf, UInt_t iTc)
-{
-    UInt_t rank = iTf + fTcalPar->GetNumTcalParsPerSignal() * ((iDet - 1) * fTcalPar->GetNumChannels() + (iCh - 1));
-    Double_t iPar = (Double_t)fTcalPar->GetSignalTcalParams(rank);
-    Double_t iDeltaClock = (Double_t)fTcalPar->GetClockOffset((iDet - 1) * fTcalPar->GetNumChannels() + (iCh - 1));
-    Double_t r = (Double_t)rand.Rndm() - 0.5;
-    Double_t iTf_ns;
-    Double_t iTc_ns = ((Double_t)iTc - iDeltaClock) * 5.;
-    //  std::cout << "R3BSofSciMapped2Tcal::CalculateTimeNs : iDet=" << iDet << ", iCh=" << iCh << ", iTf=" << iTf << ",
-    //  rank=" << rank  << std::endl;
-
-    if (r < 0)
-    {
-        Double_t iParPrev = fTcalPar->GetSignalTcalParams(rank - 1);
-        iTf_ns = iPar + r * (iPar - iParPrev);
-    }
-    else
-    {
-        Double_t iParNext = fTcalPar->GetSignalTcalParams(rank + 1);
-        iTf_ns = iPar + r * (iParNext - iPar);
-    }
-
-    // std::cout << "Tf_ns=" << iTf_ns << ", iTc_ns=" << iTc_ns << " : TimeNs = " << 5.*iTc_ns - iTf_ns << std::endl;
-    return (iTc_ns - iTf_ns);
-}
-
 // -----   Private method AddCalData  --------------------------------------------
 R3BSofSciTcalData* R3BSofSciMapped2Tcal::AddTcalData(Int_t det, Int_t ch, Double_t tns, UInt_t clock)
 {
@@ -9,12 +9,13 @@
 
 #include "FairTask.h"
 #include "R3BSofSciTcalData.h"
+#include "R3BSofTcalBatch.h"
 #include "R3BSofTcalPar.h"
+#include "R3BSofTcalRandom.h"
 #include "TClonesArray.h"
-#include "TRandom3.h"
 
-class TRandom3;
 class R3BSofTcalPar;
+class R3BEventHeader;
 
 class R3BSofSciMapped2Tcal : public FairTask
 {
@@ -44,15 +45,15 @@ class R3BSofSciMapped2Tcal : public FairTask
   private:
     Bool_t fOnline; // Don't store data for online
 
-    TClonesArray* fMapped; // input data - SofSci
-    TClonesArray* fTcal;   // output data
+    TClonesArray* fMapped;   // input data - SofSci
+    TClonesArray* fTcal;     // output data
+    R3BEventHeader* fHeader; // event number, if available, for the random spreading
 
     R3BSofTcalPar* fTcalPar; // tcal parameters container - SofSci
 
     UInt_t fNevent;
-    TRandom3 rand;
-
-    Double_t CalculateTimeNs(UShort_t det, UShort_t pmt, UInt_t tf, UInt_t tc);
+    R3BSofTcalRandom fRandom; //! keyed on (event number, hit): independent of how the events are split into ranges
+    R3BSofTcalBatch fBatch;   //! hits of the event
 
     /** Private method CalData **/
     //** Adds a TcalData to the detector
@@ -2,15 +2,15 @@
 
 #include "FairLogger.h"
 #include "FairRootManager.h"
+#include "FairRunOnline.h"
 #include "FairRuntimeDb.h"
 #include "R3BSofSciMappedData.h"
 #include "R3BSofTcalPar.h"
 #include "TClonesArray.h"
-#include "TF1.h"
 #include "TH1F.h"
+#include "THttpServer.h"
 #include "TMath.h"
 #include "TObjArray.h"
-#include "TRandom.h"
 
 #include <iostream>
 #include <stdlib.h>
@@ -24,6 +24,8 @@ R3BSofSciMapped2TcalPar::R3BSofSciMapped2TcalPar()
     , fMinStatistics(100)
     , fMapped(NULL)
     , fTcalPar(NULL)
+    , fPublishEvents(0)
+    , fNevent(0)
     , fOutputFile(NULL)
 {
 }
@@ -37,6 +39,8 @@ R3BSofSciMapped2TcalPar::R3BSofSciMapped2TcalPar(const char* name, Int_t iVerbos
     , fMinStatistics(100)
     , fMapped(NULL)
     , fTcalPar(NULL)
+    , fPublishEvents(0)
+    , fNevent(0)
     , fOutputFile(NULL)
 
 {
@@ -93,29 +97,24 @@ InitStatus R3BSofSciMapped2TcalPar::Init()
         return kFATAL;
     }
 
-    // --- ---------------------- --- //
-    // --- HISTOGRAMS DECLARATION --- //
-    // --- ---------------------- --- //
-    // --- In 1-based numbering:  --- //
-    // --- detector 1 : at S2     --- //
-    // --- detector 2 : at cave C --- //
-    // --- channel 1  : Pmt R     --- //
-    // --- channel 2  : Pmt L     --- //
-    // --- ---------------------- --- //
-    char name[100];
-    fh_TimeFineBin = new TH1F*[fNumSci * fNumChannels];
-    fh_TimeFineNs = new TH1F*[fNumSci * fNumChannels];
-    for (Int_t det = 0; det < fNumSci; det++)
+    // --- ------------------------------ --- //
+    // --- FINE TIME COUNTS PER SIGNAL    --- //
+    // --- ------------------------------ --- //
+    // --- In 1-based numbering:          --- //
+    // --- detector 1 : at S2             --- //
+    // --- detector 2 : at cave C         --- //
+    // --- channel 1  : Pmt R             --- //
+    // --- channel 2  : Pmt L             --- //
+    // --- ------------------------------ --- //
+    fCalibrator.Init(fNumSci, fNumChannels, fNumTcalParsPerSignal);
+    fNevent = 0;
+
+    // Register command to publish the parameters during an online calibration
+    FairRunOnline* run = FairRunOnline::Instance();
+    if (run && run->GetHttpServer())
     {
-        for (Int_t ch = 0; ch < fNumChannels; ch++)
-        {
-            sprintf(name, "TimeFineBin_Sci%i_Ch%i_Sig%i", det + 1, ch + 1, det * fNumChannels + ch);
-            fh_TimeFineBin[det * fNumChannels + ch] =
-                new TH1F(name, name, fNumTcalParsPerSignal, 0, fNumTcalParsPerSignal);
-            sprintf(name, "TimeFineNs_Sci%i_Ch%i_Sig%i", det + 1, ch + 1, det * fNumChannels + ch);
-            fh_TimeFineNs[det * fNumChannels + ch] =
-                new TH1F(name, name, fNumTcalParsPerSignal, 0, fNumTcalParsPerSignal);
-        }
+        run->GetHttpServer()->Register("", this);
+        run->GetHttpServer()->RegisterCommand("Publish_SOFSCI_TCALPAR", Form("/Objects/%s/->Publish()", GetName()));
     }
 
     return kSUCCESS;
@@ -135,7 +134,6 @@ void R3BSofSciMapped2TcalPar::Exec(Option_t* opt)
     // nHitsSci = number of hits per event
     // for the scintillator this number of hits can be very large especially for the detector at S2
     UInt_t nHitsSci = fMapped->GetEntries(); // can be very high especially for S2 detector
-    UInt_t iSignalSci;
     for (UInt_t ihit = 0; ihit < nHitsSci; ihit++)
     {
         R3BSofSciMappedData* hitSci = (R3BSofSciMappedData*)fMapped->At(ihit);
@@ -197,15 +195,16 @@ void R3BSofSciMapped2TcalPar::Exec(Option_t* opt)
         // ***     * channel=3                             *** //
         // ***     * signal=5                              *** //
         // *** ******************************************* *** //
-        iSignalSci = (hitSci->GetDetector() - 1) * fNumChannels + (hitSci->GetPmt() - 1);
-        if ((0 <= iSignalSci) && (iSignalSci <= fNumSci * fNumChannels))
-            fh_TimeFineBin[iSignalSci]->Fill(hitSci->GetTimeFine());
-        else
-            LOG(error) << "R3BSofSciMapped2TcalPar::Exec() Number of signals out of range: " << iSignalSci
-                       << " instead of [0," << fNumSci * fNumChannels << "]: det=" << hitSci->GetDetector()
-                       << ",  fNumChannels = " << fNumChannels << ",  pmt = " << hitSci->GetPmt();
+        if (!fCalibrator.AddHit(hitSci->GetDetector(), hitSci->GetPmt(), hitSci->GetTimeFine()))
+            LOG(error) << "R3BSofSciMapped2TcalPar::Exec() Number of signals out of range: det="
+                       << hitSci->GetDetector() << ",  fNumChannels = " << fNumChannels << ",  pmt = " << hitSci->GetPmt()
+                       << ",  tf = " << hitSci->GetTimeFine();
 
     } // end of loop over the number of hits per event in MappedSci
+
+    fNevent++;
+    if (fPublishEvents > 0 && fNevent % fPublishEvents == 0)
+        Publish();
 }
 
 // ---- Public method Reset   --------------------------------------------------
@@ -220,38 +219,50 @@ void R3BSofSciMapped2TcalPar::FinishTask()
     fTcalPar->printParams();
 }
 
+//------------------
+void R3BSofSciMapped2TcalPar::Publish()
+{
+    Int_t nPublished = fCalibrator.Publish(fTcalPar, fMinStatistics);
+    LOG(info) << "R3BSofSciMapped2TcalPar::Publish() after " << fNevent << " events: " << nPublished << " of "
+              << fCalibrator.GetNumSignals() << " signals published, " << fCalibrator.GetNumConverged()
+              << " converged";
+    for (Int_t sig = 0; sig < fCalibrator.GetNumSignals(); sig++)
+        LOG(debug) << "R3BSofSciMapped2TcalPar::Publish() signal " << sig << ": " << fCalibrator.GetEntries(sig)
+                   << " entries, max change " << fCalibrator.GetMaxChange(sig) << " ns, stat. error "
+                   << fCalibrator.GetStatError(sig) << " ns";
+}
+
 //------------------
 void R3BSofSciMapped2TcalPar::CalculateVftxTcalParams()
 {
     LOG(info) << "R3BSofSciMapped2TcalPar::CalculateVftxTcalParams()";
 
-    fTcalPar->SetNumDetectors(fNumSci);
-    fTcalPar->SetNumChannels(fNumChannels);
-    fTcalPar->SetNumTcalParsPerSignal(fNumTcalParsPerSignal);
-
-    UInt_t IntegralTot;
-    UInt_t IntegralPartial;
-    Double_t Bin2Ns[fNumTcalParsPerSignal];
+    Publish();
 
-    for (Int_t sig = 0; sig < fNumSci * fNumChannels; sig++)
+    // fine time distributions and tables, kept in the output file
+    char name[100];
+    for (Int_t det = 0; det < fNumSci; det++)
     {
-        if (fh_TimeFineBin[sig]->GetEntries() > fMinStatistics)
+        for (Int_t ch = 0; ch < fNumChannels; ch++)
         {
-            IntegralTot = fh_TimeFineBin[sig]->Integral();
-            IntegralPartial = 0;
-            for (Int_t bin = 0; bin < fNumTcalParsPerSignal; bin++)
+            Int_t sig = det * fNumChannels + ch;
+            sprintf(name, "TimeFineBin_Sci%i_Ch%i_Sig%i", det + 1, ch + 1, sig);
+            TH1F hTimeFineBin(name, name, fNumTcalParsPerSignal, 0, fNumTcalParsPerSignal);
+            sprintf(name, "TimeFineNs_Sci%i_Ch%i_Sig%i", det + 1, ch + 1, sig);
+            TH1F hTimeFineNs(name, name, fNumTcalParsPerSignal, 0, fNumTcalParsPerSignal);
+            if (fCalibrator.GetEntries(sig) > (ULong64_t)fMinStatistics)
             {
-                IntegralPartial += fh_TimeFineBin[sig]->GetBinContent(bin + 1);
-                Bin2Ns[bin] = 5. * ((Double_t)IntegralPartial) / (Double_t)IntegralTot;
-                fh_TimeFineNs[sig]->SetBinContent(bin + 1, Bin2Ns[bin]);
-                fTcalPar->SetSignalTcalParams(Bin2Ns[bin], sig * fNumTcalParsPerSignal + bin);
+                for (Int_t bin = 0; bin < fNumTcalParsPerSignal; bin++)
+                {
+                    hTimeFineBin.SetBinContent(bin + 1, fCalibrator.GetCount(sig, bin));
+                    hTimeFineNs.SetBinContent(bin + 1, fCalibrator.GetTableNs(sig, bin));
+                }
+                hTimeFineBin.SetEntries(fCalibrator.GetEntries(sig));
             }
-            fTcalPar->SetClockOffset(0.0, sig);
+            hTimeFineNs.Write(); // empty histo if stat <fMinStatistics
+            hTimeFineBin.Write();
         }
-        fh_TimeFineNs[sig]->Write(); // empty histo if stat <fMinStatistics
-        fh_TimeFineBin[sig]->Write();
     }
-    fTcalPar->setChanged();
     return;
 }
 
@@ -2,7 +2,7 @@
 #define __R3BSOFSCIMAPPED2TCALPAR_H__ 1
 
 #include "FairTask.h"
-#include "TH1F.h"
+#include "R3BSofTcalCalibrator.h"
 
 class TClonesArray;
 class R3BSofTcalPar;
@@ -40,6 +40,9 @@ class R3BSofSciMapped2TcalPar : public FairTask
     /** Virtual method calculate the Vftx Tcal Parameters **/
     virtual void CalculateVftxTcalParams();
 
+    /** Publish the current Vftx Tcal Parameters, called every fPublishEvents events or via the http server **/
+    void Publish();
+
     void SetOutputFile(const char* outFile);
 
     /** Accessor functions **/
@@ -51,6 +54,8 @@ class R3BSofSciMapped2TcalPar : public FairTask
     void SetNumChannels(UShort_t num) { fNumChannels = num; }
     void SetNumTcalParsPerSignal(Int_t NumberOfTcalParsPerSignal) { fNumTcalParsPerSignal = NumberOfTcalParsPerSignal; }
     void SetMinStatistics(Int_t minstat) { fMinStatistics = minstat; }
+    void SetPublishEvents(Int_t nev) { fPublishEvents = nev; } // 0: only at the end of the run
+    void SetTolerance(Double_t ns) { fCalibrator.SetTolerance(ns); }
 
   private:
     UShort_t fNumSci;            // Number of detectors (=1 if cave C only, 2 or more if FRS in used)
@@ -64,9 +69,10 @@ class R3BSofSciMapped2TcalPar : public FairTask
     // input data
     TClonesArray* fMapped; // Array with mapped data from scintillator detectors
 
-    // histograms
-    TH1F** fh_TimeFineBin;
-    TH1F** fh_TimeFineNs;
+    // fine time counts and convergence
+    R3BSofTcalCalibrator fCalibrator; //!
+    Int_t fPublishEvents;             // number of events between two publications, 0 if only at the end
+    ULong64_t fNevent;
     char* fOutputFile;
 
   public:
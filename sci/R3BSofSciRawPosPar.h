@@ -35,12 +35,12 @@ class R3BSofSciRawPosPar : public FairParGenericSet
     void printParams();
 
     /** Accessor functions **/
-    const Int_t GetNumDets() { return fNumDets; }
-    const Int_t GetNumPmts() { return fNumPmts; }
-    const Int_t GetNumSignals() { return fNumSignals; }
-    const Int_t GetNumParsPerSignal() { return fNumParsPerSignal; }
+    const Int_t GetNumDets() const { return fNumDets; }
+    const Int_t GetNumPmts() const { return fNumPmts; }
+    const Int_t GetNumSignals() const { return fNumSignals; }
+    const Int_t GetNumParsPerSignal() const { return fNumParsPerSignal; }
     TArrayF* GetAllSignalsAllParams() { return fAllRawPosParams; }
-    Double_t GetParam(UInt_t rank) { return (Double_t)fAllRawPosParams->GetAt(rank); }
+    Double_t GetParam(UInt_t rank) const { return (Double_t)fAllRawPosParams->GetAt(rank); }
 
     void SetNumDets(Int_t ndets) { fNumDets = ndets; }
     void SetNumPmts(Int_t nchs) { fNumPmts = nchs; }
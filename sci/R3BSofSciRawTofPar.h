@@ -35,15 +35,15 @@ class R3BSofSciRawTofPar : public FairParGenericSet
     void printParams();
 
     /** Accessor functions **/
-    const Int_t GetNumDets() { return fNumDets; }
-    const Int_t GetNumChannels() { return fNumChannels; }
-    const Int_t GetDetIdCaveC() { return fDetIdCaveC; }
-    const Int_t GetDetIdS2() { return fDetIdS2; }
-    const Int_t GetDetIdS8() { return fDetIdS8; }
-    const Int_t GetNumSignals() { return fNumSignals; }
-    const Int_t GetNumParsPerSignal() { return fNumParsPerSignal; }
+    const Int_t GetNumDets() const { return fNumDets; }
+    const Int_t GetNumChannels() const { return fNumChannels; }
+    const Int_t GetDetIdCaveC() const { return fDetIdCaveC; }
+    const Int_t GetDetIdS2() const { return fDetIdS2; }
+    const Int_t GetDetIdS8() const { return fDetIdS8; }
+    const Int_t GetNumSignals() const { return fNumSignals; }
+    const Int_t GetNumParsPerSignal() const { return fNumParsPerSignal; }
     TArrayF* GetAllSignalsRawTofParams() { return fAllSignalsRawTofParams; }
-    Double_t GetSignalRawTofParams(Int_t rank) { return (Double_t)fAllSignalsRawTofParams->GetAt(rank); }
+    Double_t GetSignalRawTofParams(Int_t rank) const { return (Double_t)fAllSignalsRawTofParams->GetAt(rank); }
 
     /**   **/
 
@@ -157,15 +157,9 @@ void R3BSofSciTcal2SingleTcal::Exec(Option_t* option)
     UShort_t idCaveC = nDets;
     UShort_t iDet; // 0-based
     UShort_t iCh;  // 0-based
-    Double_t iTraw[nDets * nChs][32];
-    UShort_t mult[nDets * nChs];
-    UShort_t mult_max = 0;
-    UInt_t maskR[nDets]; // if mult_max>=32, doesn't work
-    UInt_t maskL[nDets]; // if mult_max>=32, doesn't work
-
-    for (UShort_t i = 0; i < nDets * nChs; i++)
-        mult[i] = 0;
 
+    // no limit on the multiplicity per PMT
+    fHits.Clear(nDets * nChs);
     Int_t nHitsPerEvent_SofSci = fTcal->GetEntries();
     for (int ihit = 0; ihit < nHitsPerEvent_SofSci; ihit++)
     {
@@ -174,16 +168,23 @@ void R3BSofSciTcal2SingleTcal::Exec(Option_t* option)
             continue;
         iDet = hit->GetDetector() - 1;
         iCh = hit->GetPmt() - 1;
-        if (mult_max > 32)
-            continue; // if multiplicity in a Pmt is higher than 32, this code cannot handle it
-        iTraw[iDet * nChs + iCh][mult[iDet * nChs + iCh]] = hit->GetRawTimeNs();
-        mult[iDet * nChs + iCh]++;
-        if (mult[iDet * nChs + iCh] > mult_max)
-            mult_max = mult[iDet * nChs + iCh];
+        fHits.AddHit(iDet * nChs + iCh, hit->GetRawTimeNs());
     } // end of loop over the TClonesArray of Tcal data
+    fHits.Build();
+
+    // first hit of the reference signal (third channel) of each detector
+    Double_t iTref[nDets];
+    for (UShort_t d = 0; d < nDets; d++)
+    {
+        if (nChs > 2 && fHits.GetMult(d * nChs + 2) > 0)
+            iTref[d] = fHits.GetTime(d * nChs + 2, 0);
+        else
+            iTref[d] = -100000.;
+    }
 
     // It makes no sense to continue if there is no Left and Right signal on the SofSci at cave C
-    if ((nHitsPerEvent_SofSci > 0) && (mult[(idCaveC - 1) * nChs] > 0) && (mult[(idCaveC - 1) * nChs + 1] > 0))
+    if ((nHitsPerEvent_SofSci > 0) && (fHits.GetMult((idCaveC - 1) * nChs) > 0) &&
+        (fHits.GetMult((idCaveC - 1) * nChs + 1) > 0))
     {
         Double_t iRawPos = -100000., iRawTime = -100000.;
         UShort_t mult_selectHits[nDets];
@@ -201,26 +202,24 @@ void R3BSofSciTcal2SingleTcal::Exec(Option_t* option)
         // --- ------------------------------------------ --- //
         if (nDets == 1)
         {
-            maskL[0] = 0x0;
-            maskR[0] = 0x0;
-            for (UShort_t multR = 0; multR < mult[0]; multR++)
+            for (Int_t multR = 0; multR < fHits.GetMult(0); multR++)
             {
-                for (UShort_t multL = 0; multL < mult[1]; multL++)
+                for (Int_t multL = 0; multL < fHits.GetMult(1); multL++)
                 {
                     // RawPos = TrawRIGHT - TrawLEFT corresponds to x increasing from RIGHT to LEFT
-                    iRawPos = iTraw[0][multR] - iTraw[1][multL];
+                    iRawPos = fHits.GetTime(0, multR) - fHits.GetTime(1, multL);
                     // if the raw position is outside the range: continue
                     if (iRawPos < fRawPosPar->GetParam(0))
                         continue;
                     if (iRawPos > fRawPosPar->GetParam(1))
                         continue;
                     // if the left or right hit has already been used, continue
-                    if ((((maskR[0] >> multR) & (0x1)) == 1) || (((maskL[0] > multL) & (0x1)) == 1))
+                    if (fHits.IsUsed(0, multR) || fHits.IsUsed(1, multL))
                         continue;
-                    iRawTime = 0.5 * (iTraw[0][multL] + iTraw[1][multR]);
+                    iRawTime = 0.5 * (fHits.GetTime(0, multR) + fHits.GetTime(1, multL));
                     // tag which hit is used
-                    maskR[0] |= (0x1) << multR;
-                    maskL[0] |= (0x1) << multL;
+                    fHits.SetUsed(0, multR);
+                    fHits.SetUsed(1, multL);
                     AddSingleTcalData(1, iRawTime, iRawPos, -100000., -100000.);
                 } // end of loop over the hits of the left PMTs
             }     // end of loop over the hits of the right PMTs
@@ -238,58 +237,46 @@ void R3BSofSciTcal2SingleTcal::Exec(Option_t* option)
         {
             UShort_t idS2 = fRawTofPar->GetDetIdS2(); // 1-based
             UShort_t idS8 = fRawTofPar->GetDetIdS8(); // 1-based if 0: no detector at S8
-            Double_t iRawTime_dSta = -100000., iRawTime_dSto = -100000., iRawTime_S2 = -100000., iRawTime_S8 = -100000.;
-            Double_t iRawTof = -100000., iRawTof_S2 = -100000., iRawTof_S8 = -100000.;
+            Double_t iRawTime_S2 = -100000., iRawTime_S8 = -100000.;
+            Double_t iRawTof_S2 = -100000., iRawTof_S8 = -100000.;
             Int_t dSto = idCaveC - 1; // Fix the CaveC SofSci as the stop detector
 
             // --- selection for the scintillators along FRS versus SofSci at Cave C --- //
             // --- only if a proper selection has been found at cave C               --- //
             // --- in this case : fill the SingleTcalItem for all detectors          --- //
 
+            // --- the (Right, Left) combinations at cave C do not depend on the start detector --- //
+            fMatcher.SetStop(fHits.GetTimes(dSto * nChs),
+                             fHits.GetMult(dSto * nChs),
+                             fHits.GetTimes(dSto * nChs + 1),
+                             fHits.GetMult(dSto * nChs + 1),
+                             iTref[dSto],
+                             fRawPosPar->GetParam(2 * dSto),
+                             fRawPosPar->GetParam(2 * dSto + 1));
+
             for (Int_t dSta = 0; dSta < nDets - 1; dSta++)
             {
-                UShort_t multLstotmp = 0, multRstotmp = 0;
-                for (UShort_t multRsto = 0; multRsto < mult[dSto * nChs]; multRsto++)
+                // number of (Rsto, Lsto, Rsta, Lsta) combinations within the RawPos and RawTof gates
+                mult_selectHits[dSta] = fMatcher.MatchStart(fHits.GetTimes(dSta * nChs),
+                                                            fHits.GetMult(dSta * nChs),
+                                                            fHits.GetTimes(dSta * nChs + 1),
+                                                            fHits.GetMult(dSta * nChs + 1),
+                                                            iTref[dSta],
+                                                            fRawPosPar->GetParam(2 * dSta),
+                                                            fRawPosPar->GetParam(2 * dSta + 1),
+                                                            fRawTofPar->GetSignalRawTofParams(2 * dSta),
+                                                            fRawTofPar->GetSignalRawTofParams(2 * dSta + 1));
+                if (mult_selectHits[dSta] > 0)
                 {
-                    for (UShort_t multLsto = 0; multLsto < mult[dSto * nChs + 1]; multLsto++)
-                    {
-                        // check the position in the stop detector
-                        iRawPos = (iTraw[dSto * nChs][multRsto] - iTraw[dSto * nChs + 1][multLsto]);
-                        if ((iRawPos < fRawPosPar->GetParam(2 * dSto)) ||
-                            (iRawPos > fRawPosPar->GetParam(2 * dSto + 1)))
-                            continue;
-                        for (UShort_t multRsta = 0; multRsta < mult[dSta * nChs]; multRsta++)
-                        {
-                            for (UShort_t multLsta = 0; multLsta < mult[dSta * nChs + 1]; multLsta++)
-                            {
-                                // RawPos = TrawRIGHT - TrawLEFT corresponds to x increasing from RIGHT to LEFT
-                                iRawPos = (iTraw[dSta * nChs][multRsta] - iTraw[dSta * nChs + 1][multLsta]);
-                                if ((iRawPos < fRawPosPar->GetParam(2 * dSta)) ||
-                                    (iRawPos > fRawPosPar->GetParam(2 * dSta + 1)))
-                                    continue;
-                                iRawTime_dSta = 0.5 * (iTraw[dSta * nChs][multRsta] + iTraw[dSta * nChs + 1][multLsta]);
-                                iRawTime_dSto = 0.5 * (iTraw[dSto * nChs][multRsto] + iTraw[dSto * nChs + 1][multLsto]);
-                                iRawTof = iRawTime_dSto - iRawTime_dSta + iTraw[dSta * nChs + 2][0] -
-                                          iTraw[dSto * nChs + 2][0];
-                                if ((fRawTofPar->GetSignalRawTofParams(2 * dSta) <= iRawTof) &&
-                                    (iRawTof <= fRawTofPar->GetSignalRawTofParams(2 * dSta + 1)))
-                                {
-                                    selectLeftHit[dSta] = multLsta;
-                                    selectRightHit[dSta] = multRsta;
-                                    multLstotmp = multLsto;
-                                    multRstotmp = multRsto;
-                                    mult_selectHits[dSta]++;
-                                }
-                            } // end of multLsta
-                        }     // end of multRsta
-                    }         // end of multLsto
-                }             // end of multRsto
+                    selectLeftHit[dSta] = fMatcher.GetStartLeft();
+                    selectRightHit[dSta] = fMatcher.GetStartRight();
+                }
                 if (mult_selectHits[dSta] > 0 &&
                     (mult_selectHits[dSto] == 0 || mult_selectHits[dSta] < mult_selectHits[dSto]))
                 {
                     // Check if this TOF is better than previous TOF conditions
-                    selectLeftHit[dSto] = multLstotmp;
-                    selectRightHit[dSto] = multRstotmp;
+                    selectLeftHit[dSto] = fMatcher.GetStopLeft();
+                    selectRightHit[dSto] = fMatcher.GetStopRight();
                     mult_selectHits[dSto] = mult_selectHits[dSta];
                 }
             } // end of calculation of all Tof and Pos = end of for(dSta)
@@ -297,27 +284,29 @@ void R3BSofSciTcal2SingleTcal::Exec(Option_t* option)
             // Fill the TClonesArray of R3BSofSciSingleTcal
             if (idS2 > 0)
                 if (mult_selectHits[idS2 - 1] == 1)
-                    iRawTime_S2 = 0.5 * (iTraw[(idS2 - 1) * nChs][selectRightHit[idS2 - 1]] +
-                                         iTraw[(idS2 - 1) * nChs + 1][selectLeftHit[idS2 - 1]]);
+                    iRawTime_S2 = 0.5 * (fHits.GetTime((idS2 - 1) * nChs, selectRightHit[idS2 - 1]) +
+                                         fHits.GetTime((idS2 - 1) * nChs + 1, selectLeftHit[idS2 - 1]));
             if (idS8 > 0)
                 if (mult_selectHits[idS8 - 1] == 1)
-                    iRawTime_S8 = 0.5 * (iTraw[(idS8 - 1) * nChs][selectRightHit[idS8 - 1]] +
-                                         iTraw[(idS8 - 1) * nChs + 1][selectLeftHit[idS8 - 1]]);
+                    iRawTime_S8 = 0.5 * (fHits.GetTime((idS8 - 1) * nChs, selectRightHit[idS8 - 1]) +
+                                         fHits.GetTime((idS8 - 1) * nChs + 1, selectLeftHit[idS8 - 1]));
 
             for (UShort_t d = 0; d < nDets; d++)
             {
                 if (mult_selectHits[d] == 1)
                 {
                     // RawPos = TrawRIGHT - TrawLEFT corresponds to x increasing from RIGHT to LEFT
-                    iRawPos = iTraw[d * nChs][selectRightHit[d]] - iTraw[d * nChs + 1][selectLeftHit[d]];
-                    iRawTime = 0.5 * (iTraw[d * nChs][selectRightHit[d]] + iTraw[d * nChs + 1][selectLeftHit[d]]);
+                    iRawPos =
+                        fHits.GetTime(d * nChs, selectRightHit[d]) - fHits.GetTime(d * nChs + 1, selectLeftHit[d]);
+                    iRawTime = 0.5 * (fHits.GetTime(d * nChs, selectRightHit[d]) +
+                                      fHits.GetTime(d * nChs + 1, selectLeftHit[d]));
                     iRawTof_S2 = -100000.;
                     if (iRawTime_S2 > 0)
-                        iRawTof_S2 = iRawTime - iRawTime_S2 + iTraw[(idS2 - 1) * nChs + 2][0] - iTraw[d * nChs + 2][0];
+                        iRawTof_S2 = iRawTime - iRawTime_S2 + iTref[idS2 - 1] - iTref[d];
                     ;
                     iRawTof_S8 = -100000.;
                     if (iRawTime_S8 > 0)
-                        iRawTof_S8 = iRawTime - iRawTime_S8 + iTraw[(idS8 - 1) * nChs + 2][0] - iTraw[d * nChs + 2][0];
+                        iRawTof_S8 = iRawTime - iRawTime_S8 + iTref[idS8 - 1] - iTref[d];
                     ;
                     AddSingleTcalData(d + 1, iRawTime, iRawPos, iRawTof_S2, iRawTof_S8);
                 }
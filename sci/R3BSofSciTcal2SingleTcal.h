@@ -7,9 +7,11 @@
 #define R3BSOFSCI_TCAL2SINGLETCAL
 
 #include "FairTask.h"
+#include "R3BSofSciHitMatcher.h"
 #include "R3BSofSciRawPosPar.h"
 #include "R3BSofSciRawTofPar.h"
 #include "R3BSofSciSingleTcalData.h"
+#include "R3BSofTcalHitBuffer.h"
 #include "TClonesArray.h"
 #include "TMath.h"
 #include "TRandom.h"
@@ -49,6 +51,8 @@ class R3BSofSciTcal2SingleTcal : public FairTask
     TClonesArray* fSingleTcal;
     R3BSofSciRawPosPar* fRawPosPar;
     R3BSofSciRawTofPar* fRawTofPar;
+    R3BSofTcalHitBuffer fHits;    //! Tcal hits per PMT
+    R3BSofSciHitMatcher fMatcher; //! start-stop hit selection
 
     R3BSofSciSingleTcalData* AddSingleTcalData(UShort_t iDet,
                                                Double_t traw,
@@ -13,6 +13,7 @@
 #include "R3BSofFragmentAnaPar.h"
 #include "R3BSofFrsAnaPar.h"
 #include "R3BSofGladFieldPar.h"
+#include "R3BSofGladMapPar.h"
 #include "R3BTGeoPar.h"
 
 static R3BSofAnaContFact gR3BSofAnaContFact;
@@ -52,6 +53,10 @@ void R3BSofAnaContFact::setAllContainers()
     p5->addContext("GeometryParameterContext");
 
     containers->Add(p5);
+
+    FairContainer* p6 = new FairContainer("GladMapPar", "Glad Transfer Map Parameters", "GladMapParContext");
+    p6->addContext("GladMapParContext");
+    containers->Add(p6);
 }
 
 FairParSet* R3BSofAnaContFact::createContainer(FairContainer* c)
@@ -75,6 +80,10 @@ FairParSet* R3BSofAnaContFact::createContainer(FairContainer* c)
     {
         p = new R3BSofGladFieldPar(c->getConcatName().Data(), c->GetTitle(), c->getContext());
     }
+    if (strcmp(name, "GladMapPar") == 0)
+    {
+        p = new R3BSofGladMapPar(c->getConcatName().Data(), c->GetTitle(), c->getContext());
+    }
     if (strcmp(name, "TargetGeoPar") == 0)
     {
         p = new R3BTGeoPar(c->getConcatName().Data(), c->GetTitle(), c->getContext());
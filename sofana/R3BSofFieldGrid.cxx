@@ -0,0 +1,70 @@
+// ----------------------------------------------------------------------
+// -----                                                            -----
+// -----                     R3BSofFieldGrid                        -----
+// -----                                                            -----
+// ----------------------------------------------------------------------
+
+#include "R3BSofFieldGrid.h"
+
+#include "FairField.h"
+#include "FairLogger.h"
+#include "TMath.h"
+
+R3BSofFieldGrid::R3BSofFieldGrid()
+    : fMin{ 0., 0., 0. }
+    , fN{ 0, 0, 0 }
+    , fStep(1.)
+    , fInvStep(1.)
+    , fMaxField(0.)
+{
+}
+
+R3BSofFieldGrid::~R3BSofFieldGrid() {}
+
+void R3BSofFieldGrid::Init(Double_t xmin,
+                           Double_t xmax,
+                           Double_t ymin,
+                           Double_t ymax,
+                           Double_t zmin,
+                           Double_t zmax,
+                           Double_t step)
+{
+    const Double_t lo[3] = { xmin, ymin, zmin };
+    const Double_t hi[3] = { xmax, ymax, zmax };
+    fStep = step;
+    fInvStep = 1. / step;
+    for (Int_t a = 0; a < 3; a++)
+    {
+        fMin[a] = lo[a];
+        fN[a] = TMath::Max(2, (Int_t)TMath::Ceil((hi[a] - lo[a]) * fInvStep) + 1);
+    }
+    Node zero = { { 0.f, 0.f, 0.f, 0.f } };
+    fNodes.assign((size_t)fN[0] * fN[1] * fN[2], zero);
+    fMaxField = 0.;
+}
+
+void R3BSofFieldGrid::Fill(FairField* field)
+{
+    Double_t p[3], b[3];
+    for (Int_t iz = 0; iz < fN[2]; iz++)
+        for (Int_t iy = 0; iy < fN[1]; iy++)
+            for (Int_t ix = 0; ix < fN[0]; ix++)
+            {
+                p[0] = GetCoordinate(0, ix);
+                p[1] = GetCoordinate(1, iy);
+                p[2] = GetCoordinate(2, iz);
+                field->GetFieldValue(p, b);
+                SetNode(ix, iy, iz, 0.1 * b[0], 0.1 * b[1], 0.1 * b[2]); // kG -> T
+            }
+    LOG(info) << "R3BSofFieldGrid::Fill() : " << fN[0] << " x " << fN[1] << " x " << fN[2] << " nodes, step "
+              << fStep << " cm, " << GetMemorySize() / 1024 << " kB, |B|max = " << fMaxField << " T";
+}
+
+void R3BSofFieldGrid::SetNode(Int_t ix, Int_t iy, Int_t iz, Float_t bx, Float_t by, Float_t bz)
+{
+    Node& n = fNodes[((size_t)iz * fN[1] + iy) * fN[0] + ix];
+    n.b[0] = bx;
+    n.b[1] = by;
+    n.b[2] = bz;
+    fMaxField = TMath::Max(fMaxField, TMath::Sqrt((Double_t)bx * bx + by * by + bz * bz));
+}
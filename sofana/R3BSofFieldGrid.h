@@ -0,0 +1,95 @@
+// ----------------------------------------------------------------------
+// -----                                                            -----
+// -----                     R3BSofFieldGrid                        -----
+// -----     Magnetic field sampled on a regular 3D grid in float,  -----
+// -----     one 16-byte node (Bx, By, Bz) per grid point, with     -----
+// -----     trilinear interpolation. Outside the grid B = 0        -----
+// -----                                                            -----
+// ----------------------------------------------------------------------
+
+#ifndef R3BSofFieldGrid_H
+#define R3BSofFieldGrid_H
+
+#include "Rtypes.h"
+
+#include <cstddef>
+#include <vector>
+
+class FairField;
+
+class R3BSofFieldGrid
+{
+  public:
+    /** Default constructor **/
+    R3BSofFieldGrid();
+
+    /** Destructor **/
+    virtual ~R3BSofFieldGrid();
+
+    /** Grid from (xmin,ymin,zmin) to (xmax,ymax,zmax) in cm with the given step, B = 0 **/
+    void Init(Double_t xmin, Double_t xmax, Double_t ymin, Double_t ymax, Double_t zmin, Double_t zmax, Double_t step);
+
+    /** Samples a FairField (kG) at the grid points, stored in T **/
+    void Fill(FairField* field);
+
+    /** Field at a grid point in T **/
+    void SetNode(Int_t ix, Int_t iy, Int_t iz, Float_t bx, Float_t by, Float_t bz);
+
+    Int_t GetNx() const { return fN[0]; }
+    Int_t GetNy() const { return fN[1]; }
+    Int_t GetNz() const { return fN[2]; }
+    Double_t GetStep() const { return fStep; }
+    Double_t GetCoordinate(Int_t axis, Int_t i) const { return fMin[axis] + i * fStep; }
+    Double_t GetZMin() const { return fMin[2]; }
+    Double_t GetZMax() const { return fMin[2] + (fN[2] - 1) * fStep; }
+    Double_t GetMaxField() const { return fMaxField; }
+    size_t GetMemorySize() const { return fNodes.size() * sizeof(Node); }
+
+    /** Field in T at the point p in cm **/
+    inline void GetField(const Double_t* p, Double_t* b) const
+    {
+        Double_t u[3];
+        Int_t i[3];
+        for (Int_t a = 0; a < 3; a++)
+        {
+            u[a] = (p[a] - fMin[a]) * fInvStep;
+            if (!(u[a] >= 0. && u[a] < fN[a] - 1))
+            {
+                b[0] = b[1] = b[2] = 0.;
+                return;
+            }
+            i[a] = (Int_t)u[a];
+            u[a] -= i[a];
+        }
+
+        // 8 corners, the x neighbours are adjacent in memory
+        const Node* n = &fNodes[(i[2] * fN[1] + i[1]) * fN[0] + i[0]];
+        const Int_t dy = fN[0];
+        const Int_t dz = fN[0] * fN[1];
+        for (Int_t c = 0; c < 3; c++)
+        {
+            Double_t b00 = n[0].b[c] + u[0] * (n[1].b[c] - n[0].b[c]);
+            Double_t b10 = n[dy].b[c] + u[0] * (n[dy + 1].b[c] - n[dy].b[c]);
+            Double_t b01 = n[dz].b[c] + u[0] * (n[dz + 1].b[c] - n[dz].b[c]);
+            Double_t b11 = n[dz + dy].b[c] + u[0] * (n[dz + dy + 1].b[c] - n[dz + dy].b[c]);
+            Double_t b0 = b00 + u[1] * (b10 - b00);
+            Double_t b1 = b01 + u[1] * (b11 - b01);
+            b[c] = b0 + u[2] * (b1 - b0);
+        }
+    }
+
+  private:
+    struct alignas(16) Node
+    {
+        Float_t b[4]; // Bx, By, Bz [T], padding
+    };
+
+    Double_t fMin[3];
+    Int_t fN[3];
+    Double_t fStep;
+    Double_t fInvStep;
+    Double_t fMaxField;
+    std::vector<Node> fNodes; // x fastest, then y, then z
+};
+
+#endif /* R3BSofFieldGrid_H */
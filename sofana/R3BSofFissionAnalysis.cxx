@@ -6,6 +6,7 @@
 
 #include "R3BSofFissionAnalysis.h"
 
+#include "FairField.h"
 #include "R3BMwpcHitData.h"
 #include "R3BSofGladFieldPar.h"
 #include "R3BSofTofWHitData.h"
@@ -27,6 +28,12 @@ R3BSofFissionAnalysis::R3BSofFissionAnalysis(const TString& name, Int_t iVerbose
     , fFieldCentre(0)
     , fEffLength(0.)
     , fBfield_Glad(0.)
+    , fUseFieldMap(kFALSE)
+    , fGridRange{ -250., 100., -50., 50. }
+    , fGridStep(3.)
+    , fStepBudget(1000)
+    , fNumFieldMapTracks(0)
+    , fNumHardEdgeFallbacks(0)
     , fMwpc0HitDataCA(NULL)
     , fTwimHitDataCA(NULL)
     , fMwpc1HitDataCA(NULL)
@@ -146,6 +153,35 @@ void R3BSofFissionAnalysis::SetParameter()
     fFieldCentre = fGladPar->GetFieldCentre();
     fEffLength = fGladPar->GetEffectiveLength();
     fBfield_Glad = fGladPar->GetMagneticField();
+    if (!fTargetGeoPar || !fMw1GeoPar || !fMw2GeoPar || !fMw3GeoPar || !fTofWGeoPar)
+    {
+        LOG(error) << "R3BSofFissionAnalysis::SetParameter() : geometry containers missing for the GLAD tracking";
+        return;
+    }
+    fGladTracker.SetGeometry(
+        fFieldCentre, fEffLength, fBfield_Glad, fTargetGeoPar, fMw1GeoPar, fMw2GeoPar, fMw3GeoPar, fTofWGeoPar);
+
+    // --- Field map of the run on a grid --- //
+    if (fUseFieldMap)
+    {
+        FairField* field = FairRunAna::Instance() ? FairRunAna::Instance()->GetField() : NULL;
+        if (!field)
+        {
+            LOG(error) << "R3BSofFissionAnalysis::SetParameter() : no field map in the run, hard-edge GLAD field used";
+            fUseFieldMap = kFALSE;
+            return;
+        }
+        fFieldGrid.Init(fGridRange[0],
+                        fGridRange[1],
+                        fGridRange[2],
+                        fGridRange[3],
+                        fFieldCentre - fEffLength,
+                        fFieldCentre + fEffLength,
+                        fGridStep);
+        fFieldGrid.Fill(field);
+        fRKTracker.SetGeometry(fTargetGeoPar, fMw1GeoPar, fMw2GeoPar, fMw3GeoPar, fTofWGeoPar);
+        fRKTracker.SetField(&fFieldGrid);
+    }
     return;
 }
 
@@ -236,8 +272,6 @@ void R3BSofFissionAnalysis::Exec(Option_t* option)
     if (nHitTwim == 0 || nHitTofW == 0 || nHitMwpc1 == 0 || nHitMwpc2 == 0 || nHitMwpc3 == 0)
         return;
 
-    Double_t Length = 0.;
-    Double_t Brho = 0.;
     Int_t pdid[2];
     Double_t tof[2];
     Double_t zf[2];
@@ -249,13 +283,6 @@ void R3BSofFissionAnalysis::Exec(Option_t* option)
         zf[j] = 0.;
     }
 
-    R3BMwpcHitData** HitMwpc0 = new R3BMwpcHitData*[nHitMwpc0];
-    R3BTwimHitData** HitTwim = new R3BTwimHitData*[nHitTwim];
-    R3BMwpcHitData** HitMwpc1 = new R3BMwpcHitData*[nHitMwpc1];
-    R3BMwpcHitData** HitMwpc2 = new R3BMwpcHitData*[nHitMwpc2];
-    R3BMwpcHitData** HitMwpc3 = new R3BMwpcHitData*[nHitMwpc3];
-    R3BSofTofWHitData** HitTofW = new R3BSofTofWHitData*[nHitTofW];
-
     TVector3 pos1[2];
     pos1[0].SetXYZ(-100., 0., 0.);
     pos1[1].SetXYZ(-100., 0., 0.);
@@ -268,267 +295,147 @@ void R3BSofFissionAnalysis::Exec(Option_t* option)
 
     for (Int_t i = 0; i < nHitTwim; i++)
     {
-        HitTwim[i] = (R3BTwimHitData*)(fTwimHitDataCA->At(i));
-        if (HitTwim[i]->GetSecID() == 0 || HitTwim[i]->GetSecID() == 1) // Left
-            zf[0] = HitTwim[i]->GetZcharge();
+        R3BTwimHitData* HitTwim = (R3BTwimHitData*)(fTwimHitDataCA->At(i));
+        if (HitTwim->GetSecID() == 0 || HitTwim->GetSecID() == 1) // Left
+            zf[0] = HitTwim->GetZcharge();
         else
-            zf[1] = HitTwim[i]->GetZcharge();
+            zf[1] = HitTwim->GetZcharge();
     }
 
     for (Int_t i = 0; i < nHitMwpc1; i++)
     {
-        HitMwpc1[i] = (R3BMwpcHitData*)(fMwpc1HitDataCA->At(i));
-        if (HitMwpc1[i]->GetX() > 0.)
-            pos1[0].SetXYZ(HitMwpc1[i]->GetX(), HitMwpc1[i]->GetY(), 0.);
+        R3BMwpcHitData* HitMwpc1 = (R3BMwpcHitData*)(fMwpc1HitDataCA->At(i));
+        if (HitMwpc1->GetX() > 0.)
+            pos1[0].SetXYZ(HitMwpc1->GetX(), HitMwpc1->GetY(), 0.);
         else
-            pos1[1].SetXYZ(HitMwpc1[i]->GetX(), HitMwpc1[i]->GetY(), 0.);
+            pos1[1].SetXYZ(HitMwpc1->GetX(), HitMwpc1->GetY(), 0.);
 
-        // std::cout<<i<<" "<< HitMwpc1[i]->GetX()<<" "<< HitMwpc1[i]->GetY()<<" "<< pos.Phi() <<std::endl;
+        // std::cout<<i<<" "<< HitMwpc1->GetX()<<" "<< HitMwpc1->GetY()<<" "<< pos.Phi() <<std::endl;
     }
 
     for (Int_t i = 0; i < nHitMwpc2; i++)
     {
 
-        HitMwpc2[i] = (R3BMwpcHitData*)(fMwpc2HitDataCA->At(i));
+        R3BMwpcHitData* HitMwpc2 = (R3BMwpcHitData*)(fMwpc2HitDataCA->At(i));
 
-        if (HitMwpc2[i]->GetX() > 0.)
-            pos2[0].SetXYZ(HitMwpc2[i]->GetX(), HitMwpc2[i]->GetY(), 0.);
+        if (HitMwpc2->GetX() > 0.)
+            pos2[0].SetXYZ(HitMwpc2->GetX(), HitMwpc2->GetY(), 0.);
         else
-            pos2[1].SetXYZ(HitMwpc2[i]->GetX(), HitMwpc2[i]->GetY(), 0.);
+            pos2[1].SetXYZ(HitMwpc2->GetX(), HitMwpc2->GetY(), 0.);
 
-        // std::cout<<i<<" "<< HitMwpc2[i]->GetX() <<" "<< HitMwpc2[i]->GetY()<<" "<< pos.Phi() <<std::endl;
+        // std::cout<<i<<" "<< HitMwpc2->GetX() <<" "<< HitMwpc2->GetY()<<" "<< pos.Phi() <<std::endl;
     }
 
     for (Int_t i = 0; i < nHitMwpc3; i++)
     {
 
-        HitMwpc3[i] = (R3BMwpcHitData*)(fMwpc3HitDataCA->At(i));
+        R3BMwpcHitData* HitMwpc3 = (R3BMwpcHitData*)(fMwpc3HitDataCA->At(i));
         if (i == 0)
-            pos3[0].SetXYZ(HitMwpc3[i]->GetX(), HitMwpc3[i]->GetY(), 0.);
+            pos3[0].SetXYZ(HitMwpc3->GetX(), HitMwpc3->GetY(), 0.);
         else
         {
-            if (HitMwpc3[i]->GetX() > pos3[0].X())
+            if (HitMwpc3->GetX() > pos3[0].X())
             {
 
                 pos3[1].SetXYZ(pos3[0].X(), pos3[0].Y(), 0.);
-                pos3[0].SetXYZ(HitMwpc3[i]->GetX(), HitMwpc3[i]->GetY(), 0.);
+                pos3[0].SetXYZ(HitMwpc3->GetX(), HitMwpc3->GetY(), 0.);
             }
             else
             {
-                pos3[1].SetXYZ(HitMwpc3[i]->GetX(), HitMwpc3[i]->GetY(), 0.);
+                pos3[1].SetXYZ(HitMwpc3->GetX(), HitMwpc3->GetY(), 0.);
             }
         }
 
-        // std::cout<<i<<" "<< HitMwpc3[i]->GetX() <<" "<< HitMwpc3[i]->GetY()<<" "<< pos.Phi() <<std::endl;
+        // std::cout<<i<<" "<< HitMwpc3->GetX() <<" "<< HitMwpc3->GetY()<<" "<< pos.Phi() <<std::endl;
     }
 
     for (Int_t i = 0; i < nHitTofW; i++)
     {
 
-        HitTofW[i] = (R3BSofTofWHitData*)(fTofWHitDataCA->At(i));
+        R3BSofTofWHitData* HitTofW = (R3BSofTofWHitData*)(fTofWHitDataCA->At(i));
         if (i == 0)
         {
-            pdid[0] = HitTofW[i]->GetPaddle();
-            tof[0] = HitTofW[i]->GetTof();
+            pdid[0] = HitTofW->GetPaddle();
+            tof[0] = HitTofW->GetTof();
         }
         else
         {
-            if (HitTofW[i]->GetPaddle() > pdid[0])
+            if (HitTofW->GetPaddle() > pdid[0])
             {
-                pdid[1] = HitTofW[i]->GetPaddle();
-                tof[1] = HitTofW[i]->GetTof();
+                pdid[1] = HitTofW->GetPaddle();
+                tof[1] = HitTofW->GetTof();
             }
             else
             {
                 pdid[1] = pdid[0];
                 tof[1] = tof[0];
-                pdid[0] = HitTofW[i]->GetPaddle();
-                tof[0] = HitTofW[i]->GetTof();
+                pdid[0] = HitTofW->GetPaddle();
+                tof[0] = HitTofW->GetTof();
             }
         }
     }
 
-    if (tof[0] > 2.0 && zf[0] > 5. && pos1[0].X() > -100. && pos2[0].X() > -100. && pos3[0].X() > -451.)
+    // Tracking of the fragments through GLAD
+    Bool_t good[2];
+    good[0] = tof[0] > 2.0 && zf[0] > 5. && pos1[0].X() > -100. && pos2[0].X() > -100. && pos3[0].X() > -451.;
+    good[1] = tof[1] > 1.0 && zf[1] > 1. && pos1[1].X() > -100. && pos2[1].X() > -100 && pos3[1].X() > -451.;
+
+    Double_t x1[2], x2[2], x3[2];
+    for (Int_t j = 0; j < 2; j++)
+    {
+        x1[j] = pos1[j].X() / 10.;
+        x2[j] = pos2[j].X() / 10.;
+        x3[j] = pos3[j].X() / 10.;
+    }
+    R3BSofGladTrack track[2];
+    fGladTracker.Track(x1, x2, x3, track, 2);
+
+    // Field map tracking from the hard-edge Brho, within the step budget of the event
+    if (fUseFieldMap)
     {
-        Length = GetLength(pos1[0].X() / 10., pos2[0].X() / 10., pos3[0].X() / 10.);
-        Brho = GetBrho(pos1[0].X() / 10., pos2[0].X() / 10., pos3[0].X() / 10.);
-        // Length = sqrt(Length*Length + pos3.Y()*pos3.Y()/100.);
-        // std::cout<<"1: "<<Length<<" "<< Brho<<" "<< tof[0] <<std::endl;
-        Double_t v = Length / tof[0] / c;
-        Double_t gamma = 1. / sqrt(1. - v * v);
-        AddData(zf[0], Brho / v / gamma / 3.107, v, Length, Brho, pdid[0]);
+        Int_t budget = fStepBudget;
+        for (Int_t j = 0; j < 2; j++)
+        {
+            if (!good[j])
+                continue;
+            R3BSofGladTrack rk;
+            Bool_t tracked = kFALSE;
+            if (budget > 0)
+            {
+                fRKTracker.SetMaxSteps(budget);
+                tracked =
+                    fRKTracker.Track(x1[j], pos1[j].Y() / 10., x2[j], pos2[j].Y() / 10., x3[j], track[j].brho, rk);
+                budget -= fRKTracker.GetNumSteps();
+            }
+            if (tracked)
+            {
+                track[j] = rk;
+                fNumFieldMapTracks++;
+            }
+            else
+                fNumHardEdgeFallbacks++;
+        }
     }
 
-    if (tof[1] > 1.0 && zf[1] > 1. && pos1[1].X() > -100. && pos2[1].X() > -100 && pos3[1].X() > -451.)
+    for (Int_t j = 0; j < 2; j++)
     {
-        Length = GetLength(pos1[1].X() / 10., pos2[1].X() / 10., pos3[1].X() / 10.);
-        Brho = GetBrho(pos1[1].X() / 10., pos2[1].X() / 10., pos3[1].X() / 10.);
-        // Length = sqrt(Length*Length + pos3.Y()*pos3.Y()/100.);
-        Double_t v = Length / tof[1] / c;
+        if (!good[j])
+            continue;
+        Double_t v = track[j].length / tof[j] / c;
         Double_t gamma = 1. / sqrt(1. - v * v);
-        AddData(zf[1], Brho / v / gamma / 3.107, v, Length, Brho, pdid[1]);
-    }
-
-    if (HitTwim)
-        delete HitTwim;
-    if (HitMwpc0)
-        delete HitMwpc0;
-    if (HitMwpc1)
-        delete HitMwpc1;
-    if (HitMwpc2)
-        delete HitMwpc2;
-    if (HitMwpc3)
-        delete HitMwpc3;
-    if (HitTofW)
-        delete HitTofW;
+        AddData(zf[j], track[j].brho / v / gamma / 3.107, v, track[j].length, track[j].brho, pdid[j]);
+    }
     return;
 }
 
-// -----   Private method for length  -----------------------------------------
-Double_t R3BSofFissionAnalysis::GetLength(Double_t mw1, Double_t mw2, Double_t mw3)
-{
-    Double_t length = 0.;
-    Double_t L = fEffLength; // cm
-    Double_t alpha = -14. * TMath::DegToRad();
-    Double_t beta = -20. * TMath::DegToRad();
-
-    Double_t theta = atan((mw2 - mw1) / (fMw2GeoPar->GetPosZ() - fMw1GeoPar->GetPosZ()));
-
-    // std::cout<<mw1<<" "<<mw2<<" "<<fMw1GeoPar->GetPosZ()<<" "<<fMw2GeoPar->GetPosZ()<<std::endl;
-    // std::cout<<alpha<<" "<<theta<<std::endl;
-
-    Double_t xc = 1. / (1. + tan(alpha) * tan(theta)) * (mw1 + (fFieldCentre - fMw1GeoPar->GetPosZ()) * tan(theta));
-    Double_t zc = fFieldCentre - xc * tan(alpha);
-
-    TVector3 posc = { xc, 0., zc };
-
-    // std::cout<<"c: "<<xc<<" "<<zc<<std::endl;
-
-    Double_t xb = xc - L / 2. * sin(theta) / cos(theta - alpha);
-    Double_t zb = zc - L / 2. * cos(theta) / cos(theta - alpha);
-
-    TVector3 posb = { xb, 0., zb };
-
-    // std::cout<<"b: "<<xb<<" "<<zb<<std::endl;
-
-    TVector3 ftrans = { fMw3GeoPar->GetPosX(), fMw3GeoPar->GetPosY(), fMw3GeoPar->GetPosZ() };
-    TRotation frot;
-    frot.RotateX(-1. * fMw3GeoPar->GetRotX() * TMath::DegToRad());
-    frot.RotateY(-1. * fMw3GeoPar->GetRotY() * TMath::DegToRad());
-    frot.RotateZ(-1. * fMw3GeoPar->GetRotZ() * TMath::DegToRad());
-    TVector3 pos;
-    pos.SetXYZ(mw3, 0., 0.);
-
-    auto pos2 = frot * pos + ftrans;
-
-    // std::cout<<"E: "<<pos2.X()<<" "<<pos2.Y()<<" "<<pos2.Z()<<std::endl;
-
-    auto pos3 = pos2 - posc;
-
-    Double_t eta = atan(pos3.X() / pos3.Z());
-
-    // std::cout<<eta<<std::endl;
-
-    Double_t xd = xc + L / 2. * sin(eta) / cos(eta + alpha);
-    Double_t zd = zc + L / 2. * cos(eta) / cos(eta + alpha);
-
-    TVector3 posd = { xd, 0., zd };
-
-    // std::cout<<"d: "<<xd<<" "<<zd<<std::endl;
-
-    Double_t xf = pos2.X() + (fTofWGeoPar->GetPosZ() - fMw3GeoPar->GetPosZ()) * sin(eta) / cos(eta - beta);
-    Double_t zf = pos2.Z() + (fTofWGeoPar->GetPosZ() - fMw3GeoPar->GetPosZ()) * cos(eta) / cos(eta - beta);
-
-    TVector3 posf = { xf, 0., zf };
-
-    // std::cout<<"f: "<<xf<<" "<<zf<<std::endl;
-
-    // double rho = -0.5*L/sin((eta-theta)/2.0)/cos(alpha-(theta+eta)/2.0);
-
-    Double_t rho = 0.5 * L / sin((theta - eta) / 2.0);
-
-    // double omega = 2.0/sin(sqrt( (posd.Z()-posb.Z())*(posd.Z()-posb.Z()) + (posd.X()-posb.X())*(posd.X()-posb.X())
-    // )/2.0/rho);
-
-    Double_t omega =
-        2.0 * asin(sqrt((posd.Z() - posb.Z()) * (posd.Z() - posb.Z()) + (posd.X() - posb.X()) * (posd.X() - posb.X())) /
-                   2.0 / rho);
-
-    length = (zb - fTargetGeoPar->GetPosZ()) / cos(theta) + omega * rho + (posf.Z() - posd.Z()) / cos(-eta) + 98.75;
-
-    // std::cout<<mw2<<" "<<mw3<<" "<< rho <<" "<<omega <<" "<<omega*rho <<" "<<(posd-posb).Mag()<<" "<<
-    // fTargetGeoPar->GetPosZ()<<" "<<length<<std::endl;
-
-    return length; // [cm]
-}
-
-// -----   Private method for Brho  --------------------------------------------
-Double_t R3BSofFissionAnalysis::GetBrho(Double_t mw1, Double_t mw2, Double_t mw3)
+// -----   Protected method Finish   ------------------------------------------
+void R3BSofFissionAnalysis::Finish()
 {
-    Double_t brho = 0.;
-
-    Double_t L = fEffLength; // cm
-    Double_t alpha = -14. * TMath::DegToRad();
-    Double_t beta = -20. * TMath::DegToRad();
-    Double_t theta = atan((mw2 - mw1) / (fMw2GeoPar->GetPosZ() - fMw1GeoPar->GetPosZ()));
-
-    Double_t xc = 1. / (1. + tan(alpha) * tan(theta)) * (mw1 + (fFieldCentre - fMw1GeoPar->GetPosZ()) * tan(theta));
-    Double_t zc = fFieldCentre - xc * tan(alpha);
-
-    TVector3 posc = { xc, 0., zc };
-
-    // std::cout<<"c: "<<xc<<" "<<zc<<std::endl;
-
-    Double_t xb = xc - L / 2. * sin(theta) / cos(theta - alpha);
-    Double_t zb = zc - L / 2. * cos(theta) / cos(theta - alpha);
-
-    TVector3 posb = { xb, 0., zb };
-
-    // std::cout<<"b: "<<xb<<" "<<zb<<std::endl;
-
-    TVector3 ftrans = { fMw3GeoPar->GetPosX(), fMw3GeoPar->GetPosY(), fMw3GeoPar->GetPosZ() };
-    TRotation frot;
-    frot.RotateX(-1. * fMw3GeoPar->GetRotX() * TMath::DegToRad());
-    frot.RotateY(-1. * fMw3GeoPar->GetRotY() * TMath::DegToRad());
-    frot.RotateZ(-1. * fMw3GeoPar->GetRotZ() * TMath::DegToRad());
-
-    TVector3 pos;
-    pos.SetXYZ(mw3, 0., 0.);
-
-    auto pos2 = frot * pos + ftrans;
-
-    // std::cout<<"E: "<<pos2.X()<<" "<<pos2.Y()<<" "<<pos2.Z()<<std::endl;
-
-    auto pos3 = pos2 - posc;
-
-    Double_t eta = atan(pos3.X() / pos3.Z());
-
-    // std::cout<<eta<<std::endl;
-
-    Double_t xd = xc + L / 2. * sin(eta) / cos(eta + alpha);
-    Double_t zd = zc + L / 2. * cos(eta) / cos(eta + alpha);
-
-    TVector3 posd = { xd, 0., zd };
-
-    // std::cout<<"d: "<<xd<<" "<<zd<<std::endl;
-
-    Double_t xf = pos2.X() + (fTofWGeoPar->GetPosZ() - fMw3GeoPar->GetPosZ()) * sin(eta) / cos(eta - beta);
-    Double_t zf = pos2.Z() + (fTofWGeoPar->GetPosZ() - fMw3GeoPar->GetPosZ()) * cos(eta) / cos(eta - beta);
-
-    TVector3 posf = { xf, 0., zf };
-
-    // std::cout<<"f: "<<xf<<" "<<zf<<std::endl;
-
-    Double_t rho = 0.5 * L / sin((theta - eta) / 2.0);
-
-    brho = rho * fBfield_Glad;
-
-    return brho / 100.; //[mT]
+    if (fUseFieldMap)
+        LOG(info) << "R3BSofFissionAnalysis: " << fNumFieldMapTracks << " fragments tracked in the field map, "
+                  << fNumHardEdgeFallbacks << " with the hard-edge field";
 }
 
-// -----   Protected method Finish   ------------------------------------------
-void R3BSofFissionAnalysis::Finish() {}
-
 // -----   Protected method FinishEvent   -------------------------------------
 void R3BSofFissionAnalysis::FinishEvent() {}
 
@@ -28,6 +28,9 @@
 #include "FairTask.h"
 
 // SOFIA headers
+#include "R3BSofFieldGrid.h"
+#include "R3BSofGladRKTracker.h"
+#include "R3BSofGladTracker.h"
 #include "R3BSofTrackingData.h"
 #include "R3BTwimHitPar.h"
 
@@ -79,10 +82,23 @@ class R3BSofFissionAnalysis : public FairTask
     /** Accessor functions **/
     void SetOffsetAq(Double_t theAq) { fOffsetAq = theAq; }
 
+    /** Tracking with the field map of the run (FairRunAna::SetField) instead of the hard-edge GLAD field.
+     *  The map is sampled at Init on a grid over the given x and y range [cm] and over z within one
+     *  effective length of the field centre **/
+    void SetUseFieldMap(Bool_t option) { fUseFieldMap = option; }
+    void SetFieldGrid(Double_t xmin, Double_t xmax, Double_t ymin, Double_t ymax, Double_t step)
+    {
+        fGridRange[0] = xmin;
+        fGridRange[1] = xmax;
+        fGridRange[2] = ymin;
+        fGridRange[3] = ymax;
+        fGridStep = step;
+    }
+    /** Runge-Kutta steps per event, the fragments beyond it keep the hard-edge result **/
+    void SetStepBudget(Int_t steps) { fStepBudget = steps; }
+
   private:
     void SetParameter();
-    Double_t GetLength(Double_t mw1, Double_t mw2, Double_t mw3);
-    Double_t GetBrho(Double_t mw1, Double_t mw2, Double_t mw3);
     Double_t GetVelocity(Double_t len, Double_t tof);
     Double_t GetAoverq(Double_t brho, Double_t vel);
 
@@ -93,6 +109,16 @@ class R3BSofFissionAnalysis : public FairTask
 
     // Parameters set with accessor functions
     Double_t fFieldCentre, fEffLength, fBfield_Glad;
+    R3BSofGladTracker fGladTracker; //! GLAD geometry, set in SetParameter
+
+    Bool_t fUseFieldMap;
+    Double_t fGridRange[4];
+    Double_t fGridStep;
+    Int_t fStepBudget;
+    R3BSofFieldGrid fFieldGrid;      //!
+    R3BSofGladRKTracker fRKTracker;  //!
+    ULong64_t fNumFieldMapTracks;    // fragments tracked in the field map
+    ULong64_t fNumHardEdgeFallbacks; // over the budget or not converged
 
     R3BSofGladFieldPar* fGladPar;
     R3BTwimHitPar* fTwimPar;
@@ -43,12 +43,12 @@ class R3BSofFragmentAnaPar : public FairParGenericSet
     void printParams();
 
     /** Accessor functions **/
-    const Int_t GetNumSci() { return fNumSci; }
-    const Int_t GetInUse(Int_t sci) { return fIn_use->GetAt(sci - 1); }
-    const Float_t GetTofWOffset(Int_t sci) { return fTofW_Offset->GetAt(sci - 1); }
-    const Float_t GetEffectivLength(Int_t sci) { return fEffective_Length->GetAt(sci - 1); }
-    const Int_t GetNumBrhoParameters() { return fNumBrhoParam; }
-    const Float_t GetBrhoParameter(Int_t index) { return fBrhoParameter->GetAt(index); }
+    const Int_t GetNumSci() const { return fNumSci; }
+    const Int_t GetInUse(Int_t sci) const { return fIn_use->GetAt(sci - 1); }
+    const Float_t GetTofWOffset(Int_t sci) const { return fTofW_Offset->GetAt(sci - 1); }
+    const Float_t GetEffectivLength(Int_t sci) const { return fEffective_Length->GetAt(sci - 1); }
+    const Int_t GetNumBrhoParameters() const { return fNumBrhoParam; }
+    const Float_t GetBrhoParameter(Int_t index) const { return fBrhoParameter->GetAt(index); }
 
     void SetNumSci(Int_t nb) { fNumSci = nb; }
     void SetInUse(Int_t value, Int_t sci) { fIn_use->AddAt(value, sci - 1); }
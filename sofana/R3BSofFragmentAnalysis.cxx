@@ -34,6 +34,10 @@ R3BSofFragmentAnalysis::R3BSofFragmentAnalysis()
     , fTwimHitDataCA(NULL)
     , fTrackingDataCA(NULL)
     , fOnline(kFALSE)
+    , fUseGladMap(kFALSE)
+    , fGladMapPar(NULL)
+    , fMw3GeoPar(NULL)
+    , fTofWGeoPar(NULL)
 {
 }
 
@@ -58,6 +62,10 @@ R3BSofFragmentAnalysis::R3BSofFragmentAnalysis(const TString& name, Int_t iVerbo
     , fTwimHitDataCA(NULL)
     , fTrackingDataCA(NULL)
     , fOnline(kFALSE)
+    , fUseGladMap(kFALSE)
+    , fGladMapPar(NULL)
+    , fMw3GeoPar(NULL)
+    , fTofWGeoPar(NULL)
 {
 }
 
@@ -126,6 +134,18 @@ void R3BSofFragmentAnalysis::SetParContainers()
 
     fRoluGeoPar = (R3BTGeoPar*)rtdb->getContainer("RoluGeoPar");
     R3BLOG_IF(warn, !fRoluGeoPar, "Could not get access to RoluGeoPar container.");
+
+    if (fUseGladMap)
+    {
+        fGladMapPar = (R3BSofGladMapPar*)rtdb->getContainer("GladMapPar");
+        R3BLOG_IF(error, !fGladMapPar, "Could not get access to GladMapPar container.");
+
+        fMw3GeoPar = (R3BTGeoPar*)rtdb->getContainer("Mwpc3GeoPar");
+        R3BLOG_IF(error, !fMw3GeoPar, "Could not get access to Mwpc3GeoPar container.");
+
+        fTofWGeoPar = (R3BTGeoPar*)rtdb->getContainer("TofwGeoPar");
+        R3BLOG_IF(error, !fTofWGeoPar, "Could not get access to TofwGeoPar container.");
+    }
 }
 
 void R3BSofFragmentAnalysis::SetParameter()
@@ -136,10 +156,7 @@ void R3BSofFragmentAnalysis::SetParameter()
     Int_t fNumParams = fTwimPar->GetNumParZFit(); // Number of TwimParameters
 
     // Anodes that don't work set to zero
-    TArrayF* TwimCalZParams = new TArrayF();
-    Int_t array_size = fNumSec * fNumParams;
-    TwimCalZParams->Set(array_size);
-    TwimCalZParams = fTwimPar->GetZHitPar(); // Array with the Cal parameters
+    TArrayF* TwimCalZParams = fTwimPar->GetZHitPar(); // Array with the Cal parameters
 
     // Parameters detector
     for (Int_t s = 0; s < fNumSec; s++)
@@ -158,6 +175,38 @@ void R3BSofFragmentAnalysis::SetParameter()
         else
             R3BLOG(warn,
                    "R3BTwimCal2Hit parameters for charge-Z cannot be used here, number of parameters: " << fNumParams);
+
+    // Polynomial transfer map through GLAD
+    if (fUseGladMap)
+    {
+        // an empty map would give Brho = 0 for all the fragments
+        if (fGladMapPar && fGladMapPar->GetNumBrhoTerms() < 1)
+        {
+            R3BLOG(error, "GladMapPar without Brho coefficients, back to the linear Brho parameters");
+            fUseGladMap = kFALSE;
+        }
+        else if (!fGladMapPar || !fMw3GeoPar || !fTofWGeoPar ||
+                 !fBrhoMap.Init(R3BSofGladMapPar::kNumVariables,
+                                fGladMapPar->GetOffsets()->GetArray(),
+                                fGladMapPar->GetScales()->GetArray(),
+                                fGladMapPar->GetNumBrhoTerms(),
+                                fGladMapPar->GetBrhoExponents()->GetArray(),
+                                fGladMapPar->GetBrhoCoefficients()->GetArray()) ||
+                 !fLengthMap.Init(R3BSofGladMapPar::kNumVariables,
+                                  fGladMapPar->GetOffsets()->GetArray(),
+                                  fGladMapPar->GetScales()->GetArray(),
+                                  fGladMapPar->GetNumLengthTerms(),
+                                  fGladMapPar->GetLengthExponents()->GetArray(),
+                                  fGladMapPar->GetLengthCoefficients()->GetArray()))
+        {
+            R3BLOG(error, "GLAD transfer map cannot be used, back to the linear Brho parameters");
+            fUseGladMap = kFALSE;
+        }
+        else
+            R3BLOG(info,
+                   "GLAD transfer map with " << fBrhoMap.GetNumTerms() << " terms for Brho and "
+                                             << fLengthMap.GetNumTerms() << " terms for the length");
+    }
 }
 
 // -----   Public method Init   --------------------------------------------
@@ -251,6 +300,7 @@ void R3BSofFragmentAnalysis::Exec(Option_t* option)
     Double_t Beta = NAN, Brho_Cave = NAN, Length = NAN;
     Double_t ToF_Cave = NAN, MusicTheta = NAN, TwimTheta = NAN;
     Double_t mw[4][4] = { { NAN } }; // mwpc[ID:0-4][x,y,a,b]
+    Double_t xTofW = NAN;
     Int_t Paddle = 0;
 
     Int_t nHitMwpc0 = fMwpc0HitDataCA->GetEntries();
@@ -260,13 +310,6 @@ void R3BSofFragmentAnalysis::Exec(Option_t* option)
     Int_t nHitTofW = fTofWHitDataCA->GetEntries();
     Int_t nHitMusic = fMusicHitDataCA->GetEntries();
     Int_t nHitTwim = fTwimHitDataCA->GetEntries();
-    HitTofW = new R3BSofTofWHitData*[nHitTofW];
-    HitMusic = new R3BMusicHitData*[nHitMusic];
-    HitTwim = new R3BTwimHitData*[nHitTwim];
-    HitMwpc0 = new R3BMwpcHitData*[nHitMwpc0];
-    HitMwpc1 = new R3BMwpcHitData*[nHitMwpc1];
-    HitMwpc2 = new R3BMwpcHitData*[nHitMwpc2];
-    HitMwpc3 = new R3BMwpcHitData*[nHitMwpc3];
 
     if (nHitMwpc0 < 1 || nHitMwpc1 < 1 || nHitMwpc2 < 1 || nHitMwpc3 < 1 || nHitTofW < 1 || nHitMusic < 1 ||
         nHitTwim < 1)
@@ -274,21 +317,21 @@ void R3BSofFragmentAnalysis::Exec(Option_t* option)
 
     for (Int_t i = 0; i < nHitMwpc0; i++)
     {
-        HitMwpc0[i] = (R3BMwpcHitData*)(fMwpc0HitDataCA->At(i));
-        mw[0][0] = HitMwpc0[i]->GetX() + fMw0GeoPar->GetPosX() * 10.; // mm
-        mw[0][1] = HitMwpc0[i]->GetY() + fMw0GeoPar->GetPosY() * 10.; // mm
+        R3BMwpcHitData* HitMwpc0 = (R3BMwpcHitData*)fMwpc0HitDataCA->At(i);
+        mw[0][0] = HitMwpc0->GetX() + fMw0GeoPar->GetPosX() * 10.; // mm
+        mw[0][1] = HitMwpc0->GetY() + fMw0GeoPar->GetPosY() * 10.; // mm
     }
     for (Int_t i = 0; i < nHitMwpc1; i++)
     {
-        HitMwpc1[i] = (R3BMwpcHitData*)(fMwpc1HitDataCA->At(i));
-        mw[1][0] = HitMwpc1[i]->GetX() + fMw1GeoPar->GetPosX() * 10.; // mm
-        mw[1][1] = HitMwpc1[i]->GetY() + fMw1GeoPar->GetPosY() * 10.; // mm
+        R3BMwpcHitData* HitMwpc1 = (R3BMwpcHitData*)fMwpc1HitDataCA->At(i);
+        mw[1][0] = HitMwpc1->GetX() + fMw1GeoPar->GetPosX() * 10.; // mm
+        mw[1][1] = HitMwpc1->GetY() + fMw1GeoPar->GetPosY() * 10.; // mm
     }
     for (Int_t i = 0; i < nHitMwpc2; i++)
     {
-        HitMwpc2[i] = (R3BMwpcHitData*)(fMwpc2HitDataCA->At(i));
-        mw[2][0] = HitMwpc2[i]->GetX() + fMw2GeoPar->GetPosX() * 10.; // mm
-        mw[2][1] = HitMwpc2[i]->GetY() + fMw2GeoPar->GetPosY() * 10.; // mm
+        R3BMwpcHitData* HitMwpc2 = (R3BMwpcHitData*)fMwpc2HitDataCA->At(i);
+        mw[2][0] = HitMwpc2->GetX() + fMw2GeoPar->GetPosX() * 10.; // mm
+        mw[2][1] = HitMwpc2->GetY() + fMw2GeoPar->GetPosY() * 10.; // mm
     }
     // Calculate raw angle /mm
     // mw[1][2] = mw[2][0] - mw[1][0];
@@ -296,22 +339,23 @@ void R3BSofFragmentAnalysis::Exec(Option_t* option)
     //
     for (Int_t i = 0; i < nHitMwpc3; i++)
     {
-        HitMwpc3[i] = (R3BMwpcHitData*)(fMwpc3HitDataCA->At(i));
-        mw[3][0] = HitMwpc3[i]->GetX();
-        mw[3][1] = HitMwpc3[i]->GetY();
+        R3BMwpcHitData* HitMwpc3 = (R3BMwpcHitData*)fMwpc3HitDataCA->At(i);
+        mw[3][0] = HitMwpc3->GetX();
+        mw[3][1] = HitMwpc3->GetY();
     }
     ////
     // Time from TofW
     for (Int_t i = 0; i < nHitTofW; i++)
     {
-        HitTofW[i] = (R3BSofTofWHitData*)(fTofWHitDataCA->At(i));
-        Paddle = HitTofW[i]->GetPaddle();
+        R3BSofTofWHitData* HitTofW = (R3BSofTofWHitData*)fTofWHitDataCA->At(i);
+        Paddle = HitTofW->GetPaddle();
         if (fFragPar->GetInUse(Paddle) != 1)
             continue;
-        ToF_Cave = HitTofW[i]->GetTof() - fFragPar->GetTofWOffset(Paddle);
+        ToF_Cave = HitTofW->GetTof() - fFragPar->GetTofWOffset(Paddle);
+        xTofW = HitTofW->GetX();
         Beta = fFragPar->GetEffectivLength(Paddle) / ToF_Cave;
         Length = fFragPar->GetEffectivLength(Paddle) * 2.998e2; // in mm. 0th order approx. To be modified later.
-        // std::cout <<" init: "<< HitTofW[i]->GetPaddle() << " "<< ToF_Cave << std::endl;
+        // std::cout <<" init: "<< HitTofW->GetPaddle() << " "<< ToF_Cave << std::endl;
     }
 
     if (TMath::IsNaN(ToF_Cave))
@@ -322,14 +366,14 @@ void R3BSofFragmentAnalysis::Exec(Option_t* option)
     // Getting Music angle
     for (Int_t ihit = 0; ihit < nHitMusic; ihit++)
     {
-        HitMusic[ihit] = (R3BMusicHitData*)fMusicHitDataCA->At(ihit);
-        if (!HitMusic[ihit])
+        R3BMusicHitData* HitMusic = (R3BMusicHitData*)fMusicHitDataCA->At(ihit);
+        if (!HitMusic)
             continue;
         // In case the MusicHitData container has several "realistic" values,
         // it's not possible to distinguish which is the "correct" event. Thus skipping events having several hits.
         if (TMath::Abs(MusicTheta) < 0.1)
             return;
-        MusicTheta = HitMusic[ihit]->GetTheta();
+        MusicTheta = HitMusic->GetTheta();
     }
     //
     if (fExpId == 444 || fExpId == 467)
@@ -345,14 +389,14 @@ void R3BSofFragmentAnalysis::Exec(Option_t* option)
     Double_t countz = 0;
     for (Int_t i = 0; i < nHitTwim; i++)
     {
-        HitTwim[i] = (R3BTwimHitData*)(fTwimHitDataCA->At(i));
-        if (HitTwim[i]->GetEave() > 1)
+        R3BTwimHitData* HitTwim = (R3BTwimHitData*)fTwimHitDataCA->At(i);
+        if (HitTwim->GetEave() > 1)
         {
-            fE = HitTwim[i]->GetEave();
-            TwimTheta = HitTwim[i]->GetTheta();
+            fE = HitTwim->GetEave();
+            TwimTheta = HitTwim->GetTheta();
             countz++;
             fZ = fTwimZ0 + fTwimZ1 * TMath::Sqrt(fE) * Beta + fTwimZ2 * fE * Beta * Beta;
-            HitTwim[i]->SetZcharge(fZ); // Upate Z
+            HitTwim->SetZcharge(fZ); // Upate Z
         }
     }
     //
@@ -360,11 +404,26 @@ void R3BSofFragmentAnalysis::Exec(Option_t* option)
     Double_t x_in = (mw[1][0] + mw[2][0]) / 2.;
     Double_t theta_in = TwimTheta;
     Double_t x_out = mw[3][0];
-    // Double_t theta_out = 0;
-    if (fFragPar->GetNumBrhoParameters() < 4)
-        return;
-    Brho_Cave = fFragPar->GetBrhoParameter(0) + fFragPar->GetBrhoParameter(1) * x_in +
-                fFragPar->GetBrhoParameter(2) * theta_in + fFragPar->GetBrhoParameter(3) * x_out;
+    if (fUseGladMap)
+    {
+        Double_t in[R3BSofGladMapPar::kNumVariables];
+        in[R3BSofGladMapPar::kXIn] = x_in;
+        in[R3BSofGladMapPar::kThetaIn] = theta_in;
+        in[R3BSofGladMapPar::kYIn] = (mw[1][1] + mw[2][1]) / 2.;
+        in[R3BSofGladMapPar::kXOut] = x_out;
+        in[R3BSofGladMapPar::kThetaOut] =
+            (xTofW - x_out) / ((fTofWGeoPar->GetPosZ() - fMw3GeoPar->GetPosZ()) * 10.); // mm/mm
+        Brho_Cave = fBrhoMap.Eval(in);
+        if (fLengthMap.GetNumTerms() > 0)
+            Length = fLengthMap.Eval(in);
+    }
+    else
+    {
+        if (fFragPar->GetNumBrhoParameters() < 4)
+            return;
+        Brho_Cave = fFragPar->GetBrhoParameter(0) + fFragPar->GetBrhoParameter(1) * x_in +
+                    fFragPar->GetBrhoParameter(2) * theta_in + fFragPar->GetBrhoParameter(3) * x_out;
+    }
     fAq = Brho_Cave / (3.10716 * Beta * gamma); //  m_u * c_0 / e = 3.107
 
     // Fill the data
@@ -381,21 +440,6 @@ void R3BSofFragmentAnalysis::Reset()
 {
     R3BLOG(debug, "Clearing SofTrackingData Structure");
 
-    if (HitTofW)
-        delete HitTofW;
-    if (HitMwpc0)
-        delete HitMwpc0;
-    if (HitMwpc1)
-        delete HitMwpc1;
-    if (HitMwpc2)
-        delete HitMwpc2;
-    if (HitMwpc3)
-        delete HitMwpc3;
-    if (HitMusic)
-        delete HitMusic;
-    if (HitTwim)
-        delete HitTwim;
-
     if (fTrackingDataCA)
         fTrackingDataCA->Clear();
     if (fRoluPosDataCA)
@@ -32,6 +32,8 @@
 #include "R3BMusicHitData.h"
 #include "R3BMwpcHitData.h"
 #include "R3BSofFragmentAnaPar.h"
+#include "R3BSofGladMapPar.h"
+#include "R3BSofPolynomialMap.h"
 #include "R3BSofTofWHitData.h"
 #include "R3BSofTrackingData.h"
 #include "R3BTGeoPar.h"
@@ -88,6 +90,10 @@ class R3BSofFragmentAnalysis : public FairTask
     void SetOffsetZ(Double_t theZ) { fOffsetZ = theZ; }
     void SetTofWPos(Double_t pos) { fTofWPos = pos; }
 
+    /** Brho and path length from the polynomial transfer map of GladMapPar
+     *  instead of the linear Brho parameters of soffragmentAnaPar **/
+    void SetUseGladMap(Bool_t option) { fUseGladMap = option; }
+
   private:
     void SetParameter();
 
@@ -99,6 +105,10 @@ class R3BSofFragmentAnalysis : public FairTask
     Bool_t fOnline; // Don't store data for online
     R3BSofFragmentAnaPar* fFragPar;
     R3BTwimHitPar* fTwimPar;
+    Bool_t fUseGladMap;
+    R3BSofGladMapPar* fGladMapPar;
+    R3BSofPolynomialMap fBrhoMap;   //!
+    R3BSofPolynomialMap fLengthMap; //!
 
     // Parameters from par file
     Float_t fTwimZ0 = 0., fTwimZ1 = 0., fTwimZ2 = 0.; // CalibPar for Twim
@@ -116,18 +126,12 @@ class R3BSofFragmentAnalysis : public FairTask
     TClonesArray* fTrackingDataCA; /**< Array with Tracking-output data. >*/
     TClonesArray* fRoluPosDataCA;  /**< Array with reconstructed ROLU positions. >*/
 
-    R3BSofTofWHitData** HitTofW;
-    R3BMusicHitData** HitMusic;
-    R3BTwimHitData** HitTwim;
-    R3BMwpcHitData** HitMwpc0;
-    R3BMwpcHitData** HitMwpc1;
-    R3BMwpcHitData** HitMwpc2;
-    R3BMwpcHitData** HitMwpc3;
-
     R3BTGeoPar* fMw0GeoPar;
     R3BTGeoPar* fMw1GeoPar;
     R3BTGeoPar* fMw2GeoPar;
     R3BTGeoPar* fRoluGeoPar;
+    R3BTGeoPar* fMw3GeoPar;
+    R3BTGeoPar* fTofWGeoPar;
 
     /** Private method TrackingData **/
     //** Adds a TrackingData to the analysis
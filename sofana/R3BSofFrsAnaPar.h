@@ -44,17 +44,17 @@ class R3BSofFrsAnaPar : public FairParGenericSet
     void printParams();
 
     /** Accessor functions **/
-    const Float_t GetBrho() { return fBrho0; }
-    const Int_t GetNumTof() { return fNumTof; }
-    const Int_t GetStaSciId(Int_t i) { return fStaSciId->GetAt(i); }
-    const Int_t GetStoSciId(Int_t i) { return fStoSciId->GetAt(i); }
-    const Float_t GetPathLength(Int_t i) { return fPathLength->GetAt(i); }
-    const Float_t GetTofOffset(Int_t i) { return fTofOffset->GetAt(i); }
-    const Int_t GetUseS2x(Int_t i) { return fUseS2x->GetAt(i); }
-    const Float_t GetS2PosCoef() { return fS2PosCoef; }
-    const Float_t GetS2PosOffset() { return fS2PosOffset; }
-    const Int_t GetNumBrhoCorrPar() { return fNumBrhoCorrPar; }
-    const Float_t GetBrhoCorrPar(Int_t i) { return fBrhoCorrPar->GetAt(i); }
+    const Float_t GetBrho() const { return fBrho0; }
+    const Int_t GetNumTof() const { return fNumTof; }
+    const Int_t GetStaSciId(Int_t i) const { return fStaSciId->GetAt(i); }
+    const Int_t GetStoSciId(Int_t i) const { return fStoSciId->GetAt(i); }
+    const Float_t GetPathLength(Int_t i) const { return fPathLength->GetAt(i); }
+    const Float_t GetTofOffset(Int_t i) const { return fTofOffset->GetAt(i); }
+    const Int_t GetUseS2x(Int_t i) const { return fUseS2x->GetAt(i); }
+    const Float_t GetS2PosCoef() const { return fS2PosCoef; }
+    const Float_t GetS2PosOffset() const { return fS2PosOffset; }
+    const Int_t GetNumBrhoCorrPar() const { return fNumBrhoCorrPar; }
+    const Float_t GetBrhoCorrPar(Int_t i) const { return fBrhoCorrPar->GetAt(i); }
 
     void SetBrho(Float_t brho) { fBrho0 = brho; }
     void SetNumTof(Int_t num) { fNumTof = num; }
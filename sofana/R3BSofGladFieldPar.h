@@ -42,9 +42,9 @@ class R3BSofGladFieldPar : public FairParGenericSet
     void printParams();
 
     /** Accessor functions **/
-    const Float_t GetMagneticField() { return fBz; }
-    const Float_t GetEffectiveLength() { return fEffLength; }
-    const Float_t GetFieldCentre() { return fFieldCentre; }
+    const Float_t GetMagneticField() const { return fBz; }
+    const Float_t GetEffectiveLength() const { return fEffLength; }
+    const Float_t GetFieldCentre() const { return fFieldCentre; }
 
     void SetMagneticField(Float_t b) { fBz = b; }
     void SetEffectiveLength(Float_t l) { fEffLength = l; }
@@ -0,0 +1,154 @@
+// ------------------------------------------------------------------
+// -----          R3BSofGladMapPar source file                  -----
+// ------------------------------------------------------------------
+
+#include "R3BSofGladMapPar.h"
+
+// ---- Standard Constructor ---------------------------------------------------
+R3BSofGladMapPar::R3BSofGladMapPar(const TString& name, const TString& title, const TString& context)
+    : FairParGenericSet(name, title, context)
+    , fNumBrhoTerms(0)
+    , fNumLengthTerms(0)
+{
+    fOffsets = new TArrayD(kNumVariables);
+    fScales = new TArrayD(kNumVariables);
+    for (Int_t i = 0; i < kNumVariables; i++)
+        fScales->AddAt(1., i);
+    fBrhoExponents = new TArrayI(0);
+    fBrhoCoefficients = new TArrayD(0);
+    fLengthExponents = new TArrayI(0);
+    fLengthCoefficients = new TArrayD(0);
+}
+
+// ----  Destructor ------------------------------------------------------------
+R3BSofGladMapPar::~R3BSofGladMapPar()
+{
+    clear();
+    if (fOffsets)
+        delete fOffsets;
+    if (fScales)
+        delete fScales;
+    if (fBrhoExponents)
+        delete fBrhoExponents;
+    if (fBrhoCoefficients)
+        delete fBrhoCoefficients;
+    if (fLengthExponents)
+        delete fLengthExponents;
+    if (fLengthCoefficients)
+        delete fLengthCoefficients;
+}
+
+// ----  Method clear ----------------------------------------------------------
+void R3BSofGladMapPar::clear()
+{
+    status = kFALSE;
+    resetInputVersions();
+}
+
+// ----  Method SetNumBrhoTerms ------------------------------------------------
+void R3BSofGladMapPar::SetNumBrhoTerms(Int_t nb)
+{
+    fNumBrhoTerms = nb;
+    fBrhoExponents->Set(nb * kNumVariables);
+    fBrhoCoefficients->Set(nb);
+}
+
+// ----  Method SetNumLengthTerms ----------------------------------------------
+void R3BSofGladMapPar::SetNumLengthTerms(Int_t nb)
+{
+    fNumLengthTerms = nb;
+    fLengthExponents->Set(nb * kNumVariables);
+    fLengthCoefficients->Set(nb);
+}
+
+// ----  Method SetBrhoTerm ----------------------------------------------------
+void R3BSofGladMapPar::SetBrhoTerm(Int_t term, const Int_t* exponents, Double_t coefficient)
+{
+    for (Int_t i = 0; i < kNumVariables; i++)
+        fBrhoExponents->AddAt(exponents[i], term * kNumVariables + i);
+    fBrhoCoefficients->AddAt(coefficient, term);
+}
+
+// ----  Method SetLengthTerm --------------------------------------------------
+void R3BSofGladMapPar::SetLengthTerm(Int_t term, const Int_t* exponents, Double_t coefficient)
+{
+    for (Int_t i = 0; i < kNumVariables; i++)
+        fLengthExponents->AddAt(exponents[i], term * kNumVariables + i);
+    fLengthCoefficients->AddAt(coefficient, term);
+}
+
+// ----  Method putParams ------------------------------------------------------
+void R3BSofGladMapPar::putParams(FairParamList* list)
+{
+    LOG(info) << "R3BSofGladMapPar::putParams() called";
+    if (!list)
+    {
+        return;
+    }
+    list->add("GladMapOffsets", *fOffsets);
+    list->add("GladMapScales", *fScales);
+    list->add("GladMapNumBrhoTerms", fNumBrhoTerms);
+    if (fNumBrhoTerms > 0)
+    {
+        list->add("GladMapBrhoExponents", *fBrhoExponents);
+        list->add("GladMapBrhoCoefficients", *fBrhoCoefficients);
+    }
+    list->add("GladMapNumLengthTerms", fNumLengthTerms);
+    if (fNumLengthTerms > 0)
+    {
+        list->add("GladMapLengthExponents", *fLengthExponents);
+        list->add("GladMapLengthCoefficients", *fLengthCoefficients);
+    }
+}
+
+// ----  Method getParams ------------------------------------------------------
+Bool_t R3BSofGladMapPar::getParams(FairParamList* list)
+{
+    LOG(info) << "R3BSofGladMapPar::getParams() called";
+    if (!list)
+    {
+        return kFALSE;
+    }
+
+    if (!list->fill("GladMapOffsets", fOffsets))
+        return kFALSE;
+    if (!list->fill("GladMapScales", fScales))
+        return kFALSE;
+
+    Int_t nb = 0;
+    if (!list->fill("GladMapNumBrhoTerms", &nb))
+        return kFALSE;
+    SetNumBrhoTerms(nb);
+    if (nb > 0)
+    {
+        if (!list->fill("GladMapBrhoExponents", fBrhoExponents))
+            return kFALSE;
+        if (!list->fill("GladMapBrhoCoefficients", fBrhoCoefficients))
+            return kFALSE;
+    }
+
+    if (!list->fill("GladMapNumLengthTerms", &nb))
+        return kFALSE;
+    SetNumLengthTerms(nb);
+    if (nb > 0)
+    {
+        if (!list->fill("GladMapLengthExponents", fLengthExponents))
+            return kFALSE;
+        if (!list->fill("GladMapLengthCoefficients", fLengthCoefficients))
+            return kFALSE;
+    }
+
+    return kTRUE;
+}
+
+// ----  Method printParams ----------------------------------------------------
+void R3BSofGladMapPar::printParams()
+{
+    LOG(info) << "R3BSofGladMapPar: GLAD transfer map parameters: ";
+    for (Int_t i = 0; i < kNumVariables; i++)
+        LOG(info) << "Variable " << i << ": offset " << fOffsets->GetAt(i) << ", scale " << fScales->GetAt(i);
+    LOG(info) << "Brho: " << fNumBrhoTerms << " terms";
+    LOG(info) << "Length: " << fNumLengthTerms << " terms";
+}
+
+ClassImp(R3BSofGladMapPar);
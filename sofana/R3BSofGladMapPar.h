@@ -0,0 +1,102 @@
+// ------------------------------------------------------------------
+// -----         R3BSofGladMapPar source file                   -----
+// ------------------------------------------------------------------
+//
+//  Polynomial transfer map through GLAD, fitted offline on simulated
+//  tracks: (x_in, theta_in, y_in, x_out, theta_out) -> (Brho, length)
+//
+//  x_in      : mean x at MWPC1 and MWPC2 [mm]
+//  theta_in  : angle from the Twim hit [rad]
+//  y_in      : mean y at MWPC1 and MWPC2 [mm]
+//  x_out     : x at MWPC3 [mm]
+//  theta_out : slope between MWPC3 and the ToF wall [rad]
+//  Brho [Tm], path length from the target to the ToF wall [mm]
+//
+//  The variables are normalised with u_i = (x_i - offset_i) / scale_i,
+//  each term of a map is given by its exponents of u_0..u_4 and its coefficient.
+
+#ifndef R3BSofGladMapPar_H
+#define R3BSofGladMapPar_H
+
+#include "FairLogger.h"
+#include "FairParGenericSet.h"
+#include "FairParamList.h"
+#include "TArrayD.h"
+#include "TArrayI.h"
+#include "TObject.h"
+#include "TString.h"
+
+#include <iostream>
+
+class FairParamList;
+
+class R3BSofGladMapPar : public FairParGenericSet
+{
+  public:
+    enum
+    {
+        kXIn,
+        kThetaIn,
+        kYIn,
+        kXOut,
+        kThetaOut,
+        kNumVariables
+    };
+
+    /** Standard constructor **/
+    R3BSofGladMapPar(const TString& name = "GladMapPar",
+                     const TString& title = "Glad Transfer Map Parameters",
+                     const TString& context = "GladMapParContext");
+
+    /** Destructor **/
+    virtual ~R3BSofGladMapPar();
+
+    /** Method to reset all parameters **/
+    virtual void clear();
+
+    /** Method to store all parameters using FairRuntimeDB **/
+    virtual void putParams(FairParamList* list);
+
+    /** Method to retrieve all parameters using FairRuntimeDB**/
+    Bool_t getParams(FairParamList* list);
+
+    /** Method to print values of parameters to the standard output **/
+    void printParams();
+
+    /** Accessor functions **/
+    const Double_t GetOffset(Int_t var) const { return fOffsets->GetAt(var); }
+    const Double_t GetScale(Int_t var) const { return fScales->GetAt(var); }
+    const Int_t GetNumBrhoTerms() const { return fNumBrhoTerms; }
+    const Int_t GetNumLengthTerms() const { return fNumLengthTerms; }
+    TArrayD* GetOffsets() { return fOffsets; }
+    TArrayD* GetScales() { return fScales; }
+    TArrayI* GetBrhoExponents() { return fBrhoExponents; }
+    TArrayD* GetBrhoCoefficients() { return fBrhoCoefficients; }
+    TArrayI* GetLengthExponents() { return fLengthExponents; }
+    TArrayD* GetLengthCoefficients() { return fLengthCoefficients; }
+
+    void SetOffset(Double_t value, Int_t var) { fOffsets->AddAt(value, var); }
+    void SetScale(Double_t value, Int_t var) { fScales->AddAt(value, var); }
+    void SetNumBrhoTerms(Int_t nb);
+    void SetNumLengthTerms(Int_t nb);
+    void SetBrhoTerm(Int_t term, const Int_t* exponents, Double_t coefficient);
+    void SetLengthTerm(Int_t term, const Int_t* exponents, Double_t coefficient);
+
+  private:
+    Int_t fNumBrhoTerms;
+    Int_t fNumLengthTerms;
+    TArrayD* fOffsets;
+    TArrayD* fScales;
+    TArrayI* fBrhoExponents; // kNumVariables per term
+    TArrayD* fBrhoCoefficients;
+    TArrayI* fLengthExponents; // kNumVariables per term
+    TArrayD* fLengthCoefficients;
+
+    const R3BSofGladMapPar& operator=(const R3BSofGladMapPar&); /*< an assignment operator>*/
+
+    R3BSofGladMapPar(const R3BSofGladMapPar&); /*< a copy constructor >*/
+
+    ClassDef(R3BSofGladMapPar, 1);
+};
+
+#endif
@@ -0,0 +1,295 @@
+// ----------------------------------------------------------------------
+// -----                                                            -----
+// -----                     R3BSofGladRKTracker                    -----
+// -----                                                            -----
+// ----------------------------------------------------------------------
+
+#include "R3BSofGladRKTracker.h"
+
+#include "R3BSofFieldGrid.h"
+#include "R3BTGeoPar.h"
+#include "TMath.h"
+#include "TRotation.h"
+
+namespace
+{
+    // Cash-Karp coefficients of the embedded Runge-Kutta 4(5)
+    const Double_t a2 = 1. / 5., a3 = 3. / 10., a4 = 3. / 5., a5 = 1., a6 = 7. / 8.;
+    const Double_t b21 = 1. / 5.;
+    const Double_t b31 = 3. / 40., b32 = 9. / 40.;
+    const Double_t b41 = 3. / 10., b42 = -9. / 10., b43 = 6. / 5.;
+    const Double_t b51 = -11. / 54., b52 = 5. / 2., b53 = -70. / 27., b54 = 35. / 27.;
+    const Double_t b61 = 1631. / 55296., b62 = 175. / 512., b63 = 575. / 13824., b64 = 44275. / 110592.,
+                   b65 = 253. / 4096.;
+    const Double_t c1 = 37. / 378., c3 = 250. / 621., c4 = 125. / 594., c6 = 512. / 1771.;
+    const Double_t dc1 = c1 - 2825. / 27648., dc3 = c3 - 18575. / 48384., dc4 = c4 - 13525. / 55296.,
+                   dc5 = -277. / 14336., dc6 = c6 - 1. / 4.;
+
+    const Int_t kNumState = 5;
+    const Double_t kPlanePrecision = 1.e-6; // cm
+    const Double_t kLengthOffset = 98.75;   // cm, as in R3BSofGladTracker
+} // namespace
+
+R3BSofGladRKTracker::R3BSofGladRKTracker()
+    : fField(NULL)
+    , fZTarget(0.)
+    , fZMw1(0.)
+    , fZMw2(1.)
+    , fStepTolerance(1.e-3)
+    , fMw3Tolerance(1.e-3)
+    , fMaxStepLength(50.)
+    , fStepsPerCell(4.)
+    , fMaxSteps(2000)
+    , fNumSteps(0)
+    , fStepLength(10.)
+    , fSlope(0.)
+    , fZAtMw3(0.)
+{
+}
+
+R3BSofGladRKTracker::~R3BSofGladRKTracker() {}
+
+void R3BSofGladRKTracker::SetGeometry(R3BTGeoPar* target,
+                                      R3BTGeoPar* mw1,
+                                      R3BTGeoPar* mw2,
+                                      R3BTGeoPar* mw3,
+                                      R3BTGeoPar* tofw)
+{
+    const Double_t geoMw3[6] = {
+        mw3->GetPosX(), mw3->GetPosY(), mw3->GetPosZ(), mw3->GetRotX(), mw3->GetRotY(), mw3->GetRotZ()
+    };
+    const Double_t geoTofW[6] = {
+        tofw->GetPosX(), tofw->GetPosY(), tofw->GetPosZ(), tofw->GetRotX(), tofw->GetRotY(), tofw->GetRotZ()
+    };
+    SetGeometry(target->GetPosZ(), mw1->GetPosZ(), mw2->GetPosZ(), geoMw3, geoTofW);
+}
+
+void R3BSofGladRKTracker::SetGeometry(Double_t zTarget,
+                                      Double_t zMw1,
+                                      Double_t zMw2,
+                                      const Double_t* mw3,
+                                      const Double_t* tofw)
+{
+    fZTarget = zTarget;
+    fZMw1 = zMw1;
+    fZMw2 = zMw2;
+    SetPlane(fMw3, mw3);
+    SetPlane(fTofW, tofw);
+}
+
+void R3BSofGladRKTracker::SetPlane(Plane& plane, const Double_t* geo)
+{
+    // same convention as R3BSofGladTracker for the local axes in the lab frame
+    TRotation frot;
+    frot.RotateX(-1. * geo[3] * TMath::DegToRad());
+    frot.RotateY(-1. * geo[4] * TMath::DegToRad());
+    frot.RotateZ(-1. * geo[5] * TMath::DegToRad());
+    for (Int_t a = 0; a < 3; a++)
+        plane.origin[a] = geo[a];
+    plane.ex[0] = frot.XX();
+    plane.ex[1] = frot.YX();
+    plane.ex[2] = frot.ZX();
+    plane.normal[0] = frot.XZ();
+    plane.normal[1] = frot.YZ();
+    plane.normal[2] = frot.ZZ();
+}
+
+void R3BSofGladRKTracker::Derivatives(Double_t z, const Double_t* s, Double_t k, Double_t* ds) const
+{
+    Double_t p[3] = { s[0], s[1], z };
+    Double_t b[3];
+    fField->GetField(p, b);
+
+    const Double_t tx = s[2], ty = s[3];
+    const Double_t r = TMath::Sqrt(1. + tx * tx + ty * ty);
+    ds[0] = tx;
+    ds[1] = ty;
+    ds[2] = k * r * (tx * ty * b[0] - (1. + tx * tx) * b[1] + ty * b[2]);
+    ds[3] = k * r * ((1. + ty * ty) * b[0] - tx * ty * b[1] - tx * b[2]);
+    ds[4] = r;
+}
+
+Double_t R3BSofGladRKTracker::Step(Double_t z, const Double_t* s, Double_t h, Double_t k, Double_t* out) const
+{
+    Double_t k1[kNumState], k2[kNumState], k3[kNumState], k4[kNumState], k5[kNumState], k6[kNumState];
+    Double_t t[kNumState];
+
+    Derivatives(z, s, k, k1);
+    for (Int_t i = 0; i < kNumState; i++)
+        t[i] = s[i] + h * b21 * k1[i];
+    Derivatives(z + a2 * h, t, k, k2);
+    for (Int_t i = 0; i < kNumState; i++)
+        t[i] = s[i] + h * (b31 * k1[i] + b32 * k2[i]);
+    Derivatives(z + a3 * h, t, k, k3);
+    for (Int_t i = 0; i < kNumState; i++)
+        t[i] = s[i] + h * (b41 * k1[i] + b42 * k2[i] + b43 * k3[i]);
+    Derivatives(z + a4 * h, t, k, k4);
+    for (Int_t i = 0; i < kNumState; i++)
+        t[i] = s[i] + h * (b51 * k1[i] + b52 * k2[i] + b53 * k3[i] + b54 * k4[i]);
+    Derivatives(z + a5 * h, t, k, k5);
+    for (Int_t i = 0; i < kNumState; i++)
+        t[i] = s[i] + h * (b61 * k1[i] + b62 * k2[i] + b63 * k3[i] + b64 * k4[i] + b65 * k5[i]);
+    Derivatives(z + a6 * h, t, k, k6);
+
+    // 5th order solution, error from the embedded 4th order one on the positions and on
+    // the slopes times a lever arm of 1 m
+    Double_t err[kNumState];
+    for (Int_t i = 0; i < kNumState; i++)
+    {
+        out[i] = s[i] + h * (c1 * k1[i] + c3 * k3[i] + c4 * k4[i] + c6 * k6[i]);
+        err[i] = h * (dc1 * k1[i] + dc3 * k3[i] + dc4 * k4[i] + dc5 * k5[i] + dc6 * k6[i]);
+    }
+    return TMath::Max(TMath::Max(TMath::Abs(err[0]), TMath::Abs(err[1])),
+                      100. * TMath::Max(TMath::Abs(err[2]), TMath::Abs(err[3])));
+}
+
+Bool_t R3BSofGladRKTracker::Propagate(Double_t& z, Double_t* s, Double_t k, const Plane& plane, Int_t mode)
+{
+    Double_t out[kNumState];
+    size_t replayed = 0;
+    while (fNumSteps < fMaxSteps)
+    {
+        // distance along z to the plane on the tangent
+        Double_t d = plane.normal[0] * (s[0] - plane.origin[0]) + plane.normal[1] * (s[1] - plane.origin[1]) +
+                     plane.normal[2] * (z - plane.origin[2]);
+        Double_t rate = plane.normal[0] * s[2] + plane.normal[1] * s[3] + plane.normal[2];
+        Double_t dz = -d / rate;
+        if (TMath::Abs(dz) < kPlanePrecision)
+            return kTRUE;
+
+        fNumSteps++;
+        if (mode == kReplay && replayed < fSteps.size())
+        {
+            Double_t h = TMath::Min(fSteps[replayed++], dz);
+            Step(z, s, h, k, out);
+            z += h;
+            for (Int_t i = 0; i < kNumState; i++)
+                s[i] = out[i];
+            continue;
+        }
+
+        // in the field at most fStepsPerCell grid cells per step, straight up to the field
+        Double_t limit = fMaxStepLength;
+        if (z < fField->GetZMin())
+            limit = TMath::Max(fField->GetZMin() - z, kPlanePrecision);
+        else if (z < fField->GetZMax())
+            limit = fStepsPerCell * fField->GetStep();
+        Double_t h = TMath::Min(TMath::Min(fStepLength, limit), dz);
+        Double_t err = Step(z, s, h, k, out);
+        if (err > fStepTolerance)
+        {
+            fStepLength = h * TMath::Max(0.1, 0.9 * TMath::Power(fStepTolerance / err, 0.25));
+            continue;
+        }
+        z += h;
+        for (Int_t i = 0; i < kNumState; i++)
+            s[i] = out[i];
+        if (mode == kRecord)
+            fSteps.push_back(h);
+        if (h == fStepLength || h == limit)
+        {
+            Double_t grow = err > 0. ? 0.9 * TMath::Power(fStepTolerance / err, 0.2) : 5.;
+            fStepLength = TMath::Min(fMaxStepLength, h * TMath::Min(5., grow));
+        }
+    }
+    return kFALSE;
+}
+
+Bool_t R3BSofGladRKTracker::GetMw3X(Double_t x1, Double_t y1, Double_t x2, Double_t y2, Double_t brho, Double_t& x3)
+{
+    fNumSteps = 0;
+    if (!fField || !(brho > 0.))
+        return kFALSE;
+    return Shoot(x2, y2, (x2 - x1) / (fZMw2 - fZMw1), (y2 - y1) / (fZMw2 - fZMw1), 1. / brho, kAdaptive, x3);
+}
+
+Bool_t R3BSofGladRKTracker::Shoot(Double_t x2,
+                                  Double_t y2,
+                                  Double_t tx,
+                                  Double_t ty,
+                                  Double_t invBrho,
+                                  Int_t mode,
+                                  Double_t& x3)
+{
+    Double_t s[kNumState] = { x2, y2, tx, ty, 0. };
+    Double_t z = fZMw2;
+    fStepLength = fMaxStepLength;
+    if (mode == kRecord)
+        fSteps.clear();
+    if (!Propagate(z, s, 0.01 * invBrho, fMw3, mode)) // 1/Brho in 1/(T cm)
+        return kFALSE;
+
+    fZAtMw3 = z;
+    for (Int_t i = 0; i < kNumState; i++)
+        fStateAtMw3[i] = s[i];
+    x3 = fMw3.ex[0] * (s[0] - fMw3.origin[0]) + fMw3.ex[1] * (s[1] - fMw3.origin[1]) +
+         fMw3.ex[2] * (z - fMw3.origin[2]);
+    return kTRUE;
+}
+
+Bool_t R3BSofGladRKTracker::Track(Double_t x1,
+                                  Double_t y1,
+                                  Double_t x2,
+                                  Double_t y2,
+                                  Double_t x3,
+                                  Double_t brho,
+                                  R3BSofGladTrack& track)
+{
+    fNumSteps = 0;
+    if (!fField || !(brho > 0.))
+        return kFALSE;
+
+    Double_t tx = (x2 - x1) / (fZMw2 - fZMw1);
+    Double_t ty = (y2 - y1) / (fZMw2 - fZMw1);
+
+    // Secant iteration on 1/Brho, the deflection at MWPC3 is nearly linear in 1/Brho.
+    // The steps of the first propagation are replayed in the next ones, such that
+    // x at MWPC3 is a smooth function of 1/Brho and not affected by the step control
+    Double_t kPrev = 1. / brho;
+    Double_t fPrev;
+    if (!Shoot(x2, y2, tx, ty, kPrev, kRecord, fPrev))
+        return kFALSE;
+    fPrev -= x3;
+    Double_t kCur = kPrev;
+    Double_t fCur = fPrev;
+    if (TMath::Abs(fCur) >= fMw3Tolerance)
+    {
+        // Newton step with the slope of the previous track, if any
+        kCur = fSlope != 0. ? kPrev - fPrev / fSlope : 1.01 * kPrev;
+        if (!(kCur > 0.))
+            kCur = 1.01 * kPrev;
+        if (!Shoot(x2, y2, tx, ty, kCur, kReplay, fCur))
+            return kFALSE;
+        fCur -= x3;
+    }
+    for (Int_t iter = 0; TMath::Abs(fCur) >= fMw3Tolerance; iter++)
+    {
+        if (iter == 20 || fCur == fPrev)
+            return kFALSE;
+        Double_t kNext = kCur - fCur * (kCur - kPrev) / (fCur - fPrev);
+        kPrev = kCur;
+        fPrev = fCur;
+        kCur = kNext;
+        if (!(kCur > 0.) || !Shoot(x2, y2, tx, ty, kCur, kReplay, fCur))
+            return kFALSE;
+        fCur -= x3;
+    }
+
+    if (fCur != fPrev)
+        fSlope = (fCur - fPrev) / (kCur - kPrev);
+
+    // from MWPC3 to the ToF wall with the converged Brho
+    Double_t z = fZAtMw3;
+    Double_t s[kNumState];
+    for (Int_t i = 0; i < kNumState; i++)
+        s[i] = fStateAtMw3[i];
+    fStepLength = fMaxStepLength;
+    if (!Propagate(z, s, 0.01 * kCur, fTofW, kAdaptive))
+        return kFALSE;
+
+    track.brho = 1. / kCur;
+    track.length = (fZMw2 - fZTarget) * TMath::Sqrt(1. + tx * tx + ty * ty) + s[4] + kLengthOffset;
+    track.omega = TMath::ATan(tx) - TMath::ATan(s[2]);
+    track.rho = 0.;
+    return kTRUE;
+}
@@ -0,0 +1,115 @@
+// ----------------------------------------------------------------------
+// -----                                                            -----
+// -----                     R3BSofGladRKTracker                    -----
+// -----     Tracking of a fragment through the GLAD field map      -----
+// -----     (R3BSofFieldGrid) with an adaptive Runge-Kutta-Fehlberg -----
+// -----     4(5) integration in z (Cash-Karp coefficients). Brho   -----
+// -----     is found by a secant (Newton) iteration on the x       -----
+// -----     position at MWPC3                                      -----
+// -----                                                            -----
+// ----------------------------------------------------------------------
+
+#ifndef R3BSofGladRKTracker_H
+#define R3BSofGladRKTracker_H
+
+#include "R3BSofGladTracker.h"
+#include "Rtypes.h"
+
+#include <vector>
+
+class R3BTGeoPar;
+class R3BSofFieldGrid;
+
+class R3BSofGladRKTracker
+{
+  public:
+    /** Default constructor **/
+    R3BSofGladRKTracker();
+
+    /** Destructor **/
+    virtual ~R3BSofGladRKTracker();
+
+    /** Geometry from the parameter containers, positions in cm and rotations in deg **/
+    void SetGeometry(R3BTGeoPar* target, R3BTGeoPar* mw1, R3BTGeoPar* mw2, R3BTGeoPar* mw3, R3BTGeoPar* tofw);
+
+    /** Same with the values, mw3 and tofw: posX, posY, posZ, rotX, rotY, rotZ **/
+    void SetGeometry(Double_t zTarget, Double_t zMw1, Double_t zMw2, const Double_t* mw3, const Double_t* tofw);
+
+    /** Field map, not owned **/
+    void SetField(const R3BSofFieldGrid* field) { fField = field; }
+
+    /** Tolerance of a Runge-Kutta step [cm] and on the x at MWPC3 [cm] **/
+    void SetTolerance(Double_t step, Double_t mw3)
+    {
+        fStepTolerance = step;
+        fMw3Tolerance = mw3;
+    }
+
+    /** Maximum length of a Runge-Kutta step in the field in units of the grid step. Longer steps jump over
+     *  the kinks of the trilinear interpolation and the error estimate of the step size control misses them **/
+    void SetStepsPerCell(Double_t n) { fStepsPerCell = n; }
+
+    /** Maximum number of Runge-Kutta steps for one call to Track **/
+    void SetMaxSteps(Int_t n) { fMaxSteps = n; }
+
+    /** Runge-Kutta steps, accepted or not, used by the last call to Track **/
+    Int_t GetNumSteps() const { return fNumSteps; }
+
+    /** x and y at MWPC1 and MWPC2, x at MWPC3, in cm. brho is the starting value of the iteration.
+     *  Returns kFALSE if the iteration does not converge within the maximum number of steps.
+     *  omega is the bending angle in the horizontal plane, rho is not defined and set to 0 **/
+    Bool_t Track(Double_t x1,
+                 Double_t y1,
+                 Double_t x2,
+                 Double_t y2,
+                 Double_t x3,
+                 Double_t brho,
+                 R3BSofGladTrack& track);
+
+    /** Local x at MWPC3 of a fragment of given Brho, from its x and y at MWPC1 and MWPC2 **/
+    Bool_t GetMw3X(Double_t x1, Double_t y1, Double_t x2, Double_t y2, Double_t brho, Double_t& x3);
+
+  private:
+    struct Plane
+    {
+        Double_t origin[3];
+        Double_t ex[3];     // local x axis
+        Double_t normal[3]; // local z axis
+    };
+    void SetPlane(Plane& plane, const Double_t* geo);
+
+    enum
+    {
+        kAdaptive, // step size control only
+        kRecord,   // step size control, the steps are stored
+        kReplay    // the stored steps, then step size control
+    };
+
+    // State: x, y, tx = dx/dz, ty = dy/dz, path length
+    void Derivatives(Double_t z, const Double_t* s, Double_t k, Double_t* ds) const;
+    Double_t Step(Double_t z, const Double_t* s, Double_t h, Double_t k, Double_t* out) const;
+    Bool_t Propagate(Double_t& z, Double_t* s, Double_t k, const Plane& plane, Int_t mode);
+    Bool_t Shoot(Double_t x2, Double_t y2, Double_t tx, Double_t ty, Double_t invBrho, Int_t mode, Double_t& x3);
+
+    const R3BSofFieldGrid* fField;
+    Double_t fZTarget;
+    Double_t fZMw1;
+    Double_t fZMw2;
+    Plane fMw3;
+    Plane fTofW;
+
+    Double_t fStepTolerance;
+    Double_t fMw3Tolerance;
+    Double_t fMaxStepLength;
+    Double_t fStepsPerCell;
+    Int_t fMaxSteps;
+    Int_t fNumSteps;
+    Double_t fStepLength;         // last accepted step
+    std::vector<Double_t> fSteps; // steps of the first propagation of a track
+    Double_t fSlope;              // dx3/d(1/Brho) of the last track
+
+    Double_t fZAtMw3; // state at MWPC3 of the last call to Shoot
+    Double_t fStateAtMw3[5];
+};
+
+#endif /* R3BSofGladRKTracker_H */
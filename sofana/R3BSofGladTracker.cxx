@@ -0,0 +1,126 @@
+// ----------------------------------------------------------------------
+// -----                                                            -----
+// -----                     R3BSofGladTracker                      -----
+// -----                                                            -----
+// ----------------------------------------------------------------------
+
+#include "R3BSofGladTracker.h"
+
+#include "R3BTGeoPar.h"
+#include "TMath.h"
+#include "TRotation.h"
+
+R3BSofGladTracker::R3BSofGladTracker()
+    : fFieldCentre(0.)
+    , fHalfLength(0.)
+    , fBfield(0.)
+    , fTanAlpha(0.)
+    , fSinAlpha(0.)
+    , fCosAlpha(1.)
+    , fSinBeta(0.)
+    , fCosBeta(1.)
+    , fZTarget(0.)
+    , fZMw1(0.)
+    , fInvDzMw12(0.)
+    , fMw3X{ 1., 0., 0. }
+    , fMw3Pos{ 0., 0., 0. }
+    , fDzMw3TofW(0.)
+{
+}
+
+R3BSofGladTracker::~R3BSofGladTracker() {}
+
+void R3BSofGladTracker::SetGeometry(Double_t fieldCentre,
+                                    Double_t effLength,
+                                    Double_t bfield,
+                                    R3BTGeoPar* target,
+                                    R3BTGeoPar* mw1,
+                                    R3BTGeoPar* mw2,
+                                    R3BTGeoPar* mw3,
+                                    R3BTGeoPar* tofw)
+{
+    Double_t alpha = -14. * TMath::DegToRad();
+    Double_t beta = -20. * TMath::DegToRad();
+
+    fFieldCentre = fieldCentre;
+    fHalfLength = effLength / 2.;
+    fBfield = bfield;
+    fTanAlpha = TMath::Tan(alpha);
+    fSinAlpha = TMath::Sin(alpha);
+    fCosAlpha = TMath::Cos(alpha);
+    fSinBeta = TMath::Sin(beta);
+    fCosBeta = TMath::Cos(beta);
+
+    fZTarget = target->GetPosZ();
+    fZMw1 = mw1->GetPosZ();
+    fInvDzMw12 = 1. / (mw2->GetPosZ() - mw1->GetPosZ());
+
+    // the hits at MWPC3 are along its local x axis
+    TRotation frot;
+    frot.RotateX(-1. * mw3->GetRotX() * TMath::DegToRad());
+    frot.RotateY(-1. * mw3->GetRotY() * TMath::DegToRad());
+    frot.RotateZ(-1. * mw3->GetRotZ() * TMath::DegToRad());
+    fMw3X[0] = frot.XX();
+    fMw3X[1] = frot.YX();
+    fMw3X[2] = frot.ZX();
+    fMw3Pos[0] = mw3->GetPosX();
+    fMw3Pos[1] = mw3->GetPosY();
+    fMw3Pos[2] = mw3->GetPosZ();
+    fDzMw3TofW = tofw->GetPosZ() - mw3->GetPosZ();
+}
+
+R3BSofGladTrack R3BSofGladTracker::Track(Double_t mw1, Double_t mw2, Double_t mw3) const
+{
+    R3BSofGladTrack track;
+
+    // incoming angle theta from MWPC1 and MWPC2
+    Double_t tanTheta = (mw2 - mw1) * fInvDzMw12;
+    Double_t cosTheta = 1. / TMath::Sqrt(1. + tanTheta * tanTheta);
+    Double_t sinTheta = tanTheta * cosTheta;
+
+    // c: intersection with the field centre plane
+    Double_t xc = (mw1 + (fFieldCentre - fZMw1) * tanTheta) / (1. + fTanAlpha * tanTheta);
+    Double_t zc = fFieldCentre - xc * fTanAlpha;
+
+    // b: entrance in the field
+    Double_t cosThetaAlpha = cosTheta * fCosAlpha + sinTheta * fSinAlpha;
+    Double_t xb = xc - fHalfLength * sinTheta / cosThetaAlpha;
+    Double_t zb = zc - fHalfLength * cosTheta / cosThetaAlpha;
+
+    // e: hit at MWPC3 in the lab frame, outgoing angle eta from c
+    Double_t xe = fMw3X[0] * mw3 + fMw3Pos[0];
+    Double_t ze = fMw3X[2] * mw3 + fMw3Pos[2];
+    Double_t tanEta = (xe - xc) / (ze - zc);
+    Double_t cosEta = 1. / TMath::Sqrt(1. + tanEta * tanEta);
+    Double_t sinEta = tanEta * cosEta;
+
+    // d: exit of the field
+    Double_t cosEtaAlpha = cosEta * fCosAlpha - sinEta * fSinAlpha;
+    Double_t xd = xc + fHalfLength * sinEta / cosEtaAlpha;
+    Double_t zd = zc + fHalfLength * cosEta / cosEtaAlpha;
+
+    // f: ToF wall
+    Double_t zf = ze + fDzMw3TofW * cosEta / (cosEta * fCosBeta + sinEta * fSinBeta);
+
+    // rho = L/2 / sin((theta-eta)/2), with sin(x/2) = sin(x) / sqrt(2(1+cos(x)))
+    Double_t sinDelta = sinTheta * cosEta - cosTheta * sinEta;
+    Double_t cosDelta = cosTheta * cosEta + sinTheta * sinEta;
+    track.rho = fHalfLength * TMath::Sqrt(2. * (1. + cosDelta)) / sinDelta;
+
+    Double_t chord = TMath::Sqrt((zd - zb) * (zd - zb) + (xd - xb) * (xd - xb));
+    track.omega = 2. * TMath::ASin(chord / 2. / track.rho);
+
+    track.length = (zb - fZTarget) / cosTheta + track.omega * track.rho + (zf - zd) / cosEta + 98.75;
+    track.brho = track.rho * fBfield / 100.;
+    return track;
+}
+
+void R3BSofGladTracker::Track(const Double_t* mw1,
+                              const Double_t* mw2,
+                              const Double_t* mw3,
+                              R3BSofGladTrack* track,
+                              Int_t n) const
+{
+    for (Int_t i = 0; i < n; i++)
+        track[i] = Track(mw1[i], mw2[i], mw3[i]);
+}
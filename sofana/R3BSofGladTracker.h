@@ -0,0 +1,65 @@
+// ----------------------------------------------------------------------
+// -----                                                            -----
+// -----                     R3BSofGladTracker                      -----
+// -----     Closed-form tracking of a fragment through GLAD with   -----
+// -----     a sharp-edge field, from the x positions at MWPC1,     -----
+// -----     MWPC2 and MWPC3. The geometry is fixed at              -----
+// -----     SetGeometry, one call per fragment gives the           -----
+// -----     length, Brho, radius and bending angle                 -----
+// -----                                                            -----
+// ----------------------------------------------------------------------
+
+#ifndef R3BSofGladTracker_H
+#define R3BSofGladTracker_H
+
+#include "Rtypes.h"
+
+class R3BTGeoPar;
+
+struct R3BSofGladTrack
+{
+    Double_t length; // [cm] from the target to the ToF wall
+    Double_t brho;   // [Tm]
+    Double_t rho;    // [cm] radius of curvature in GLAD
+    Double_t omega;  // [rad] bending angle in GLAD
+};
+
+class R3BSofGladTracker
+{
+  public:
+    /** Default constructor **/
+    R3BSofGladTracker();
+
+    /** Destructor **/
+    virtual ~R3BSofGladTracker();
+
+    /** Field centre and effective length in cm, magnetic field as in R3BSofGladFieldPar **/
+    void SetGeometry(Double_t fieldCentre,
+                     Double_t effLength,
+                     Double_t bfield,
+                     R3BTGeoPar* target,
+                     R3BTGeoPar* mw1,
+                     R3BTGeoPar* mw2,
+                     R3BTGeoPar* mw3,
+                     R3BTGeoPar* tofw);
+
+    /** x positions at MWPC1, MWPC2 and MWPC3 in cm **/
+    R3BSofGladTrack Track(Double_t mw1, Double_t mw2, Double_t mw3) const;
+
+    /** Batch version over n fragments **/
+    void Track(const Double_t* mw1, const Double_t* mw2, const Double_t* mw3, R3BSofGladTrack* track, Int_t n) const;
+
+  private:
+    Double_t fFieldCentre; // z of the field centre
+    Double_t fHalfLength;  // half of the effective length
+    Double_t fBfield;
+    Double_t fTanAlpha, fSinAlpha, fCosAlpha; // GLAD field boundaries, alpha = -14 deg
+    Double_t fSinBeta, fCosBeta;              // ToF wall, beta = -20 deg
+    Double_t fZTarget;
+    Double_t fZMw1, fInvDzMw12; // 1/(zMw2-zMw1)
+    Double_t fMw3X[3];          // MWPC3 local x axis in the lab frame
+    Double_t fMw3Pos[3];        // MWPC3 position
+    Double_t fDzMw3TofW;        // zTofW - zMw3
+};
+
+#endif /* R3BSofGladTracker_H */
@@ -0,0 +1,84 @@
+// -----------------------------------------------------------------
+// -----                                                       -----
+// -----              R3BSofMappedColumnsReader                -----
+// -----                                                       -----
+// -----------------------------------------------------------------
+
+#include "R3BSofMappedColumnsReader.h"
+
+#include "FairLogger.h"
+#include "FairRootManager.h"
+#include "TClonesArray.h"
+
+R3BSofMappedColumnsReader::R3BSofMappedColumnsReader()
+    : R3BSofMappedColumnsReader("R3BSofMappedColumnsReader", 1)
+{
+}
+
+R3BSofMappedColumnsReader::R3BSofMappedColumnsReader(const TString& name, Int_t iVerbose)
+    : FairTask(name, iVerbose)
+    , fOnline(kTRUE)
+{
+    for (Int_t det = 0; det < R3BSofMappedColumns::kNumDetectors; det++)
+    {
+        fColumns[det] = NULL;
+        fMappedData[det] = NULL;
+    }
+}
+
+R3BSofMappedColumnsReader::~R3BSofMappedColumnsReader()
+{
+    LOG(debug) << "R3BSofMappedColumnsReader: Delete instance";
+    for (Int_t det = 0; det < R3BSofMappedColumns::kNumDetectors; det++)
+        if (fMappedData[det])
+            delete fMappedData[det];
+}
+
+InitStatus R3BSofMappedColumnsReader::Init()
+{
+    LOG(info) << "R3BSofMappedColumnsReader::Init()";
+    FairRootManager* mgr = FairRootManager::Instance();
+    if (!mgr)
+    {
+        LOG(fatal) << "R3BSofMappedColumnsReader::Init() FairRootManager not found";
+        return kFATAL;
+    }
+
+    Int_t nDetectors = 0;
+    for (Int_t det = 0; det < R3BSofMappedColumns::kNumDetectors; det++)
+    {
+        R3BSofMappedColumns::Detector id = (R3BSofMappedColumns::Detector)det;
+        fColumns[det] = (R3BSofMappedColumns*)mgr->GetObject(R3BSofMappedColumns::GetColumnsName(id));
+        if (!fColumns[det])
+            continue;
+        // same name as the reader of the detector, the tasks do not see the difference
+        fMappedData[det] = new TClonesArray(R3BSofMappedColumns::GetMappedClassName(id));
+        mgr->Register(R3BSofMappedColumns::GetMappedName(id),
+                      R3BSofMappedColumns::GetFolderName(id),
+                      fMappedData[det],
+                      !fOnline);
+        LOG(info) << "R3BSofMappedColumnsReader::Init() " << R3BSofMappedColumns::GetMappedName(id) << " read from "
+                  << R3BSofMappedColumns::GetColumnsName(id);
+        nDetectors++;
+    }
+
+    if (nDetectors == 0)
+        LOG(warn) << "R3BSofMappedColumnsReader::Init() No SOFIA mapped columns in the input";
+    return kSUCCESS;
+}
+
+void R3BSofMappedColumnsReader::Exec(Option_t* option)
+{
+    for (Int_t det = 0; det < R3BSofMappedColumns::kNumDetectors; det++)
+        if (fColumns[det])
+            fColumns[det]->Unpack(fMappedData[det]);
+}
+
+void R3BSofMappedColumnsReader::Reset()
+{
+    for (Int_t det = 0; det < R3BSofMappedColumns::kNumDetectors; det++)
+        if (fMappedData[det])
+            fMappedData[det]->Clear();
+}
+
+ClassImp(R3BSofMappedColumnsReader)
@@ -0,0 +1,55 @@
+// -----------------------------------------------------------------
+// -----                                                       -----
+// -----              R3BSofMappedColumnsReader                -----
+// -----   Rebuilds the TClonesArray of SOFIA mapped data      -----
+// -----   (SofSciMappedData, TrimMappedData, ...) from the    -----
+// -----   "...MappedColumns" branches of the input file, for  -----
+// -----   the tasks that follow. Add it first to the run      -----
+// -----------------------------------------------------------------
+
+#ifndef R3BSofMappedColumnsReader_H
+#define R3BSofMappedColumnsReader_H
+
+#include "FairTask.h"
+#include "R3BSofMappedColumns.h"
+
+class TClonesArray;
+
+class R3BSofMappedColumnsReader : public FairTask
+{
+
+  public:
+    /** Default constructor **/
+    R3BSofMappedColumnsReader();
+
+    /** Standard constructor **/
+    R3BSofMappedColumnsReader(const TString& name, Int_t iVerbose = 1);
+
+    /** Destructor **/
+    virtual ~R3BSofMappedColumnsReader();
+
+    /** Virtual method Init **/
+    virtual InitStatus Init();
+
+    /** Virtual method Exec **/
+    virtual void Exec(Option_t* option);
+
+    /** Virtual method Reset **/
+    virtual void Reset();
+
+    /** Virtual method FinishEvent **/
+    virtual void FinishEvent() { Reset(); }
+
+    /** Accessor to store the rebuilt mapped data in the output file **/
+    void SetOnline(Bool_t option) { fOnline = option; }
+
+  private:
+    Bool_t fOnline;
+    R3BSofMappedColumns* fColumns[R3BSofMappedColumns::kNumDetectors];
+    TClonesArray* fMappedData[R3BSofMappedColumns::kNumDetectors];
+
+  public:
+    ClassDef(R3BSofMappedColumnsReader, 1)
+};
+
+#endif /* R3BSofMappedColumnsReader_H */
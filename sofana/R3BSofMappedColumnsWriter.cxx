@@ -0,0 +1,82 @@
+// -----------------------------------------------------------------
+// -----                                                       -----
+// -----              R3BSofMappedColumnsWriter                -----
+// -----                                                       -----
+// -----------------------------------------------------------------
+
+#include "R3BSofMappedColumnsWriter.h"
+
+#include "FairLogger.h"
+#include "FairRootManager.h"
+#include "TClonesArray.h"
+
+R3BSofMappedColumnsWriter::R3BSofMappedColumnsWriter()
+    : R3BSofMappedColumnsWriter("R3BSofMappedColumnsWriter", 1)
+{
+}
+
+R3BSofMappedColumnsWriter::R3BSofMappedColumnsWriter(const TString& name, Int_t iVerbose)
+    : FairTask(name, iVerbose)
+{
+    for (Int_t det = 0; det < R3BSofMappedColumns::kNumDetectors; det++)
+    {
+        fMappedData[det] = NULL;
+        fColumns[det] = NULL;
+    }
+}
+
+R3BSofMappedColumnsWriter::~R3BSofMappedColumnsWriter()
+{
+    LOG(debug) << "R3BSofMappedColumnsWriter: Delete instance";
+    for (Int_t det = 0; det < R3BSofMappedColumns::kNumDetectors; det++)
+        if (fColumns[det])
+            delete fColumns[det];
+}
+
+InitStatus R3BSofMappedColumnsWriter::Init()
+{
+    LOG(info) << "R3BSofMappedColumnsWriter::Init()";
+    FairRootManager* mgr = FairRootManager::Instance();
+    if (!mgr)
+    {
+        LOG(fatal) << "R3BSofMappedColumnsWriter::Init() FairRootManager not found";
+        return kFATAL;
+    }
+
+    Int_t nDetectors = 0;
+    for (Int_t det = 0; det < R3BSofMappedColumns::kNumDetectors; det++)
+    {
+        R3BSofMappedColumns::Detector id = (R3BSofMappedColumns::Detector)det;
+        fMappedData[det] = (TClonesArray*)mgr->GetObject(R3BSofMappedColumns::GetMappedName(id));
+        if (!fMappedData[det])
+            continue;
+        fColumns[det] = new R3BSofMappedColumns(id);
+        mgr->Register(R3BSofMappedColumns::GetColumnsName(id),
+                      R3BSofMappedColumns::GetFolderName(id),
+                      fColumns[det],
+                      kTRUE);
+        LOG(info) << "R3BSofMappedColumnsWriter::Init() " << R3BSofMappedColumns::GetMappedName(id) << " stored as "
+                  << R3BSofMappedColumns::GetColumnsName(id);
+        nDetectors++;
+    }
+
+    if (nDetectors == 0)
+        LOG(warn) << "R3BSofMappedColumnsWriter::Init() No SOFIA mapped data found";
+    return kSUCCESS;
+}
+
+void R3BSofMappedColumnsWriter::Exec(Option_t* option)
+{
+    for (Int_t det = 0; det < R3BSofMappedColumns::kNumDetectors; det++)
+        if (fColumns[det])
+            fColumns[det]->Pack(fMappedData[det]);
+}
+
+void R3BSofMappedColumnsWriter::Reset()
+{
+    for (Int_t det = 0; det < R3BSofMappedColumns::kNumDetectors; det++)
+        if (fColumns[det])
+            fColumns[det]->Clear();
+}
+
+ClassImp(R3BSofMappedColumnsWriter)
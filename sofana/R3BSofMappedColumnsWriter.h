@@ -0,0 +1,51 @@
+// -----------------------------------------------------------------
+// -----                                                       -----
+// -----              R3BSofMappedColumnsWriter                -----
+// -----   Stores the SOFIA mapped data in columns: for each   -----
+// -----   detector with mapped data, a R3BSofMappedColumns    -----
+// -----   branch "...MappedColumns". Run the readers with     -----
+// -----   SetOnline(kTRUE) to not store the TClonesArray too  -----
+// -----------------------------------------------------------------
+
+#ifndef R3BSofMappedColumnsWriter_H
+#define R3BSofMappedColumnsWriter_H
+
+#include "FairTask.h"
+#include "R3BSofMappedColumns.h"
+
+class TClonesArray;
+
+class R3BSofMappedColumnsWriter : public FairTask
+{
+
+  public:
+    /** Default constructor **/
+    R3BSofMappedColumnsWriter();
+
+    /** Standard constructor **/
+    R3BSofMappedColumnsWriter(const TString& name, Int_t iVerbose = 1);
+
+    /** Destructor **/
+    virtual ~R3BSofMappedColumnsWriter();
+
+    /** Virtual method Init **/
+    virtual InitStatus Init();
+
+    /** Virtual method Exec **/
+    virtual void Exec(Option_t* option);
+
+    /** Virtual method Reset **/
+    virtual void Reset();
+
+    /** Virtual method FinishEvent **/
+    virtual void FinishEvent() { Reset(); }
+
+  private:
+    TClonesArray* fMappedData[R3BSofMappedColumns::kNumDetectors];
+    R3BSofMappedColumns* fColumns[R3BSofMappedColumns::kNumDetectors];
+
+  public:
+    ClassDef(R3BSofMappedColumnsWriter, 1)
+};
+
+#endif /* R3BSofMappedColumnsWriter_H */
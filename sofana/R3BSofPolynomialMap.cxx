@@ -0,0 +1,136 @@
+// ----------------------------------------------------------------------
+// -----                                                            -----
+// -----                     R3BSofPolynomialMap                    -----
+// -----                                                            -----
+// ----------------------------------------------------------------------
+
+#include "R3BSofPolynomialMap.h"
+
+#include "FairLogger.h"
+
+#include <algorithm>
+#include <map>
+#include <numeric>
+
+R3BSofPolynomialMap::R3BSofPolynomialMap()
+    : fNumVariables(0)
+    , fNumTerms(0)
+{
+}
+
+R3BSofPolynomialMap::~R3BSofPolynomialMap() {}
+
+Bool_t R3BSofPolynomialMap::Init(Int_t nVariables,
+                                 const Double_t* offset,
+                                 const Double_t* scale,
+                                 Int_t nTerms,
+                                 const Int_t* exponents,
+                                 const Double_t* coefficients)
+{
+    fNumVariables = 0;
+    fNumTerms = 0;
+    if (nVariables < 1 || nVariables > kMaxVariables)
+    {
+        LOG(error) << "R3BSofPolynomialMap::Init() : " << nVariables << " variables, at most " << kMaxVariables;
+        return kFALSE;
+    }
+
+    fOffset.assign(offset, offset + nVariables);
+    fInvScale.resize(nVariables);
+    for (Int_t i = 0; i < nVariables; i++)
+    {
+        if (scale[i] == 0.)
+        {
+            LOG(error) << "R3BSofPolynomialMap::Init() : scale of the variable " << i << " is 0";
+            return kFALSE;
+        }
+        fInvScale[i] = 1. / scale[i];
+    }
+
+    // --- Terms, the ones with the same exponents are summed --- //
+    std::map<std::vector<Int_t>, Double_t> terms;
+    for (Int_t t = 0; t < nTerms; t++)
+    {
+        std::vector<Int_t> e(exponents + t * nVariables, exponents + (t + 1) * nVariables);
+        if (*std::min_element(e.begin(), e.end()) < 0)
+        {
+            LOG(error) << "R3BSofPolynomialMap::Init() : negative exponent in the term " << t;
+            return kFALSE;
+        }
+        terms[e] += coefficients[t];
+    }
+
+    // --- Monomials of the terms and their parents, the parent of a monomial has the exponent
+    // --- of its first non-zero variable lowered by one
+    std::map<std::vector<Int_t>, Int_t> monomials; // exponents -> total degree
+    for (auto& term : terms)
+    {
+        std::vector<Int_t> e = term.first;
+        Int_t degree = std::accumulate(e.begin(), e.end(), 0);
+        while (monomials.insert(std::make_pair(e, degree)).second && degree > 0)
+        {
+            (*std::find_if(e.begin(), e.end(), [](Int_t x) { return x > 0; }))--;
+            degree--;
+        }
+    }
+    if (monomials.size() > kMaxMonomials)
+    {
+        LOG(error) << "R3BSofPolynomialMap::Init() : " << monomials.size() << " monomials, at most " << kMaxMonomials;
+        return kFALSE;
+    }
+
+    // --- Increasing total degree, the parents come before their children --- //
+    std::vector<std::vector<Int_t>> order;
+    for (auto& mono : monomials)
+        order.push_back(mono.first);
+    std::stable_sort(order.begin(),
+                     order.end(),
+                     [&](const std::vector<Int_t>& a, const std::vector<Int_t>& b)
+                     { return monomials[a] < monomials[b]; });
+    std::map<std::vector<Int_t>, Int_t> index;
+    for (size_t m = 0; m < order.size(); m++)
+        index[order[m]] = m;
+
+    fParent.assign(order.size(), 0);
+    fVariable.assign(order.size(), 0);
+    fCoef.assign(order.size(), 0.);
+    for (size_t m = 0; m < order.size(); m++)
+    {
+        std::vector<Int_t> e = order[m];
+        auto term = terms.find(e);
+        if (term != terms.end())
+            fCoef[m] = term->second;
+        if (m == 0)
+            continue;
+        Int_t var = std::find_if(e.begin(), e.end(), [](Int_t x) { return x > 0; }) - e.begin();
+        e[var]--;
+        fParent[m] = index[e];
+        fVariable[m] = var;
+    }
+
+    fNumVariables = nVariables;
+    fNumTerms = terms.size();
+    return kTRUE;
+}
+
+Double_t R3BSofPolynomialMap::Eval(const Double_t* x) const
+{
+    const Int_t nMono = fCoef.size();
+    if (nMono == 0)
+        return 0.;
+
+    Double_t u[kMaxVariables];
+    for (Int_t i = 0; i < fNumVariables; i++)
+        u[i] = (x[i] - fOffset[i]) * fInvScale[i];
+
+    // The dependency chain of a monomial is its degree, the four partial sums are independent
+    Double_t mono[kMaxMonomials];
+    mono[0] = 1.;
+    Double_t sum[4] = { fCoef[0], 0., 0., 0. };
+    for (Int_t m = 1; m < nMono; m++)
+    {
+        mono[m] = mono[fParent[m]] * u[fVariable[m]];
+        sum[m & 3] += fCoef[m] * mono[m];
+    }
+    return (sum[0] + sum[1]) + (sum[2] + sum[3]);
+}
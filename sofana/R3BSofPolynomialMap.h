@@ -0,0 +1,60 @@
+// ----------------------------------------------------------------------
+// -----                                                            -----
+// -----                     R3BSofPolynomialMap                    -----
+// -----     Evaluation of a multivariate polynomial, e.g. a        -----
+// -----     transfer map through GLAD. The monomials are built     -----
+// -----     as a tree precomputed at Init, each one from a lower   -----
+// -----     degree one times a variable, and summed with           -----
+// -----     independent partial sums (Estrin-like evaluation)      -----
+// -----                                                            -----
+// ----------------------------------------------------------------------
+
+#ifndef R3BSofPolynomialMap_H
+#define R3BSofPolynomialMap_H
+
+#include "Rtypes.h"
+
+#include <vector>
+
+class R3BSofPolynomialMap
+{
+  public:
+    static const Int_t kMaxVariables = 8;
+    static const Int_t kMaxMonomials = 1024;
+
+    /** Default constructor **/
+    R3BSofPolynomialMap();
+
+    /** Destructor **/
+    virtual ~R3BSofPolynomialMap();
+
+    /** P(x) = sum_t coefficients[t] * prod_i u_i^exponents[t*nVariables+i], with u_i = (x_i-offset_i)/scale_i
+     *  Terms with the same exponents are summed. Returns kFALSE if the map cannot be evaluated **/
+    Bool_t Init(Int_t nVariables,
+                const Double_t* offset,
+                const Double_t* scale,
+                Int_t nTerms,
+                const Int_t* exponents,
+                const Double_t* coefficients);
+
+    Int_t GetNumVariables() const { return fNumVariables; }
+    Int_t GetNumTerms() const { return fNumTerms; }
+    Int_t GetNumMonomials() const { return fCoef.size(); }
+
+    /** x has nVariables values **/
+    Double_t Eval(const Double_t* x) const;
+
+  private:
+    Int_t fNumVariables;
+    Int_t fNumTerms;
+    std::vector<Double_t> fOffset;
+    std::vector<Double_t> fInvScale;
+
+    // Monomials in increasing total degree, the first one is 1.
+    // Monomial m = monomial fParent[m] * u[fVariable[m]]
+    std::vector<Int_t> fParent;
+    std::vector<Int_t> fVariable;
+    std::vector<Double_t> fCoef; // coefficient of each monomial, 0 for the intermediate ones
+};
+
+#endif /* R3BSofPolynomialMap_H */
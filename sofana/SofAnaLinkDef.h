@@ -11,7 +11,10 @@
 #pragma link C++ class R3BSofFrsAnaPar+;
 #pragma link C++ class R3BSofFragmentAnaPar+;
 #pragma link C++ class R3BSofGladFieldPar+;
+#pragma link C++ class R3BSofGladMapPar+;
 #pragma link C++ class R3BSofAnaContFact+;
 #pragma link C++ class R3BSofFissionAnalysis+;
+#pragma link C++ class R3BSofMappedColumnsWriter+;
+#pragma link C++ class R3BSofMappedColumnsReader+;
 
 #endif
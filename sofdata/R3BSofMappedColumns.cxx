@@ -0,0 +1,181 @@
+// -------------------------------------------------------------------------
+// -----                R3BSofMappedColumns source file                -----
+// -------------------------------------------------------------------------
+
+#include "R3BSofMappedColumns.h"
+
+#include "R3BSofAtMappedData.h"
+#include "R3BSofSciMappedData.h"
+#include "R3BSofTofWMappedData.h"
+#include "R3BSofTrimMappedData.h"
+#include "TClonesArray.h"
+
+namespace
+{
+    struct DetectorInfo
+    {
+        const char* mappedName;
+        const char* className;
+        const char* columnsName;
+        const char* folderName;
+        UInt_t columns;
+    };
+
+    // same order as R3BSofMappedColumns::Detector
+    const DetectorInfo kDetectorInfo[R3BSofMappedColumns::kNumDetectors] = {
+        { "SofSciMappedData",
+          "R3BSofSciMappedData",
+          "SofSciMappedColumns",
+          "SofSci",
+          R3BSofMappedColumns::kDetector | R3BSofMappedColumns::kChannel | R3BSofMappedColumns::kTime |
+              R3BSofMappedColumns::kTimeFine },
+        { "SofTofWMappedData",
+          "R3BSofTofWMappedData",
+          "SofTofWMappedColumns",
+          "SofTofW",
+          R3BSofMappedColumns::kDetector | R3BSofMappedColumns::kChannel | R3BSofMappedColumns::kTime |
+              R3BSofMappedColumns::kTimeFine | R3BSofMappedColumns::kEnergy | R3BSofMappedColumns::kFlags },
+        { "TrimMappedData",
+          "R3BSofTrimMappedData",
+          "TrimMappedColumns",
+          "SofTrim",
+          R3BSofMappedColumns::kDetector | R3BSofMappedColumns::kChannel | R3BSofMappedColumns::kTime |
+              R3BSofMappedColumns::kEnergy | R3BSofMappedColumns::kFlags },
+        { "AtMappedData",
+          "R3BSofAtMappedData",
+          "AtMappedColumns",
+          "SofAt",
+          R3BSofMappedColumns::kChannel | R3BSofMappedColumns::kTime | R3BSofMappedColumns::kEnergy |
+              R3BSofMappedColumns::kFlags },
+    };
+} // namespace
+
+// -----   Default constructor   -------------------------------------------
+R3BSofMappedColumns::R3BSofMappedColumns()
+    : TNamed("SofMappedColumns", "SOFIA mapped data in columns")
+    , fDetectorType(-1)
+    , fColumns(kChannel)
+{
+}
+
+// -----   Standard constructor   ------------------------------------------
+R3BSofMappedColumns::R3BSofMappedColumns(Detector det)
+    : TNamed(kDetectorInfo[det].columnsName, "SOFIA mapped data in columns")
+    , fDetectorType(det)
+    , fColumns(kDetectorInfo[det].columns)
+{
+}
+
+const char* R3BSofMappedColumns::GetMappedName(Detector det) { return kDetectorInfo[det].mappedName; }
+const char* R3BSofMappedColumns::GetMappedClassName(Detector det) { return kDetectorInfo[det].className; }
+const char* R3BSofMappedColumns::GetColumnsName(Detector det) { return kDetectorInfo[det].columnsName; }
+const char* R3BSofMappedColumns::GetFolderName(Detector det) { return kDetectorInfo[det].folderName; }
+
+// -----   Public method Clear   -------------------------------------------
+void R3BSofMappedColumns::Clear(Option_t*)
+{
+    // keeps the capacity of the columns from one event to the next
+    fDetectorId.clear();
+    fChannel.clear();
+    fTime.clear();
+    fTimeFine.clear();
+    fEnergy.clear();
+    fFlags.clear();
+}
+
+// -----   Public method Pack   --------------------------------------------
+void R3BSofMappedColumns::Pack(TClonesArray* mapped)
+{
+    Clear();
+    if (!mapped)
+        return;
+    const Int_t nHits = mapped->GetEntriesFast();
+    for (Int_t ihit = 0; ihit < nHits; ihit++)
+    {
+        switch (fDetectorType)
+        {
+            case kSci:
+            {
+                R3BSofSciMappedData* hit = (R3BSofSciMappedData*)mapped->At(ihit);
+                AddHit(hit->GetDetector(), hit->GetPmt(), hit->GetTimeCoarse(), hit->GetTimeFine(), 0, 0);
+                break;
+            }
+            case kTofW:
+            {
+                R3BSofTofWMappedData* hit = (R3BSofTofWMappedData*)mapped->At(ihit);
+                AddHit(hit->GetDetector(),
+                       hit->GetPmt(),
+                       hit->GetTimeCoarse(),
+                       hit->GetTimeFine(),
+                       hit->GetEnergy(),
+                       hit->WhichFlag() ? kPileup : 0);
+                break;
+            }
+            case kTrim:
+            {
+                R3BSofTrimMappedData* hit = (R3BSofTrimMappedData*)mapped->At(ihit);
+                AddHit(hit->GetSecID(),
+                       hit->GetAnodeID(),
+                       hit->GetTime(),
+                       0,
+                       hit->GetEnergy(),
+                       (hit->GetPileupStatus() ? kPileup : 0) | (hit->GetOverflowStatus() ? kOverflow : 0));
+                break;
+            }
+            case kAt:
+            {
+                R3BSofAtMappedData* hit = (R3BSofAtMappedData*)mapped->At(ihit);
+                AddHit(0,
+                       hit->GetAnodeID(),
+                       hit->GetTime(),
+                       0,
+                       hit->GetEnergy(),
+                       (hit->GetPileupStatus() ? kPileup : 0) | (hit->GetOverflowStatus() ? kOverflow : 0));
+                break;
+            }
+            default:
+                return;
+        }
+    }
+}
+
+// -----   Public method Unpack   ------------------------------------------
+void R3BSofMappedColumns::Unpack(TClonesArray* mapped) const
+{
+    mapped->Clear();
+    TClonesArray& clref = *mapped;
+    const UInt_t nHits = GetNumHits();
+    for (UInt_t i = 0; i < nHits; i++)
+    {
+        switch (fDetectorType)
+        {
+            case kSci:
+                new (clref[i]) R3BSofSciMappedData(GetDetector(i), GetChannel(i), GetTime(i), GetTimeFine(i));
+                break;
+            case kTofW:
+                new (clref[i]) R3BSofTofWMappedData(GetDetector(i),
+                                                    GetChannel(i),
+                                                    GetTime(i),
+                                                    GetTimeFine(i),
+                                                    GetEnergy(i),
+                                                    GetFlags(i) & kPileup);
+                break;
+            case kTrim:
+                new (clref[i]) R3BSofTrimMappedData(GetDetector(i),
+                                                    GetChannel(i),
+                                                    GetTime(i),
+                                                    GetEnergy(i),
+                                                    GetFlags(i) & kPileup,
+                                                    (GetFlags(i) & kOverflow) >> 1);
+                break;
+            case kAt:
+                new (clref[i]) R3BSofAtMappedData(
+                    GetChannel(i), GetEnergy(i), GetTime(i), GetFlags(i) & kPileup, (GetFlags(i) & kOverflow) >> 1);
+                break;
+            default:
+                return;
+        }
+    }
+}
+
+ClassImp(R3BSofMappedColumns)
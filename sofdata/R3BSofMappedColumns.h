@@ -0,0 +1,114 @@
+// -------------------------------------------------------------------------
+// -----                R3BSofMappedColumns header file                -----
+// -----     Mapped data of one SOFIA detector for one event, stored   -----
+// -----     in columns (one split branch per field, no TObject per    -----
+// -----     hit). Pack and Unpack convert from and to the             -----
+// -----     TClonesArray of R3BSof...MappedData used by the tasks     -----
+// -------------------------------------------------------------------------
+
+#ifndef R3BSofMappedColumns_H
+#define R3BSofMappedColumns_H
+
+#include "TNamed.h"
+
+#include <vector>
+
+class TClonesArray;
+
+class R3BSofMappedColumns : public TNamed
+{
+
+  public:
+    enum Detector
+    {
+        kSci = 0,
+        kTofW,
+        kTrim,
+        kAt,
+        kNumDetectors
+    };
+
+    // columns filled for a detector
+    enum Column
+    {
+        kDetector = 0x01,
+        kChannel = 0x02,
+        kTime = 0x04,
+        kTimeFine = 0x08,
+        kEnergy = 0x10,
+        kFlags = 0x20
+    };
+
+    // flags: pileup (TofW: flag) and overflow
+    enum Flag
+    {
+        kPileup = 0x1,
+        kOverflow = 0x2
+    };
+
+    /** Default constructor **/
+    R3BSofMappedColumns();
+
+    /** Constructor for one detector **/
+    R3BSofMappedColumns(Detector det);
+
+    /** Destructor **/
+    virtual ~R3BSofMappedColumns() {}
+
+    /** Names of the branches: "SofSciMappedData", ... and "SofSciMappedColumns", ... **/
+    static const char* GetMappedName(Detector det);
+    static const char* GetMappedClassName(Detector det);
+    static const char* GetColumnsName(Detector det);
+    static const char* GetFolderName(Detector det);
+
+    /** Resets the record for a new event **/
+    virtual void Clear(Option_t* option = "");
+
+    inline void AddHit(UShort_t det, UShort_t ch, UInt_t time, UInt_t timeFine, UInt_t energy, UChar_t flags)
+    {
+        if (fColumns & kDetector)
+            fDetectorId.push_back(det);
+        fChannel.push_back(ch);
+        if (fColumns & kTime)
+            fTime.push_back(time);
+        if (fColumns & kTimeFine)
+            fTimeFine.push_back(timeFine);
+        if (fColumns & kEnergy)
+            fEnergy.push_back(energy);
+        if (fColumns & kFlags)
+            fFlags.push_back(flags);
+    }
+
+    /** Fills the columns from the mapped data of the detector **/
+    void Pack(TClonesArray* mapped);
+
+    /** Fills the mapped data of the detector from the columns **/
+    void Unpack(TClonesArray* mapped) const;
+
+    /** Accessors, 0 for a column not used by the detector **/
+    inline Int_t GetDetectorType() const { return fDetectorType; }
+    inline UInt_t GetNumHits() const { return fChannel.size(); }
+    inline UShort_t GetDetector(UInt_t i) const { return (fColumns & kDetector) ? fDetectorId[i] : 0; }
+    inline UShort_t GetChannel(UInt_t i) const { return fChannel[i]; }
+    inline UInt_t GetTime(UInt_t i) const { return (fColumns & kTime) ? fTime[i] : 0; }
+    inline UInt_t GetTimeFine(UInt_t i) const { return (fColumns & kTimeFine) ? fTimeFine[i] : 0; }
+    inline UInt_t GetEnergy(UInt_t i) const { return (fColumns & kEnergy) ? fEnergy[i] : 0; }
+    inline UChar_t GetFlags(UInt_t i) const { return (fColumns & kFlags) ? fFlags[i] : 0; }
+
+  protected:
+    Int_t fDetectorType;
+    UInt_t fColumns;
+
+    // one entry per hit
+    std::vector<UShort_t> fDetectorId; // Sci, TofW: detector, Trim: section
+    std::vector<UShort_t> fChannel;    // Sci, TofW: pmt, Trim, At: anode
+    std::vector<UInt_t> fTime;         // Sci, TofW: coarse time
+    std::vector<UInt_t> fTimeFine;
+    std::vector<UInt_t> fEnergy;
+    std::vector<UChar_t> fFlags;
+
+  public:
+    ClassDef(R3BSofMappedColumns, 1)
+};
+
+#endif
@@ -29,13 +29,17 @@
 
 #pragma link C++ class R3BSofTrimMappedData+;
 #pragma link C++ class R3BSofTrimCalData+;
+#pragma link C++ class R3BSofTrimCalEvent+;
 #pragma link C++ class R3BSofTrimHitData+;
 
 #pragma link C++ class R3BSofTrackingData+;
 
 #pragma link C++ class R3BSofScalersMappedData+;
+#pragma link C++ class R3BSofScalersSpillData+;
 
 #pragma link C++ class R3BSofCorrmMappedData+;
 #pragma link C++ class R3BSofCorrvMappedData+;
 
+#pragma link C++ class R3BSofMappedColumns+;
+
 #endif
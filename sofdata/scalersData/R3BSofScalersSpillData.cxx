@@ -0,0 +1,84 @@
+// -------------------------------------------------------------------------
+// -----              R3BSofScalersSpillData source file               -----
+// -------------------------------------------------------------------------
+
+#include "R3BSofScalersSpillData.h"
+
+#include "R3BSofScalersMappedData.h"
+#include "TClonesArray.h"
+
+#include <algorithm>
+
+R3BSofScalersSpillData::R3BSofScalersSpillData()
+    : TNamed("SofScalersSpillData", "SOFIA scalers per spill")
+    , fCleared(kFALSE)
+    , fReadout(kFALSE)
+    , fHasReference(kFALSE)
+    , fNumSpills(0)
+    , fOffsets(1, 0)
+{
+}
+
+R3BSofScalersSpillData::R3BSofScalersSpillData(const std::vector<Int_t>& nChannels)
+    : R3BSofScalersSpillData()
+{
+    SetShape(nChannels);
+}
+
+void R3BSofScalersSpillData::SetShape(const std::vector<Int_t>& nChannels)
+{
+    fOffsets.assign(1, 0);
+    for (Int_t n : nChannels)
+        fOffsets.push_back(fOffsets.back() + n);
+    fLast.assign(fOffsets.back(), 0);
+    fHasReference = kFALSE;
+    fSpillCounts.resize(fOffsets.back());
+    fLastSpillCounts.resize(fOffsets.back());
+    fRunCounts.resize(fOffsets.back());
+    ResetCounts();
+}
+
+void R3BSofScalersSpillData::ResetCounts()
+{
+    fNumSpills = 0;
+    std::fill(fSpillCounts.begin(), fSpillCounts.end(), 0);
+    std::fill(fLastSpillCounts.begin(), fLastSpillCounts.end(), 0);
+    std::fill(fRunCounts.begin(), fRunCounts.end(), 0);
+}
+
+void R3BSofScalersSpillData::EndEvent()
+{
+    if (!fReadout)
+        return;
+    if (!fCleared && !fHasReference)
+    {
+        // values of the first readout
+        fHasReference = kTRUE;
+        std::fill(fSpillCounts.begin(), fSpillCounts.end(), 0);
+        return;
+    }
+    for (size_t i = 0; i < fSpillCounts.size(); i++)
+    {
+        fRunCounts[i] += fSpillCounts[i];
+        fLastSpillCounts[i] = fSpillCounts[i];
+        fSpillCounts[i] = 0;
+    }
+    fNumSpills++;
+}
+
+void R3BSofScalersSpillData::Update(const TClonesArray* mapped)
+{
+    BeginEvent();
+    if (mapped)
+    {
+        const Int_t nHits = mapped->GetEntriesFast();
+        for (Int_t ihit = 0; ihit < nHits; ihit++)
+        {
+            R3BSofScalersMappedData* hit = (R3BSofScalersMappedData*)mapped->At(ihit);
+            Fill(hit->GetScaler(), hit->GetChannel(), hit->GetValue());
+        }
+    }
+    EndEvent();
+}
+
+ClassImp(R3BSofScalersSpillData)
@@ -0,0 +1,93 @@
+// -------------------------------------------------------------------------
+// -----              R3BSofScalersSpillData header file               -----
+// -----     Counts of the SOFIA scalers per spill and per run,        -----
+// -----     filled by R3BSofScalersReader or by the online spectra    -----
+// -------------------------------------------------------------------------
+
+#ifndef R3BSOFSCALERSSPILLDATA_H
+#define R3BSOFSCALERSSPILLDATA_H
+
+#include "TNamed.h"
+
+#include <vector>
+
+class TClonesArray;
+
+// Counts of the SOFIA scalers aggregated per spill, updated event by event.
+// A scaler readout (at least one channel read with a non-zero value) closes the current spill.
+// The scaler modules count continuously: the counts of a channel are the differences between two readouts
+// (32-bit wrap-around included) and the first readout is the reference, unless SetCleared(kTRUE) for modules
+// cleared at each readout.
+class R3BSofScalersSpillData : public TNamed
+{
+  public:
+    // Default Constructor
+    R3BSofScalersSpillData();
+
+    // Constructor with the number of channels of each scaler, scalers and channels are 1-based
+    R3BSofScalersSpillData(const std::vector<Int_t>& nChannels);
+
+    // Destructor
+    virtual ~R3BSofScalersSpillData() {}
+
+    void SetShape(const std::vector<Int_t>& nChannels);
+    void SetCleared(Bool_t cleared) { fCleared = cleared; }
+    Bool_t IsCleared() const { return fCleared; }
+
+    // Clears the counts of the run
+    void ResetCounts();
+
+    // Event by event: BeginEvent, Fill for each channel read, EndEvent
+    inline void BeginEvent() { fReadout = kFALSE; }
+    inline void Fill(UShort_t scaler, UShort_t channel, UInt_t value)
+    {
+        if (value == 0 || scaler < 1 || scaler > fOffsets.size() - 1 || channel < 1 ||
+            fOffsets[scaler - 1] + channel > fOffsets[scaler])
+            return;
+        const Int_t i = fOffsets[scaler - 1] + channel - 1;
+        fSpillCounts[i] += fCleared ? value : value - fLast[i];
+        fLast[i] = value;
+        fReadout = kTRUE;
+    }
+    void EndEvent();
+
+    // Same from R3BSofScalersMappedData
+    void Update(const TClonesArray* mapped);
+
+    // Getters
+    // kTRUE in the events with a scaler readout, which closes a spill
+    inline Bool_t IsReadout() const { return fReadout; }
+    inline UInt_t GetNumSpills() const { return fNumSpills; }
+    inline Int_t GetNumScalers() const { return fOffsets.size() - 1; }
+    inline Int_t GetNumChannels(UShort_t scaler) const { return fOffsets[scaler] - fOffsets[scaler - 1]; }
+    inline ULong64_t GetRunCounts(UShort_t scaler, UShort_t channel) const
+    {
+        return fRunCounts[fOffsets[scaler - 1] + channel - 1];
+    }
+    inline ULong64_t GetLastSpillCounts(UShort_t scaler, UShort_t channel) const
+    {
+        return fLastSpillCounts[fOffsets[scaler - 1] + channel - 1];
+    }
+    // Mean counts per spill over the run
+    inline Double_t GetRatePerSpill(UShort_t scaler, UShort_t channel) const
+    {
+        return fNumSpills ? (Double_t)GetRunCounts(scaler, channel) / fNumSpills : 0.;
+    }
+
+  private:
+    Bool_t fCleared;
+    Bool_t fReadout;
+    Bool_t fHasReference;
+    UInt_t fNumSpills;
+    std::vector<Int_t> fOffsets; // first index of each scaler, fOffsets[0] = 0
+
+    std::vector<UInt_t> fLast; // last value read per channel
+    std::vector<ULong64_t> fSpillCounts;
+    std::vector<ULong64_t> fLastSpillCounts;
+    std::vector<ULong64_t> fRunCounts;
+
+  public:
+    ClassDef(R3BSofScalersSpillData, 1)
+};
+
+#endif
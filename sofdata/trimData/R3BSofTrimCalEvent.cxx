@@ -0,0 +1,77 @@
+// -------------------------------------------------------------------------
+// -----                 R3BSofTrimCalEvent source file                -----
+// -------------------------------------------------------------------------
+
+#include "R3BSofTrimCalEvent.h"
+
+#include "R3BSofTrimCalData.h"
+#include "TClonesArray.h"
+
+#include <algorithm>
+
+// -----   Default constructor   -------------------------------------------
+R3BSofTrimCalEvent::R3BSofTrimCalEvent()
+    : TNamed("TrimCalEvent", "Trim Cal event")
+    , fNumSections(0)
+    , fNumAnodes(0)
+    , fNumHits(0)
+{
+}
+
+// -----   Standard constructor   ------------------------------------------
+R3BSofTrimCalEvent::R3BSofTrimCalEvent(Int_t nSections, Int_t nAnodes)
+    : TNamed("TrimCalEvent", "Trim Cal event")
+    , fNumSections(0)
+    , fNumAnodes(0)
+    , fNumHits(0)
+{
+    SetShape(nSections, nAnodes);
+}
+
+// -----   Public method SetShape   ----------------------------------------
+void R3BSofTrimCalEvent::SetShape(Int_t nSections, Int_t nAnodes)
+{
+    fNumSections = nSections;
+    fNumAnodes = std::min(nAnodes, 32); // one bit per anode in the valid mask
+    fMult.resize(fNumSections * fNumAnodes);
+    fValidMask.resize(fNumSections);
+    fDriftTimeRaw.resize(fNumSections * fNumAnodes);
+    fDriftTimeAligned.resize(fNumSections * fNumAnodes);
+    fEnergySub.resize(fNumSections * fNumAnodes);
+    fEnergyMatch.resize(fNumSections * fNumAnodes);
+    Clear();
+}
+
+// -----   Public method Clear   -------------------------------------------
+void R3BSofTrimCalEvent::Clear(Option_t*)
+{
+    // same default values as R3BSofTrimCalData
+    fNumHits = 0;
+    std::fill(fMult.begin(), fMult.end(), 0);
+    std::fill(fValidMask.begin(), fValidMask.end(), 0);
+    std::fill(fDriftTimeRaw.begin(), fDriftTimeRaw.end(), -1000000.);
+    std::fill(fDriftTimeAligned.begin(), fDriftTimeAligned.end(), -1000000.);
+    std::fill(fEnergySub.begin(), fEnergySub.end(), 0.);
+    std::fill(fEnergyMatch.begin(), fEnergyMatch.end(), 0.);
+}
+
+// -----   Public method Fill   --------------------------------------------
+void R3BSofTrimCalEvent::Fill(TClonesArray* calData)
+{
+    Clear();
+    if (!calData)
+        return;
+    Int_t nHits = calData->GetEntriesFast();
+    for (Int_t ihit = 0; ihit < nHits; ihit++)
+    {
+        R3BSofTrimCalData* hit = (R3BSofTrimCalData*)calData->At(ihit);
+        AddHit(hit->GetSecID() - 1,
+               hit->GetAnodeID() - 1,
+               hit->GetDriftTimeRaw(),
+               hit->GetDriftTimeAligned(),
+               hit->GetEnergySub(),
+               hit->GetEnergyMatch());
+    }
+}
+
+ClassImp(R3BSofTrimCalEvent)
@@ -0,0 +1,100 @@
+// -------------------------------------------------------------------------
+// -----                 R3BSofTrimCalEvent header file                -----
+// -----     Cal data of the Triple-MUSIC for one event, dense per     -----
+// -----     section and anode: multiplicity and first hit. Filled     -----
+// -----     once by R3BSofTrimMapped2Cal for the Trim tasks, not      -----
+// -----     stored (R3BSofTrimCalData is the persistent output)       -----
+// -------------------------------------------------------------------------
+
+#ifndef R3BSofTrimCalEvent_H
+#define R3BSofTrimCalEvent_H
+
+#include "TNamed.h"
+
+#include <vector>
+
+class TClonesArray;
+
+class R3BSofTrimCalEvent : public TNamed
+{
+
+  public:
+    /** Default constructor **/
+    R3BSofTrimCalEvent();
+
+    /** Constructor with the number of sections and of anodes per section **/
+    R3BSofTrimCalEvent(Int_t nSections, Int_t nAnodes);
+
+    /** Destructor **/
+    virtual ~R3BSofTrimCalEvent() {}
+
+    void SetShape(Int_t nSections, Int_t nAnodes);
+
+    /** Resets the record for a new event **/
+    virtual void Clear(Option_t* option = "");
+
+    /** Adds a hit, section and anode are 0-based. Only the first hit of an anode is kept **/
+    inline void AddHit(Int_t section, Int_t anode, Double_t dtraw, Double_t dtal, Float_t esub, Float_t ematch)
+    {
+        if (section < 0 || section >= fNumSections || anode < 0 || anode >= fNumAnodes)
+            return;
+        const Int_t i = anode + section * fNumAnodes;
+        fNumHits++;
+        if (++fMult[i] == 1)
+        {
+            fDriftTimeRaw[i] = dtraw;
+            fDriftTimeAligned[i] = dtal;
+            fEnergySub[i] = esub;
+            fEnergyMatch[i] = ematch;
+            fValidMask[section] |= 1u << anode;
+        }
+        else
+            fValidMask[section] &= ~(1u << anode);
+    }
+
+    /** Record built from R3BSofTrimCalData, for the input files without it **/
+    void Fill(TClonesArray* calData);
+
+    /** Accessors, section and anode are 0-based **/
+    inline Int_t GetNumSections() const { return fNumSections; }
+    inline Int_t GetNumAnodes() const { return fNumAnodes; }
+    inline Int_t GetNumHits() const { return fNumHits; }
+
+    inline UInt_t GetMult(Int_t section, Int_t anode) const { return fMult[anode + section * fNumAnodes]; }
+
+    /** Anodes with exactly one hit: bit a for anode a **/
+    inline UInt_t GetValidMask(Int_t section) const { return fValidMask[section]; }
+    inline Bool_t IsValid(Int_t section, Int_t anode) const { return (fValidMask[section] >> anode) & 1u; }
+
+    inline Double_t GetDriftTimeRaw(Int_t section, Int_t anode) const
+    {
+        return fDriftTimeRaw[anode + section * fNumAnodes];
+    }
+    inline Double_t GetDriftTimeAligned(Int_t section, Int_t anode) const
+    {
+        return fDriftTimeAligned[anode + section * fNumAnodes];
+    }
+    inline Float_t GetEnergySub(Int_t section, Int_t anode) const { return fEnergySub[anode + section * fNumAnodes]; }
+    inline Float_t GetEnergyMatch(Int_t section, Int_t anode) const
+    {
+        return fEnergyMatch[anode + section * fNumAnodes];
+    }
+
+  protected:
+    Int_t fNumSections;
+    Int_t fNumAnodes;
+    Int_t fNumHits;
+
+    // anode + section * fNumAnodes, values of the first hit
+    std::vector<UInt_t> fMult;
+    std::vector<UInt_t> fValidMask; // per section
+    std::vector<Double_t> fDriftTimeRaw;
+    std::vector<Double_t> fDriftTimeAligned;
+    std::vector<Float_t> fEnergySub;
+    std::vector<Float_t> fEnergyMatch;
+
+  public:
+    ClassDef(R3BSofTrimCalEvent, 1)
+};
+
+#endif
@@ -28,7 +28,6 @@
 #include "TH2F.h"
 #include "THttpServer.h"
 #include "TMath.h"
-#include "TRandom.h"
 #include "TVector3.h"
 
 #include <array>
@@ -510,6 +509,8 @@ void R3BAmsCorrelationOnlineSpectra::Exec(Option_t* option)
     if (NULL == mgr)
         LOG(fatal) << "R3BAmsCorrelationOnlineSpectra::Exec FairRootManager not found";
 
+    fJitter.SetEvent(fNEvents);
+
     // Fill histogram with trigger information
 
     Int_t tpatbin;
@@ -620,7 +621,7 @@ void R3BAmsCorrelationOnlineSpectra::Exec(Option_t* option)
                 califa_phi[ihit] = phi;
                 califa_e[ihit] = hit->GetEnergy();
                 fh2_Califa_theta_phi->Fill(theta, phi);
-                fh2_Califa_theta_energy->Fill(theta + gRandom->Uniform(-1.5, 1.5), hit->GetEnergy());
+                fh2_Califa_theta_energy->Fill(theta + fJitter.Uniform(-1.5, 1.5), hit->GetEnergy());
                 fh1_Califa_total_energy->Fill(hit->GetEnergy());
             }
 
@@ -650,7 +651,7 @@ void R3BAmsCorrelationOnlineSpectra::Exec(Option_t* option)
             // Comparison of hits to get energy, theta and phi correlations between them
             for (Int_t i1 = 0; i1 < nHits; i1++)
                 for (Int_t i2 = i1 + 1; i2 < nHits; i2++)
-                    if (gRandom->Uniform(0., 1.) < 0.5)
+                    if (fJitter.Uniform(0., 1.) < 0.5)
                     {
                         fh2_Califa_coinE->Fill(califa_e[i1], califa_e[i2]);
                         fh2_Califa_coinTheta->Fill(califa_theta[i1], califa_theta[i2]);
@@ -753,29 +754,7 @@ void R3BAmsCorrelationOnlineSpectra::Exec(Option_t* option)
     fNEvents += 1;
 }
 
-void R3BAmsCorrelationOnlineSpectra::FinishEvent()
-{
-    if (fHitItemsAms)
-    {
-        fHitItemsAms->Clear();
-    }
-    if (fHitItemsTwim)
-    {
-        fHitItemsTwim->Clear();
-    }
-    if (fHitItemsMus)
-    {
-        fHitItemsMus->Clear();
-    }
-    if (fHitItemsTrim)
-    {
-        fHitItemsTrim->Clear();
-    }
-    if (fHitItemsCalifa)
-    {
-        fHitItemsCalifa->Clear();
-    }
-}
+void R3BAmsCorrelationOnlineSpectra::FinishEvent() {}
 
 void R3BAmsCorrelationOnlineSpectra::FinishTask()
 {
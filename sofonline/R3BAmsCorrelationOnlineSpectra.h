@@ -8,6 +8,7 @@
 #define R3BAmsCorrelationOnlineSpectra_H
 
 #include "FairTask.h"
+#include "R3BSofJitter.h"
 #include "TCanvas.h"
 #include "TH2F.h"
 #include "TMath.h"
@@ -109,6 +110,7 @@ class R3BAmsCorrelationOnlineSpectra : public FairTask
     R3BEventHeader* fEventHeader; /**< Event header.      */
     Int_t fTrigger;               /**< Trigger value. */
     Int_t fNEvents;               /**< Event counter. */
+    R3BSofJitter fJitter; //! smearing of the display fills
     Float_t fZproj;               // Atomic number of projectile
     Float_t fMinProtonE;          /**< Min proton energy (in keV) to calculate the opening angle */
 
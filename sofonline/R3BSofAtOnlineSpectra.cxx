@@ -16,6 +16,8 @@
 #include "FairRunOnline.h"
 #include "FairRuntimeDb.h"
 #include "R3BEventHeader.h"
+#include "R3BSofHistoFiller.h"
+#include "R3BSofSnapshotPublisher.h"
 #include "R3BSofAtMappedData.h"
 #include "R3BTwimHitData.h"
 #include "TCanvas.h"
@@ -43,6 +45,8 @@ R3BSofAtOnlineSpectra::R3BSofAtOnlineSpectra()
     , fHitItemsTwim(NULL)
     , fNumAnodes(4)
     , fNEvents(0)
+    , fFiller(new R3BSofHistoFiller())
+    , fPublisher(NULL)
 {
     for (Int_t a = 0; a < fNumAnodes; a++)
         fcutg[a] = new TCutG();
@@ -54,6 +58,8 @@ R3BSofAtOnlineSpectra::R3BSofAtOnlineSpectra(const char* name, Int_t iVerbose)
     , fHitItemsTwim(NULL)
     , fNumAnodes(4)
     , fNEvents(0)
+    , fFiller(new R3BSofHistoFiller())
+    , fPublisher(NULL)
 {
     for (Int_t a = 0; a < fNumAnodes; a++)
         fcutg[a] = new TCutG();
@@ -62,6 +68,8 @@ R3BSofAtOnlineSpectra::R3BSofAtOnlineSpectra(const char* name, Int_t iVerbose)
 R3BSofAtOnlineSpectra::~R3BSofAtOnlineSpectra()
 {
     LOG(info) << "R3BSofAtOnlineSpectra::Delete instance";
+    if (fFiller)
+        delete fFiller;
     if (fMappedItemsAt)
         delete fMappedItemsAt;
     if (fHitItemsTwim)
@@ -183,6 +191,7 @@ InitStatus R3BSofAtOnlineSpectra::Init()
         sprintf(Name1, "AT_E_anode%d", a + 1);
         sprintf(Name2, "AT - Energy - Anode %d", a + 1);
         fh1_atmap_E[a] = new TH1F(Name1, Name2, 65000, 0., 65000); // MDPP16 on 16 bits
+        fFiller->AddSparse(fh1_atmap_E[a]);
         fh1_atmap_E[a]->GetXaxis()->SetTitle("Raw Energy [channels]");
         fh1_atmap_E[a]->GetYaxis()->SetTitle("Counts");
         fh1_atmap_E[a]->GetYaxis()->SetTitleOffset(1.1);
@@ -199,6 +208,7 @@ InitStatus R3BSofAtOnlineSpectra::Init()
         sprintf(Name1, "AT_E_m1_anode%d", a + 1);
         sprintf(Name2, "AT - Energy - Anode %d - mult=1, pu and ov rejection", a + 1);
         fh1_atmap_E_mult1_wo_pu_ov[a] = new TH1F(Name1, Name2, 65000, 0., 65000); // MDPP16 on 16 bits
+        fFiller->AddSparse(fh1_atmap_E_mult1_wo_pu_ov[a]);
         fh1_atmap_E_mult1_wo_pu_ov[a]->GetXaxis()->SetTitle("Raw Energy [channels]");
         fh1_atmap_E_mult1_wo_pu_ov[a]->GetYaxis()->SetTitle("Counts");
         fh1_atmap_E_mult1_wo_pu_ov[a]->GetYaxis()->SetTitleOffset(1.1);
@@ -222,6 +232,7 @@ InitStatus R3BSofAtOnlineSpectra::Init()
         sprintf(Name1, "AT_E_anode%d_vs_E_anode%d", a + 2, a + 1);
         sprintf(Name2, "AT - Energy - Anode %d vs Anode %d", a + 2, a + 1);
         fh2_atmap_EvsE[a] = new TH2F(Name1, Name2, 650, 0., 65000, 650, 0., 65000); // MDPP16 on 16 bits
+        fFiller->AddSparse(fh2_atmap_EvsE[a], 250, 250);
         fh2_atmap_EvsE[a]->GetXaxis()->SetTitle("Raw Energy [channels]");
         fh2_atmap_EvsE[a]->GetYaxis()->SetTitle("Raw Energy [channels]");
         fh2_atmap_EvsE[a]->GetYaxis()->SetTitleOffset(1.1);
@@ -240,6 +251,7 @@ InitStatus R3BSofAtOnlineSpectra::Init()
     sprintf(Name1, "AT_E_anode%d_vs_E_anode%d", fNumAnodes, 1);
     sprintf(Name2, "AT - Energy - Anode %d vs Anode %d", fNumAnodes, 1);
     fh2_atmap_EvsE[fNumAnodes - 1] = new TH2F(Name1, Name2, 650, 0., 65000, 650, 0., 65000); // MDPP16 on 16 bits
+    fFiller->AddSparse(fh2_atmap_EvsE[fNumAnodes - 1], 250, 250);
     fh2_atmap_EvsE[fNumAnodes - 1]->GetXaxis()->SetTitle("Raw Energy [channels]");
     fh2_atmap_EvsE[fNumAnodes - 1]->GetYaxis()->SetTitle("Raw Energy [channels]");
     fh2_atmap_EvsE[fNumAnodes - 1]->GetYaxis()->SetTitleOffset(1.1);
@@ -261,6 +273,7 @@ InitStatus R3BSofAtOnlineSpectra::Init()
         sprintf(Name1, "AT_E_anode%d_vs_E_anode%d_mult1_nopu", a + 2, a + 1);
         sprintf(Name2, "AT - Energy - Anode %d vs Anode %d_mult1_nopu", a + 2, a + 1);
         fh2_atmap_EvsE_mult1_nopu[a] = new TH2F(Name1, Name2, 650, 0., 65000, 650, 0., 65000); // MDPP16 on 16 bits
+        fFiller->AddSparse(fh2_atmap_EvsE_mult1_nopu[a], 250, 250);
         fh2_atmap_EvsE_mult1_nopu[a]->GetXaxis()->SetTitle("Raw Energy [channels]");
         fh2_atmap_EvsE_mult1_nopu[a]->GetYaxis()->SetTitle("Raw Energy [channels]");
         fh2_atmap_EvsE_mult1_nopu[a]->GetYaxis()->SetTitleOffset(1.1);
@@ -315,6 +328,7 @@ InitStatus R3BSofAtOnlineSpectra::Init()
     sprintf(Name2, "AT - Energy - Anode %d vs Anode %d_mult1_nopu", fNumAnodes, 1);
     fh2_atmap_EvsE_mult1_nopu[fNumAnodes - 1] =
         new TH2F(Name1, Name2, 650, 0., 65000, 650, 0., 65000); // MDPP16 on 16 bits
+    fFiller->AddSparse(fh2_atmap_EvsE_mult1_nopu[fNumAnodes - 1], 250, 250);
     fh2_atmap_EvsE_mult1_nopu[fNumAnodes - 1]->GetXaxis()->SetTitle("Raw Energy [channels]");
     fh2_atmap_EvsE_mult1_nopu[fNumAnodes - 1]->GetYaxis()->SetTitle("Raw Energy [channels]");
     fh2_atmap_EvsE_mult1_nopu[fNumAnodes - 1]->GetYaxis()->SetTitleOffset(1.1);
@@ -444,15 +458,26 @@ InitStatus R3BSofAtOnlineSpectra::Init()
 
     run->AddObject(mainfolAt);
 
+    // copies served off the event loop
+    if (fPublisher)
+        fFiller->SetPublisher(fPublisher, fPublisher->Add(mainfolAt));
+
     // Register command to reset histograms
     run->GetHttpServer()->RegisterCommand("Reset_ActiveTarget_HIST", Form("/Objects/%s/->Reset_Histo()", GetName()));
 
     return kSUCCESS;
 }
 
+void R3BSofAtOnlineSpectra::SetUpdateRate(Int_t n, Double_t s)
+{
+    fFiller->SetFlushEvents(n);
+    fFiller->SetFlushSeconds(s);
+}
+
 void R3BSofAtOnlineSpectra::Reset_Histo()
 {
     LOG(info) << "R3BSofAtOnlineSpectra::Reset_Histo";
+    fFiller->Flush();
 
     // Mapped Data
     if (fMappedItemsAt)
@@ -463,10 +488,10 @@ void R3BSofAtOnlineSpectra::Reset_Histo()
         fh2_atmap_mult_wo_pu->Reset();
         for (Int_t a = 0; a < fNumAnodes; a++)
         {
-            fh1_atmap_E[a]->Reset();
-            fh1_atmap_E_mult1_wo_pu_ov[a]->Reset();
-            fh2_atmap_EvsE[a]->Reset();
-            fh2_atmap_EvsE_mult1_nopu[a]->Reset();
+            fFiller->Reset(fh1_atmap_E[a]);
+            fFiller->Reset(fh1_atmap_E_mult1_wo_pu_ov[a]);
+            fFiller->Reset(fh2_atmap_EvsE[a]);
+            fFiller->Reset(fh2_atmap_EvsE_mult1_nopu[a]);
         }
     }
     // Hit twim Data
@@ -523,20 +548,20 @@ void R3BSofAtOnlineSpectra::Exec(Option_t* option)
             if (map->GetOverflowStatus() == kTRUE)
                 ov[iAnode] = kTRUE; // at least one entry has overflow
             mult[iAnode]++;
-            fh1_atmap_mult->Fill(iAnode + 1);
-            fh1_atmap_E[iAnode]->Fill(E[iAnode]);
+            fFiller->Fill(fh1_atmap_mult, iAnode + 1);
+            fFiller->Fill(fh1_atmap_E[iAnode], E[iAnode]);
         } // end of loop over the Mapped data
 
         for (Int_t a = 0; a < fNumAnodes - 1; a++)
         {
             if (mult[a] == 1 && mult[a + 1] == 1)
             {
-                fh2_atmap_EvsE[a]->Fill(E[a], E[a + 1]);
+                fFiller->Fill(fh2_atmap_EvsE[a], E[a], E[a + 1]);
             }
         }
         if (mult[0] == 1 && mult[fNumAnodes - 1] == 1)
         { //      x ,  y
-            fh2_atmap_EvsE[fNumAnodes - 1]->Fill(E[0], E[fNumAnodes - 1]);
+            fFiller->Fill(fh2_atmap_EvsE[fNumAnodes - 1], E[0], E[fNumAnodes - 1]);
         }
 
         // ajout gui
@@ -544,28 +569,28 @@ void R3BSofAtOnlineSpectra::Exec(Option_t* option)
         {
             if (mult[a] == 1 && mult[a + 1] == 1 && pu[a] == kFALSE && pu[a + 1] == kFALSE)
             {
-                fh2_atmap_EvsE_mult1_nopu[a]->Fill(E[a], E[a + 1]);
+                fFiller->Fill(fh2_atmap_EvsE_mult1_nopu[a], E[a], E[a + 1]);
             }
         }
         if (mult[0] == 1 && mult[fNumAnodes - 1] == 1 && pu[0] == kFALSE && pu[fNumAnodes - 1] == kFALSE)
         { //      x ,  y
-            fh2_atmap_EvsE_mult1_nopu[fNumAnodes - 1]->Fill(E[0], E[fNumAnodes - 1]);
+            fFiller->Fill(fh2_atmap_EvsE_mult1_nopu[fNumAnodes - 1], E[0], E[fNumAnodes - 1]);
         }
 
         for (Int_t a = 0; a < fNumAnodes; a++)
         {
             if (mult[a] > 0)
             {
-                fh2_atmap_mult->Fill(a + 1, mult[a]);
+                fFiller->Fill(fh2_atmap_mult, a + 1, mult[a]);
                 if (pu[a] == kFALSE)
                 { // no entry is flaged with the pile-up bit
-                    fh1_atmap_mult_wo_pu->Fill(a + 1);
-                    fh2_atmap_mult_wo_pu->Fill(a + 1, mult[a]);
+                    fFiller->Fill(fh1_atmap_mult_wo_pu, a + 1);
+                    fFiller->Fill(fh2_atmap_mult_wo_pu, a + 1, mult[a]);
                 }
             }
             if (mult[a] == 1 && pu[a] == kFALSE && ov[a] == kFALSE)
             {
-                fh1_atmap_E_mult1_wo_pu_ov[a]->Fill(E[a]);
+                fFiller->Fill(fh1_atmap_E_mult1_wo_pu_ov[a], E[a]);
             }
         }
 
@@ -591,14 +616,14 @@ void R3BSofAtOnlineSpectra::Exec(Option_t* option)
                     }
 
                     if (zl > 0.)
-                        fh1_Twimhit_Zl[a]->Fill(zl);
+                        fFiller->Fill(fh1_Twimhit_Zl[a], zl);
                     if (zr > 0.)
-                        fh1_Twimhit_Zr[a]->Fill(zr);
+                        fFiller->Fill(fh1_Twimhit_Zr[a], zr);
 
                     if (zr > 0. && zl > 0.)
                     {
-                        fh2_Twimhit_ZrZl[a]->Fill(zl, zr);
-                        fh1_twim_ZSum[a]->Fill(zl + zr);
+                        fFiller->Fill(fh2_Twimhit_ZrZl[a], zl, zr);
+                        fFiller->Fill(fh1_twim_ZSum[a], zl + zr);
                     }
                 }
             }
@@ -606,19 +631,18 @@ void R3BSofAtOnlineSpectra::Exec(Option_t* option)
 
     } // end of if(MappedData)
 
+    // the histograms are updated every N events or T seconds, this event included
+    fFiller->Tick();
+
     fNEvents += 1;
 }
 
-void R3BSofAtOnlineSpectra::FinishEvent()
-{
-    if (fMappedItemsAt)
-        fMappedItemsAt->Clear();
-    if (fHitItemsTwim)
-        fHitItemsTwim->Clear();
-}
+void R3BSofAtOnlineSpectra::FinishEvent() {}
 
 void R3BSofAtOnlineSpectra::FinishTask()
 {
+    // written with the full binning, the zoom of the sparse histograms is only for the display
+    fFiller->Flush(kTRUE);
     if (fMappedItemsAt)
     {
         cAtMap_mult->Write();
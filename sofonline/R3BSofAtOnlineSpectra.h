@@ -22,6 +22,8 @@
 
 class TClonesArray;
 class R3BEventHeader;
+class R3BSofHistoFiller;
+class R3BSofSnapshotPublisher;
 
 /**
  * This taks reads FRS data and plots online histograms
@@ -83,6 +85,11 @@ class R3BSofAtOnlineSpectra : public FairTask
      */
     virtual void Reset_Histo();
 
+    /** The histograms served by the http server are updated every n events or s seconds, whichever first **/
+    void SetUpdateRate(Int_t n, Double_t s);
+    /** Copies of the histograms also served by publisher, updated at the same rate, before Init **/
+    void SetPublisher(R3BSofSnapshotPublisher* publisher) { fPublisher = publisher; }
+
     void SetSelection(Int_t section, TCutG* c) { fcutg[section - 1] = c; }
 
     void SetNumAnodes(Int_t num) { fNumAnodes = num; }
@@ -120,6 +127,9 @@ class R3BSofAtOnlineSpectra : public FairTask
     TH1F** fh1_Twimhit_Zr;
     TH2F** fh2_Twimhit_ZrZl;
     TH1F* fh1_twim_ZSum[3];
+    // Buffered fills of the histograms
+    R3BSofHistoFiller* fFiller;          //!
+    R3BSofSnapshotPublisher* fPublisher; //!
 
   public:
     ClassDef(R3BSofAtOnlineSpectra, 0)
@@ -352,15 +352,7 @@ void R3BSofCorrOnlineSpectra::Exec(Option_t* option)
     fNEvents += 1;
 }
 
-void R3BSofCorrOnlineSpectra::FinishEvent()
-{
-    if (fCorrvMapped)
-        fCorrvMapped->Clear();
-    if (fCorrmMapped)
-        fCorrmMapped->Clear();
-    if (fSciTcal)
-        fSciTcal->Clear();
-}
+void R3BSofCorrOnlineSpectra::FinishEvent() {}
 
 void R3BSofCorrOnlineSpectra::FinishTask()
 {
@@ -0,0 +1,328 @@
+// ------------------------------------------------------------
+// -----                 R3BSofEventSummary               -----
+// -----    Decodes once per event the SOFIA data used    -----
+// -----    by several online spectra                     -----
+// ------------------------------------------------------------
+
+#include "R3BSofEventSummary.h"
+
+#include "FairLogger.h"
+#include "FairRootManager.h"
+#include "R3BSofEventSummaryData.h"
+#include "R3BSofSciCalData.h"
+#include "R3BSofSciMappedData.h"
+#include "R3BSofSciSingleTcalData.h"
+#include "R3BSofSciTcalData.h"
+#include "R3BSofTofWHitData.h"
+#include "R3BSofTofWMappedData.h"
+#include "R3BSofTofWSingleTcalData.h"
+#include "R3BSofTofWTcalData.h"
+#include "R3BSofTrimCalData.h"
+#include "R3BSofTrimHitData.h"
+#include "R3BTwimHitData.h"
+#include "TClonesArray.h"
+
+typedef R3BSofEventSummaryData Summary;
+
+R3BSofEventSummary::R3BSofEventSummary()
+    : FairTask("SofEventSummary", 1)
+    , fSciMapped(NULL)
+    , fSciTcal(NULL)
+    , fSciSingleTcal(NULL)
+    , fSciCal(NULL)
+    , fTofWMapped(NULL)
+    , fTofWTcal(NULL)
+    , fTofWSingleTcal(NULL)
+    , fTofWHit(NULL)
+    , fTrimCal(NULL)
+    , fTrimHit(NULL)
+    , fTwimHit(NULL)
+    , fSummary(NULL)
+{
+}
+
+R3BSofEventSummary::R3BSofEventSummary(const char* name, Int_t iVerbose)
+    : FairTask(name, iVerbose)
+    , fSciMapped(NULL)
+    , fSciTcal(NULL)
+    , fSciSingleTcal(NULL)
+    , fSciCal(NULL)
+    , fTofWMapped(NULL)
+    , fTofWTcal(NULL)
+    , fTofWSingleTcal(NULL)
+    , fTofWHit(NULL)
+    , fTrimCal(NULL)
+    , fTrimHit(NULL)
+    , fTwimHit(NULL)
+    , fSummary(NULL)
+{
+}
+
+R3BSofEventSummary::~R3BSofEventSummary()
+{
+    LOG(info) << "R3BSofEventSummary::Delete instance";
+    if (fSummary)
+        delete fSummary;
+}
+
+InitStatus R3BSofEventSummary::Init()
+{
+    LOG(info) << "R3BSofEventSummary::Init()";
+
+    FairRootManager* mgr = FairRootManager::Instance();
+    if (NULL == mgr)
+        LOG(fatal) << "R3BSofEventSummary::Init FairRootManager not found";
+
+    // --- ------------------------------------- --- //
+    // --- input data, each detector is optional --- //
+    // --- ------------------------------------- --- //
+    fSciMapped = (TClonesArray*)mgr->GetObject("SofSciMappedData");
+    fSciTcal = (TClonesArray*)mgr->GetObject("SofSciTcalData");
+    fSciSingleTcal = (TClonesArray*)mgr->GetObject("SofSciSingleTcalData");
+    fSciCal = (TClonesArray*)mgr->GetObject("SofSciCalData");
+    fTofWMapped = (TClonesArray*)mgr->GetObject("SofTofWMappedData");
+    fTofWTcal = (TClonesArray*)mgr->GetObject("SofTofWTcalData");
+    fTofWSingleTcal = (TClonesArray*)mgr->GetObject("SofTofWSingleTcalData");
+    fTofWHit = (TClonesArray*)mgr->GetObject("TofWHitData");
+    fTrimCal = (TClonesArray*)mgr->GetObject("TrimCalData");
+    fTrimHit = (TClonesArray*)mgr->GetObject("TrimHitData");
+    fTwimHit = (TClonesArray*)mgr->GetObject("TwimHitData");
+    if (!fSciMapped)
+        LOG(warn) << "R3BSofEventSummary::Init SofSciMappedData not found";
+    if (!fTofWMapped)
+        LOG(warn) << "R3BSofEventSummary::Init SofTofWMappedData not found";
+    if (!fTrimHit)
+        LOG(warn) << "R3BSofEventSummary::Init TrimHitData not found";
+
+    // --- ------------------------------------- --- //
+    // --- output summary for the online spectra --- //
+    // --- ------------------------------------- --- //
+    fSummary = new R3BSofEventSummaryData();
+    mgr->Register("SofEventSummary", "Sofia", fSummary, kFALSE);
+
+    return kSUCCESS;
+}
+
+void R3BSofEventSummary::Exec(Option_t* option)
+{
+    fSummary->Clear();
+    ExecSci();
+    ExecTofW();
+    ExecTrim();
+}
+
+void R3BSofEventSummary::ExecSci()
+{
+    Int_t nHits, iDet, iCh;
+
+    if (fSciMapped)
+    {
+        nHits = fSciMapped->GetEntriesFast();
+        for (Int_t ihit = 0; ihit < nHits; ihit++)
+        {
+            R3BSofSciMappedData* hit = (R3BSofSciMappedData*)fSciMapped->At(ihit);
+            if (!hit)
+                continue;
+            iDet = hit->GetDetector();
+            iCh = hit->GetPmt() - 1;
+            if (iDet < 1 || iDet > Summary::kSciDets || iCh < 0 || iCh >= Summary::kSciChs)
+                continue;
+            Summary::Sci& sci = fSummary->GetSci(iDet);
+            if (sci.multMap[iCh]++ == 0)
+                sci.coarse[iCh] = (Float_t)hit->GetTimeCoarse();
+        }
+    }
+
+    if (fSciTcal)
+    {
+        nHits = fSciTcal->GetEntriesFast();
+        for (Int_t ihit = 0; ihit < nHits; ihit++)
+        {
+            R3BSofSciTcalData* hit = (R3BSofSciTcalData*)fSciTcal->At(ihit);
+            if (!hit)
+                continue;
+            iDet = hit->GetDetector();
+            iCh = hit->GetPmt() - 1;
+            if (iDet < 1 || iDet > Summary::kSciDets || iCh < 0 || iCh >= Summary::kSciChs)
+                continue;
+            Summary::Sci& sci = fSummary->GetSci(iDet);
+            if (sci.multTcal[iCh]++ == 0)
+            {
+                sci.rawTimeNs[iCh] = hit->GetRawTimeNs();
+                sci.clock[iCh] = (Float_t)hit->GetCoarseTime();
+            }
+        }
+    }
+
+    if (fSciSingleTcal)
+    {
+        nHits = fSciSingleTcal->GetEntriesFast();
+        for (Int_t ihit = 0; ihit < nHits; ihit++)
+        {
+            R3BSofSciSingleTcalData* hit = (R3BSofSciSingleTcalData*)fSciSingleTcal->At(ihit);
+            if (!hit)
+                continue;
+            iDet = hit->GetDetector();
+            if (iDet < 1 || iDet > Summary::kSciDets)
+                continue;
+            Summary::Sci& sci = fSummary->GetSci(iDet);
+            if (sci.multSTcal++ == 0)
+            {
+                sci.rawTime = hit->GetRawTimeNs();
+                sci.rawPos = hit->GetRawPosNs();
+                sci.rawTofS2 = hit->GetRawTofNs_FromS2();
+                sci.rawTofS8 = hit->GetRawTofNs_FromS8();
+            }
+        }
+    }
+
+    if (fSciCal)
+    {
+        nHits = fSciCal->GetEntriesFast();
+        for (Int_t ihit = 0; ihit < nHits; ihit++)
+        {
+            R3BSofSciCalData* hit = (R3BSofSciCalData*)fSciCal->At(ihit);
+            if (!hit)
+                continue;
+            iDet = hit->GetDetector();
+            if (iDet < 1 || iDet > Summary::kSciDets)
+                continue;
+            Summary::Sci& sci = fSummary->GetSci(iDet);
+            if (sci.multCal++ == 0)
+            {
+                sci.calPos = hit->GetPosMm();
+                sci.tofS2 = hit->GetTofNs_S2();
+                sci.betaS2 = hit->GetBeta_S2();
+                sci.tofS8 = hit->GetTofNs_S8();
+                sci.betaS8 = hit->GetBeta_S8();
+            }
+        }
+    }
+}
+
+void R3BSofEventSummary::ExecTofW()
+{
+    Int_t nHits, iDet, iCh;
+
+    if (fTofWMapped)
+    {
+        nHits = fTofWMapped->GetEntriesFast();
+        for (Int_t ihit = 0; ihit < nHits; ihit++)
+        {
+            R3BSofTofWMappedData* hit = (R3BSofTofWMappedData*)fTofWMapped->At(ihit);
+            if (!hit)
+                continue;
+            iDet = hit->GetDetector();
+            iCh = hit->GetPmt() - 1;
+            if (iDet < 1 || iDet > Summary::kTofWDets || iCh < 0 || iCh >= Summary::kTofWChs)
+                continue;
+            fSummary->GetTofW(iDet).multMap[iCh]++;
+        }
+    }
+
+    if (fTofWTcal)
+    {
+        nHits = fTofWTcal->GetEntriesFast();
+        for (Int_t ihit = 0; ihit < nHits; ihit++)
+        {
+            R3BSofTofWTcalData* hit = (R3BSofTofWTcalData*)fTofWTcal->At(ihit);
+            if (!hit)
+                continue;
+            iDet = hit->GetDetector();
+            iCh = hit->GetPmt() - 1;
+            // the third pmt is the reference time
+            if (iDet < 1 || iDet > Summary::kTofWDets || iCh < 0 || iCh >= Summary::kTofWChs)
+                continue;
+            Summary::TofW& tofw = fSummary->GetTofW(iDet);
+            if (tofw.multTcal[iCh]++ == 0)
+                tofw.rawTimeNs[iCh] = hit->GetRawTimeNs();
+        }
+    }
+
+    if (fTofWSingleTcal)
+    {
+        nHits = fTofWSingleTcal->GetEntriesFast();
+        for (Int_t ihit = 0; ihit < nHits; ihit++)
+        {
+            R3BSofTofWSingleTcalData* hit = (R3BSofTofWSingleTcalData*)fTofWSingleTcal->At(ihit);
+            if (!hit)
+                continue;
+            iDet = hit->GetDetector();
+            if (iDet < 1 || iDet > Summary::kTofWDets)
+                continue;
+            Summary::TofW& tofw = fSummary->GetTofW(iDet);
+            if (tofw.multSTcal++ == 0)
+            {
+                tofw.rawPos = hit->GetRawPosNs();
+                tofw.rawTof = hit->GetRawTofNs();
+            }
+        }
+    }
+
+    if (fTofWHit)
+    {
+        nHits = fTofWHit->GetEntriesFast();
+        for (Int_t ihit = 0; ihit < nHits; ihit++)
+        {
+            R3BSofTofWHitData* hit = (R3BSofTofWHitData*)fTofWHit->At(ihit);
+            if (hit)
+                fSummary->AddTofWHit(hit->GetPaddle(), hit->GetTof(), hit->GetY());
+        }
+    }
+}
+
+void R3BSofEventSummary::ExecTrim()
+{
+    Int_t nHits, iSec;
+
+    if (fTrimCal)
+    {
+        nHits = fTrimCal->GetEntriesFast();
+        for (Int_t ihit = 0; ihit < nHits; ihit++)
+        {
+            R3BSofTrimCalData* hit = (R3BSofTrimCalData*)fTrimCal->At(ihit);
+            if (!hit || hit->GetAnodeID() != 3)
+                continue;
+            iSec = hit->GetSecID();
+            if (iSec < 1 || iSec > Summary::kTrimSections)
+                continue;
+            Summary::Trim& trim = fSummary->GetTrim(iSec);
+            if (trim.multDT++ == 0)
+                trim.dt = hit->GetDriftTimeAligned();
+        }
+    }
+
+    if (fTrimHit)
+    {
+        nHits = fTrimHit->GetEntriesFast();
+        for (Int_t ihit = 0; ihit < nHits; ihit++)
+        {
+            R3BSofTrimHitData* hit = (R3BSofTrimHitData*)fTrimHit->At(ihit);
+            if (!hit)
+                continue;
+            iSec = hit->GetSecID();
+            if (iSec < 1 || iSec > Summary::kTrimSections)
+                continue;
+            Summary::Trim& trim = fSummary->GetTrim(iSec);
+            if (trim.multHit++ == 0)
+            {
+                trim.eraw = hit->GetEnergyRaw();
+                trim.etheta = hit->GetEnergyTheta();
+                trim.z = hit->GetZcharge();
+            }
+        }
+    }
+
+    if (fTwimHit)
+    {
+        nHits = fTwimHit->GetEntriesFast();
+        for (Int_t ihit = 0; ihit < nHits; ihit++)
+        {
+            R3BTwimHitData* hit = (R3BTwimHitData*)fTwimHit->At(ihit);
+            if (hit)
+                fSummary->AddTwimHit(hit->GetZcharge());
+        }
+    }
+}
+
+ClassImp(R3BSofEventSummary)
@@ -0,0 +1,81 @@
+// ------------------------------------------------------------
+// -----                 R3BSofEventSummary               -----
+// -----    Decodes once per event the SOFIA data used    -----
+// -----    by several online spectra                     -----
+// ------------------------------------------------------------
+
+#ifndef R3BSofEventSummary_H
+#define R3BSofEventSummary_H
+
+#include "FairTask.h"
+
+class TClonesArray;
+class R3BSofEventSummaryData;
+
+/**
+ * This task fills the R3BSofEventSummaryData "SofEventSummary" from the Sci, TofW, Trim and Twim data.
+ * It has to be added after the calibration tasks and before the online spectra reading it.
+ */
+class R3BSofEventSummary : public FairTask
+{
+
+  public:
+    /**
+     * Default constructor.
+     * Creates an instance of the task with default parameters.
+     */
+    R3BSofEventSummary();
+
+    /**
+     * Standard constructor.
+     * Creates an instance of the task.
+     * @param name a name of the task.
+     * @param iVerbose a verbosity level.
+     */
+    R3BSofEventSummary(const char* name, Int_t iVerbose = 1);
+
+    /**
+     * Destructor.
+     * Frees the memory used by the object.
+     */
+    virtual ~R3BSofEventSummary();
+
+    /**
+     * Method for task initialization.
+     * This function is called by the framework before
+     * the event loop.
+     * @return Initialization status. kSUCCESS, kERROR or kFATAL.
+     */
+    virtual InitStatus Init();
+
+    /**
+     * Method for event loop implementation.
+     * Is called by the framework every time a new event is read.
+     * @param option an execution option.
+     */
+    virtual void Exec(Option_t* option);
+
+  private:
+    void ExecSci();
+    void ExecTofW();
+    void ExecTrim();
+
+    TClonesArray* fSciMapped;      /**< Array with R3BSofSciMappedData */
+    TClonesArray* fSciTcal;        /**< Array with R3BSofSciTcalData */
+    TClonesArray* fSciSingleTcal;  /**< Array with R3BSofSciSingleTcalData */
+    TClonesArray* fSciCal;         /**< Array with R3BSofSciCalData */
+    TClonesArray* fTofWMapped;     /**< Array with R3BSofTofWMappedData */
+    TClonesArray* fTofWTcal;       /**< Array with R3BSofTofWTcalData */
+    TClonesArray* fTofWSingleTcal; /**< Array with R3BSofTofWSingleTcalData */
+    TClonesArray* fTofWHit;        /**< Array with R3BSofTofWHitData */
+    TClonesArray* fTrimCal;        /**< Array with R3BSofTrimCalData */
+    TClonesArray* fTrimHit;        /**< Array with R3BSofTrimHitData */
+    TClonesArray* fTwimHit;        /**< Array with R3BTwimHitData */
+
+    R3BSofEventSummaryData* fSummary;
+
+  public:
+    ClassDef(R3BSofEventSummary, 1)
+};
+
+#endif
@@ -0,0 +1,45 @@
+// --------------------------------------------------------------
+// -----               R3BSofEventSummaryData               -----
+// --------------------------------------------------------------
+
+#include "R3BSofEventSummaryData.h"
+
+#include <cstring>
+
+R3BSofEventSummaryData::R3BSofEventSummaryData()
+    : TNamed("SofEventSummary", "SOFIA event summary")
+{
+    Clear();
+}
+
+void R3BSofEventSummaryData::Clear(Option_t* option)
+{
+    // plain structures, the multiplicities at 0 invalidate the values
+    memset(fSci, 0, sizeof(fSci));
+    memset(fTofW, 0, sizeof(fTofW));
+    memset(fTrim, 0, sizeof(fTrim));
+    fTofWMultHit = 0;
+    fTofWPaddle = 0;
+    fTofWTof = 0.;
+    fTofWY = 0.;
+    fTwimMultHit = 0;
+    fTwimZ = 0.;
+}
+
+void R3BSofEventSummaryData::AddTofWHit(Int_t paddle, Double_t tof, Double_t y)
+{
+    if (fTofWMultHit++ > 0)
+        return;
+    fTofWPaddle = paddle;
+    fTofWTof = tof;
+    fTofWY = y;
+}
+
+void R3BSofEventSummaryData::AddTwimHit(Double_t z)
+{
+    if (fTwimMultHit++ > 0)
+        return;
+    fTwimZ = z;
+}
+
+ClassImp(R3BSofEventSummaryData)
@@ -0,0 +1,106 @@
+// --------------------------------------------------------------
+// -----               R3BSofEventSummaryData               -----
+// -----    Per-event summary of the SOFIA data, filled once  -----
+// -----    by R3BSofEventSummary and read by the online      -----
+// -----    spectra: multiplicities, first-hit times, raw     -----
+// -----    positions and time-of-flights, Z, per channel     -----
+// --------------------------------------------------------------
+
+#ifndef R3BSofEventSummaryData_H
+#define R3BSofEventSummaryData_H
+
+#include "TNamed.h"
+
+class R3BSofEventSummaryData : public TNamed
+{
+  public:
+    static const Int_t kSciDets = 4;
+    static const Int_t kSciChs = 3; // right, left, Tref
+    static const Int_t kTofWDets = 28;
+    static const Int_t kTofWChs = 2; // down, up
+    static const Int_t kTrimSections = 3;
+
+    // All the times and values below are the ones of the first hit, valid if the multiplicity is not 0
+    struct Sci
+    {
+        Int_t multMap[kSciChs];
+        Int_t multTcal[kSciChs];
+        Float_t coarse[kSciChs];     // mapped coarse time
+        Float_t clock[kSciChs];      // tcal coarse time
+        Double_t rawTimeNs[kSciChs]; // tcal time
+        Int_t multSTcal;
+        Double_t rawTime; // 0.5 * (TrawRIGHT + TrawLEFT)
+        Double_t rawPos;  // TrawRIGHT - TrawLEFT
+        Double_t rawTofS2;
+        Double_t rawTofS8;
+        Int_t multCal;
+        Double_t calPos;
+        Double_t tofS2;
+        Double_t betaS2;
+        Double_t tofS8;
+        Double_t betaS8;
+    };
+
+    struct TofW
+    {
+        Int_t multMap[kTofWChs];
+        Int_t multTcal[kTofWChs];
+        Double_t rawTimeNs[kTofWChs]; // tcal time
+        Int_t multSTcal;
+        Double_t rawPos;
+        Double_t rawTof;
+    };
+
+    struct Trim
+    {
+        Int_t multHit;
+        Double_t eraw;
+        Double_t etheta;
+        Double_t z;
+        Int_t multDT; // cal hits of the anode 3
+        Double_t dt;  // aligned drift time of the anode 3
+    };
+
+    /** Default constructor **/
+    R3BSofEventSummaryData();
+
+    /** Destructor **/
+    virtual ~R3BSofEventSummaryData() {}
+
+    /** Virtual method Clear, at the start of each event **/
+    virtual void Clear(Option_t* option = "");
+
+    // Detector and section numbers are 1-based, as in the data
+    inline const Sci& GetSci(Int_t det) const { return fSci[det - 1]; }
+    inline const TofW& GetTofW(Int_t det) const { return fTofW[det - 1]; }
+    inline const Trim& GetTrim(Int_t sec) const { return fTrim[sec - 1]; }
+    inline Sci& GetSci(Int_t det) { return fSci[det - 1]; }
+    inline TofW& GetTofW(Int_t det) { return fTofW[det - 1]; }
+    inline Trim& GetTrim(Int_t sec) { return fTrim[sec - 1]; }
+
+    // Hit level of the TofW and Twim, first hit
+    void AddTofWHit(Int_t paddle, Double_t tof, Double_t y);
+    void AddTwimHit(Double_t z);
+    inline Int_t GetTofWMultHit() const { return fTofWMultHit; }
+    inline Int_t GetTofWPaddle() const { return fTofWPaddle; }
+    inline Double_t GetTofWTof() const { return fTofWTof; }
+    inline Double_t GetTofWY() const { return fTofWY; }
+    inline Int_t GetTwimMultHit() const { return fTwimMultHit; }
+    inline Double_t GetTwimZ() const { return fTwimZ; }
+
+  private:
+    Sci fSci[kSciDets];        //!
+    TofW fTofW[kTofWDets];     //!
+    Trim fTrim[kTrimSections]; //!
+    Int_t fTofWMultHit;
+    Int_t fTofWPaddle;
+    Double_t fTofWTof;
+    Double_t fTofWY;
+    Int_t fTwimMultHit;
+    Double_t fTwimZ;
+
+  public:
+    ClassDef(R3BSofEventSummaryData, 1)
+};
+
+#endif
@@ -208,13 +208,7 @@ void R3BSofFrsOnlineSpectra::Exec(Option_t* option)
     fNEvents += 1;
 }
 
-void R3BSofFrsOnlineSpectra::FinishEvent()
-{
-    if (fHitItemsFrs)
-    {
-        fHitItemsFrs->Clear();
-    }
-}
+void R3BSofFrsOnlineSpectra::FinishEvent() {}
 
 void R3BSofFrsOnlineSpectra::FinishTask()
 {
@@ -0,0 +1,198 @@
+// --------------------------------------------------------------
+// -----                 R3BSofHistoFiller                  -----
+// --------------------------------------------------------------
+
+#include "R3BSofHistoFiller.h"
+#include "R3BSofSnapshotPublisher.h"
+
+#include "TArrayD.h"
+
+// Synchronous timer: it fires from gSystem->ProcessEvents(), as the http server, never during a fill
+class R3BSofHistoFillerTimer : public TTimer
+{
+  public:
+    R3BSofHistoFillerTimer(R3BSofHistoFiller* filler, Long_t ms)
+        : TTimer(ms, kTRUE)
+        , fFiller(filler)
+    {
+    }
+
+    virtual Bool_t Notify()
+    {
+        fFiller->FlushIfLate();
+        Reset();
+        return kTRUE;
+    }
+
+  private:
+    R3BSofHistoFiller* fFiller;
+};
+
+R3BSofHistoFiller::R3BSofHistoFiller(Int_t flushEvents, Double_t flushSeconds)
+    : fFlushEvents(flushEvents)
+    , fFlushSeconds(flushSeconds)
+    , fNumEvents(0)
+    , fLastFlush(std::chrono::steady_clock::now())
+    , fTimer(new R3BSofHistoFillerTimer(this, (Long_t)(1000. * flushSeconds)))
+    , fPublisher(NULL)
+    , fGroup(-1)
+{
+    fTimer->TurnOn();
+}
+
+void R3BSofHistoFiller::SetFlushSeconds(Double_t s)
+{
+    fFlushSeconds = s;
+    fTimer->SetTime((Long_t)(1000. * s));
+}
+
+UInt_t R3BSofHistoFiller::Register(TH1* h)
+{
+    const TAxis* x = h->GetXaxis();
+    const TAxis* y = h->GetYaxis();
+    if (h->GetDimension() > 2 || h->CanExtendAllAxes() || x->IsVariableBinSize() || y->IsVariableBinSize())
+    {
+        fIndex[h] = kDirect;
+        return kDirect;
+    }
+
+    Slot s;
+    s.h = h;
+    s.nx = x->GetNbins();
+    s.xmin = x->GetXmin();
+    s.xmax = x->GetXmax();
+    s.ny = h->GetDimension() == 2 ? y->GetNbins() : 0;
+    s.ymin = y->GetXmin();
+    s.ymax = y->GetXmax();
+    s.sumw2 = h->GetSumw2N() > 0;
+    s.entries = 0.;
+    s.sumw.assign((s.nx + 2) * (s.ny ? s.ny + 2 : 1), 0.);
+    if (s.sumw2)
+        s.sumw22.assign(s.sumw.size(), 0.);
+    s.maxBinsX = s.maxBinsY = 0;
+    fSlots.push_back(std::move(s));
+
+    fIndex[h] = fSlots.size();
+    return fSlots.size();
+}
+
+void R3BSofHistoFiller::AddSparse(TH1* h, Int_t maxBinsX, Int_t maxBinsY)
+{
+    if (fIndex.count(h) || h->GetDimension() > 2 || h->CanExtendAllAxes() ||
+        h->GetXaxis()->IsVariableBinSize() || h->GetYaxis()->IsVariableBinSize())
+        return;
+
+    Slot s;
+    const TAxis* x = h->GetXaxis();
+    const TAxis* y = h->GetYaxis();
+    s.h = h;
+    s.nx = x->GetNbins();
+    s.ny = h->GetDimension() == 2 ? y->GetNbins() : 0;
+    s.xmin = x->GetXmin();
+    s.xmax = x->GetXmax();
+    s.ymin = y->GetXmin();
+    s.ymax = y->GetXmax();
+    s.sumw2 = kFALSE;
+    s.entries = 0.;
+    if (h->GetDimension() == 2)
+        s.sparse.reset(new R3BSofSparseHisto(s.nx, s.xmin, s.xmax, s.ny, s.ymin, s.ymax));
+    else
+        s.sparse.reset(new R3BSofSparseHisto(s.nx, s.xmin, s.xmax));
+    s.maxBinsX = maxBinsX;
+    s.maxBinsY = maxBinsY;
+    // frees the dense bins of h
+    s.sparse->Export(h, maxBinsX, maxBinsY);
+    fSlots.push_back(std::move(s));
+
+    fIndex[h] = fSlots.size();
+}
+
+void R3BSofHistoFiller::Tick()
+{
+    if (++fNumEvents >= fFlushEvents)
+        Flush();
+    else
+        FlushIfLate();
+}
+
+void R3BSofHistoFiller::FlushIfLate()
+{
+    if (std::chrono::duration<Double_t>(std::chrono::steady_clock::now() - fLastFlush).count() >= fFlushSeconds)
+        Flush();
+}
+
+void R3BSofHistoFiller::Flush(Bool_t fullBinning)
+{
+    for (auto& s : fSlots)
+    {
+        if (s.sparse)
+        {
+            if (fullBinning || s.sparse->IsModified())
+                s.sparse->Export(s.h, s.maxBinsX, s.maxBinsY, fullBinning);
+            continue;
+        }
+        if (s.touched.empty())
+            continue;
+        Double_t entries = s.h->GetEntries() + s.entries;
+        TArrayD* sumw2 = s.sumw2 ? s.h->GetSumw2() : nullptr;
+        for (Int_t bin : s.touched)
+        {
+            s.h->AddBinContent(bin, s.sumw[bin]);
+            s.sumw[bin] = 0.;
+            if (sumw2)
+            {
+                sumw2->fArray[bin] += s.sumw22[bin];
+                s.sumw22[bin] = 0.;
+            }
+        }
+        s.touched.clear();
+        s.entries = 0.;
+        // means and RMS from the bin contents
+        s.h->ResetStats();
+        s.h->SetEntries(entries);
+    }
+    // the histograms at full binning are written at the end of the run, too large to be copied
+    if (fPublisher && !fullBinning)
+        fPublisher->Publish(fGroup);
+    fNumEvents = 0;
+    fLastFlush = std::chrono::steady_clock::now();
+}
+
+void R3BSofHistoFiller::Clear()
+{
+    for (auto& s : fSlots)
+        Clear(s);
+}
+
+void R3BSofHistoFiller::Clear(Slot& s)
+{
+    for (Int_t bin : s.touched)
+    {
+        s.sumw[bin] = 0.;
+        if (s.sumw2)
+            s.sumw22[bin] = 0.;
+    }
+    s.touched.clear();
+    s.entries = 0.;
+}
+
+void R3BSofHistoFiller::Reset(TH1* h)
+{
+    auto it = fIndex.find(h);
+    if (it == fIndex.end() || it->second == kDirect)
+    {
+        h->Reset();
+        return;
+    }
+    Slot& s = fSlots[it->second - 1];
+    if (s.sparse)
+    {
+        s.sparse->Reset();
+        s.sparse->Export(h, s.maxBinsX, s.maxBinsY);
+    }
+    else
+    {
+        Clear(s);
+        h->Reset();
+    }
+}
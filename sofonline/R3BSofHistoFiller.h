@@ -0,0 +1,150 @@
+// --------------------------------------------------------------
+// -----                 R3BSofHistoFiller                  -----
+// -----    Fill layer of the online spectra: the fills are   -----
+// -----    counted in plain arrays of bins, added to the     -----
+// -----    ROOT histograms served by THttpServer every N     -----
+// -----    events or every T seconds, also without events    -----
+// -----    through a TTimer. The very large ones can be      -----
+// -----    kept sparse, see R3BSofSparseHisto                -----
+// --------------------------------------------------------------
+
+#ifndef R3BSofHistoFiller_H
+#define R3BSofHistoFiller_H
+
+#include "R3BSofSparseHisto.h"
+#include "TH1.h"
+#include "TTimer.h"
+
+#include <chrono>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+class R3BSofSnapshotPublisher;
+
+class R3BSofHistoFiller
+{
+  public:
+    /** Default constructor **/
+    R3BSofHistoFiller(Int_t flushEvents = 1000, Double_t flushSeconds = 1.);
+
+    /** Destructor **/
+    virtual ~R3BSofHistoFiller() {}
+
+    void SetFlushEvents(Int_t n) { fFlushEvents = n; }
+    void SetFlushSeconds(Double_t s);
+    /** The copies of group in publisher are updated at each flush, except at full binning **/
+    void SetPublisher(R3BSofSnapshotPublisher* publisher, Int_t group)
+    {
+        fPublisher = publisher;
+        fGroup = group;
+    }
+
+    /** Same as h->Fill(x) and h->Fill(x, y): the histograms are buffered at their first fill, each filler
+     *  keeps its own index of them. Histograms with variable bins or extendable axes are filled directly **/
+    inline void Fill(TH1* h, Double_t x)
+    {
+        Slot* s = Find(h);
+        if (!s)
+            h->Fill(x);
+        else
+            s->Fill(x, 0., 1.);
+    }
+    // For a TH1, y is the weight, as in TH1::Fill(x, w)
+    inline void Fill(TH1* h, Double_t x, Double_t y)
+    {
+        Slot* s = Find(h);
+        if (!s)
+            h->Fill(x, y);
+        else if (s->ny)
+            s->Fill(x, y, 1.);
+        else
+            s->Fill(x, 0., y);
+    }
+
+    /** Very large histogram kept in a R3BSofSparseHisto: h only holds the occupied region, with at most
+     *  maxBinsX (maxBinsY) bins, after each flush. To be called after the creation of h **/
+    void AddSparse(TH1* h, Int_t maxBinsX = 1000, Int_t maxBinsY = 250);
+
+    /** Once per event, after the fills: flushes when the number of events or the time since the last flush
+     *  is reached. The timer flushes the remaining fills when no event comes, e.g. between two spills **/
+    void Tick();
+    /** Adds the buffered fills to the histograms, before reading or writing them. With fullBinning, the
+     *  sparse histograms get their original binning, for writing them at the end of the run **/
+    void Flush(Bool_t fullBinning = kFALSE);
+    /** Flush() if the last one is older than the flush time **/
+    void FlushIfLate();
+    /** Drops the buffered fills, with the reset of the histograms **/
+    void Clear();
+    /** Reset of a histogram and of its buffered fills, needed for the sparse histograms **/
+    void Reset(TH1* h);
+
+  private:
+    static const UInt_t kDirect = 0xFFFFFFFF;
+
+    struct Slot
+    {
+        TH1* h;
+        Int_t nx, ny; // ny = 0 for a TH1
+        Double_t xmin, xmax;
+        Double_t ymin, ymax;
+        Bool_t sumw2;
+        Double_t entries;
+        std::vector<Double_t> sumw;   // bins with under- and overflows, numbered as TH1::GetBin
+        std::vector<Double_t> sumw22; // only when the histogram stores the sum of the squared weights
+        std::vector<Int_t> touched;   // bins filled since the last flush
+        std::unique_ptr<R3BSofSparseHisto> sparse;
+        Int_t maxBinsX, maxBinsY;
+
+        // same as TAxis::FindBin for fixed bins, NaN in the overflow
+        inline Int_t Bin(Double_t v, Int_t n, Double_t vmin, Double_t vmax) const
+        {
+            if (v < vmin)
+                return 0;
+            if (!(v < vmax))
+                return n + 1;
+            return 1 + (Int_t)(n * (v - vmin) / (vmax - vmin));
+        }
+        inline void Fill(Double_t x, Double_t y, Double_t w)
+        {
+            if (sparse)
+            {
+                sparse->Fill(x, y, w);
+                return;
+            }
+            Int_t bin = Bin(x, nx, xmin, xmax);
+            if (ny)
+                bin += (nx + 2) * Bin(y, ny, ymin, ymax);
+            if (sumw[bin] == 0.)
+                touched.push_back(bin);
+            sumw[bin] += w;
+            if (sumw2)
+                sumw22[bin] += w * w;
+            entries++;
+        }
+    };
+
+    UInt_t Register(TH1* h);
+    void Clear(Slot& s);
+
+    // slot of h, registered at its first fill, NULL for a histogram filled directly
+    inline Slot* Find(TH1* h)
+    {
+        auto it = fIndex.find(h);
+        UInt_t id = it != fIndex.end() ? it->second : Register(h);
+        return id == kDirect ? NULL : &fSlots[id - 1];
+    }
+
+    Int_t fFlushEvents;
+    Double_t fFlushSeconds;
+    Int_t fNumEvents;
+    std::chrono::steady_clock::time_point fLastFlush;
+    std::vector<Slot> fSlots;
+    // slot + 1, or kDirect, of each histogram: the unique ID of the histograms is left to their owners
+    std::unordered_map<const TH1*, UInt_t> fIndex;
+    std::unique_ptr<TTimer> fTimer;
+    R3BSofSnapshotPublisher* fPublisher;
+    Int_t fGroup;
+};
+
+#endif
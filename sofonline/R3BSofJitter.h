@@ -0,0 +1,47 @@
+// --------------------------------------------------------------
+// -----                    R3BSofJitter                    -----
+// -----    Counter-based uniform numbers used to smear the   -----
+// -----    integer coordinates of the online 2D spectra      -----
+// --------------------------------------------------------------
+
+#ifndef R3BSofJitter_H
+#define R3BSofJitter_H
+
+#include "R3BSofTcalRandom.h"
+
+/**
+ * Same hash of (seed, event, rank of the call) as the VFTX time spreading, see R3BSofTcalRandom:
+ * one instance per task, the display fills do not touch gRandom used by the physics code.
+ * Not meant for the analysis, only for the display.
+ */
+class R3BSofJitter
+{
+  public:
+    /** Default constructor **/
+    R3BSofJitter(ULong64_t seed = 0)
+        : fRandom(seed)
+        , fKey(fRandom.GetEventKey(0))
+        , fCall(0)
+    {
+    }
+
+    /** To be called once per event, before the fills **/
+    inline void SetEvent(ULong64_t event)
+    {
+        fKey = fRandom.GetEventKey(event);
+        fCall = 0;
+    }
+
+    /** Uniform in [min, max[ **/
+    inline Double_t Uniform(Double_t min, Double_t max)
+    {
+        return min + 0.5 * (max - min) * (R3BSofTcalRandom::SymmetricFromKey(fKey, fCall++) + 1.);
+    }
+
+  private:
+    R3BSofTcalRandom fRandom;
+    UInt_t fKey;
+    UInt_t fCall;
+};
+
+#endif
@@ -260,25 +260,7 @@ void R3BSofMwpcvsMusicOnlineSpectra::Exec(Option_t* option)
     fNEvents += 1;
 }
 
-void R3BSofMwpcvsMusicOnlineSpectra::FinishEvent()
-{
-    if (fCalItemsMwpc)
-    {
-        fCalItemsMwpc->Clear();
-    }
-    if (fHitItemsMwpc)
-    {
-        fHitItemsMwpc->Clear();
-    }
-    if (fMappedItemsMus)
-    {
-        fMappedItemsMus->Clear();
-    }
-    if (fHitItemsMus)
-    {
-        fHitItemsMus->Clear();
-    }
-}
+void R3BSofMwpcvsMusicOnlineSpectra::FinishEvent() {}
 
 void R3BSofMwpcvsMusicOnlineSpectra::FinishTask()
 {
@@ -710,34 +710,7 @@ void R3BSofOnlineSpectra::Exec(Option_t* option)
     return;
 }
 
-void R3BSofOnlineSpectra::FinishEvent()
-{
-
-    if (fWRItemsMaster)
-    {
-        fWRItemsMaster->Clear();
-    }
-    if (fWRItemsSofia)
-    {
-        fWRItemsSofia->Clear();
-    }
-    if (fWRItemsCalifa)
-    {
-        fWRItemsCalifa->Clear();
-    }
-    if (fWRItemsNeuland)
-    {
-        fWRItemsNeuland->Clear();
-    }
-    if (fWRItemsS2)
-    {
-        fWRItemsS2->Clear();
-    }
-    if (fWRItemsS8)
-    {
-        fWRItemsS8->Clear();
-    }
-}
+void R3BSofOnlineSpectra::FinishEvent() {}
 
 void R3BSofOnlineSpectra::FinishTask()
 {
@@ -16,10 +16,13 @@
 #include "FairRuntimeDb.h"
 #include "R3BEventHeader.h"
 #include "R3BSofScalersMappedData.h"
+#include "R3BSofScalersSpillData.h"
+#include "R3BSofTrloiiSpillRates.h"
 #include "R3BTrloiiData.h"
 #include "TCanvas.h"
 #include "TClonesArray.h"
 #include "TFolder.h"
+#include "TGraph.h"
 #include "TH1.h"
 #include "TH1D.h"
 #include "TH2F.h"
@@ -37,13 +40,23 @@
 #include <iostream>
 #include <sstream>
 
+// Bin of h_RatePerSpill, type and channel of the Trloii scalers
+static const Int_t NbRatesTrloii = 8;
+static const UShort_t RatesTrloii[NbRatesTrloii][3] = { { 1, 5, 10 }, { 2, 5, 11 }, { 3, 9, 1 }, { 4, 9, 2 },
+                                                       { 7, 2, 1 },  { 8, 2, 2 },  { 9, 2, 3 }, { 10, 3, 1 } };
+
 R3BSofScalersOnlineSpectra::R3BSofScalersOnlineSpectra()
     : FairTask("SofScalersOnlineSpectra", 1)
     , fMappedItemsScalers(NULL)
     , fMappedItemsTrloii(NULL)
+    , fSpillData(NULL)
+    , fOwnSpillData(kFALSE)
+    , fCleared(kFALSE)
     , fNEvents(0)
-    , fNSpill(0)
     , read_trloii(false)
+    , fNumSpillsStored(100)
+    , fSpillEndReadout(kTRUE)
+    , fSpillRates(NULL)
 {
 }
 
@@ -51,9 +64,14 @@ R3BSofScalersOnlineSpectra::R3BSofScalersOnlineSpectra(const char* name, Int_t i
     : FairTask(name, iVerbose)
     , fMappedItemsScalers(NULL)
     , fMappedItemsTrloii(NULL)
+    , fSpillData(NULL)
+    , fOwnSpillData(kFALSE)
+    , fCleared(kFALSE)
     , fNEvents(0)
-    , fNSpill(0)
     , read_trloii(false)
+    , fNumSpillsStored(100)
+    , fSpillEndReadout(kTRUE)
+    , fSpillRates(NULL)
 {
 }
 
@@ -64,6 +82,10 @@ R3BSofScalersOnlineSpectra::~R3BSofScalersOnlineSpectra()
         delete fMappedItemsScalers;
     if (read_trloii && fMappedItemsTrloii)
         delete fMappedItemsTrloii;
+    if (fOwnSpillData && fSpillData)
+        delete fSpillData;
+    if (fSpillRates)
+        delete fSpillRates;
 }
 
 InitStatus R3BSofScalersOnlineSpectra::Init()
@@ -86,6 +108,15 @@ InitStatus R3BSofScalersOnlineSpectra::Init()
     {
         return kFATAL;
     }
+    // Counts per spill from R3BSofScalersReader, or built here when reading mapped data from a file
+    fSpillData = (R3BSofScalersSpillData*)mgr->GetObject("SofScalersSpillData");
+    if (!fSpillData)
+    {
+        static int l_NbChannelsPerScaler[NbScalers] = NbChannelsPerScaler;
+        fSpillData = new R3BSofScalersSpillData({ l_NbChannelsPerScaler[0], l_NbChannelsPerScaler[1] });
+        fOwnSpillData = kTRUE;
+        fSpillData->SetCleared(fCleared);
+    }
     if (read_trloii)
     {
         fMappedItemsTrloii = (TClonesArray*)mgr->GetObject("TrloiiData");
@@ -93,6 +124,9 @@ InitStatus R3BSofScalersOnlineSpectra::Init()
         {
             return kFATAL;
         }
+        // the spill is on while the accepted triggers are counted (MAIN ADT channel 1)
+        fSpillRates = new R3BSofTrloiiSpillRates(fNumSpillsStored);
+        fSpillRates->SetSpillEndReadout(fSpillEndReadout);
     }
 
     // --- ------------------------------- --- //
@@ -179,6 +213,27 @@ InitStatus R3BSofScalersOnlineSpectra::Init()
     h_RatePerSpill->Draw("HIST TEXT0");
     // h_RatePerSpill->Draw("same text");
 
+    // Time series of the last spills, only updated at the end of each spill
+    cSpillRates = new TCanvas("cSpillRates", "cSpillRates", 10, 10, 1200, 1200);
+    cSpillRates->Divide(3, 3);
+    for (Int_t i = 0; i < NbRatesTrloii; i++)
+    {
+        fg_RatePerSpill[i] = new TGraph();
+        sprintf(Name1, "g_RatePerSpill_%s", h_RatePerSpill->GetXaxis()->GetBinLabel(RatesTrloii[i][0]));
+        fg_RatePerSpill[i]->SetName(TString(Name1).ReplaceAll(" ", ""));
+        fg_RatePerSpill[i]->SetTitle(Form("%s;Spill number;Counts per spill",
+                                          h_RatePerSpill->GetXaxis()->GetBinLabel(RatesTrloii[i][0])));
+        fg_RatePerSpill[i]->SetMarkerStyle(20);
+        cSpillRates->cd(i + 1);
+        fg_RatePerSpill[i]->Draw("APL");
+    }
+    fg_LiveTime = new TGraph();
+    fg_LiveTime->SetName("g_LiveTime");
+    fg_LiveTime->SetTitle("Live time of the MAIN trigger (ADT / BDT);Spill number;Live time");
+    fg_LiveTime->SetMarkerStyle(20);
+    cSpillRates->cd(9);
+    fg_LiveTime->Draw("APL");
+
     // --- ------------------- --- //
     // --- MAIN FOLDER-Scalers --- //
     // --- ------------------- --- //
@@ -187,6 +242,9 @@ InitStatus R3BSofScalersOnlineSpectra::Init()
     {
         mainfolScalers->Add(cScalersGeneralView[i]);
     }
+    mainfolScalers->Add(cRate);
+    if (read_trloii)
+        mainfolScalers->Add(cSpillRates);
     run->AddObject(mainfolScalers);
 
     // Register command to reset histograms
@@ -203,6 +261,43 @@ void R3BSofScalersOnlineSpectra::Reset_Histo()
         // === accumulated statistics per channel === //
         fh1_GeneralView[i]->Reset();
     }
+    h_RatePerSpill->Reset();
+    // counts of a spill data object from another task are reset by that task
+    if (fOwnSpillData)
+        fSpillData->ResetCounts();
+    if (fSpillRates)
+    {
+        fSpillRates->Reset();
+        UpdateSpillGraphs();
+    }
+}
+
+void R3BSofScalersOnlineSpectra::UpdateRates()
+{
+    // CaveC Left and Right, channels 1 and 2 of the upstream scaler
+    h_RatePerSpill->SetBinContent(5, fSpillData->GetRatePerSpill(1, 1));
+    h_RatePerSpill->SetBinContent(6, fSpillData->GetRatePerSpill(1, 2));
+    if (!fSpillRates)
+        return;
+    for (Int_t i = 0; i < NbRatesTrloii; i++)
+        h_RatePerSpill->SetBinContent(RatesTrloii[i][0],
+                                      fSpillRates->GetRatePerSpill(RatesTrloii[i][1], RatesTrloii[i][2]));
+}
+
+void R3BSofScalersOnlineSpectra::UpdateSpillGraphs()
+{
+    const Int_t nSpills = fSpillRates->GetNumStored();
+    for (Int_t i = 0; i < NbRatesTrloii; i++)
+    {
+        fg_RatePerSpill[i]->Set(nSpills);
+        for (Int_t spill = 0; spill < nSpills; spill++)
+            fg_RatePerSpill[i]->SetPoint(spill,
+                                         fSpillRates->GetSpillNumber(spill),
+                                         fSpillRates->GetCounts(spill, RatesTrloii[i][1], RatesTrloii[i][2]));
+    }
+    fg_LiveTime->Set(nSpills);
+    for (Int_t spill = 0; spill < nSpills; spill++)
+        fg_LiveTime->SetPoint(spill, fSpillRates->GetSpillNumber(spill), fSpillRates->GetLiveTime(spill, 0, 1));
 }
 
 void R3BSofScalersOnlineSpectra::Exec(Option_t* option)
@@ -211,33 +306,17 @@ void R3BSofScalersOnlineSpectra::Exec(Option_t* option)
     if (NULL == mgr)
         LOG(fatal) << "R3BSofScalersOnlineSpectra::Exec FairRootManager not found";
 
-    if (fMappedItemsScalers && fMappedItemsScalers->GetEntriesFast())
+    if (fOwnSpillData)
+        fSpillData->Update(fMappedItemsScalers);
+
+    if (fSpillData->IsReadout())
     {
-        // --- --------------------- --- //
-        // --- loop over mapped data --- //
-        // --- --------------------- --- //
-        for (Int_t ihit = 0; ihit < fMappedItemsScalers->GetEntriesFast(); ihit++)
-        {
-            R3BSofScalersMappedData* hitmapped = (R3BSofScalersMappedData*)fMappedItemsScalers->At(ihit);
-            if (!hitmapped)
-                continue;
-            fh1_GeneralView[hitmapped->GetScaler() - 1]->Fill(hitmapped->GetChannel(), hitmapped->GetValue());
-            //
-            if (hitmapped->GetScaler() != 1)
-                continue;
-            if (hitmapped->GetValue() == 0)
-                continue;
-            ULong64_t offset = 0; // fScaler[hitmapped->GetChannel() - 1];
-            fScaler[hitmapped->GetChannel() - 1] = hitmapped->GetValue();
-            // if (offset == 0); (hitmapped->GetValue() < offset || offset == 0) continue;
-            if (hitmapped->GetChannel() == 0 + 1)
-                fcounts[4] += hitmapped->GetValue() - offset;
-            else if (hitmapped->GetChannel() == 1 + 1)
-                fcounts[5] += hitmapped->GetValue() - offset;
-            else
-                continue;
-            LOG(debug) << hitmapped->GetChannel() << " " << hitmapped->GetValue() << " " << offset << " " << fcounts[4];
-        }
+        // --- ------------------------------------------ --- //
+        // --- counts of the last spill, for each channel --- //
+        // --- ------------------------------------------ --- //
+        for (Int_t scaler = 1; scaler <= fSpillData->GetNumScalers(); scaler++)
+            for (Int_t ch = 1; ch <= fSpillData->GetNumChannels(scaler); ch++)
+                fh1_GeneralView[scaler - 1]->Fill(ch, fSpillData->GetLastSpillCounts(scaler, ch));
     }
     if (read_trloii && fMappedItemsTrloii && fMappedItemsTrloii->GetEntriesFast())
     {
@@ -249,74 +328,40 @@ void R3BSofScalersOnlineSpectra::Exec(Option_t* option)
             R3BTrloiiData* hitmapped = (R3BTrloiiData*)fMappedItemsTrloii->At(ihit);
             if (!hitmapped)
                 continue;
-            if (hitmapped->GetCounts() == 0)
-                continue;
-            // if (fTrloii[hitmapped->GetType() - 1][hitmapped->GetCh() - 1] == 0)
-            // fTrloii[hitmapped->GetType() - 1][hitmapped->GetCh() - 1] = hitmapped->GetCounts();
-            ULong64_t offset = fTrloii[hitmapped->GetType() - 1][hitmapped->GetCh() - 1];
-            fh1_GeneralView[hitmapped->GetType() - 1 + 2]->Fill(hitmapped->GetCh(), hitmapped->GetCounts() - offset);
-            fTrloii[hitmapped->GetType() - 1][hitmapped->GetCh() - 1] = hitmapped->GetCounts();
-            //
-            if (hitmapped->GetCounts() - offset < 10 || offset == 0)
+            ULong64_t counts = fSpillRates->Fill(hitmapped->GetType(), hitmapped->GetCh(), hitmapped->GetCounts());
+            if (counts == 0)
                 continue;
-            else if (hitmapped->GetType() == 4 + 1 && hitmapped->GetCh() == 9 + 1)
-                fcounts[0] += hitmapped->GetCounts() - offset;
-            else if (hitmapped->GetType() == 4 + 1 && hitmapped->GetCh() == 10 + 1)
-                fcounts[1] += hitmapped->GetCounts() - offset;
-            else if (hitmapped->GetType() == 8 + 1 && hitmapped->GetCh() == 0 + 1)
-                fcounts[2] += hitmapped->GetCounts() - offset;
-            else if (hitmapped->GetType() == 8 + 1 && hitmapped->GetCh() == 1 + 1)
-                fcounts[3] += hitmapped->GetCounts() - offset;
-            // else if (hitmapped->GetType() == 0 + 1 && hitmapped->GetCh() == 0 + 1) fcounts[4] +=
-            // hitmapped->GetCounts() - offset;
-            // else if (hitmapped->GetType() == 0 + 1 && hitmapped->GetCh() == 1 + 1) fcounts[5] +=
-            // hitmapped->GetCounts() - offset;
-            else if (hitmapped->GetType() == 1 + 1 && hitmapped->GetCh() == 0 + 1)
-                fcounts[6] += hitmapped->GetCounts() - offset;
-            else if (hitmapped->GetType() == 1 + 1 && hitmapped->GetCh() == 1 + 1)
-                fcounts[7] += hitmapped->GetCounts() - offset;
-            else if (hitmapped->GetType() == 1 + 1 && hitmapped->GetCh() == 2 + 1)
-                fcounts[8] += hitmapped->GetCounts() - offset;
-            else if (hitmapped->GetType() == 2 + 1 && hitmapped->GetCh() == 0 + 1)
-            {
-                fcounts[9] += hitmapped->GetCounts() - offset;
-                fNSpill++;
-            }
-            else
-                continue;
-            // LOG(info) << fNSpill << " " << hitmapped->GetType() << " " << hitmapped->GetCh() << " " <<
-            // hitmapped->GetCounts() - offset << " " << fcounts[7];
+            fh1_GeneralView[hitmapped->GetType() - 1 + 2]->Fill(hitmapped->GetCh(), counts);
             LOG(debug) << hitmapped->GetType() << " " << hitmapped->GetCh() << " " << hitmapped->GetCounts() << " "
-                       << offset;
+                       << counts;
+        }
+        if (fSpillRates->EndEvent())
+        {
+            UpdateRates();
+            UpdateSpillGraphs();
         }
     }
     fNEvents += 1;
 }
 
-void R3BSofScalersOnlineSpectra::FinishEvent()
-{
-    if (fMappedItemsScalers)
-    {
-        fMappedItemsScalers->Clear();
-    }
-    if (read_trloii && fMappedItemsTrloii)
-    {
-        fMappedItemsTrloii->Clear();
-    }
-}
+void R3BSofScalersOnlineSpectra::FinishEvent() {}
 
 void R3BSofScalersOnlineSpectra::FinishTask()
 {
-    for (UShort_t i = 0; i < 10; i++)
-    {
-        frate[i] = (double)fcounts[i] / (double)fNSpill;
-        // h_RatePerSpill->SetPoint(i,(double)i,frate[i]);
-        h_RatePerSpill->Fill((double)i + 1, frate[i]);
-        std::cout << frate[i] << " ";
-    }
+    UpdateRates();
+    for (Int_t bin = 1; bin <= h_RatePerSpill->GetNbinsX(); bin++)
+        std::cout << h_RatePerSpill->GetBinContent(bin) << " ";
     h_RatePerSpill->Write();
     cRate->Write();
     std::cout << std::endl;
+    if (fSpillRates)
+    {
+        LOG(info) << "R3BSofScalersOnlineSpectra::FinishTask " << fSpillRates->GetNumSpills() << " spills";
+        for (Int_t i = 0; i < NbRatesTrloii; i++)
+            fg_RatePerSpill[i]->Write();
+        fg_LiveTime->Write();
+        cSpillRates->Write();
+    }
     if (fMappedItemsScalers && (!read_trloii || fMappedItemsTrloii))
     {
         for (UShort_t i = 0; i < NbScalers; i++)
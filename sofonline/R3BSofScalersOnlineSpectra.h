@@ -27,6 +27,9 @@
 
 class TClonesArray;
 class R3BEventHeader;
+class R3BSofScalersSpillData;
+class R3BSofTrloiiSpillRates;
+class TGraph;
 
 /**
  * This taks reads SCI data and plots online histograms
@@ -91,23 +94,40 @@ class R3BSofScalersOnlineSpectra : public FairTask
     void SetReadTrloii(Bool_t trloii) { read_trloii = trloii; }
     Bool_t GetReadTrloii() { return read_trloii; }
 
+    // Number of spills shown in the time series of the Trloii rates
+    void SetNumSpillsStored(Int_t n) { fNumSpillsStored = n; }
+    // kFALSE when the Trloii scalers are read periodically during the spill, see R3BSofTrloiiSpillRates
+    void SetSpillEndReadout(Bool_t option) { fSpillEndReadout = option; }
+    // kTRUE for scaler modules cleared at each readout, only used when the counts per spill are built here
+    void SetCleared(Bool_t option) { fCleared = option; }
+
   private:
     TClonesArray* fMappedItemsScalers; /**< Array with mapped items. */
     TClonesArray* fMappedItemsTrloii;
+    R3BSofScalersSpillData* fSpillData; /**< Counts per spill of the SOFIA scalers. */
+    Bool_t fOwnSpillData;               /**< Built here from the mapped data. */
+    Bool_t fCleared;                    /**< Scaler modules cleared at each readout. */
 
     // check for trigger should be done globablly (somewhere else)
-    R3BEventHeader* header;  /**< Event header.      */
-    Int_t fNEvents, fNSpill; /**< Event counter.     */
+    R3BEventHeader* header; /**< Event header.      */
+    Int_t fNEvents;         /**< Event counter.     */
     Bool_t read_trloii;
-    ULong64_t fTrloii[16][16] = { { 0 } }, fScaler[8] = { 0 }, fcounts[10] = { 0 };
-    Double_t frate[10] = { 0. };
+    Int_t fNumSpillsStored;
+    Bool_t fSpillEndReadout;
+    R3BSofTrloiiSpillRates* fSpillRates; //! /**< Counts of the Trloii scalers per spill. */
 
     // Canvas
-    TCanvas *cScalersGeneralView[NbScalers], *cRate;
+    TCanvas *cScalersGeneralView[NbScalers], *cRate, *cSpillRates;
 
     // Histograms for Mapped data : accumulate statistics per channel
     TH1D *fh1_GeneralView[NbScalers], *h_RatePerSpill;
 
+    // Time series of the last spills
+    TGraph *fg_RatePerSpill[8], *fg_LiveTime;
+
+    void UpdateRates();
+    void UpdateSpillGraphs();
+
   public:
     ClassDef(R3BSofScalersOnlineSpectra, 1)
 };
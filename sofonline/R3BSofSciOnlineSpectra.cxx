@@ -15,10 +15,12 @@
 #include "FairRunOnline.h"
 #include "FairRuntimeDb.h"
 #include "R3BEventHeader.h"
+#include "R3BSofEventSummaryData.h"
+#include "R3BSofHistoFiller.h"
+#include "R3BSofSnapshotPublisher.h"
 #include "R3BSofSciCalData.h"
 #include "R3BSofSciMappedData.h"
 #include "R3BSofSciSingleTcalData.h"
-#include "R3BSofSciTcalData.h"
 #include "TCanvas.h"
 #include "TClonesArray.h"
 #include "TFolder.h"
@@ -50,11 +52,14 @@ R3BSofSciOnlineSpectra::R3BSofSciOnlineSpectra()
     , fTcal(NULL)
     , fSingleTcal(NULL)
     , fCal(NULL)
+    , fSummary(NULL)
     , fNEvents(0)
     , fNbDetectors(2)
     , fNbChannels(3)
     , fIdS2(1)
     , fIdS8(0)
+    , fFiller(new R3BSofHistoFiller())
+    , fPublisher(NULL)
 {
     fCalTofS2min = new TArrayF(4);
     fCalTofS2max = new TArrayF(4);
@@ -69,11 +74,14 @@ R3BSofSciOnlineSpectra::R3BSofSciOnlineSpectra(const char* name, Int_t iVerbose)
     , fTcal(NULL)
     , fSingleTcal(NULL)
     , fCal(NULL)
+    , fSummary(NULL)
     , fNEvents(0)
     , fNbDetectors(2)
     , fNbChannels(3)
     , fIdS2(1)
     , fIdS8(0)
+    , fFiller(new R3BSofHistoFiller())
+    , fPublisher(NULL)
 {
     fCalTofS2min = new TArrayF(4);
     fCalTofS2max = new TArrayF(4);
@@ -84,6 +92,8 @@ R3BSofSciOnlineSpectra::R3BSofSciOnlineSpectra(const char* name, Int_t iVerbose)
 R3BSofSciOnlineSpectra::~R3BSofSciOnlineSpectra()
 {
     LOG(info) << "R3BSofSciOnlineSpectra::Delete instance";
+    if (fFiller)
+        delete fFiller;
     if (fMapped)
         delete fMapped;
     if (fTcal)
@@ -149,6 +159,22 @@ InitStatus R3BSofSciOnlineSpectra::Init()
         return kFATAL;
     }
 
+    // --- ------------------------------- --- //
+    // --- get access to the event summary --- //
+    // --- ------------------------------- --- //
+    fSummary = (R3BSofEventSummaryData*)mgr->GetObject("SofEventSummary");
+    if (!fSummary)
+    {
+        LOG(error) << "R3BSofSciOnlineSpectra::Init SofEventSummary not found, R3BSofEventSummary to be added before";
+        return kFATAL;
+    }
+    if (fNbDetectors > R3BSofEventSummaryData::kSciDets)
+    {
+        LOG(error) << "R3BSofSciOnlineSpectra::Init " << fNbDetectors << " SofSci, at most "
+                   << R3BSofEventSummaryData::kSciDets;
+        return kFATAL;
+    }
+
     // --- ------------------------------ --- //
     // --- declare TCanvas and Histograms --- //
     // --- ------------------------------ --- //
@@ -303,6 +329,7 @@ InitStatus R3BSofSciOnlineSpectra::Init()
         {
             sprintf(Name1, "DeltaTref_Sci%02d_to_SciCaveC", d + 1);
             fh1_DeltaTref[d] = new TH1D(Name1, Name1, 45000, -20000, 25000);
+            fFiller->AddSparse(fh1_DeltaTref[d]);
             cDeltaTref->cd(d + 1);
             fh1_DeltaTref[d]->Draw();
         }
@@ -868,15 +895,30 @@ InitStatus R3BSofSciOnlineSpectra::Init()
     run->AddObject(mainfolSciMult);
     run->AddObject(mainfolSci);
 
+    // copies served off the event loop
+    if (fPublisher)
+    {
+        Int_t group = fPublisher->Add(mainfolSciMult);
+        fPublisher->Add(mainfolSci, group);
+        fFiller->SetPublisher(fPublisher, group);
+    }
+
     // Register command to reset histograms
     run->GetHttpServer()->RegisterCommand("Reset_SOFSCI_HIST", Form("/Objects/%s/->Reset_Histo()", GetName()));
 
     return kSUCCESS;
 }
 
+void R3BSofSciOnlineSpectra::SetUpdateRate(Int_t n, Double_t s)
+{
+    fFiller->SetFlushEvents(n);
+    fFiller->SetFlushSeconds(s);
+}
+
 void R3BSofSciOnlineSpectra::Reset_Histo()
 {
     LOG(info) << "R3BSofSciOnlineSpectra::Reset_Histo";
+    fFiller->Flush();
     for (Int_t d = 0; d < fNbDetectors; d++)
         for (Int_t p = 0; p < 2; p++)
         {
@@ -917,7 +959,7 @@ void R3BSofSciOnlineSpectra::Reset_Histo()
     if (fNbDetectors > 1)
     {
         for (int d = 0; d < fNbDetectors - 1; d++)
-            fh1_DeltaTref[d]->Reset();
+            fFiller->Reset(fh1_DeltaTref[d]);
     }
     // === TIME OF FLIGHT AND BETA === //
     if (fIdS2 > 0)
@@ -969,37 +1011,17 @@ void R3BSofSciOnlineSpectra::Exec(Option_t* option)
 
     Int_t nHits;
     Int_t iDet; // 0-based
-    Int_t iCh;  // 0-based
     Float_t iRawPos;
     Double_t iRawTof;
-    Double_t TofS2[fNbDetectors - fIdS2];
-    Double_t TofS8[fNbDetectors - fIdS8];
-    Float_t RawPos[fNbDetectors];
-    Float_t CalPos[fNbDetectors];
-
-    Int_t multMap[fNbDetectors * fNbChannels];
-    Int_t multTcal[fNbDetectors * fNbChannels];
-    Int_t multSTcal[fNbDetectors];
-    Int_t multCal[fNbDetectors];
-    Double_t iRawTimeNs[fNbDetectors * fNbChannels];
-    Float_t iClock[fNbDetectors * fNbChannels];
-    Float_t iCoarse[fNbDetectors * fNbChannels];
 
+    // multiplicities and first-hit times per channel, decoded once per event
+    typedef R3BSofEventSummaryData::Sci Sci;
+    const Sci* sci[R3BSofEventSummaryData::kSciDets];
     for (Int_t i = 0; i < fNbDetectors; i++)
-    {
-        for (Int_t j = 0; j < fNbChannels; j++)
-        {
-            multMap[i * fNbChannels + j] = 0;
-            multTcal[i * fNbChannels + j] = 0;
-            iRawTimeNs[i * fNbChannels + j] = 0;
-            iClock[i * fNbChannels + j] = 0;
-            iCoarse[i * fNbChannels + j] = 0;
-        }
-        multSTcal[i] = 0;
-        multCal[i] = 0;
-        RawPos[i] = -100000.;
-        CalPos[i] = -100000.;
-    }
+        sci[i] = &fSummary->GetSci(i + 1);
+    // positions out of the histograms without hit
+    auto RawPos = [&](Int_t i) { return sci[i]->multSTcal ? sci[i]->rawPos : -100000.; };
+    auto CalPos = [&](Int_t i) { return sci[i]->multCal ? sci[i]->calPos : -100000.; };
 
     if (fMapped && fMapped->GetEntriesFast())
     {
@@ -1012,47 +1034,30 @@ void R3BSofSciOnlineSpectra::Exec(Option_t* option)
             R3BSofSciMappedData* hitmapped = (R3BSofSciMappedData*)fMapped->At(ihit);
             if (!hitmapped)
                 continue;
-            iDet = hitmapped->GetDetector() - 1;
-            iCh = hitmapped->GetPmt() - 1;
-            multMap[iDet * fNbChannels + iCh]++;
-            fh1_finetime[iDet * fNbChannels + iCh]->Fill(hitmapped->GetTimeFine());
-            iCoarse[iDet * fNbChannels + iCh] = (Float_t)hitmapped->GetTimeCoarse();
+            fFiller->Fill(fh1_finetime[(hitmapped->GetDetector() - 1) * fNbChannels + hitmapped->GetPmt() - 1],
+                          hitmapped->GetTimeFine());
         } // end of loop over mapped data
 
         if (fTcal && fTcal->GetEntriesFast())
         {
-            // --- -------------- --- //
-            // --- read tcal data --- //
-            // --- -------------- --- //
-            nHits = fTcal->GetEntriesFast();
-            for (Int_t ihit = 0; ihit < nHits; ihit++)
-            {
-                R3BSofSciTcalData* hittcal = (R3BSofSciTcalData*)fTcal->At(ihit);
-                if (!hittcal)
-                    continue;
-                iDet = hittcal->GetDetector() - 1;
-                iCh = hittcal->GetPmt() - 1;
-                multTcal[iDet * fNbChannels + iCh]++;
-                iRawTimeNs[iDet * fNbChannels + iCh] = hittcal->GetRawTimeNs();
-                iClock[iDet * fNbChannels + iCh] = (Float_t)hittcal->GetCoarseTime();
-                if (multMap[iDet * fNbChannels + iCh] == 1 &&
-                    iCoarse[iDet * fNbChannels + iCh] != iClock[iDet * fNbChannels + iCh])
-                {
-                    std::cout << "iCoarse[" << iDet * fNbChannels + iCh << "] = " << iCoarse[iDet * fNbChannels + iCh]
-                              << ", iClock[" << iDet * fNbChannels + iCh << "]" << iClock[iDet * fNbChannels + iCh]
-                              << std::endl;
-                }
-            } // --- end of loop over Tcal data --- //
+            // --- ----------------------------- --- //
+            // --- coarse time mapped versus tcal --- //
+            // --- ----------------------------- --- //
+            for (Int_t i = 0; i < fNbDetectors; i++)
+                for (Int_t j = 0; j < fNbChannels; j++)
+                    if (sci[i]->multMap[j] == 1 && sci[i]->multTcal[j] > 0 && sci[i]->coarse[j] != sci[i]->clock[j])
+                    {
+                        std::cout << "iCoarse[" << i * fNbChannels + j << "] = " << sci[i]->coarse[j] << ", iClock["
+                                  << i * fNbChannels + j << "]" << sci[i]->clock[j] << std::endl;
+                    }
 
             if (fNbDetectors > 1)
             {
+                const Sci* caveC = sci[fNbDetectors - 1];
                 for (int d = 0; d < fNbDetectors - 1; d++)
                 {
-                    if (multMap[(fNbDetectors - 1) * fNbChannels + 2] == 1 && multMap[d * fNbChannels + 2] == 1)
-                        fh1_DeltaTref[d]->Fill(iRawTimeNs[d * fNbChannels + 2] -
-                                               iRawTimeNs[(fNbDetectors - 1) * fNbChannels + 2]);
-                    // std::cout << "index first tref : " << d*fNbChannels+2 << ", index cave C Tref = " <<
-                    // (fNbDetectors-1)*fNbChannels+2 << std::endl;
+                    if (caveC->multMap[2] == 1 && sci[d]->multMap[2] == 1)
+                        fFiller->Fill(fh1_DeltaTref[d], sci[d]->rawTimeNs[2] - caveC->rawTimeNs[2]);
                 }
             }
 
@@ -1068,13 +1073,11 @@ void R3BSofSciOnlineSpectra::Exec(Option_t* option)
                     if (!hitstcal)
                         continue;
                     iDet = hitstcal->GetDetector() - 1;
-                    multSTcal[iDet]++;
-                    RawPos[iDet] = hitstcal->GetRawPosNs();
-                    fh1_RawPos_SingleTcal[iDet]->Fill(hitstcal->GetRawPosNs());
+                    fFiller->Fill(fh1_RawPos_SingleTcal[iDet], hitstcal->GetRawPosNs());
                     if (fIdS2 > 0 && hitstcal->GetDetector() > fIdS2)
-                        fh1_RawTofFromS2_SingleTcal[iDet - fIdS2]->Fill(hitstcal->GetRawTofNs_FromS2());
+                        fFiller->Fill(fh1_RawTofFromS2_SingleTcal[iDet - fIdS2], hitstcal->GetRawTofNs_FromS2());
                     if (fIdS8 > 0 && hitstcal->GetDetector() > fIdS8)
-                        fh1_RawTofFromS8_SingleTcal[iDet - fIdS8]->Fill(hitstcal->GetRawTofNs_FromS8());
+                        fFiller->Fill(fh1_RawTofFromS8_SingleTcal[iDet - fIdS8], hitstcal->GetRawTofNs_FromS8());
                 } // --- end of loop over SingleTcal data --- //
 
                 if (fCal && fCal->GetEntries())
@@ -1082,10 +1085,6 @@ void R3BSofSciOnlineSpectra::Exec(Option_t* option)
                     // --- ------------- --- //
                     // --- read cal data --- //
                     // --- ------------- --- //
-                    for (Int_t i = fIdS2; i < fNbDetectors; i++)
-                        TofS2[i - fIdS2] = 0;
-                    for (Int_t i = fIdS8; i < fNbDetectors; i++)
-                        TofS8[i - fIdS8] = 0;
                     nHits = fCal->GetEntriesFast();
                     for (Int_t ihit = 0; ihit < nHits; ihit++)
                     {
@@ -1093,22 +1092,20 @@ void R3BSofSciOnlineSpectra::Exec(Option_t* option)
                         if (!hitcal)
                             continue;
                         iDet = hitcal->GetDetector() - 1;
-                        multCal[iDet]++;
-                        fh1_CalPos[iDet]->Fill(hitcal->GetPosMm());
-                        CalPos[iDet] = hitcal->GetPosMm();
+                        fFiller->Fill(fh1_CalPos[iDet], hitcal->GetPosMm());
                         if (fIdS2 > 0 && hitcal->GetDetector() > fIdS2)
                         {
-                            fh1_CalTofFromS2[iDet - fIdS2]->Fill(hitcal->GetTofNs_S2());
-                            fh1_BetaFromS2[iDet - fIdS2]->Fill(hitcal->GetBeta_S2());
-                            TofS2[iDet - fIdS2] = hitcal->GetTofNs_S2();
-                            fh2_PosVsTofS2[2 * (iDet - fIdS2) + 1]->Fill(hitcal->GetTofNs_S2(), hitcal->GetPosMm());
+                            fFiller->Fill(fh1_CalTofFromS2[iDet - fIdS2], hitcal->GetTofNs_S2());
+                            fFiller->Fill(fh1_BetaFromS2[iDet - fIdS2], hitcal->GetBeta_S2());
+                            fFiller->Fill(fh2_PosVsTofS2[2 * (iDet - fIdS2) + 1], hitcal->GetTofNs_S2(),
+                                          hitcal->GetPosMm());
                         }
                         if (fIdS8 > 0 && hitcal->GetDetector() > fIdS8)
                         {
-                            fh1_CalTofFromS8[iDet - fIdS8]->Fill(hitcal->GetTofNs_S8());
-                            fh1_BetaFromS8[iDet - fIdS8]->Fill(hitcal->GetBeta_S8());
-                            TofS8[iDet - fIdS8] = hitcal->GetTofNs_S8();
-                            fh2_PosVsTofS8[2 * (iDet - fIdS8) + 1]->Fill(TofS8[iDet - fIdS8], hitcal->GetPosMm());
+                            fFiller->Fill(fh1_CalTofFromS8[iDet - fIdS8], hitcal->GetTofNs_S8());
+                            fFiller->Fill(fh1_BetaFromS8[iDet - fIdS8], hitcal->GetBeta_S8());
+                            fFiller->Fill(fh2_PosVsTofS8[2 * (iDet - fIdS8) + 1], hitcal->GetTofNs_S8(),
+                                          hitcal->GetPosMm());
                         }
                     } // --- end of loop over Cal data --- //
                 }     // --- end of if Cal data --- //
@@ -1118,151 +1115,146 @@ void R3BSofSciOnlineSpectra::Exec(Option_t* option)
         // --- ----------------------------------------- --- //
         // --- filling some histogramms outside the loop --- //
         // --- ----------------------------------------- --- //
-        Float_t delta = 0;
         for (Int_t i = 0; i < fNbDetectors; i++)
         {
-            fh2_mult_RvsL[i]->Fill(multMap[i * fNbChannels + 1], multMap[i * fNbChannels]);
+            const Int_t* multMap = sci[i]->multMap;
+            const Int_t* multTcal = sci[i]->multTcal;
+            const Float_t* iClock = sci[i]->clock;
+            fFiller->Fill(fh2_mult_RvsL[i], multMap[1], multMap[0]);
             for (Int_t j = 0; j < (fNbChannels - 1); j++)
-                fh2_mult_TrefVsPmt[i * (fNbChannels - 1) + j]->Fill(multMap[i * fNbChannels + j],
-                                                                    multMap[i * fNbChannels + 2]);
+                fFiller->Fill(fh2_mult_TrefVsPmt[i * (fNbChannels - 1) + j], multMap[j], multMap[2]);
             if (BeamOrFission == kTRUE)
             {
-                fh2_mult_RvsL_condTpat[i]->Fill(multMap[i * fNbChannels + 1], multMap[i * fNbChannels]);
+                fFiller->Fill(fh2_mult_RvsL_condTpat[i], multMap[1], multMap[0]);
                 for (Int_t j = 0; j < (fNbChannels - 1); j++)
-                    fh2_mult_TrefVsPmt_condTpat[i * (fNbChannels - 1) + j]->Fill(multMap[i * fNbChannels + j],
-                                                                                 multMap[i * fNbChannels + 2]);
+                    fFiller->Fill(fh2_mult_TrefVsPmt_condTpat[i * (fNbChannels - 1) + j], multMap[j], multMap[2]);
             }
 
             for (Int_t j = 0; j < fNbChannels; j++)
             {
-                fh2_mult[i]->Fill(j + 1, multMap[i * fNbChannels + j]);
-                fh1_multMap[i * fNbChannels + j]->Fill(multMap[i * fNbChannels + j]);
-                fh1_multTcal[i * fNbChannels + j]->Fill(multTcal[i * fNbChannels + j]);
+                fFiller->Fill(fh2_mult[i], j + 1, multMap[j]);
+                fFiller->Fill(fh1_multMap[i * fNbChannels + j], multMap[j]);
+                fFiller->Fill(fh1_multTcal[i * fNbChannels + j], multTcal[j]);
                 if (BeamOrFission == kTRUE)
                 {
-                    fh1_multMap_condTpat[i * fNbChannels + j]->Fill(multMap[i * fNbChannels + j]);
-                    fh1_multTcal_condTpat[i * fNbChannels + j]->Fill(multTcal[i * fNbChannels + j]);
+                    fFiller->Fill(fh1_multMap_condTpat[i * fNbChannels + j], multMap[j]);
+                    fFiller->Fill(fh1_multTcal_condTpat[i * fNbChannels + j], multTcal[j]);
                 }
             }
-            fh1_multSingleTcal[i]->Fill(multSTcal[i]);
-            fh1_multCal[i]->Fill(multCal[i]);
+            fFiller->Fill(fh1_multSingleTcal[i], sci[i]->multSTcal);
+            fFiller->Fill(fh1_multCal[i], sci[i]->multCal);
             if (BeamOrFission == kTRUE)
             {
-                fh1_multSingleTcal_condTpat[i]->Fill(multSTcal[i]);
-                // fh1_multCal_condTpat[i]->Fill(multCal[i]);
+                fFiller->Fill(fh1_multSingleTcal_condTpat[i], sci[i]->multSTcal);
+                // fh1_multCal_condTpat[i]->Fill(sci[i]->multCal);
             }
-            if ((multTcal[i * fNbChannels] == 1) && (multTcal[i * fNbChannels + 1] == 1))
+            if ((multTcal[0] == 1) && (multTcal[1] == 1))
             {
                 // TrawRIGHT-TrawLEFT = 5*(CCr-CCl)+(FTl-FTr) : x is increasing from RIGHT to LEFT
-                iRawPos = iRawTimeNs[i * fNbChannels] - iRawTimeNs[i * fNbChannels + 1];
-                fh1_RawPos_TcalMult1[i]->Fill(iRawPos);
-                if (multTcal[i * fNbChannels + 2] == 1)
+                iRawPos = sci[i]->rawTimeNs[0] - sci[i]->rawTimeNs[1];
+                fFiller->Fill(fh1_RawPos_TcalMult1[i], iRawPos);
+                if (multTcal[2] == 1)
                 {
                     if (fNbDetectors > 1 && fIdS2 > 0)
                     {
                         if (i == 0)
                         {
-                            fh1_deltaClockPerSci[2 * i]->Fill(
-                                (Float_t)(iClock[i * fNbChannels + 2] - iClock[i * fNbChannels]) -
-                                (Float_t)(DeltaClockTrefRight_S2));
-                            fh1_deltaClockPerSci[2 * i + 1]->Fill(
-                                (Float_t)(iClock[i * fNbChannels + 2] - iClock[i * fNbChannels + 1]) -
-                                (Float_t)(DeltaClockTrefLeft_S2));
+                            fFiller->Fill(fh1_deltaClockPerSci[2 * i],
+                                          (Float_t)(iClock[2] - iClock[0]) - (Float_t)(DeltaClockTrefRight_S2));
+                            fFiller->Fill(fh1_deltaClockPerSci[2 * i + 1],
+                                          (Float_t)(iClock[2] - iClock[1]) - (Float_t)(DeltaClockTrefLeft_S2));
                             if (BeamOrFission == kTRUE)
                             {
-                                fh1_deltaClockPerSci_condTpat[2 * i]->Fill(
-                                    (Float_t)(iClock[i * fNbChannels + 2] - iClock[i * fNbChannels]) -
-                                    (Float_t)(DeltaClockTrefRight_S2));
-                                fh1_deltaClockPerSci_condTpat[2 * i + 1]->Fill(
-                                    (Float_t)(iClock[i * fNbChannels + 2] - iClock[i * fNbChannels + 1]) -
-                                    (Float_t)(DeltaClockTrefLeft_S2));
+                                fFiller->Fill(fh1_deltaClockPerSci_condTpat[2 * i],
+                                              (Float_t)(iClock[2] - iClock[0]) - (Float_t)(DeltaClockTrefRight_S2));
+                                fFiller->Fill(fh1_deltaClockPerSci_condTpat[2 * i + 1],
+                                              (Float_t)(iClock[2] - iClock[1]) - (Float_t)(DeltaClockTrefLeft_S2));
                             }
                         }
                         else if (i == 1)
                         {
-                            fh1_deltaClockPerSci[2 * i]->Fill(
-                                (Float_t)(iClock[i * fNbChannels + 2] - iClock[i * fNbChannels]) -
-                                (Float_t)(DeltaClockTrefRight_CaveC));
-                            fh1_deltaClockPerSci[2 * i + 1]->Fill(
-                                (Float_t)(iClock[i * fNbChannels + 2] - iClock[i * fNbChannels + 1]) -
-                                (Float_t)(DeltaClockTrefLeft_CaveC));
+                            fFiller->Fill(fh1_deltaClockPerSci[2 * i],
+                                          (Float_t)(iClock[2] - iClock[0]) - (Float_t)(DeltaClockTrefRight_CaveC));
+                            fFiller->Fill(fh1_deltaClockPerSci[2 * i + 1],
+                                          (Float_t)(iClock[2] - iClock[1]) - (Float_t)(DeltaClockTrefLeft_CaveC));
                             if (BeamOrFission == kTRUE)
                             {
-                                fh1_deltaClockPerSci_condTpat[2 * i]->Fill(
-                                    (Float_t)(iClock[i * fNbChannels + 2] - iClock[i * fNbChannels]) -
-                                    (Float_t)(DeltaClockTrefRight_CaveC));
-                                fh1_deltaClockPerSci_condTpat[2 * i + 1]->Fill(
-                                    (Float_t)(iClock[i * fNbChannels + 2] - iClock[i * fNbChannels + 1]) -
-                                    (Float_t)(DeltaClockTrefLeft_CaveC));
+                                fFiller->Fill(fh1_deltaClockPerSci_condTpat[2 * i],
+                                              (Float_t)(iClock[2] - iClock[0]) - (Float_t)(DeltaClockTrefRight_CaveC));
+                                fFiller->Fill(fh1_deltaClockPerSci_condTpat[2 * i + 1],
+                                              (Float_t)(iClock[2] - iClock[1]) - (Float_t)(DeltaClockTrefLeft_CaveC));
                             }
                         }
                     }
                     else if (fNbDetectors == 1)
                     {
-                        fh1_deltaClockPerSci[2 * i]->Fill(
-                            (Float_t)(iClock[i * fNbChannels + 2] - iClock[i * fNbChannels]) -
-                            (Float_t)(DeltaClockTrefRight_CaveC));
-                        fh1_deltaClockPerSci[2 * i + 1]->Fill(
-                            (Float_t)(iClock[i * fNbChannels + 2] - iClock[i * fNbChannels + 1]) -
-                            (Float_t)(DeltaClockTrefLeft_CaveC));
+                        fFiller->Fill(fh1_deltaClockPerSci[2 * i],
+                                      (Float_t)(iClock[2] - iClock[0]) - (Float_t)(DeltaClockTrefRight_CaveC));
+                        fFiller->Fill(fh1_deltaClockPerSci[2 * i + 1],
+                                      (Float_t)(iClock[2] - iClock[1]) - (Float_t)(DeltaClockTrefLeft_CaveC));
                         if (BeamOrFission == kTRUE)
                         {
-                            fh1_deltaClockPerSci_condTpat[2 * i]->Fill(
-                                (Float_t)(iClock[i * fNbChannels + 2] - iClock[i * fNbChannels]) -
-                                (Float_t)(DeltaClockTrefRight_CaveC));
-                            fh1_deltaClockPerSci_condTpat[2 * i + 1]->Fill(
-                                (Float_t)(iClock[i * fNbChannels + 2] - iClock[i * fNbChannels + 1]) -
-                                (Float_t)(DeltaClockTrefLeft_CaveC));
+                            fFiller->Fill(fh1_deltaClockPerSci_condTpat[2 * i],
+                                          (Float_t)(iClock[2] - iClock[0]) - (Float_t)(DeltaClockTrefRight_CaveC));
+                            fFiller->Fill(fh1_deltaClockPerSci_condTpat[2 * i + 1],
+                                          (Float_t)(iClock[2] - iClock[1]) - (Float_t)(DeltaClockTrefLeft_CaveC));
                         }
                     }
                 }
             }
-            fh2_RawPosVsCalPos[i]->Fill(CalPos[i], RawPos[i]);
+            fFiller->Fill(fh2_RawPosVsCalPos[i], CalPos(i), RawPos(i));
         }
 
         if (fIdS2 > 0)
         {
+            const Sci* start = sci[fIdS2 - 1];
             for (Int_t dstop = fIdS2; dstop < fNbDetectors; dstop++)
             {
-                if ((multTcal[(fIdS2 - 1) * fNbChannels] == 1) &&     // SofSci at S2: PMT RIGHT
-                    (multTcal[(fIdS2 - 1) * fNbChannels + 1] == 1) && // SofSci at S2: PMT LEFT
-                    (multTcal[(fIdS2 - 1) * fNbChannels + 2] == 1) && // Tref of SofSci at S2
-                    (multTcal[dstop * fNbChannels] == 1) &&           // SofSci stop: PMT RIGHT
-                    (multTcal[dstop * fNbChannels + 1] == 1) &&       // SofSci stop: PMT LEFT
-                    (multTcal[dstop * fNbChannels + 2] == 1))         // Tref of SofSci stop
+                const Sci* stop = sci[dstop];
+                if ((start->multTcal[0] == 1) && // SofSci at S2: PMT RIGHT
+                    (start->multTcal[1] == 1) && // SofSci at S2: PMT LEFT
+                    (start->multTcal[2] == 1) && // Tref of SofSci at S2
+                    (stop->multTcal[0] == 1) &&  // SofSci stop: PMT RIGHT
+                    (stop->multTcal[1] == 1) &&  // SofSci stop: PMT LEFT
+                    (stop->multTcal[2] == 1))    // Tref of SofSci stop
                 {
-                    iRawTof =
-                        0.5 * (iRawTimeNs[dstop * fNbChannels] + iRawTimeNs[dstop * fNbChannels + 1]) -
-                        0.5 * (iRawTimeNs[(fIdS2 - 1) * fNbChannels] + iRawTimeNs[(fIdS2 - 1) * fNbChannels + 1]) +
-                        iRawTimeNs[(fIdS2 - 1) * fNbChannels + 2] - iRawTimeNs[dstop * fNbChannels + 2];
-                    fh1_RawTofFromS2_TcalMult1[dstop - fIdS2]->Fill(iRawTof);
+                    iRawTof = 0.5 * (stop->rawTimeNs[0] + stop->rawTimeNs[1]) -
+                              0.5 * (start->rawTimeNs[0] + start->rawTimeNs[1]) + start->rawTimeNs[2] -
+                              stop->rawTimeNs[2];
+                    fFiller->Fill(fh1_RawTofFromS2_TcalMult1[dstop - fIdS2], iRawTof);
                 }
-                fh2_PosVsTofS2[2 * (dstop - fIdS2)]->Fill(TofS2[dstop - fIdS2], CalPos[fIdS2 - 1]);
+                fFiller->Fill(fh2_PosVsTofS2[2 * (dstop - fIdS2)], stop->multCal ? stop->tofS2 : 0.,
+                              CalPos(fIdS2 - 1));
             }
         } // --- end of if SofSci at S2 --- //
 
         if (fIdS8 > 0)
         {
+            const Sci* start = sci[fIdS8 - 1];
             for (Int_t dstop = fIdS8; dstop < fNbDetectors; dstop++)
             {
-                if ((multMap[(fIdS8 - 1) * fNbChannels] == 1) &&     // SofSci at S8: PMT RIGHT
-                    (multMap[(fIdS8 - 1) * fNbChannels + 1] == 1) && // SofSci at S8: PMT LEFT
-                    (multMap[(fIdS8 - 1) * fNbChannels + 2] == 1) && // Tref of SofSci at S8
-                    (multMap[dstop * fNbChannels] == 1) &&           // SofSci stop: PMT RIGHT
-                    (multMap[dstop * fNbChannels + 1] == 1) &&       // SofSci stop: PMT LEFT
-                    (multMap[dstop * fNbChannels + 2] == 1))         // Tref of SofSci stop
+                const Sci* stop = sci[dstop];
+                if ((start->multMap[0] == 1) && // SofSci at S8: PMT RIGHT
+                    (start->multMap[1] == 1) && // SofSci at S8: PMT LEFT
+                    (start->multMap[2] == 1) && // Tref of SofSci at S8
+                    (stop->multMap[0] == 1) &&  // SofSci stop: PMT RIGHT
+                    (stop->multMap[1] == 1) &&  // SofSci stop: PMT LEFT
+                    (stop->multMap[2] == 1))    // Tref of SofSci stop
                 {
-                    iRawTof =
-                        0.5 * (iRawTimeNs[dstop * fNbChannels] + iRawTimeNs[dstop * fNbChannels + 1]) -
-                        0.5 * (iRawTimeNs[(fIdS8 - 1) * fNbChannels] + iRawTimeNs[(fIdS8 - 1) * fNbChannels + 1]) +
-                        iRawTimeNs[(fIdS8 - 1) * fNbChannels + 2] - iRawTimeNs[dstop * fNbChannels + 2];
-                    fh1_RawTofFromS8_TcalMult1[dstop - fIdS8]->Fill(iRawTof);
+                    iRawTof = 0.5 * (stop->rawTimeNs[0] + stop->rawTimeNs[1]) -
+                              0.5 * (start->rawTimeNs[0] + start->rawTimeNs[1]) + start->rawTimeNs[2] -
+                              stop->rawTimeNs[2];
+                    fFiller->Fill(fh1_RawTofFromS8_TcalMult1[dstop - fIdS8], iRawTof);
                 }
-                fh2_PosVsTofS8[2 * (dstop - fIdS8)]->Fill(TofS8[dstop - fIdS8], CalPos[fIdS8 - 1]);
+                fFiller->Fill(fh2_PosVsTofS8[2 * (dstop - fIdS8)], stop->multCal ? stop->tofS8 : 0.,
+                              CalPos(fIdS8 - 1));
             }
         } // --- end of if SofSci at S8 --- //
     }     // --- end of if Mapped data --- //
 
+    // the histograms are updated every N events or T seconds, this event included
+    fFiller->Tick();
+
     fNEvents++;
 }
 
@@ -1270,28 +1262,12 @@ void R3BSofSciOnlineSpectra::Exec(Option_t* option)
 void R3BSofSciOnlineSpectra::Reset() {}
 
 // -----   Public method Finish   -----------------------------------------------
-void R3BSofSciOnlineSpectra::FinishEvent()
-{
-    if (fMapped)
-    {
-        fMapped->Clear();
-    }
-    if (fTcal)
-    {
-        fTcal->Clear();
-    }
-    if (fSingleTcal)
-    {
-        fSingleTcal->Clear();
-    }
-    if (fCal)
-    {
-        fCal->Clear();
-    }
-}
+void R3BSofSciOnlineSpectra::FinishEvent() {}
 
 void R3BSofSciOnlineSpectra::FinishTask()
 {
+    // written with the full binning, the zoom of the sparse histograms is only for the display
+    fFiller->Flush(kTRUE);
 
     for (Int_t i = 0; i < fNbDetectors; i++)
     {
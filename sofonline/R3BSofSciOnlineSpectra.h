@@ -21,6 +21,9 @@
 
 class TClonesArray;
 class R3BEventHeader;
+class R3BSofEventSummaryData;
+class R3BSofHistoFiller;
+class R3BSofSnapshotPublisher;
 
 /**
  * This taks reads SCI data and plots online histograms
@@ -82,6 +85,11 @@ class R3BSofSciOnlineSpectra : public FairTask
      */
     virtual void Reset_Histo();
 
+    /** The histograms served by the http server are updated every n events or s seconds, whichever first **/
+    void SetUpdateRate(Int_t n, Double_t s);
+    /** Copies of the histograms also served by publisher, updated at the same rate, before Init **/
+    void SetPublisher(R3BSofSnapshotPublisher* publisher) { fPublisher = publisher; }
+
     /** Virtual method Reset **/
     virtual void Reset();
 
@@ -103,10 +111,11 @@ class R3BSofSciOnlineSpectra : public FairTask
     Float_t GetTofS8max(Int_t rank) { return fCalTofS8max->GetAt(rank); }
 
   private:
-    TClonesArray* fMapped;     /**< Array with R3BSofSciMappedData */
-    TClonesArray* fTcal;       /**< Array with R3BSofSciTcalData */
-    TClonesArray* fSingleTcal; /**< Array with R3BSofSciSingleTcalData */
-    TClonesArray* fCal;        /**< Array with R3BSofSciCalData */
+    TClonesArray* fMapped;            /**< Array with R3BSofSciMappedData */
+    TClonesArray* fTcal;              /**< Array with R3BSofSciTcalData */
+    TClonesArray* fSingleTcal;        /**< Array with R3BSofSciSingleTcalData */
+    TClonesArray* fCal;               /**< Array with R3BSofSciCalData */
+    R3BSofEventSummaryData* fSummary; /**< Multiplicities and times per channel */
 
     Int_t fNbDetectors; // fNbDetectors is also equal to fIdCaveC
     Int_t fNbChannels;
@@ -197,6 +206,9 @@ class R3BSofSciOnlineSpectra : public FairTask
     // Histograms Pos vs Tof
     TH2D** fh2_PosVsTofS2; //[2*(fNbDetectors-fIdS2)]
     TH2D** fh2_PosVsTofS8; //[2*(fNbDetectors-fIdS8)]
+    // Buffered fills of the histograms
+    R3BSofHistoFiller* fFiller;          //!
+    R3BSofSnapshotPublisher* fPublisher; //!
 
   public:
     ClassDef(R3BSofSciOnlineSpectra, 1)
@@ -17,8 +17,8 @@
 #include "R3BEventHeader.h"
 #include "R3BMusicCalData.h"
 #include "R3BMusicHitData.h"
+#include "R3BSofEventSummaryData.h"
 #include "R3BSofSciCalData.h"
-#include "R3BSofSciTcalData.h"
 #include "TCanvas.h"
 #include "TClonesArray.h"
 #include "TFolder.h"
@@ -40,10 +40,10 @@
 
 R3BSofSciVsMusicOnlineSpectra::R3BSofSciVsMusicOnlineSpectra()
     : FairTask("SofSciVsMusicOnlineSpectra", 1)
-    , fTcalSci(NULL)
     , fCalSci(NULL)
     , fMusHitItems(NULL)
     , fMusCalItems(NULL)
+    , fSummary(NULL)
     , fNEvents(0)
     , fNbDetectors(2)
     , fNbChannels(3)
@@ -61,10 +61,10 @@ R3BSofSciVsMusicOnlineSpectra::R3BSofSciVsMusicOnlineSpectra()
 
 R3BSofSciVsMusicOnlineSpectra::R3BSofSciVsMusicOnlineSpectra(const char* name, Int_t iVerbose)
     : FairTask(name, iVerbose)
-    , fTcalSci(NULL)
     , fCalSci(NULL)
     , fMusHitItems(NULL)
     , fMusCalItems(NULL)
+    , fSummary(NULL)
     , fNEvents(0)
     , fNbDetectors(2)
     , fNbChannels(3)
@@ -83,8 +83,6 @@ R3BSofSciVsMusicOnlineSpectra::R3BSofSciVsMusicOnlineSpectra(const char* name, I
 R3BSofSciVsMusicOnlineSpectra::~R3BSofSciVsMusicOnlineSpectra()
 {
     LOG(info) << "R3BSofSciVsMusicOnlineSpectra::Delete instance";
-    if (fTcalSci)
-        delete fTcalSci;
     if (fCalSci)
         delete fCalSci;
     if (fMusHitItems)
@@ -109,12 +107,20 @@ InitStatus R3BSofSciVsMusicOnlineSpectra::Init()
     FairRunOnline* run = FairRunOnline::Instance();
     run->GetHttpServer()->Register("", this);
 
-    // --- ---------------------------------- --- //
-    // --- get access to tcal data of the Sci --- //
-    // --- ---------------------------------- --- //
-    fTcalSci = (TClonesArray*)mgr->GetObject("SofSciTcalData");
-    if (!fTcalSci)
+    // --- ------------------------------- --- //
+    // --- get access to the event summary --- //
+    // --- ------------------------------- --- //
+    fSummary = (R3BSofEventSummaryData*)mgr->GetObject("SofEventSummary");
+    if (!fSummary)
+    {
+        LOG(error) << "R3BSofSciVsMusicOnlineSpectra::Init SofEventSummary not found, R3BSofEventSummary to be added "
+                      "before";
+        return kFATAL;
+    }
+    if (fNbDetectors > R3BSofEventSummaryData::kSciDets)
     {
+        LOG(error) << "R3BSofSciVsMusicOnlineSpectra::Init " << fNbDetectors << " SofSci, at most "
+                   << R3BSofEventSummaryData::kSciDets;
         return kFATAL;
     }
 
@@ -475,19 +481,8 @@ void R3BSofSciVsMusicOnlineSpectra::Exec(Option_t* option)
         LOG(fatal) << "R3BSofSciVsMusicOnlineSpectra::Exec FairRootManager not found";
 
     Int_t nHits;
-    Int_t multTcal[fNbDetectors * 3];
-    Double_t TofS2[fNbDetectors - fIdS2];
-    Double_t TofS8[fNbDetectors - fIdS8];
     Double_t Gamma, Brho, xS2, AoQ;
 
-    for (Int_t det = 0; det < fNbDetectors; det++)
-    {
-        for (Int_t pmt = 0; pmt < 3; pmt++)
-        {
-            multTcal[det * 3 + pmt] = 0;
-        }
-    }
-
     // --- -------------- --- //
     // --- MUSIC Hit data --- //
     // --- -------------- --- //
@@ -526,20 +521,6 @@ void R3BSofSciVsMusicOnlineSpectra::Exec(Option_t* option)
         }
     }
 
-    // --- ---------------- --- //
-    // --- SofSci tcal data --- //
-    // --- ---------------- --- //
-    if (fTcalSci && fTcalSci->GetEntriesFast())
-    {
-        nHits = fTcalSci->GetEntriesFast();
-        for (Int_t ihit = 0; ihit < nHits; ihit++)
-        {
-            R3BSofSciTcalData* hit = (R3BSofSciTcalData*)fTcalSci->At(ihit);
-            if (!hit)
-                continue;
-            multTcal[3 * (hit->GetDetector() - 1) + hit->GetPmt() - 1]++;
-        }
-    }
     // --- --------------- --- //
     // --- SofSci cal data --- //
     // --- --------------- --- //
@@ -554,11 +535,6 @@ void R3BSofSciVsMusicOnlineSpectra::Exec(Option_t* option)
     {
         xS2 = 0.;
         Gamma = 1.;
-
-        for (Int_t i = fIdS2; i < fNbDetectors; i++)
-            TofS2[i - fIdS2] = 0;
-        for (Int_t i = fIdS8; i < fNbDetectors; i++)
-            TofS8[i - fIdS8] = 0;
         nHits = fCalSci->GetEntriesFast();
         for (Int_t ihit = 0; ihit < nHits; ihit++)
         {
@@ -600,40 +576,39 @@ void R3BSofSciVsMusicOnlineSpectra::Exec(Option_t* option)
                     fh1_EcorrBetaDT->Fill(EDT);
                     fh2_EcorrBetaVsDT->Fill(MusicDT, Ebeta);
                     fh2_EcorrBetaDTVsDT->Fill(MusicDT, EDT);
-                    if (multTcal[3 * (fNbDetectors - 1) + 2] == 1 && multTcal[3 * (fIdS2 - 1) + 2] == 1)
+                    // SofSci Tcal multiplicities of the right, left and Tref channels
+                    const Int_t* multS2 = fSummary->GetSci(fIdS2).multTcal;
+                    const Int_t* multCC = fSummary->GetSci(fNbDetectors).multTcal;
+                    if (multCC[2] == 1 && multS2[2] == 1)
                     {
                         fh2_Aqvsq_mult1Tref->Fill(AoQ, MusicZ);
 
-                        if (multTcal[3 * (fIdS2 - 1)] == 1 && multTcal[3 * (fIdS2 - 1) + 1] == 1)
+                        if (multS2[0] == 1 && multS2[1] == 1)
                         {
                             fh2_EvsAoQ[0]->Fill(AoQ, Esum);
                             fh2_EcorrvsAoQ[0]->Fill(AoQ, EDT);
                         }
-                        else if ((2 <= multTcal[3 * (fIdS2 - 1)] && multTcal[3 * (fIdS2 - 1)] <= 5) &&
-                                 (2 <= multTcal[3 * (fIdS2 - 1) + 1] && multTcal[3 * (fIdS2 - 1) + 1] <= 5))
+                        else if ((2 <= multS2[0] && multS2[0] <= 5) && (2 <= multS2[1] && multS2[1] <= 5))
                         {
                             fh2_EvsAoQ[1]->Fill(AoQ, Esum);
                             fh2_EcorrvsAoQ[1]->Fill(AoQ, EDT);
                         }
-                        else if ((6 <= multTcal[3 * (fIdS2 - 1)] && multTcal[3 * (fIdS2 - 1)] <= 10) &&
-                                 (6 <= multTcal[3 * (fIdS2 - 1) + 1] && multTcal[3 * (fIdS2 - 1) + 1] <= 10))
+                        else if ((6 <= multS2[0] && multS2[0] <= 10) && (6 <= multS2[1] && multS2[1] <= 10))
                         {
                             fh2_EvsAoQ[2]->Fill(AoQ, Esum);
                             fh2_EcorrvsAoQ[2]->Fill(AoQ, EDT);
                         }
-                        else if ((11 <= multTcal[3 * (fIdS2 - 1)] && multTcal[3 * (fIdS2 - 1)] <= 15) &&
-                                 (11 <= multTcal[3 * (fIdS2 - 1) + 1] && multTcal[3 * (fIdS2 - 1) + 1] <= 15))
+                        else if ((11 <= multS2[0] && multS2[0] <= 15) && (11 <= multS2[1] && multS2[1] <= 15))
                         {
                             fh2_EvsAoQ[3]->Fill(AoQ, Esum);
                             fh2_EcorrvsAoQ[3]->Fill(AoQ, EDT);
                         }
-                        else if ((16 <= multTcal[3 * (fIdS2 - 1)] && multTcal[3 * (fIdS2 - 1)] <= 20) &&
-                                 (16 <= multTcal[3 * (fIdS2 - 1) + 1] && multTcal[3 * (fIdS2 - 1) + 1] <= 20))
+                        else if ((16 <= multS2[0] && multS2[0] <= 20) && (16 <= multS2[1] && multS2[1] <= 20))
                         {
                             fh2_EvsAoQ[4]->Fill(AoQ, Esum);
                             fh2_EcorrvsAoQ[4]->Fill(AoQ, EDT);
                         }
-                        else if ((21 <= multTcal[3 * (fIdS2 - 1)]) && (21 <= multTcal[3 * (fIdS2 - 1) + 1]))
+                        else if ((21 <= multS2[0]) && (21 <= multS2[1]))
                         {
                             fh2_EvsAoQ[5]->Fill(AoQ, Esum);
                             fh2_EcorrvsAoQ[5]->Fill(AoQ, EDT);
@@ -652,25 +627,7 @@ void R3BSofSciVsMusicOnlineSpectra::Exec(Option_t* option)
 void R3BSofSciVsMusicOnlineSpectra::Reset() { LOG(debug) << "Clearing TofWHitData Structure"; }
 
 // -----   Public method Finish   -----------------------------------------------
-void R3BSofSciVsMusicOnlineSpectra::FinishEvent()
-{
-    if (fTcalSci)
-    {
-        fTcalSci->Clear();
-    }
-    if (fCalSci)
-    {
-        fCalSci->Clear();
-    }
-    if (fMusHitItems)
-    {
-        fMusHitItems->Clear();
-    }
-    if (fMusCalItems)
-    {
-        fMusCalItems->Clear();
-    }
-}
+void R3BSofSciVsMusicOnlineSpectra::FinishEvent() {}
 
 void R3BSofSciVsMusicOnlineSpectra::FinishTask()
 {
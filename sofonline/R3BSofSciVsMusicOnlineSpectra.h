@@ -21,6 +21,7 @@
 
 class TClonesArray;
 class R3BEventHeader;
+class R3BSofEventSummaryData;
 
 /**
  * This taks reads SCI data and plots online histograms
@@ -109,10 +110,10 @@ class R3BSofSciVsMusicOnlineSpectra : public FairTask
     Float_t GetTofS8max(Int_t rank) { return fCalTofS8max->GetAt(rank); }
 
   private:
-    TClonesArray* fTcalSci;     /**< Array with SofSci Tcal items. */
-    TClonesArray* fCalSci;      /**< Array with SofSci Cal items. */
-    TClonesArray* fMusHitItems; /**< Array with MUSIC Hit items. */
-    TClonesArray* fMusCalItems; /**< Array with MUSIC Cal items. */
+    TClonesArray* fCalSci;            /**< Array with SofSci Cal items. */
+    TClonesArray* fMusHitItems;       /**< Array with MUSIC Hit items. */
+    TClonesArray* fMusCalItems;       /**< Array with MUSIC Cal items. */
+    R3BSofEventSummaryData* fSummary; /**< SofSci Tcal multiplicities per channel */
 
     Int_t fNbDetectors;
     Int_t fNbChannels;
@@ -264,21 +264,7 @@ void R3BSofSciVsMwpc0OnlineSpectra::Exec(Option_t* option)
 void R3BSofSciVsMwpc0OnlineSpectra::Reset() {}
 
 // -----   Public method Finish   -----------------------------------------------
-void R3BSofSciVsMwpc0OnlineSpectra::FinishEvent()
-{
-    if (fSTcalSci)
-    {
-        fSTcalSci->Clear();
-    }
-    if (fCalSci)
-    {
-        fCalSci->Clear();
-    }
-    if (fHitMwpc0)
-    {
-        fHitMwpc0->Clear();
-    }
-}
+void R3BSofSciVsMwpc0OnlineSpectra::FinishEvent() {}
 
 void R3BSofSciVsMwpc0OnlineSpectra::FinishTask()
 {
@@ -312,25 +312,7 @@ void R3BSofSciVsPspxOnlineSpectra::Exec(Option_t* option)
 }
 
 // -----   Public method Finish   -----------------------------------------------
-void R3BSofSciVsPspxOnlineSpectra::FinishEvent()
-{
-    if (fSciSTcal)
-    {
-        fSciSTcal->Clear();
-    }
-    if (fSciCal)
-    {
-        fSciCal->Clear();
-    }
-    if (fPspxCal)
-    {
-        fPspxCal->Clear();
-    }
-    if (fPspxHit)
-    {
-        fPspxHit->Clear();
-    }
-}
+void R3BSofSciVsPspxOnlineSpectra::FinishEvent() {}
 
 void R3BSofSciVsPspxOnlineSpectra::FinishTask()
 {
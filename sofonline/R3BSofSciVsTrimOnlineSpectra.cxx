@@ -15,10 +15,9 @@
 #include "FairRunOnline.h"
 #include "FairRuntimeDb.h"
 #include "R3BEventHeader.h"
+#include "R3BSofEventSummaryData.h"
 #include "R3BSofSciCalData.h"
 #include "R3BSofSciSingleTcalData.h"
-#include "R3BSofTrimCalData.h"
-#include "R3BSofTrimHitData.h"
 #include "TCanvas.h"
 #include "TClonesArray.h"
 #include "TFolder.h"
@@ -44,6 +43,7 @@ R3BSofSciVsTrimOnlineSpectra::R3BSofSciVsTrimOnlineSpectra()
     , fSciCal(NULL)
     , fTrimCal(NULL)
     , fTrimHit(NULL)
+    , fSummary(NULL)
     , fNEvents(0)
     , fNbDetectors(2)
     , fNbChannels(3)
@@ -64,6 +64,7 @@ R3BSofSciVsTrimOnlineSpectra::R3BSofSciVsTrimOnlineSpectra(const char* name, Int
     , fSciCal(NULL)
     , fTrimCal(NULL)
     , fTrimHit(NULL)
+    , fSummary(NULL)
     , fNEvents(0)
     , fNbDetectors(2)
     , fNbChannels(3)
@@ -143,6 +144,16 @@ InitStatus R3BSofSciVsTrimOnlineSpectra::Init()
         LOG(warn) << "R3BSofSciVsTrimOnlineSpectra: TrimHitData not found";
     }
 
+    // --- ------------------------------- --- //
+    // --- get access to the event summary --- //
+    // --- ------------------------------- --- //
+    fSummary = (R3BSofEventSummaryData*)mgr->GetObject("SofEventSummary");
+    if (!fSummary)
+    {
+        LOG(error) << "R3BSofSciVsTrimOnlineSpectra::Init SofEventSummary not found";
+        return kFATAL;
+    }
+
     // --- ------------------------------- --- //
     // --- Create histograms for detectors --- //
     // --- ------------------------------- --- //
@@ -396,44 +407,17 @@ void R3BSofSciVsTrimOnlineSpectra::Exec(Option_t* option)
     Double_t DT[3];
     Float_t E[3];
     Float_t Z[3];
+
+    // --- ----------------------------------------- --- //
+    // --- TRIPLE-MUSIC Cal and Hit data, per section --- //
+    // --- ----------------------------------------- --- //
     for (int section = 0; section < 3; section++)
     {
-        Eraw[section] = -1.;
-        E[section] = -1.;
-        DT[section] = -1000000.;
-    }
-
-    // --- --------------------- --- //
-    // --- TRIPLE-MUSIC Cal data --- //
-    // --- --------------------- --- //
-    if (fTrimCal && fTrimCal->GetEntriesFast() > 0)
-    {
-        nHits = fTrimCal->GetEntriesFast();
-        for (Int_t ihit = 0; ihit < nHits; ihit++)
-        {
-            R3BSofTrimCalData* hit = (R3BSofTrimCalData*)fTrimCal->At(ihit);
-            if (!hit)
-                continue;
-            if (hit->GetAnodeID() == 3)
-                DT[hit->GetSecID() - 1] = hit->GetDriftTimeAligned();
-        }
-    }
-
-    // --- --------------------- --- //
-    // --- TRIPLE-MUSIC Hit data --- //
-    // --- --------------------- --- //
-    if (fTrimHit && fTrimHit->GetEntriesFast() > 0)
-    {
-        nHits = fTrimHit->GetEntriesFast();
-        for (Int_t ihit = 0; ihit < nHits; ihit++)
-        {
-            R3BSofTrimHitData* hit = (R3BSofTrimHitData*)fTrimHit->At(ihit);
-            if (!hit)
-                continue;
-            Eraw[hit->GetSecID() - 1] = hit->GetEnergyRaw();
-            E[hit->GetSecID() - 1] = hit->GetEnergyTheta();
-            Z[hit->GetSecID() - 1] = hit->GetZcharge();
-        }
+        const R3BSofEventSummaryData::Trim& trim = fSummary->GetTrim(section + 1);
+        Eraw[section] = trim.multHit ? trim.eraw : -1.;
+        E[section] = trim.multHit ? trim.etheta : -1.;
+        Z[section] = trim.z;
+        DT[section] = trim.multDT ? trim.dt : -1000000.;
     }
 
     // --- ---------------------- --- //
@@ -528,25 +512,7 @@ void R3BSofSciVsTrimOnlineSpectra::Exec(Option_t* option)
 void R3BSofSciVsTrimOnlineSpectra::Reset() { LOG(debug) << "Clearing TofWHitData Structure"; }
 
 // -----   Public method Finish   -----------------------------------------------
-void R3BSofSciVsTrimOnlineSpectra::FinishEvent()
-{
-    if (fSciSTcal)
-    {
-        fSciSTcal->Clear();
-    }
-    if (fSciCal)
-    {
-        fSciCal->Clear();
-    }
-    if (fTrimCal)
-    {
-        fTrimCal->Clear();
-    }
-    if (fTrimHit)
-    {
-        fTrimHit->Clear();
-    }
-}
+void R3BSofSciVsTrimOnlineSpectra::FinishEvent() {}
 
 void R3BSofSciVsTrimOnlineSpectra::FinishTask()
 {
@@ -21,6 +21,7 @@
 
 class TClonesArray;
 class R3BEventHeader;
+class R3BSofEventSummaryData;
 
 /**
  * This taks reads SCI data and plots online histograms
@@ -108,10 +109,11 @@ class R3BSofSciVsTrimOnlineSpectra : public FairTask
     Float_t GetEmax(Int_t rank) { return fEmax->GetAt(rank); }
 
   private:
-    TClonesArray* fSciSTcal; // Array with SofSci Tcal items.
-    TClonesArray* fSciCal;   // Array with SofSci Cal items.
-    TClonesArray* fTrimCal;  // Array with Trim Cal items.
-    TClonesArray* fTrimHit;  // Array with Trim Hit items.
+    TClonesArray* fSciSTcal;          // Array with SofSci Tcal items.
+    TClonesArray* fSciCal;            // Array with SofSci Cal items.
+    TClonesArray* fTrimCal;           // Array with Trim Cal items.
+    TClonesArray* fTrimHit;           // Array with Trim Hit items.
+    R3BSofEventSummaryData* fSummary; // Trim values per section.
 
     Int_t fNbDetectors;
     Int_t fNbChannels;
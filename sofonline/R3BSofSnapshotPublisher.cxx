@@ -0,0 +1,163 @@
+// --------------------------------------------------------------
+// -----              R3BSofSnapshotPublisher               -----
+// --------------------------------------------------------------
+
+#include "R3BSofSnapshotPublisher.h"
+
+#include "FairLogger.h"
+#include "TFolder.h"
+#include "TH1.h"
+#include "THttpServer.h"
+#include "TList.h"
+#include "TPad.h"
+#include "TROOT.h"
+
+#include <chrono>
+
+namespace
+{
+    // the requests are answered within this time
+    const Int_t kPollMs = 10;
+
+    // bins, contents and statistics of source, without the attachment to gDirectory of TH1::Copy.
+    // Only the sparse histograms of R3BSofHistoFiller change their (fixed) bins
+    void CopyContents(const TH1* source, TH1* copy)
+    {
+        const TAxis* x = source->GetXaxis();
+        const TAxis* y = source->GetYaxis();
+        const TAxis* cx = copy->GetXaxis();
+        const TAxis* cy = copy->GetYaxis();
+        if (!x->IsVariableBinSize() && (cx->GetNbins() != x->GetNbins() || cx->GetXmin() != x->GetXmin() ||
+                                        cx->GetXmax() != x->GetXmax() || cy->GetNbins() != y->GetNbins() ||
+                                        cy->GetXmin() != y->GetXmin() || cy->GetXmax() != y->GetXmax()))
+        {
+            if (source->GetDimension() == 2)
+                copy->SetBins(x->GetNbins(), x->GetXmin(), x->GetXmax(), y->GetNbins(), y->GetXmin(), y->GetXmax());
+            else
+                copy->SetBins(x->GetNbins(), x->GetXmin(), x->GetXmax());
+        }
+        copy->Reset("ICES");
+        copy->Add(source);
+    }
+} // namespace
+
+R3BSofSnapshotPublisher::R3BSofSnapshotPublisher(const char* engine)
+    : fServer(NULL)
+    , fRunning(kTRUE)
+{
+    // the event loop creates ROOT objects while the thread serialises the copies
+    ROOT::EnableThreadSafety();
+    fServer = new THttpServer(engine);
+    // no processing from gSystem->ProcessEvents() in the event loop
+    fServer->SetTimer(0, kTRUE);
+    fThread = std::thread(&R3BSofSnapshotPublisher::Run, this);
+    LOG(info) << "R3BSofSnapshotPublisher: copies of the online histograms served on " << engine;
+}
+
+R3BSofSnapshotPublisher::~R3BSofSnapshotPublisher()
+{
+    fRunning = kFALSE;
+    if (fThread.joinable())
+        fThread.join();
+    delete fServer;
+}
+
+void R3BSofSnapshotPublisher::Run()
+{
+    while (fRunning)
+    {
+        {
+            std::lock_guard<std::mutex> lock(fMutex);
+            fServer->ProcessRequests();
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(kPollMs));
+    }
+}
+
+Int_t R3BSofSnapshotPublisher::Add(TFolder* folder, Int_t group)
+{
+    if (group < 0 || group >= (Int_t)fGroups.size())
+    {
+        group = fGroups.size();
+        fGroups.emplace_back();
+        fGroups.back().front = 0;
+    }
+    Group& g = fGroups[group];
+    size_t first = g.snapshots.size();
+    AddFolder(folder, TString("/") + folder->GetName(), g);
+
+    // first copies, served from now on
+    std::lock_guard<std::mutex> lock(fMutex);
+    for (size_t i = first; i < g.snapshots.size(); i++)
+    {
+        Snapshot& s = g.snapshots[i];
+        CopyContents(s.source, s.copy[g.front].get());
+        fServer->Register(s.path, s.copy[g.front].get());
+    }
+    return group;
+}
+
+void R3BSofSnapshotPublisher::AddFolder(TFolder* folder, const TString& path, Group& group)
+{
+    TIter next(folder->GetListOfFolders());
+    while (TObject* obj = next())
+    {
+        if (obj->InheritsFrom(TFolder::Class()))
+            AddFolder((TFolder*)obj, path + "/" + obj->GetName(), group);
+        else if (obj->InheritsFrom(TPad::Class()))
+            AddPad(obj, path, group);
+    }
+}
+
+void R3BSofSnapshotPublisher::AddPad(TObject* pad, const TString& path, Group& group)
+{
+    TIter next(((TPad*)pad)->GetListOfPrimitives());
+    while (TObject* obj = next())
+    {
+        if (obj->InheritsFrom(TPad::Class()))
+        {
+            AddPad(obj, path, group);
+            continue;
+        }
+        if (!obj->InheritsFrom(TH1::Class()))
+            continue;
+        // a histogram drawn in several pads is served once
+        Bool_t known = kFALSE;
+        for (auto& s : group.snapshots)
+            known |= s.source == obj;
+        if (known)
+            continue;
+
+        Snapshot s;
+        s.source = (TH1*)obj;
+        s.path = path;
+        for (Int_t i = 0; i < 2; i++)
+        {
+            s.copy[i].reset((TH1*)obj->Clone());
+            s.copy[i]->SetDirectory(NULL);
+        }
+        group.snapshots.push_back(std::move(s));
+    }
+}
+
+void R3BSofSnapshotPublisher::Publish(Int_t group)
+{
+    if (group < 0 || group >= (Int_t)fGroups.size())
+        return;
+    Group& g = fGroups[group];
+    Int_t back = 1 - g.front;
+
+    // the back copies are not registered, the thread does not read them
+    for (auto& s : g.snapshots)
+        CopyContents(s.source, s.copy[back].get());
+
+    std::lock_guard<std::mutex> lock(fMutex);
+    for (auto& s : g.snapshots)
+    {
+        fServer->Unregister(s.copy[g.front].get());
+        fServer->Register(s.path, s.copy[back].get());
+    }
+    g.front = back;
+}
+
+ClassImp(R3BSofSnapshotPublisher)
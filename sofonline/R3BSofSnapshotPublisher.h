@@ -0,0 +1,76 @@
+// --------------------------------------------------------------
+// -----              R3BSofSnapshotPublisher               -----
+// -----    Second http server for the remote users: it       -----
+// -----    serves copies of the online histograms, updated   -----
+// -----    at the flushes of R3BSofHistoFiller, and answers  -----
+// -----    the requests from its own thread                  -----
+// --------------------------------------------------------------
+
+#ifndef R3BSofSnapshotPublisher_H
+#define R3BSofSnapshotPublisher_H
+
+#include "TObject.h"
+#include "TString.h"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class TFolder;
+class TH1;
+class THttpServer;
+
+/**
+ * The histograms drawn in the canvases of a folder of an online task are copied twice: the front copies are
+ * registered with the server of the publisher, the back copies are updated from the histograms at each flush
+ * of the filler of the task, in the event loop, then both are swapped under a lock. The requests are processed
+ * by the thread of the publisher, with the same lock, so that the event loop never waits for a serialisation
+ * and a request never sees a copy being updated.
+ * The histograms are served without their canvases, the server of FairRunOnline is not changed.
+ */
+class R3BSofSnapshotPublisher : public TObject
+{
+  public:
+    /** Standard constructor, engine as for THttpServer, e.g. "http:8889" **/
+    R3BSofSnapshotPublisher(const char* engine = "http:8889");
+
+    /** Destructor, stops the thread and the server **/
+    virtual ~R3BSofSnapshotPublisher();
+
+    /** Adds copies of the histograms of the canvases of folder and of its subfolders, served in the same
+     *  folders. Returns the group of the copies, a new one if group < 0 **/
+    Int_t Add(TFolder* folder, Int_t group = -1);
+
+    /** Updates the back copies of the group from their histograms and swaps them with the served ones **/
+    void Publish(Int_t group);
+
+  private:
+    struct Snapshot
+    {
+        TH1* source;
+        TString path;
+        std::unique_ptr<TH1> copy[2];
+    };
+    struct Group
+    {
+        Int_t front;
+        std::vector<Snapshot> snapshots;
+    };
+
+    void AddFolder(TFolder* folder, const TString& path, Group& group);
+    void AddPad(TObject* pad, const TString& path, Group& group);
+    void Run();
+
+    THttpServer* fServer;         //!
+    std::vector<Group> fGroups;   //!
+    std::mutex fMutex;            //!
+    std::atomic<Bool_t> fRunning; //!
+    std::thread fThread;          //!
+
+  public:
+    ClassDef(R3BSofSnapshotPublisher, 1)
+};
+
+#endif
@@ -0,0 +1,132 @@
+// --------------------------------------------------------------
+// -----                 R3BSofSparseHisto                  -----
+// --------------------------------------------------------------
+
+#include "R3BSofSparseHisto.h"
+
+#include "TH1.h"
+
+R3BSofSparseHisto::R3BSofSparseHisto(Int_t nx, Double_t xmin, Double_t xmax, Int_t ny, Double_t ymin, Double_t ymax)
+    : fNx(nx)
+    , fNy(ny)
+    , fXmin(xmin)
+    , fXmax(xmax)
+    , fYmin(ymin)
+    , fYmax(ymax)
+    , fBlocks(((nx + 2) * (ny ? ny + 2 : 1) + kBlockSize - 1) / kBlockSize)
+{
+    Reset();
+}
+
+void R3BSofSparseHisto::Reset()
+{
+    for (auto& block : fBlocks)
+        std::vector<Double_t>().swap(block);
+    fEntries = 0.;
+    fModified = kTRUE;
+}
+
+size_t R3BSofSparseHisto::GetSize() const
+{
+    size_t size = fBlocks.size() * sizeof(std::vector<Double_t>);
+    for (const auto& block : fBlocks)
+        size += block.capacity() * sizeof(Double_t);
+    return size;
+}
+
+namespace
+{
+    // first and last bins of p[1..n] once the tails of the contents are left out, all for no contents
+    void Quantiles(const std::vector<Double_t>& p, Int_t n, Double_t tail, Int_t& first, Int_t& last)
+    {
+        Double_t total = 0.;
+        for (Int_t i = 1; i <= n; i++)
+            total += p[i];
+        first = 1;
+        last = n;
+        if (total <= 0.)
+            return;
+        Double_t cut = tail * total, sum = 0.;
+        while (first < n && (sum += p[first]) <= cut)
+            first++;
+        sum = 0.;
+        while (last > first && (sum += p[last]) <= cut)
+            last--;
+    }
+} // namespace
+
+void R3BSofSparseHisto::Range(Int_t& xfirst, Int_t& xlast, Int_t& yfirst, Int_t& ylast) const
+{
+    std::vector<Double_t> px(fNx + 2, 0.), py(fNy + 2, 0.);
+    for (size_t b = 0; b < fBlocks.size(); b++)
+    {
+        const std::vector<Double_t>& block = fBlocks[b];
+        for (Int_t k = 0; k < (Int_t)block.size(); k++)
+        {
+            if (block[k] <= 0.)
+                continue;
+            Int_t bin = (b << kBlockBits) + k;
+            Int_t ix = bin % (fNx + 2);
+            Int_t iy = bin / (fNx + 2);
+            if (ix < 1 || ix > fNx || (fNy && (iy < 1 || iy > fNy)))
+                continue;
+            px[ix] += block[k];
+            py[iy] += block[k];
+        }
+    }
+    Quantiles(px, fNx, kTail, xfirst, xlast);
+    if (fNy)
+        Quantiles(py, fNy, kTail, yfirst, ylast);
+}
+
+void R3BSofSparseHisto::Export(TH1* h, Int_t maxBinsX, Int_t maxBinsY, Bool_t full)
+{
+    // occupied region, the full range for an empty histogram, grouped in at most maxBins bins
+    Int_t xfirst = 1, xlast = fNx, yfirst = 1, ylast = fNy;
+    if (!full)
+        Range(xfirst, xlast, yfirst, ylast);
+    Int_t gx = full ? 1 : (xlast - xfirst + maxBinsX) / maxBinsX;
+    Int_t nx = (xlast - xfirst + gx) / gx;
+    Double_t wx = (fXmax - fXmin) / fNx;
+    Double_t xlo = fXmin + (xfirst - 1) * wx;
+
+    Int_t gy = 1, ny = 0;
+    if (fNy)
+    {
+        gy = full ? 1 : (ylast - yfirst + maxBinsY) / maxBinsY;
+        ny = (ylast - yfirst + gy) / gy;
+        Double_t wy = (fYmax - fYmin) / fNy;
+        Double_t ylo = fYmin + (yfirst - 1) * wy;
+        h->SetBins(nx, xlo, xlo + nx * gx * wx, ny, ylo, ylo + ny * gy * wy);
+    }
+    else
+        h->SetBins(nx, xlo, xlo + nx * gx * wx);
+    // SetBins keeps the bin array, with the contents of the previous export, if its size does not change
+    h->Reset("ICES");
+
+    for (size_t b = 0; b < fBlocks.size(); b++)
+    {
+        const std::vector<Double_t>& block = fBlocks[b];
+        for (Int_t k = 0; k < (Int_t)block.size(); k++)
+        {
+            if (block[k] == 0.)
+                continue;
+            Int_t bin = (b << kBlockBits) + k;
+            Int_t ix = bin % (fNx + 2);
+            Int_t dx = ix < xfirst ? 0 : (ix > xlast ? nx + 1 : 1 + (ix - xfirst) / gx);
+            Int_t dy = 0;
+            if (fNy)
+            {
+                Int_t iy = bin / (fNx + 2);
+                dy = iy < yfirst ? 0 : (iy > ylast ? ny + 1 : 1 + (iy - yfirst) / gy);
+            }
+            h->AddBinContent(dx + (nx + 2) * dy, block[k]);
+        }
+    }
+    // errors from the bin contents
+    if (h->GetSumw2N() > 0)
+        h->Sumw2(kFALSE);
+    h->ResetStats();
+    h->SetEntries(fEntries);
+    fModified = kFALSE;
+}
@@ -0,0 +1,80 @@
+// --------------------------------------------------------------
+// -----                 R3BSofSparseHisto                  -----
+// -----    Sparse storage of a histogram with a very large   -----
+// -----    number of fixed bins: blocks of bins allocated    -----
+// -----    at their first fill. It is exported as a TH1/TH2  -----
+// -----    zoomed on the occupied region (quantiles), with   -----
+// -----    at most N bins per axis, or with its full binning -----
+// --------------------------------------------------------------
+
+#ifndef R3BSofSparseHisto_H
+#define R3BSofSparseHisto_H
+
+#include "Rtypes.h"
+
+#include <cstddef>
+#include <vector>
+
+class TH1;
+
+class R3BSofSparseHisto
+{
+  public:
+    /** Standard constructor, same binning as TH1 (ny = 0) or TH2 **/
+    R3BSofSparseHisto(Int_t nx, Double_t xmin, Double_t xmax, Int_t ny = 0, Double_t ymin = 0., Double_t ymax = 1.);
+
+    /** Destructor **/
+    virtual ~R3BSofSparseHisto() {}
+
+    inline void Fill(Double_t x, Double_t y, Double_t w)
+    {
+        Int_t ix = Bin(x, fNx, fXmin, fXmax);
+        Int_t iy = fNy ? Bin(y, fNy, fYmin, fYmax) : 0;
+        Int_t bin = ix + (fNx + 2) * iy;
+        std::vector<Double_t>& block = fBlocks[bin >> kBlockBits];
+        if (block.empty())
+            block.resize(kBlockSize, 0.);
+        block[bin & (kBlockSize - 1)] += w;
+        fEntries++;
+        fModified = kTRUE;
+    }
+
+    void Reset();
+
+    /** Sets the bins of h to the occupied region, at most maxBinsX (maxBinsY) bins, and fills them.
+     *  The occupied region leaves out kTail of the contents on each side, so that a few outliers do not
+     *  widen it, they go to the under- and overflows. With full, h gets the original binning **/
+    void Export(TH1* h, Int_t maxBinsX, Int_t maxBinsY, Bool_t full = kFALSE);
+
+    inline Bool_t IsModified() const { return fModified; }
+    inline Double_t GetEntries() const { return fEntries; }
+    // Memory used by the bins, in bytes
+    size_t GetSize() const;
+
+  private:
+    static const Int_t kBlockBits = 10;
+    static const Int_t kBlockSize = 1 << kBlockBits;
+    static constexpr Double_t kTail = 1.e-3;
+
+    // same as TAxis::FindBin for fixed bins, NaN in the overflow
+    inline Int_t Bin(Double_t v, Int_t n, Double_t vmin, Double_t vmax) const
+    {
+        if (v < vmin)
+            return 0;
+        if (!(v < vmax))
+            return n + 1;
+        return 1 + (Int_t)(n * (v - vmin) / (vmax - vmin));
+    }
+
+    // occupied region of the bins inside the axes, from the projections
+    void Range(Int_t& xfirst, Int_t& xlast, Int_t& yfirst, Int_t& ylast) const;
+
+    Int_t fNx, fNy; // fNy = 0 for a TH1
+    Double_t fXmin, fXmax;
+    Double_t fYmin, fYmax;
+    Double_t fEntries;
+    Bool_t fModified;
+    std::vector<std::vector<Double_t>> fBlocks; // bins numbered as TH1::GetBin
+};
+
+#endif
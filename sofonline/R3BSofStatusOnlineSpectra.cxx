@@ -21,6 +21,7 @@
 #include "R3BMwpcMappedData.h"
 #include "R3BSofTofWMappedData.h"
 #include "R3BSofTrimMappedData.h"
+#include "R3BSofWRCorrelation.h"
 #include "R3BTwimMappedData.h"
 #include "R3BWRData.h"
 #include "TCanvas.h"
@@ -35,6 +36,7 @@
 #include "TRandom.h"
 #include "TVector3.h"
 
+#include <algorithm>
 #include <array>
 #include <cstdlib>
 #include <ctime>
@@ -64,6 +66,9 @@ R3BSofStatusOnlineSpectra::R3BSofStatusOnlineSpectra()
     , fMwpc2MappedDataCA(NULL)
     , fMwpc3MappedDataCA(NULL)
     , fTofWMappedDataCA(NULL)
+    , fNWREvents(0)
+    , fNMisbuilt(0)
+    , fWRCorrelation(new R3BSofWRCorrelation())
 {
 }
 
@@ -87,6 +92,9 @@ R3BSofStatusOnlineSpectra::R3BSofStatusOnlineSpectra(const TString& name, Int_t
     , fMwpc2MappedDataCA(NULL)
     , fMwpc3MappedDataCA(NULL)
     , fTofWMappedDataCA(NULL)
+    , fNWREvents(0)
+    , fNMisbuilt(0)
+    , fWRCorrelation(new R3BSofWRCorrelation())
 {
 }
 
@@ -125,6 +133,8 @@ R3BSofStatusOnlineSpectra::~R3BSofStatusOnlineSpectra()
         delete fMwpc3MappedDataCA;
     if (fTofWMappedDataCA)
         delete fTofWMappedDataCA;
+    if (fWRCorrelation)
+        delete fWRCorrelation;
 }
 
 InitStatus R3BSofStatusOnlineSpectra::Init()
@@ -247,6 +257,15 @@ InitStatus R3BSofStatusOnlineSpectra::Init()
         return kFATAL;
     }
 
+    // WR timestamps of the other subsystems, compared with SOFIA
+    fWRCorrelation->AddStream("Master", fWRItemsMaster);
+    fWRCorrelation->AddStream("Califa_Messel", fWRItemsCalifa, 0);
+    fWRCorrelation->AddStream("Califa_Wixhausen", fWRItemsCalifa, 1);
+    fWRCorrelation->AddStream("Neuland", fWRItemsNeuland);
+    fWRCorrelation->AddStream("S2", fWRItemsS2);
+    fWRCorrelation->AddStream("S8", fWRItemsS8);
+    fWRCorrelation->AddStream("Ams", fWRItemsAms);
+
     for (int i = 0; i < 16; i++)
         fCounterTpats[i] = 0;
 
@@ -293,101 +312,45 @@ InitStatus R3BSofStatusOnlineSpectra::Init()
     fh1_wr[1]->SetLineWidth(2);
     fh1_wr[1]->Draw("same");
 
-    // Difference between Califa-Sofia WRs
-    stack_wrs = new THStack("stack_wrs", "WR-Sofia - WR-Other");
+    // Correlation of the SOFIA WR with the other WRs, one bin per subsystem
     sprintf(Name1, "WRs_Sofia_vs_others");
-    cWrs = new TCanvas(Name1, Name1, 10, 10, 500, 500);
-    sprintf(Name2, "fh1_WR_Sofia_Wixhausen");
-    sprintf(Name3, "WR-Sofia - WR-Other"); // Messel (blue), Wixhausen (red)
-    fh1_wrs[0] = new TH1F(Name2, Name3, 1200, -4100, 4100);
-    fh1_wrs[0]->GetXaxis()->SetTitle("WRs difference");
-    fh1_wrs[0]->GetYaxis()->SetTitle("Counts");
-    fh1_wrs[0]->GetYaxis()->SetTitleOffset(1.3);
-    fh1_wrs[0]->GetXaxis()->CenterTitle(true);
-    fh1_wrs[0]->GetYaxis()->CenterTitle(true);
-    fh1_wrs[0]->SetLineColor(2);
-    fh1_wrs[0]->SetLineWidth(3);
+    cWrs = new TCanvas(Name1, Name1, 10, 10, 500, 900);
+    cWrs->Divide(1, 3);
+    const Int_t nStreams = fWRCorrelation->GetNumStreams();
+    fh1_wrs_offset =
+        new TH1F("fh1_WR_Sofia_offset", "WR-Sofia - WR-Other: offset and sigma", nStreams, 0.5, nStreams + 0.5);
+    fh1_wrs_offset->GetYaxis()->SetTitle("Offset [ns]");
+    fh1_wrs_drift = new TH1F("fh1_WR_Sofia_drift", "WR-Sofia - WR-Other: drift", nStreams, 0.5, nStreams + 0.5);
+    fh1_wrs_drift->GetYaxis()->SetTitle("Drift [ns/s]");
+    fh1_wrs_misbuilt = new TH1F(
+        "fh1_WR_Sofia_misbuilt", "Fraction of mis-built (red) and missing (blue) WRs", nStreams, 0.5, nStreams + 0.5);
+    fh1_wrs_misbuilt->GetYaxis()->SetTitle("Fraction of the events with WR-Sofia");
+    fh1_wrs_misbuilt->SetLineColor(2);
+    fh1_wrs_misbuilt->SetLineWidth(3);
+    fh1_wrs_missing = new TH1F("fh1_WR_Sofia_missing", "", nStreams, 0.5, nStreams + 0.5);
+    fh1_wrs_missing->SetLineColor(4);
+    fh1_wrs_missing->SetLineWidth(3);
+    TH1F* metrics[4] = { fh1_wrs_offset, fh1_wrs_drift, fh1_wrs_misbuilt, fh1_wrs_missing };
+    for (Int_t h = 0; h < 4; h++)
+    {
+        for (Int_t i = 0; i < nStreams; i++)
+            metrics[h]->GetXaxis()->SetBinLabel(i + 1, fWRCorrelation->GetName(i));
+        metrics[h]->GetXaxis()->CenterTitle(true);
+        metrics[h]->GetYaxis()->CenterTitle(true);
+        metrics[h]->SetStats(0);
+    }
+    cWrs->cd(1);
+    gPad->SetGridy(1);
+    fh1_wrs_offset->SetMarkerStyle(20);
+    fh1_wrs_offset->Draw("E1");
+    cWrs->cd(2);
+    gPad->SetGridy(1);
+    fh1_wrs_drift->SetMarkerStyle(20);
+    fh1_wrs_drift->Draw("P");
+    cWrs->cd(3);
     gPad->SetLogy(1);
-    stack_wrs->Add(fh1_wrs[0]); //->Draw("");
-    fh1_wrs[1] = new TH1F("fh1_WR_Sofia_Califa_Messel", "", 1200, -4100, 4100);
-    fh1_wrs[1]->SetLineColor(4);
-    fh1_wrs[1]->SetLineWidth(3);
-    if (fWRItemsCalifa)
-        stack_wrs->Add(fh1_wrs[1]); //->Draw("same");
-    fh1_wrs[2] = new TH1F("fh1_WR_Sofia_Neuland", "", 1200, -4100, 4100);
-    fh1_wrs[2]->SetLineColor(3);
-    fh1_wrs[2]->SetLineWidth(3);
-    if (fWRItemsNeuland)
-        stack_wrs->Add(fh1_wrs[2]); //->Draw("same");
-    fh1_wrs[3] = new TH1F("fh1_WR_Sofia_S2", "", 1200, -4100, 4100);
-    fh1_wrs[3]->SetLineColor(1);
-    fh1_wrs[3]->SetLineWidth(3);
-    if (fWRItemsS2)
-        stack_wrs->Add(fh1_wrs[3]); //->Draw("same");
-    fh1_wrs[4] = new TH1F("fh1_WR_Sofia_S8", "", 1200, -4100, 4100);
-    fh1_wrs[4]->SetLineColor(5);
-    fh1_wrs[4]->SetLineWidth(3);
-    if (fWRItemsS8)
-        stack_wrs->Add(fh1_wrs[4]); //->Draw("same");
-    fh1_wrs[5] = new TH1F("fh1_WR_Sofia_Ams", "", 1200, -4100, 4100);
-    fh1_wrs[5]->SetLineColor(7);
-    fh1_wrs[5]->SetLineWidth(3);
-    if (fWRItemsAms)
-        stack_wrs->Add(fh1_wrs[5]); //->Draw("same");
-    stack_wrs->Draw("nostack");
-
-    TLegend* leg = new TLegend(0.05, 0.9, 0.39, 0.9999, NULL, "brNDC");
-    leg->SetBorderSize(0);
-    leg->SetTextFont(62);
-    leg->SetTextSize(0.03);
-    leg->SetLineColor(1);
-    leg->SetLineStyle(1);
-    leg->SetLineWidth(1);
-    leg->SetFillColor(0);
-    leg->SetFillStyle(0);
-    TLegendEntry* entry = leg->AddEntry("null", "Califa_Wixhausen", "l");
-    entry->SetLineColor(4);
-    entry->SetLineStyle(1);
-    entry->SetLineWidth(3);
-    entry->SetTextFont(62);
-    entry = leg->AddEntry("null", "Califa_Messel", "l");
-    entry->SetLineColor(2);
-    entry->SetLineStyle(1);
-    entry->SetLineWidth(3);
-    entry->SetTextFont(62);
-    if (fWRItemsNeuland)
-    {
-        entry = leg->AddEntry("null", "Neuland", "l");
-        entry->SetLineColor(3);
-        entry->SetLineStyle(1);
-        entry->SetLineWidth(3);
-        entry->SetTextFont(62);
-    }
-    if (fWRItemsS2)
-    {
-        entry = leg->AddEntry("null", "S2", "l");
-        entry->SetLineColor(1);
-        entry->SetLineStyle(1);
-        entry->SetLineWidth(3);
-        entry->SetTextFont(62);
-    }
-    if (fWRItemsS8)
-    {
-        entry = leg->AddEntry("null", "S8", "l");
-        entry->SetLineColor(5);
-        entry->SetLineStyle(1);
-        entry->SetLineWidth(3);
-        entry->SetTextFont(62);
-    }
-    if (fWRItemsAms)
-    {
-        entry = leg->AddEntry("null", "AMS", "l");
-        entry->SetLineColor(7);
-        entry->SetLineStyle(1);
-        entry->SetLineWidth(3);
-        entry->SetTextFont(62);
-    }
-    leg->Draw();
+    fh1_wrs_misbuilt->Draw("HIST");
+    fh1_wrs_missing->Draw("HIST same");
 
     sprintf(Name1, "Detector_Status");
     cDetGeneralView = new TCanvas(Name1, Name1, 10, 10, 800, 700);
@@ -467,7 +430,7 @@ InitStatus R3BSofStatusOnlineSpectra::Init()
     mainfolsof->Add(cTotNbTrig);
     if (fWRItemsMaster && fWRItemsSofia)
         mainfolsof->Add(cWr);
-    if (fWRItemsSofia && fWRItemsCalifa)
+    if (fWRItemsSofia)
         mainfolsof->Add(cWrs);
     run->AddObject(mainfolsof);
 
@@ -487,18 +450,31 @@ void R3BSofStatusOnlineSpectra::Reset_GENERAL_Histo()
         fh1_wr[0]->Reset();
         fh1_wr[1]->Reset();
     }
-    if (fWRItemsCalifa && fWRItemsSofia)
+    fWRCorrelation->Reset();
+    fNWREvents = 0;
+    fNMisbuilt = 0;
+    UpdateWRMetrics();
+}
+
+void R3BSofStatusOnlineSpectra::UpdateWRMetrics()
+{
+    for (Int_t i = 0; i < fWRCorrelation->GetNumStreams(); i++)
     {
-        fh1_wrs[0]->Reset();
-        fh1_wrs[1]->Reset();
-        if (fWRItemsNeuland)
-            fh1_wrs[2]->Reset();
-        if (fWRItemsS2)
-            fh1_wrs[3]->Reset();
-        if (fWRItemsS8)
-            fh1_wrs[4]->Reset();
-        if (fWRItemsAms)
-            fh1_wrs[5]->Reset();
+        if (fWRCorrelation->IsLocked(i))
+        {
+            fh1_wrs_offset->SetBinContent(i + 1, fWRCorrelation->GetOffset(i));
+            fh1_wrs_offset->SetBinError(i + 1, fWRCorrelation->GetSigma(i));
+            fh1_wrs_drift->SetBinContent(i + 1, fWRCorrelation->GetDrift(i));
+        }
+        else
+        {
+            fh1_wrs_offset->SetBinContent(i + 1, 0.);
+            fh1_wrs_offset->SetBinError(i + 1, 0.);
+            fh1_wrs_drift->SetBinContent(i + 1, 0.);
+        }
+        Double_t nEvents = fWRCorrelation->GetNumEvents(i);
+        fh1_wrs_misbuilt->SetBinContent(i + 1, nEvents > 0 ? fWRCorrelation->GetNumOutliers(i) / nEvents : 0.);
+        fh1_wrs_missing->SetBinContent(i + 1, nEvents > 0 ? fWRCorrelation->GetNumMissing(i) / nEvents : 0.);
     }
 }
 
@@ -539,86 +515,21 @@ void R3BSofStatusOnlineSpectra::Exec(Option_t* option)
     // WR data
     if (fWRItemsSofia && fWRItemsSofia->GetEntriesFast() > 0)
     {
-        // SOFIA
-        Int_t nHits = fWRItemsSofia->GetEntriesFast();
-        int64_t wrs[2];
-        for (Int_t ihit = 0; ihit < nHits; ihit++)
+        // SOFIA: first item WRSE, second item WRME
+        fNWREvents++;
+        if (fWRCorrelation->Process(fWRItemsSofia))
         {
-            R3BWRData* hit = (R3BWRData*)fWRItemsSofia->At(ihit);
-            if (!hit)
-                continue;
-            wrs[ihit] = hit->GetTimeStamp();
+            fNMisbuilt++;
+            LOG(debug) << "R3BSofStatusOnlineSpectra::Exec Mis-built event, WR-Sofia "
+                       << ((R3BWRData*)fWRItemsSofia->At(0))->GetTimeStamp();
         }
+        if (fNWREvents % 1000 == 0)
+            UpdateWRMetrics();
 
-        // Califa
-        if (fWRItemsCalifa && fWRItemsCalifa->GetEntriesFast() > 0)
-        {
-            nHits = fWRItemsCalifa->GetEntriesFast();
-            int64_t wr[nHits];
-            for (Int_t ihit = 0; ihit < nHits; ihit++)
-            {
-                R3BWRData* hit = (R3BWRData*)fWRItemsCalifa->At(ihit);
-                if (!hit)
-                    continue;
-                wr[ihit] = hit->GetTimeStamp();
-            }
-            fh1_wrs[0]->Fill(wrs[0] - wr[0]); // messel
-            fh1_wrs[1]->Fill(wrs[0] - wr[1]); // wixhausen
-        }
-        // Neuland
-        if (fWRItemsNeuland && fWRItemsNeuland->GetEntriesFast() > 0)
-        {
-            nHits = fWRItemsNeuland->GetEntriesFast();
-            for (Int_t ihit = 0; ihit < nHits; ihit++)
-            {
-                R3BWRData* hit = (R3BWRData*)fWRItemsNeuland->At(ihit);
-                if (!hit)
-                    continue;
-                fh1_wrs[2]->Fill(int64_t(wrs[0] - hit->GetTimeStamp()));
-            }
-            // fh1_wrs[4]->GetMaximum();
-            fh1_wrs[0]->SetMaximum(5. * fh1_wrs[2]->GetBinContent(fh1_wrs[2]->GetMaximumBin()));
-        }
-        // S2
-        if (fWRItemsS2 && fWRItemsS2->GetEntriesFast() > 0)
-        {
-            nHits = fWRItemsS2->GetEntriesFast();
-            for (Int_t ihit = 0; ihit < nHits; ihit++)
-            {
-                R3BWRData* hit = (R3BWRData*)fWRItemsS2->At(ihit);
-                if (!hit)
-                    continue;
-                fh1_wrs[3]->Fill(int64_t(wrs[0] - hit->GetTimeStamp()));
-            }
-        }
-        // S8
-        if (fWRItemsS8 && fWRItemsS8->GetEntriesFast() > 0)
-        {
-            nHits = fWRItemsS8->GetEntriesFast();
-            for (Int_t ihit = 0; ihit < nHits; ihit++)
-            {
-                R3BWRData* hit = (R3BWRData*)fWRItemsS8->At(ihit);
-                if (!hit)
-                    continue;
-                fh1_wrs[4]->Fill(int64_t(wrs[0] - hit->GetTimeStamp()));
-            }
-        }
-        // AMS
-        if (fWRItemsAms && fWRItemsAms->GetEntriesFast() > 0)
-        {
-            nHits = fWRItemsAms->GetEntriesFast();
-            for (Int_t ihit = 0; ihit < nHits; ihit++)
-            {
-                R3BWRData* hit = (R3BWRData*)fWRItemsAms->At(ihit);
-                if (!hit)
-                    continue;
-                fh1_wrs[5]->Fill(int64_t(wrs[0] - hit->GetTimeStamp()));
-            }
-        }
         // Master
         if (fWRItemsMaster && fWRItemsMaster->GetEntriesFast() > 0)
         {
-            nHits = fWRItemsMaster->GetEntriesFast();
+            Int_t nHits = fWRItemsMaster->GetEntriesFast();
             int64_t wrm = 0.;
             for (Int_t ihit = 0; ihit < nHits; ihit++)
             {
@@ -627,8 +538,11 @@ void R3BSofStatusOnlineSpectra::Exec(Option_t* option)
                     continue;
                 wrm = hit->GetTimeStamp();
             }
-            fh1_wr[0]->Fill(wrm - wrs[0]);
-            fh1_wr[1]->Fill(wrm - wrs[1]);
+            for (Int_t ihit = 0; ihit < std::min(fWRItemsSofia->GetEntriesFast(), 2); ihit++)
+            {
+                R3BWRData* hit = (R3BWRData*)fWRItemsSofia->At(ihit);
+                fh1_wr[ihit]->Fill(int64_t(wrm - hit->GetTimeStamp()));
+            }
         }
     }
 
@@ -865,36 +779,7 @@ void R3BSofStatusOnlineSpectra::Exec(Option_t* option)
     }
 }
 
-void R3BSofStatusOnlineSpectra::FinishEvent()
-{
-
-    LOG(debug) << "Clearing Structure";
-
-    if (fWRItemsMaster)
-    {
-        fWRItemsMaster->Clear();
-    }
-    if (fWRItemsSofia)
-    {
-        fWRItemsSofia->Clear();
-    }
-    if (fWRItemsCalifa)
-    {
-        fWRItemsCalifa->Clear();
-    }
-    if (fWRItemsNeuland)
-    {
-        fWRItemsNeuland->Clear();
-    }
-    if (fWRItemsS2)
-    {
-        fWRItemsS2->Clear();
-    }
-    if (fWRItemsS8)
-    {
-        fWRItemsS8->Clear();
-    }
-}
+void R3BSofStatusOnlineSpectra::FinishEvent() {}
 
 void R3BSofStatusOnlineSpectra::FinishTask()
 {
@@ -905,7 +790,19 @@ void R3BSofStatusOnlineSpectra::FinishTask()
     if (fWRItemsMaster && fWRItemsSofia)
     {
         cWr->Write();
+    }
+    if (fWRItemsSofia)
+    {
+        UpdateWRMetrics();
         cWrs->Write();
+        LOG(info) << "R3BSofStatusOnlineSpectra::FinishTask " << fNMisbuilt << " mis-built events out of "
+                  << fNWREvents << " events with WR-Sofia";
+        for (Int_t i = 0; i < fWRCorrelation->GetNumStreams(); i++)
+            if (fWRCorrelation->GetNumEvents(i) > fWRCorrelation->GetNumMissing(i))
+                LOG(info) << "WR-Sofia - WR-" << fWRCorrelation->GetName(i) << ": offset "
+                          << fWRCorrelation->GetOffset(i) << " ns, sigma " << fWRCorrelation->GetSigma(i)
+                          << " ns, drift " << fWRCorrelation->GetDrift(i) << " ns/s, "
+                          << fWRCorrelation->GetNumOutliers(i) << " mis-built";
     }
 }
 
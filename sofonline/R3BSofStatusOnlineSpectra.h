@@ -24,6 +24,7 @@
 
 class TClonesArray;
 class R3BEventHeader;
+class R3BSofWRCorrelation;
 
 /**
  * This taks reads General SOFIA data and plots online histograms
@@ -85,6 +86,9 @@ class R3BSofStatusOnlineSpectra : public FairTask
      */
     virtual void Reset_GENERAL_Histo();
 
+    // Access to the WR correlation, to change its settings before Init
+    R3BSofWRCorrelation* GetWRCorrelation() { return fWRCorrelation; }
+
   private:
     TClonesArray* fWRItemsMaster;  /**< Array with WR-Master items. */
     TClonesArray* fWRItemsSofia;   /**< Array with WR-Sofia items. */
@@ -111,6 +115,9 @@ class R3BSofStatusOnlineSpectra : public FairTask
     Float_t fCounterTpats[16];
     Float_t fCounterRates[16];
     Float_t fCounterDet[10];
+    ULong64_t fNWREvents;                   /**< Events with SOFIA WR.    */
+    ULong64_t fNMisbuilt;                   /**< Mis-built events.        */
+    R3BSofWRCorrelation* fWRCorrelation; //! /**< WR(SOFIA) - WR(others). */
 
     // Canvas
     TCanvas *cTrigger, *cWr, *cWrs, *cTotNbTrig, *cDetGeneralView;
@@ -120,11 +127,12 @@ class R3BSofStatusOnlineSpectra : public FairTask
     // Unpack
     TH1F *fh1_trigger, *fh1_wr[2];
     TH1F* fh1_GeneralView;
-    TH1F* fh1_wrs[6];
-    THStack* stack_wrs;
+    TH1F *fh1_wrs_offset, *fh1_wrs_drift, *fh1_wrs_misbuilt, *fh1_wrs_missing;
     TH1F* fh1_display;
     TGraph* gh;
 
+    void UpdateWRMetrics();
+
   public:
     ClassDef(R3BSofStatusOnlineSpectra, 0)
 };
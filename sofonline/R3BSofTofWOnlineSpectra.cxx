@@ -15,13 +15,13 @@
 #include "FairRunOnline.h"
 #include "FairRuntimeDb.h"
 #include "R3BEventHeader.h"
+#include "R3BSofEventSummaryData.h"
+#include "R3BSofHistoFiller.h"
+#include "R3BSofSnapshotPublisher.h"
 #include "R3BMwpcCalData.h"
-#include "R3BSofSciSingleTcalData.h"
 #include "R3BSofTofWHitData.h"
 #include "R3BSofTofWMappedData.h"
 #include "R3BSofTofWSingleTcalData.h"
-#include "R3BSofTofWTcalData.h"
-#include "R3BTwimHitData.h"
 #include "TCanvas.h"
 #include "TClonesArray.h"
 #include "TFolder.h"
@@ -31,7 +31,6 @@
 #include "TLegend.h"
 #include "TLegendEntry.h"
 #include "TMath.h"
-#include "TRandom.h"
 #include "TVector3.h"
 
 #include <array>
@@ -50,10 +49,13 @@ R3BSofTofWOnlineSpectra::R3BSofTofWOnlineSpectra()
     , fSingleTcalItemsSci(NULL)
     , fHitItemsTwim(NULL)
     , fCalItemsMwpc(NULL)
+    , fSummary(NULL)
     , fTwimTofRangeMax(-65.)
     , fTwimTofRangeMin(-87.)
     , fIdSofSciCaveC(1)
     , fNEvents(0)
+    , fFiller(new R3BSofHistoFiller())
+    , fPublisher(NULL)
 {
 }
 
@@ -66,16 +68,21 @@ R3BSofTofWOnlineSpectra::R3BSofTofWOnlineSpectra(const char* name, Int_t iVerbos
     , fSingleTcalItemsSci(NULL)
     , fHitItemsTwim(NULL)
     , fCalItemsMwpc(NULL)
+    , fSummary(NULL)
     , fTwimTofRangeMax(-65.)
     , fTwimTofRangeMin(-87.)
     , fIdSofSciCaveC(1)
     , fNEvents(0)
+    , fFiller(new R3BSofHistoFiller())
+    , fPublisher(NULL)
 {
 }
 
 R3BSofTofWOnlineSpectra::~R3BSofTofWOnlineSpectra()
 {
     LOG(info) << "R3BSofTofWOnlineSpectra::Delete instance";
+    if (fFiller)
+        delete fFiller;
     if (fMappedItemsTofW)
         delete fMappedItemsTofW;
     if (fTcalItemsTofW)
@@ -163,6 +170,19 @@ InitStatus R3BSofTofWOnlineSpectra::Init()
     if (!fCalItemsMwpc)
         LOG(warn) << "R3BSofTofWOnlineSpectra: Mwpc3CalData not found";
 
+    // get access to the event summary: multiplicities and times per channel
+    fSummary = (R3BSofEventSummaryData*)mgr->GetObject("SofEventSummary");
+    if (!fSummary)
+    {
+        LOG(error) << "R3BSofTofWOnlineSpectra::Init SofEventSummary not found, R3BSofEventSummary to be added before";
+        return kFATAL;
+    }
+    if (fIdSofSciCaveC < 1 || fIdSofSciCaveC > R3BSofEventSummaryData::kSciDets)
+    {
+        LOG(error) << "R3BSofTofWOnlineSpectra::Init SofSci at Cave C " << fIdSofSciCaveC << " out of range";
+        return kFATAL;
+    }
+
     // --- ------------------------------- --- //
     // --- Create histograms for detectors --- //
     // --- ------------------------------- --- //
@@ -210,6 +230,7 @@ InitStatus R3BSofTofWOnlineSpectra::Init()
     {
         sprintf(Name1, "SofTofW%i_RawPosAtTcal_Mult1", i + 1);
         fh1_RawPos_AtTcalMult1[i] = new TH1F(Name1, Name1, 40000, -20, 20);
+        fFiller->AddSparse(fh1_RawPos_AtTcalMult1[i]);
         fh1_RawPos_AtTcalMult1[i]->GetXaxis()->SetTitle("Raw position [ns with one bin/ps]");
         fh1_RawPos_AtTcalMult1[i]->GetYaxis()->SetTitle("Counts per bin");
         fh1_RawPos_AtTcalMult1[i]->GetXaxis()->CenterTitle(true);
@@ -223,6 +244,7 @@ InitStatus R3BSofTofWOnlineSpectra::Init()
 
         sprintf(Name1, "SofTofW%i_RawPosAtSingleTcal", i + 1);
         fh1_RawPos_AtSingleTcal[i] = new TH1F(Name1, Name1, 40000, -20, 20);
+        fFiller->AddSparse(fh1_RawPos_AtSingleTcal[i]);
         fh1_RawPos_AtSingleTcal[i]->GetXaxis()->SetTitle("Raw position [ns with one bin/ps]");
         fh1_RawPos_AtSingleTcal[i]->GetYaxis()->SetTitle("Counts per bin");
         fh1_RawPos_AtSingleTcal[i]->GetXaxis()->CenterTitle(true);
@@ -267,6 +289,7 @@ InitStatus R3BSofTofWOnlineSpectra::Init()
         cTofWRawTof[i]->Divide(1, 2);
         sprintf(Name1, "SofTofW%i_RawTofAtTcal_Mult1", i + 1);
         fh1_RawTof_AtTcalMult1[i] = new TH1D(Name1, Name1, 100000, -1000, 1000);
+        fFiller->AddSparse(fh1_RawTof_AtTcalMult1[i]);
         fh1_RawTof_AtTcalMult1[i]->GetXaxis()->SetTitle("Raw time-of-flight [ns with one bin/ps]");
         fh1_RawTof_AtTcalMult1[i]->GetYaxis()->SetTitle("Counts per bin");
         fh1_RawTof_AtTcalMult1[i]->GetXaxis()->CenterTitle(true);
@@ -279,6 +302,7 @@ InitStatus R3BSofTofWOnlineSpectra::Init()
         fh1_RawTof_AtTcalMult1[i]->Draw("");
         sprintf(Name1, "SofTofW%i_RawTofAtSingleTcal", i + 1);
         fh1_RawTof_AtSingleTcal[i] = new TH1D(Name1, Name1, 100000, -1000, 1000);
+        fFiller->AddSparse(fh1_RawTof_AtSingleTcal[i]);
         fh1_RawTof_AtSingleTcal[i]->GetXaxis()->SetTitle("Raw time-of-flight [ns, 1ps/bin]");
         fh1_RawTof_AtSingleTcal[i]->GetYaxis()->SetTitle("Counts per bin");
         fh1_RawTof_AtSingleTcal[i]->GetXaxis()->CenterTitle(true);
@@ -299,6 +323,7 @@ InitStatus R3BSofTofWOnlineSpectra::Init()
         sprintf(Name1, "fh2_Twim_vs_ToF_Plastic_%i", i + 1);
         sprintf(Name2, "Twim vs ToF for plastic %i", i + 1);
         fh2_Twim_Tof[i] = new TH2F(Name1, Name2, 7000, fTwimTofRangeMin, fTwimTofRangeMax, 1000, 5, 95);
+        fFiller->AddSparse(fh2_Twim_Tof[i], 250, 250);
         fh2_Twim_Tof[i]->GetXaxis()->SetTitle("Raw time-of-flight [ns with one bin/ps]");
         fh2_Twim_Tof[i]->GetYaxis()->SetTitle("Charge Z");
         fh2_Twim_Tof[i]->GetXaxis()->CenterTitle(true);
@@ -317,6 +342,7 @@ InitStatus R3BSofTofWOnlineSpectra::Init()
     sprintf(Name1, "fh2_Mwpc3X_vs_ToF_Plastic");
     sprintf(Name2, "Mwpc3X vs ToF for plastic number");
     fh2_Mwpc3X_Tof = new TH2F(Name1, Name2, 28 * 8, 0.5, 28.5, 288 * 8, 0.5, 288.5);
+    fFiller->AddSparse(fh2_Mwpc3X_Tof, 250, 250);
     fh2_Mwpc3X_Tof->GetXaxis()->SetTitle("TofW-Plastic number [1-28]");
     fh2_Mwpc3X_Tof->GetYaxis()->SetTitle("MWPC3-X [pads]");
     fh2_Mwpc3X_Tof->GetXaxis()->CenterTitle(true);
@@ -433,15 +459,26 @@ InitStatus R3BSofTofWOnlineSpectra::Init()
 
     run->AddObject(mainfolTofW);
 
+    // copies served off the event loop
+    if (fPublisher)
+        fFiller->SetPublisher(fPublisher, fPublisher->Add(mainfolTofW));
+
     // Register command to reset histograms
     run->GetHttpServer()->RegisterCommand("Reset_SOFTOFW_HIST", Form("/Objects/%s/->Reset_Histo()", GetName()));
 
     return kSUCCESS;
 }
 
+void R3BSofTofWOnlineSpectra::SetUpdateRate(Int_t n, Double_t s)
+{
+    fFiller->SetFlushEvents(n);
+    fFiller->SetFlushSeconds(s);
+}
+
 void R3BSofTofWOnlineSpectra::Reset_Histo()
 {
     LOG(info) << "R3BSofTofWOnlineSpectra::Reset_Histo";
+    fFiller->Flush();
     for (Int_t j = 0; j < NbChs; j++)
     {
         // === MULT === //
@@ -457,19 +494,19 @@ void R3BSofTofWOnlineSpectra::Reset_Histo()
     for (Int_t i = 0; i < NbDets; i++)
     {
         // === RAW POSITION === //
-        fh1_RawPos_AtTcalMult1[i]->Reset();
-        fh1_RawPos_AtSingleTcal[i]->Reset();
+        fFiller->Reset(fh1_RawPos_AtTcalMult1[i]);
+        fFiller->Reset(fh1_RawPos_AtSingleTcal[i]);
         // === RAW TIME-OF-FLIGHT === //
-        fh1_RawTof_AtTcalMult1[i]->Reset();
-        fh1_RawTof_AtSingleTcal[i]->Reset();
+        fFiller->Reset(fh1_RawTof_AtTcalMult1[i]);
+        fFiller->Reset(fh1_RawTof_AtSingleTcal[i]);
     }
     for (UShort_t i = 0; i < NbDets; i++)
     {
-        fh2_Twim_Tof[i]->Reset();
+        fFiller->Reset(fh2_Twim_Tof[i]);
         fh2_Mwpc3Y_PosTof[i]->Reset();
     }
 
-    fh2_Mwpc3X_Tof->Reset();
+    fFiller->Reset(fh2_Mwpc3X_Tof);
 
     if (fHitItemsTofW)
     {
@@ -484,22 +521,11 @@ void R3BSofTofWOnlineSpectra::Exec(Option_t* option)
     if (NULL == mgr)
         LOG(fatal) << "R3BSofTofWOnlineSpectra::Exec FairRootManager not found";
 
+    fJitter.SetEvent(fNEvents);
+
     Int_t nHits;
     UShort_t iDet; // 0-bsed
     UShort_t iCh;  // 0-based
-    Double_t iRawTimeNs[NbDets * 2];
-    UShort_t mult[NbDets * NbChs];
-
-    // --- -------------- --- //
-    // --- initialisation --- //
-    // --- -------------- --- //
-    for (UShort_t i = 0; i < NbDets; i++)
-    {
-        for (UShort_t j = 0; j < NbChs; j++)
-        {
-            mult[i * NbChs + j] = 0;
-        }
-    }
 
     if (fSingleTcalItemsTofW && fSingleTcalItemsTofW->GetEntriesFast())
     {
@@ -510,8 +536,8 @@ void R3BSofTofWOnlineSpectra::Exec(Option_t* option)
         for (Int_t ihit = 0; ihit < nHits; ihit++)
         {
             R3BSofTofWSingleTcalData* hitST = (R3BSofTofWSingleTcalData*)fSingleTcalItemsTofW->At(ihit);
-            fh1_RawPos_AtSingleTcal[hitST->GetDetector() - 1]->Fill(hitST->GetRawPosNs());
-            fh1_RawTof_AtSingleTcal[hitST->GetDetector() - 1]->Fill(hitST->GetRawTofNs());
+            fFiller->Fill(fh1_RawPos_AtSingleTcal[hitST->GetDetector() - 1], hitST->GetRawPosNs());
+            fFiller->Fill(fh1_RawTof_AtSingleTcal[hitST->GetDetector() - 1], hitST->GetRawTofNs());
         } // end of loop over the singletcal data
     }
 
@@ -524,8 +550,8 @@ void R3BSofTofWOnlineSpectra::Exec(Option_t* option)
             R3BSofTofWHitData* hit = (R3BSofTofWHitData*)fHitItemsTofW->At(ihit);
             if (!hit)
                 continue;
-            fh2_Tof_hit->Fill(hit->GetPaddle() + gRandom->Uniform(-0.49, 0.49), hit->GetTof());
-            fh2_Pos_hit->Fill(hit->GetPaddle() + gRandom->Uniform(-0.49, 0.49), hit->GetY());
+            fFiller->Fill(fh2_Tof_hit, hit->GetPaddle() + fJitter.Uniform(-0.49, 0.49), hit->GetTof());
+            fFiller->Fill(fh2_Pos_hit, hit->GetPaddle() + fJitter.Uniform(-0.49, 0.49), hit->GetY());
         }
     }
 
@@ -543,57 +569,19 @@ void R3BSofTofWOnlineSpectra::Exec(Option_t* option)
                 continue;
             iDet = hitmapped->GetDetector() - 1;
             iCh = hitmapped->GetPmt() - 1;
-            mult[iDet * NbChs + iCh]++;
-            fh1_finetime[iDet * NbChs + iCh]->Fill(hitmapped->GetTimeFine());
-            fh1_EneRaw[iDet * NbChs + iCh]->Fill(hitmapped->GetEnergy());
+            fFiller->Fill(fh1_finetime[iDet * NbChs + iCh], hitmapped->GetTimeFine());
+            fFiller->Fill(fh1_EneRaw[iDet * NbChs + iCh], hitmapped->GetEnergy());
         }
 
-        // --- ------------------- --- //
-        // --- loop over tcal data --- //
-        // --- ------------------- --- //
-        nHits = fTcalItemsTofW->GetEntriesFast();
-        for (Int_t ihit = 0; ihit < nHits; ihit++)
-        {
-            R3BSofTofWTcalData* hittcal = (R3BSofTofWTcalData*)fTcalItemsTofW->At(ihit);
-            if (!hittcal)
-                continue;
-            if (hittcal->GetPmt() == 3)
-                continue;
-            iDet = hittcal->GetDetector() - 1;
-            iCh = hittcal->GetPmt() - 1;
-            iRawTimeNs[iDet * 2 + iCh] = hittcal->GetRawTimeNs();
-            ;
-        }
-
-        // --- ----------------------------------- --- //
-        // --- Get the Time at the Start detectors --- //
-        // --- ----------------------------------- --- //
+        // --- ------------------------------------------------------ --- //
+        // --- Time at the Start detector and Twim Z from the summary --- //
+        // --- ------------------------------------------------------ --- //
         Double_t TrawStart = -1000000.;
-        if (fSingleTcalItemsSci)
-        {
-            for (Int_t i = 0; i < fSingleTcalItemsSci->GetEntriesFast(); i++)
-            {
-                R3BSofSciSingleTcalData* hitsingletcalsci = (R3BSofSciSingleTcalData*)fSingleTcalItemsSci->At(i);
-                if (hitsingletcalsci && hitsingletcalsci->GetDetector() == fIdSofSciCaveC)
-                {
-                    TrawStart = hitsingletcalsci->GetRawTimeNs();
-                }
-            } // end of if mult=1 in the Start
-        }
-
-        // Get hit data Twim
+        if (fSingleTcalItemsSci && fSummary->GetSci(fIdSofSciCaveC).multSTcal > 0)
+            TrawStart = fSummary->GetSci(fIdSofSciCaveC).rawTime;
         Double_t twimZ = 0.;
-        if (fHitItemsTwim && fHitItemsTwim->GetEntriesFast() > 0)
-        {
-            nHits = fHitItemsTwim->GetEntriesFast();
-            for (Int_t ihit = 0; ihit < nHits; ihit++)
-            {
-                R3BTwimHitData* hit = (R3BTwimHitData*)fHitItemsTwim->At(ihit);
-                if (!hit)
-                    continue;
-                twimZ = hit->GetZcharge();
-            }
-        }
+        if (fHitItemsTwim && fSummary->GetTwimMultHit() > 0)
+            twimZ = fSummary->GetTwimZ();
 
         // Get cal data MWPC3
         Double_t mwpc3x = -1., qmax = -100.;
@@ -626,73 +614,50 @@ void R3BSofTofWOnlineSpectra::Exec(Option_t* option)
         Double_t tofpos = -1000;
         for (UShort_t i = 0; i < NbDets; i++)
         {
+            const R3BSofEventSummaryData::TofW& tofwi = fSummary->GetTofW(i + 1);
             for (UShort_t j = 0; j < NbChs; j++)
             {
-                fh2_mult[j]->Fill(i + 1, mult[i * NbChs + j]);
+                fFiller->Fill(fh2_mult[j], i + 1, tofwi.multMap[j]);
             }
-            if ((mult[i * NbChs] == 1) && (mult[i * NbChs + 1] == 1))
+            if ((tofwi.multMap[0] == 1) && (tofwi.multMap[1] == 1))
             {
                 // Y position is increasing from down to up: PosRaw = TrawDown - TrawUp
-                tofpos = (Double_t)(iRawTimeNs[i * NbChs] - iRawTimeNs[i * NbChs + 1]);
-                fh1_RawPos_AtTcalMult1[i]->Fill(tofpos);
+                tofpos = (Double_t)(tofwi.rawTimeNs[0] - tofwi.rawTimeNs[1]);
+                fFiller->Fill(fh1_RawPos_AtTcalMult1[i], tofpos);
                 if (mwpc3x > 0)
                 {
-                    fh2_Mwpc3X_Tof->Fill(i + 1 + gRandom->Uniform(-0.5, 0.5), mwpc3x + gRandom->Uniform(-0.5, 0.5));
+                    fFiller->Fill(fh2_Mwpc3X_Tof, i + 1 + fJitter.Uniform(-0.5, 0.5),
+                                  mwpc3x + fJitter.Uniform(-0.5, 0.5));
                 }
                 if (mwpc3y > 0)
                 {
-                    fh2_Mwpc3Y_PosTof[i]->Fill(tofpos, mwpc3y + gRandom->Uniform(-0.5, 0.5));
+                    fFiller->Fill(fh2_Mwpc3Y_PosTof[i], tofpos, mwpc3y + fJitter.Uniform(-0.5, 0.5));
                 }
                 if (TrawStart != -1000000.)
                 {
-                    tofw = (0.5 * (iRawTimeNs[i * 2 + 1] + iRawTimeNs[i * 2])) - TrawStart;
-                    fh1_RawTof_AtTcalMult1[i]->Fill(tofw);
+                    tofw = (0.5 * (tofwi.rawTimeNs[1] + tofwi.rawTimeNs[0])) - TrawStart;
+                    fFiller->Fill(fh1_RawTof_AtTcalMult1[i], tofw);
                     if (twimZ > 0)
                     {
-                        fh2_Twim_Tof[i]->Fill(tofw, twimZ);
+                        fFiller->Fill(fh2_Twim_Tof[i], tofw, twimZ);
                     }
                 }
             } // end of if mult=1 in the plastic
         }
     }
 
+    // the histograms are updated every N events or T seconds, this event included
+    fFiller->Tick();
+
     fNEvents += 1;
 }
 
-void R3BSofTofWOnlineSpectra::FinishEvent()
-{
-    if (fMappedItemsTofW)
-    {
-        fMappedItemsTofW->Clear();
-    }
-    if (fTcalItemsTofW)
-    {
-        fTcalItemsTofW->Clear();
-    }
-    if (fSingleTcalItemsTofW)
-    {
-        fSingleTcalItemsTofW->Clear();
-    }
-    if (fHitItemsTofW)
-    {
-        fHitItemsTofW->Clear();
-    }
-    if (fSingleTcalItemsSci)
-    {
-        fSingleTcalItemsSci->Clear();
-    }
-    if (fHitItemsTwim)
-    {
-        fHitItemsTwim->Clear();
-    }
-    if (fCalItemsMwpc)
-    {
-        fCalItemsMwpc->Clear();
-    }
-}
+void R3BSofTofWOnlineSpectra::FinishEvent() {}
 
 void R3BSofTofWOnlineSpectra::FinishTask()
 {
+    // written with the full binning, the zoom of the sparse histograms is only for the display
+    fFiller->Flush(kTRUE);
 
     if (fMappedItemsTofW)
     {
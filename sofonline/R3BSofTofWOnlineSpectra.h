@@ -7,6 +7,7 @@
 #define R3BSofTofWOnlineSpectra_H
 
 #include "FairTask.h"
+#include "R3BSofJitter.h"
 #include "TCanvas.h"
 #include "TH1.h"
 #include "TH2F.h"
@@ -24,6 +25,9 @@
 
 class TClonesArray;
 class R3BEventHeader;
+class R3BSofEventSummaryData;
+class R3BSofHistoFiller;
+class R3BSofSnapshotPublisher;
 
 /**
  * This taks reads SCI data and plots online histograms
@@ -85,6 +89,11 @@ class R3BSofTofWOnlineSpectra : public FairTask
      */
     virtual void Reset_Histo();
 
+    /** The histograms served by the http server are updated every n events or s seconds, whichever first **/
+    void SetUpdateRate(Int_t n, Double_t s);
+    /** Copies of the histograms also served by publisher, updated at the same rate, before Init **/
+    void SetPublisher(R3BSofSnapshotPublisher* publisher) { fPublisher = publisher; }
+
     inline void Set_TwimvsTof_range(Float_t min, Float_t max)
     {
         fTwimTofRangeMin = min;
@@ -100,6 +109,7 @@ class R3BSofTofWOnlineSpectra : public FairTask
     TClonesArray* fSingleTcalItemsSci;  /**< Array with single tcal items of Sci */
     TClonesArray* fHitItemsTwim;        /**< Array with hit items of twim. */
     TClonesArray* fCalItemsMwpc;        /**< Array with cal items of mwpc3. */
+    R3BSofEventSummaryData* fSummary;   /**< Multiplicities and times per channel */
     Float_t fTwimTofRangeMax;           // Range for Twim vs ToF histograms
     Float_t fTwimTofRangeMin;
     Int_t fIdSofSciCaveC;
@@ -107,6 +117,7 @@ class R3BSofTofWOnlineSpectra : public FairTask
     // check for trigger should be done globablly (somewhere else)
     R3BEventHeader* header; /**< Event header.      */
     Int_t fNEvents;         /**< Event counter.     */
+    R3BSofJitter fJitter; //! smearing of the display fills
 
     // Canvas
     TCanvas* cTofWFineTime[NbChs];
@@ -146,6 +157,9 @@ class R3BSofTofWOnlineSpectra : public FairTask
     // Histograms for Mwpc3 vs ToF-plastic
     TH2F* fh2_Mwpc3X_Tof;
     TH2F* fh2_Mwpc3Y_PosTof[NbDets];
+    // Buffered fills of the histograms
+    R3BSofHistoFiller* fFiller;          //!
+    R3BSofSnapshotPublisher* fPublisher; //!
 
   public:
     ClassDef(R3BSofTofWOnlineSpectra, 1)
@@ -33,7 +33,6 @@
 #include "TLegendEntry.h"
 #include "TLine.h"
 #include "TMath.h"
-#include "TRandom.h"
 #include "TVector3.h"
 
 #include <array>
@@ -481,6 +480,8 @@ void R3BSofTrackingFissionOnlineSpectra::Exec(Option_t* option)
     if (NULL == mgr)
         LOG(fatal) << "R3BSofTrackingFissionOnlineSpectra::Exec FairRootManager not found";
 
+    fJitter.SetEvent(fNEvents);
+
     Double_t mwpc0x = -300., mwpc0y = -300., anglemus = 0., zrand = 0., mwpc3x = -10000.;
     Double_t xtarget = -500., ytarget = -500.;
 
@@ -514,7 +515,7 @@ void R3BSofTrackingFissionOnlineSpectra::Exec(Option_t* option)
                 if (TMath::Abs(angX) < 0.075 && TMath::Abs(angY) < 0.075)
                 {
                     // zrand = gRandom->Uniform(0., fPosTarget);
-                    zrand = gRandom->Uniform(0., fDist_acelerator_glad);
+                    zrand = fJitter.Uniform(0., fDist_acelerator_glad);
                     fh2_tracking_planeYZ->Fill(zrand, mwpc0y + angY * zrand);
                     ytarget = mwpc0y + angY * fPosTarget;
                     fh2_tracking_planeXZ->Fill(zrand, mwpc0x + angX * zrand);
@@ -539,7 +540,7 @@ void R3BSofTrackingFissionOnlineSpectra::Exec(Option_t* option)
                                     (fMw2GeoPar->GetPosZ() - fMw1GeoPar->GetPosZ()) / 10.;
                     if (TMath::Abs(angX) < 0.1 && TMath::Abs(angY) < 0.1)
                     {
-                        zrand = gRandom->Uniform(fPosTarget, fDist_acelerator_glad);
+                        zrand = fJitter.Uniform(fPosTarget, fDist_acelerator_glad);
                         fh2_tracking_planeYZ->Fill(zrand, ytarget + angY * zrand);
                         fh2_tracking_planeXZ->Fill(zrand, xtarget + angX * zrand);
                     }
@@ -572,7 +573,7 @@ void R3BSofTrackingFissionOnlineSpectra::Exec(Option_t* option)
 
                     if ((mw1x > 0. && mw2x > 0.) || (mw1x < 0. && mw2x < 0.))
                     {
-                        zrand = gRandom->Uniform(0., fDist_acelerator_glad - fPosTarget);
+                        zrand = fJitter.Uniform(0., fDist_acelerator_glad - fPosTarget);
                         Double_t angX = (mw2x - mw1x) / (fMw2GeoPar->GetPosZ() - fMw1GeoPar->GetPosZ()) / 10.;
                         Double_t angY = (mw2y - mw1y) / (fMw2GeoPar->GetPosZ() - fMw1GeoPar->GetPosZ()) / 10.;
                         fh2_tracking_planeXZ->Fill(
@@ -628,48 +629,7 @@ void R3BSofTrackingFissionOnlineSpectra::Exec(Option_t* option)
     fNEvents += 1;
 }
 
-void R3BSofTrackingFissionOnlineSpectra::FinishEvent()
-{
-    if (fMwpc0HitDataCA)
-    {
-        fMwpc0HitDataCA->Clear();
-    }
-
-    if (fMwpc1HitDataCA)
-    {
-        fMwpc1HitDataCA->Clear();
-    }
-
-    if (fTrimHitDataCA)
-    {
-        fTrimHitDataCA->Clear();
-    }
-
-    if (fTwimHitDataCA)
-    {
-        fTwimHitDataCA->Clear();
-    }
-
-    if (fMwpc2HitDataCA)
-    {
-        fMwpc2HitDataCA->Clear();
-    }
-
-    if (fMwpc3HitDataCA)
-    {
-        fMwpc3HitDataCA->Clear();
-    }
-
-    if (fTofWHitDataCA)
-    {
-        fTofWHitDataCA->Clear();
-    }
-
-    if (fTrackingDataCA)
-    {
-        fTrackingDataCA->Clear();
-    }
-}
+void R3BSofTrackingFissionOnlineSpectra::FinishEvent() {}
 
 void R3BSofTrackingFissionOnlineSpectra::FinishTask()
 {
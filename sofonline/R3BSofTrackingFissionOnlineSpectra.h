@@ -8,6 +8,7 @@
 #define R3BSofTrackingFissionOnlineSpectra_H
 
 #include "FairTask.h"
+#include "R3BSofJitter.h"
 #include "TCanvas.h"
 #include "TH1.h"
 #include "TH2F.h"
@@ -120,6 +121,7 @@ class R3BSofTrackingFissionOnlineSpectra : public FairTask
     // check for trigger should be done globablly (somewhere else)
     R3BEventHeader* header; /**< Event header.      */
     Int_t fNEvents;         /**< Event counter.     */
+    R3BSofJitter fJitter; //! smearing of the display fills
     Float_t fPosTarget;
     Float_t fWidthTarget;
     Float_t fDist_acelerator_glad;
@@ -32,7 +32,6 @@
 #include "TLegendEntry.h"
 #include "TLine.h"
 #include "TMath.h"
-#include "TRandom.h"
 #include "TVector3.h"
 
 #include <array>
@@ -404,6 +403,8 @@ void R3BSofTrackingOnlineSpectra::Exec(Option_t* option)
     if (NULL == mgr)
         LOG(fatal) << "R3BSofTrackingOnlineSpectra::Exec FairRootManager not found";
 
+    fJitter.SetEvent(fNEvents);
+
     Double_t mwpc0x = -300., mwpc0y = -300., mwpc1y = 0., mwpc2y = 0., anglemus = 0., zrand = 0., mwpc3x = -10000.;
     Double_t xtarget = -500., ytarget = -500.;
 
@@ -434,7 +435,7 @@ void R3BSofTrackingOnlineSpectra::Exec(Option_t* option)
                 if (TMath::Abs(angX) < 0.075 && TMath::Abs(angY) < 0.075)
                 {
                     mwpc1y = hit->GetY() - 6.0;
-                    zrand = gRandom->Uniform(0., fDist_acelerator_glad);
+                    zrand = fJitter.Uniform(0., fDist_acelerator_glad);
                     fh2_tracking_planeYZ->Fill(zrand, mwpc0y + (mwpc1y - mwpc0y) / 2835. * zrand);
                     ytarget = mwpc0y + (hit->GetY() - mwpc0y) / 2835. * fPosTarget;
                     fh2_tracking_planeXZ->Fill(zrand, mwpc0x + (hit->GetX() - mwpc0x) / 2835. * zrand);
@@ -453,7 +454,7 @@ void R3BSofTrackingOnlineSpectra::Exec(Option_t* option)
                                 continue;
                             anglemus = hit->GetTheta();
                         }
-                        zrand = gRandom->Uniform(0., fDist_acelerator_glad);
+                        zrand = fJitter.Uniform(0., fDist_acelerator_glad);
                         fh2_tracking_planeXZ->Fill(zrand, mwpc0x + anglemus * zrand);
                         xtarget = mwpc0x + anglemus * fPosTarget;
                     }
@@ -504,48 +505,7 @@ void R3BSofTrackingOnlineSpectra::Exec(Option_t* option)
     fNEvents += 1;
 }
 
-void R3BSofTrackingOnlineSpectra::FinishEvent()
-{
-    if (fMwpc0HitDataCA)
-    {
-        fMwpc0HitDataCA->Clear();
-    }
-
-    if (fMwpc1HitDataCA)
-    {
-        fMwpc1HitDataCA->Clear();
-    }
-
-    if (fMusicHitDataCA)
-    {
-        fMusicHitDataCA->Clear();
-    }
-
-    if (fTwimHitDataCA)
-    {
-        fTwimHitDataCA->Clear();
-    }
-
-    if (fMwpc2HitDataCA)
-    {
-        fMwpc2HitDataCA->Clear();
-    }
-
-    if (fMwpc3HitDataCA)
-    {
-        fMwpc3HitDataCA->Clear();
-    }
-
-    if (fTofWHitDataCA)
-    {
-        fTofWHitDataCA->Clear();
-    }
-
-    if (fTrackingDataCA)
-    {
-        fTrackingDataCA->Clear();
-    }
-}
+void R3BSofTrackingOnlineSpectra::FinishEvent() {}
 
 void R3BSofTrackingOnlineSpectra::FinishTask()
 {
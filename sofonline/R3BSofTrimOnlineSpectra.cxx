@@ -10,6 +10,8 @@
 #include "FairRunOnline.h"
 #include "FairRuntimeDb.h"
 #include "R3BEventHeader.h"
+#include "R3BSofHistoFiller.h"
+#include "R3BSofSnapshotPublisher.h"
 #include "R3BSofTrimCalData.h"
 #include "R3BSofTrimHitData.h"
 #include "R3BSofTrimMappedData.h"
@@ -44,6 +46,8 @@ R3BSofTrimOnlineSpectra::R3BSofTrimOnlineSpectra()
     , fNumAnodes(6)
     , fNumTref(1)
     , fNumTtrig(1)
+    , fFiller(new R3BSofHistoFiller())
+    , fPublisher(NULL)
 {
     fNumPairs = fNumAnodes / 2;
 }
@@ -58,6 +62,8 @@ R3BSofTrimOnlineSpectra::R3BSofTrimOnlineSpectra(const TString& name, Int_t iVer
     , fNumAnodes(6)
     , fNumTref(1)
     , fNumTtrig(1)
+    , fFiller(new R3BSofHistoFiller())
+    , fPublisher(NULL)
 {
     fNumPairs = fNumAnodes / 2;
 }
@@ -65,6 +71,8 @@ R3BSofTrimOnlineSpectra::R3BSofTrimOnlineSpectra(const TString& name, Int_t iVer
 R3BSofTrimOnlineSpectra::~R3BSofTrimOnlineSpectra()
 {
     LOG(info) << "R3BSofTrimOnlineSpectra::Delete instance";
+    if (fFiller)
+        delete fFiller;
     if (fMappedItemsTrim)
         delete fMappedItemsTrim;
     if (fCalItemsTrim)
@@ -827,15 +835,26 @@ InitStatus R3BSofTrimOnlineSpectra::Init()
     }
     run->AddObject(mainfolTrim);
 
+    // copies served off the event loop
+    if (fPublisher)
+        fFiller->SetPublisher(fPublisher, fPublisher->Add(mainfolTrim));
+
     // === Register command to reset histograms
     run->GetHttpServer()->RegisterCommand("Reset_TRIM_HIST", Form("/Objects/%s/->Reset_Histo()", GetName()));
 
     return kSUCCESS;
 }
 
+void R3BSofTrimOnlineSpectra::SetUpdateRate(Int_t n, Double_t s)
+{
+    fFiller->SetFlushEvents(n);
+    fFiller->SetFlushSeconds(s);
+}
+
 void R3BSofTrimOnlineSpectra::Reset_Histo()
 {
     LOG(info) << "R3BSofTrimOnlineSpectra::Reset_Histo";
+    fFiller->Flush();
 
     // Mapped data
     if (fMappedItemsTrim)
@@ -938,7 +957,7 @@ void R3BSofTrimOnlineSpectra::Exec(Option_t* option)
             R3BSofTrimMappedData* mapitem = (R3BSofTrimMappedData*)fMappedItemsTrim->At(ihit);
             if (!mapitem)
                 continue;
-            fh1_trimmap_Mult[mapitem->GetSecID() - 1]->Fill(mapitem->GetAnodeID());
+            fFiller->Fill(fh1_trimmap_Mult[mapitem->GetSecID() - 1], mapitem->GetAnodeID());
             mult[mapitem->GetSecID() - 1][mapitem->GetAnodeID() - 1]++;
             // ATTENTION: take into accound only the first hit
             if (mult[mapitem->GetSecID() - 1][mapitem->GetAnodeID() - 1] == 1)
@@ -952,23 +971,24 @@ void R3BSofTrimOnlineSpectra::Exec(Option_t* option)
         for (Int_t s = 0; s < fNumSections; s++)
         {
             if (mult[s][fNumAnodes] == 1 && mult[s][fNumAnodes + 1] == 1)
-                fh1_trimmap_DeltaTrefTtrig[s]->Fill(Traw[s][fNumAnodes] - Traw[s][fNumAnodes + 1]);
+                fFiller->Fill(fh1_trimmap_DeltaTrefTtrig[s], Traw[s][fNumAnodes] - Traw[s][fNumAnodes + 1]);
             for (Int_t a = 0; a < fNumAnodes; a++)
             {
                 if (mult[s][a] == 1)
                 {
-                    fh1_trimmap_E[s * fNumAnodes + a]->Fill(Eraw[s][a]);
+                    fFiller->Fill(fh1_trimmap_E[s * fNumAnodes + a], Eraw[s][a]);
                     if (mult[s][fNumAnodes] == 1)
                     {
-                        fh1_trimmap_DT[s * fNumAnodes + a]->Fill(Traw[s][a] - Traw[s][fNumAnodes]);
-                        fh2_trimmap_EvsDT[s * fNumAnodes + a]->Fill(Traw[s][a] - Traw[s][fNumAnodes], Eraw[s][a]);
+                        fFiller->Fill(fh1_trimmap_DT[s * fNumAnodes + a], Traw[s][a] - Traw[s][fNumAnodes]);
+                        fFiller->Fill(fh2_trimmap_EvsDT[s * fNumAnodes + a], Traw[s][a] - Traw[s][fNumAnodes],
+                                      Eraw[s][a]);
                     }
                 }
             }
             for (Int_t a = 0; a < fNumAnodes - 1; a++)
                 if (mult[s][a] == 1 && mult[s][a + 1] == 1 && mult[s][fNumAnodes] == 1)
-                    fh2_trimmap_DTvsDT[s * (fNumAnodes - 1) + a]->Fill(Traw[s][a] - Traw[s][fNumAnodes],
-                                                                       Traw[s][a + 1] - Traw[s][fNumAnodes]);
+                    fFiller->Fill(fh2_trimmap_DTvsDT[s * (fNumAnodes - 1) + a], Traw[s][a] - Traw[s][fNumAnodes],
+                                  Traw[s][a + 1] - Traw[s][fNumAnodes]);
         } // end of for(fNumSections)
 
     } // end of if (MappedItemsTrim)
@@ -1015,10 +1035,10 @@ void R3BSofTrimOnlineSpectra::Exec(Option_t* option)
             iAnode = calitem->GetAnodeID() - 1;
             iPair = (int)(iAnode / 2);
             // draw data per anode
-            fh1_trimcal_Esub[iAnode + iSec * fNumAnodes]->Fill(calitem->GetEnergySub());
-            fh1_trimcal_Ematch[iAnode + iSec * fNumAnodes]->Fill(calitem->GetEnergyMatch());
-            fh1_trimcal_DTraw[iAnode + iSec * fNumAnodes]->Fill(calitem->GetDriftTimeRaw());
-            fh1_trimcal_DTalign[iAnode + iSec * fNumAnodes]->Fill(calitem->GetDriftTimeAligned());
+            fFiller->Fill(fh1_trimcal_Esub[iAnode + iSec * fNumAnodes], calitem->GetEnergySub());
+            fFiller->Fill(fh1_trimcal_Ematch[iAnode + iSec * fNumAnodes], calitem->GetEnergyMatch());
+            fFiller->Fill(fh1_trimcal_DTraw[iAnode + iSec * fNumAnodes], calitem->GetDriftTimeRaw());
+            fFiller->Fill(fh1_trimcal_DTalign[iAnode + iSec * fNumAnodes], calitem->GetDriftTimeAligned());
             // calculate data per pair
             EmatchPair[iPair + iSec * fNumPairs] += 0.5 * calitem->GetEnergyMatch();
             DTalignedPair[iPair + iSec * fNumPairs] += 0.5 * calitem->GetDriftTimeAligned();
@@ -1030,14 +1050,14 @@ void R3BSofTrimOnlineSpectra::Exec(Option_t* option)
             {
                 if (multPair[fNumPairs * s + p] == 2)
                 {
-                    fh1_trimcal_EmatchPair[fNumPairs * s + p]->Fill(EmatchPair[fNumPairs * s + p]);
+                    fFiller->Fill(fh1_trimcal_EmatchPair[fNumPairs * s + p], EmatchPair[fNumPairs * s + p]);
                     // if(4800<DTalignedPair[fNumPairs*s+p]&&DTalignedPair[fNumPairs*s+p]<5200){
                     //  fh1_trimcal_EmatchPair[fNumPairs*s+p]->Fill(EmatchPair[fNumPairs*s+p]);
                     //}
-                    fh2_trimcal_EnePairVsDT[fNumPairs * s + p]->Fill(DTalignedPair[fNumPairs * s + p],
-                                                                     EmatchPair[fNumPairs * s + p]);
-                    fh2_trimcal_EnePairVsDeltaDT[fNumPairs * s + p]->Fill(DTalignedPair[7] - DTalignedPair[1],
-                                                                          EmatchPair[fNumPairs * s + p]);
+                    fFiller->Fill(fh2_trimcal_EnePairVsDT[fNumPairs * s + p], DTalignedPair[fNumPairs * s + p],
+                                  EmatchPair[fNumPairs * s + p]);
+                    fFiller->Fill(fh2_trimcal_EnePairVsDeltaDT[fNumPairs * s + p], DTalignedPair[7] - DTalignedPair[1],
+                                  EmatchPair[fNumPairs * s + p]);
                     if (p == 1)
                         DTaligned[s] = DTalignedPair[fNumPairs * s + p];
                 }
@@ -1064,46 +1084,42 @@ void R3BSofTrimOnlineSpectra::Exec(Option_t* option)
             Edt[iSec] = hititem->GetEnergyDT();
             Etheta[iSec] = hititem->GetEnergyTheta();
             Z[iSec] = hititem->GetZcharge();
-            fh1_trimhit_Eraw[iSec]->Fill(Eraw[iSec]);
+            fFiller->Fill(fh1_trimhit_Eraw[iSec], Eraw[iSec]);
             for (Int_t p = 0; p < fNumPairs; p++)
-                fh1_trimhit_ErawPair[iSec * fNumPairs + p]->Fill(ErawPair[iSec * fNumPairs + p]);
+                fFiller->Fill(fh1_trimhit_ErawPair[iSec * fNumPairs + p], ErawPair[iSec * fNumPairs + p]);
             // if(4600<DTaligned[iSec]&&DTaligned[iSec]<5500){
             // fh1_trimhit_Eraw[iSec]->Fill(Eraw[iSec]);
             //}
-            fh1_trimhit_Ebeta[iSec]->Fill(Ebeta[iSec]);
-            fh1_trimhit_Edt[iSec]->Fill(Edt[iSec]);
-            fh1_trimhit_Etheta[iSec]->Fill(Etheta[iSec]);
-            fh1_trimhit_Z[iSec]->Fill(Z[iSec]);
-            fh2_trimhit_Eraw_vs_DT[iSec]->Fill(DTaligned[iSec], Eraw[iSec]);
-            fh2_trimhit_Ebeta_vs_DT[iSec]->Fill(DTaligned[iSec], Ebeta[iSec]);
-            fh2_trimhit_Edt_vs_DT[iSec]->Fill(DTaligned[iSec], Edt[iSec]);
-            fh2_trimhit_Edt_vs_theta[iSec]->Fill(DTdiff, Edt[iSec]);
-            fh2_trimhit_Etheta_vs_theta[iSec]->Fill(DTdiff, Etheta[iSec]);
+            fFiller->Fill(fh1_trimhit_Ebeta[iSec], Ebeta[iSec]);
+            fFiller->Fill(fh1_trimhit_Edt[iSec], Edt[iSec]);
+            fFiller->Fill(fh1_trimhit_Etheta[iSec], Etheta[iSec]);
+            fFiller->Fill(fh1_trimhit_Z[iSec], Z[iSec]);
+            fFiller->Fill(fh2_trimhit_Eraw_vs_DT[iSec], DTaligned[iSec], Eraw[iSec]);
+            fFiller->Fill(fh2_trimhit_Ebeta_vs_DT[iSec], DTaligned[iSec], Ebeta[iSec]);
+            fFiller->Fill(fh2_trimhit_Edt_vs_DT[iSec], DTaligned[iSec], Edt[iSec]);
+            fFiller->Fill(fh2_trimhit_Edt_vs_theta[iSec], DTdiff, Edt[iSec]);
+            fFiller->Fill(fh2_trimhit_Etheta_vs_theta[iSec], DTdiff, Etheta[iSec]);
         } // end of loop over the HitData TClonesArray
-        fh2_trimhit_EvsE[0]->Fill(Etheta[0], Etheta[1]);
-        fh2_trimhit_ZvsZ[0]->Fill(Z[0], Z[1]);
-        fh2_trimhit_EvsE[1]->Fill(Etheta[1], Etheta[2]);
-        fh2_trimhit_ZvsZ[1]->Fill(Z[1], Z[2]);
-        fh2_trimhit_EvsE[2]->Fill(TMath::Max(Etheta[0], Etheta[1]), Etheta[2]);
-        fh2_trimhit_ZvsZ[2]->Fill(TMath::Max(Z[0], Z[1]), Z[2]);
-        fh1_trimhit_Emax->Fill(TMath::Max(Etheta[0], Etheta[1]));
+        fFiller->Fill(fh2_trimhit_EvsE[0], Etheta[0], Etheta[1]);
+        fFiller->Fill(fh2_trimhit_ZvsZ[0], Z[0], Z[1]);
+        fFiller->Fill(fh2_trimhit_EvsE[1], Etheta[1], Etheta[2]);
+        fFiller->Fill(fh2_trimhit_ZvsZ[1], Z[1], Z[2]);
+        fFiller->Fill(fh2_trimhit_EvsE[2], TMath::Max(Etheta[0], Etheta[1]), Etheta[2]);
+        fFiller->Fill(fh2_trimhit_ZvsZ[2], TMath::Max(Z[0], Z[1]), Z[2]);
+        fFiller->Fill(fh1_trimhit_Emax, TMath::Max(Etheta[0], Etheta[1]));
     }
 
+    // the histograms are updated every N events or T seconds, this event included
+    fFiller->Tick();
+
     fNEvents += 1;
 }
 
-void R3BSofTrimOnlineSpectra::FinishEvent()
-{
-    if (fMappedItemsTrim)
-        fMappedItemsTrim->Clear();
-    if (fCalItemsTrim)
-        fCalItemsTrim->Clear();
-    if (fHitItemsTrim)
-        fHitItemsTrim->Clear();
-}
+void R3BSofTrimOnlineSpectra::FinishEvent() {}
 
 void R3BSofTrimOnlineSpectra::FinishTask()
 {
+    fFiller->Flush();
     if (fMappedItemsTrim)
     {
         cTrimMap_DeltaTrefTtrig->Write();
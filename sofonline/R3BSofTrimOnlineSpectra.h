@@ -15,6 +15,8 @@
 
 class TClonesArray;
 class R3BEventHeader;
+class R3BSofHistoFiller;
+class R3BSofSnapshotPublisher;
 
 /**
  * This taks reads TWIM data and plots online histograms
@@ -76,6 +78,11 @@ class R3BSofTrimOnlineSpectra : public FairTask
      */
     virtual void Reset_Histo();
 
+    /** The histograms served by the http server are updated every n events or s seconds, whichever first **/
+    void SetUpdateRate(Int_t n, Double_t s);
+    /** Copies of the histograms also served by publisher, updated at the same rate, before Init **/
+    void SetPublisher(R3BSofSnapshotPublisher* publisher) { fPublisher = publisher; }
+
     void SetNumSections(Int_t num) { fNumSections = num; }
     void SetNumAnodes(Int_t num) { fNumAnodes = num; }
     void SetNumPairs(Int_t num) { fNumPairs = num; }
@@ -153,6 +160,9 @@ class R3BSofTrimOnlineSpectra : public FairTask
     TH2F** fh2_trimhit_EvsE;
     TH2F** fh2_trimhit_ZvsZ;
     TH1F* fh1_trimhit_Emax;
+    // Buffered fills of the histograms
+    R3BSofHistoFiller* fFiller;          //!
+    R3BSofSnapshotPublisher* fPublisher; //!
 
   public:
     ClassDef(R3BSofTrimOnlineSpectra, 1)
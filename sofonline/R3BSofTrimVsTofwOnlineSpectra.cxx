@@ -10,8 +10,7 @@
 #include "FairRunOnline.h"
 #include "FairRuntimeDb.h"
 #include "R3BEventHeader.h"
-#include "R3BSofTofWHitData.h"
-#include "R3BSofTrimHitData.h"
+#include "R3BSofEventSummaryData.h"
 #include "TCanvas.h"
 #include "TClonesArray.h"
 #include "TFolder.h"
@@ -37,6 +36,7 @@ R3BSofTrimVsTofwOnlineSpectra::R3BSofTrimVsTofwOnlineSpectra()
     : FairTask("SofTrimVsTofwOnlineSpectra", 1)
     , fTrimHit(NULL)
     , fTofwHit(NULL)
+    , fSummary(NULL)
     , fNEvents(0)
     , fNumSections(3)
 {
@@ -46,6 +46,7 @@ R3BSofTrimVsTofwOnlineSpectra::R3BSofTrimVsTofwOnlineSpectra(const TString& name
     : FairTask(name, iVerbose)
     , fTrimHit(NULL)
     , fTofwHit(NULL)
+    , fSummary(NULL)
     , fNEvents(0)
     , fNumSections(3)
 {
@@ -94,6 +95,16 @@ InitStatus R3BSofTrimVsTofwOnlineSpectra::Init()
         LOG(warn) << " R3BSofTrimVsTofwOnlineSpectra::Init(), TofwHitData not found ... is ok !";
     }
 
+    // === ============= === //
+    // === EVENT SUMMARY === //
+    // === ============= === //
+    fSummary = (R3BSofEventSummaryData*)mgr->GetObject("SofEventSummary");
+    if (!fSummary)
+    {
+        LOG(error) << "R3BSofTrimVsTofwOnlineSpectra::Init(), SofEventSummary not found";
+        return kFATAL;
+    }
+
     // === =============================== === //
     // === Create histograms for detectors === //
     // === =============================== === //
@@ -153,43 +164,24 @@ void R3BSofTrimVsTofwOnlineSpectra::Exec(Option_t* option)
     if (NULL == mgr)
         LOG(fatal) << "R3BSofTrimVsTofwOnlineSpectra::Exec FairRootManager not found";
 
-    // === Tof-wall Hit data
-    Int_t nHitsTofW = 0;
-    Double_t Tof = 0;
-    if (fTofwHit && fTofwHit->GetEntriesFast() > 0)
+    // === Tof-wall Hit data, events with one hit only
+    if (fTofwHit && fTrimHit && fSummary->GetTofWMultHit() == 1)
     {
-        nHitsTofW = fTrimHit->GetEntriesFast();
-        if (nHitsTofW == 1)
-        {
-            R3BSofTofWHitData* hit = (R3BSofTofWHitData*)fTofwHit->At(0);
-            if (hit)
-                Tof = hit->GetTof();
-        }
-    }
+        Double_t Tof = fSummary->GetTofWTof();
 
-    // === Triple-MUSIC Hit data
-    if (fTrimHit && fTrimHit->GetEntriesFast() > 0 && nHitsTofW == 1)
-    {
-        Int_t nHits = fTrimHit->GetEntriesFast();
-        for (Int_t ihit = 0; ihit < nHitsTofW; ihit++)
+        // === Triple-MUSIC Hit data, per section
+        for (Int_t section = 0; section < fNumSections; section++)
         {
-            R3BSofTrimHitData* hit = (R3BSofTrimHitData*)fTrimHit->At(ihit);
-            if (!hit)
-                continue;
-            fh2_TrimE_vs_TofCaveC[hit->GetSecID() - 1]->Fill(Tof, hit->GetEnergyTheta());
-        } // end of loop over the HitData TClonesArray
+            const R3BSofEventSummaryData::Trim& trim = fSummary->GetTrim(section + 1);
+            if (trim.multHit > 0)
+                fh2_TrimE_vs_TofCaveC[section]->Fill(Tof, trim.etheta);
+        }
     }
 
     fNEvents += 1;
 }
 
-void R3BSofTrimVsTofwOnlineSpectra::FinishEvent()
-{
-    if (fTrimHit)
-        fTrimHit->Clear();
-    if (fTofwHit)
-        fTofwHit->Clear();
-}
+void R3BSofTrimVsTofwOnlineSpectra::FinishEvent() {}
 
 void R3BSofTrimVsTofwOnlineSpectra::FinishTask()
 {
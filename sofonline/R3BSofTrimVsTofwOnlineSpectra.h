@@ -15,6 +15,7 @@
 
 class TClonesArray;
 class R3BEventHeader;
+class R3BSofEventSummaryData;
 
 /**
  * This taks reads TWIM data and plots online histograms
@@ -81,8 +82,9 @@ class R3BSofTrimVsTofwOnlineSpectra : public FairTask
   private:
     Int_t fNumSections;
 
-    TClonesArray* fTrimHit; /**< Array with Trim hit items. */
-    TClonesArray* fTofwHit; /**< Array with Tofw hit items. */
+    TClonesArray* fTrimHit;           /**< Array with Trim hit items. */
+    TClonesArray* fTofwHit;           /**< Array with Tofw hit items. */
+    R3BSofEventSummaryData* fSummary; /**< Tofw and Trim hits, first hit */
 
     // Canvas
     TCanvas* c_TrimE_vs_TofCaveC[3];
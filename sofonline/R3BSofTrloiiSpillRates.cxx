@@ -0,0 +1,88 @@
+// --------------------------------------------------------------
+// -----               R3BSofTrloiiSpillRates               -----
+// --------------------------------------------------------------
+
+#include "R3BSofTrloiiSpillRates.h"
+
+#include <cstring>
+
+R3BSofTrloiiSpillRates::R3BSofTrloiiSpillRates(Int_t nSpills)
+    : fSpillType(kAdt + 1)
+    , fSpillChannel(1)
+    , fSpillThreshold(10)
+    , fSpillEndReadout(kTRUE)
+    , fReadout(kFALSE)
+    , fSpillOn(kFALSE)
+    , fNumSpills(0)
+    , fSpills(nSpills > 0 ? nSpills : 1)
+{
+    memset(fLast, 0, sizeof(fLast));
+    memset(fReadoutCounts, 0, sizeof(fReadoutCounts));
+    Reset();
+}
+
+void R3BSofTrloiiSpillRates::SetSpillChannel(UShort_t type, UShort_t channel, UInt_t threshold)
+{
+    if (type < 1 || type > kNumTypes || channel < 1 || channel > kNumChannels)
+        return;
+    fSpillType = type;
+    fSpillChannel = channel;
+    fSpillThreshold = threshold;
+}
+
+void R3BSofTrloiiSpillRates::Reset()
+{
+    // the last values are kept, the next readout still gives the counts since the previous one
+    fSpillOn = kFALSE;
+    fNumSpills = 0;
+    memset(&fCurrent, 0, sizeof(fCurrent));
+    memset(fRunCounts, 0, sizeof(fRunCounts));
+}
+
+ULong64_t R3BSofTrloiiSpillRates::Fill(UShort_t type, UShort_t channel, ULong64_t value)
+{
+    // the value is 0 in the events without readout of the scalers
+    if (value == 0 || type < 1 || type > kNumTypes || channel < 1 || channel > kNumChannels)
+        return 0;
+    ULong64_t& last = fLast[type - 1][channel - 1];
+    // 32-bit counters, the first readout is the reference
+    ULong64_t counts = last ? (UInt_t)(value - last) : 0;
+    last = value;
+    fReadoutCounts[type - 1][channel - 1] += counts;
+    fReadout = kTRUE;
+    return counts;
+}
+
+Bool_t R3BSofTrloiiSpillRates::EndEvent()
+{
+    if (!fReadout)
+        return kFALSE;
+    fReadout = kFALSE;
+
+    Bool_t beam = fReadoutCounts[fSpillType - 1][fSpillChannel - 1] >= fSpillThreshold;
+    Bool_t close = fSpillEndReadout ? beam : (fSpillOn && !beam);
+    // counts of the readout, also the tail of the spill when it closes
+    if (beam || close)
+        for (Int_t t = 0; t < kNumTypes; t++)
+            for (Int_t ch = 0; ch < kNumChannels; ch++)
+                fCurrent.counts[t][ch] += fReadoutCounts[t][ch];
+    memset(fReadoutCounts, 0, sizeof(fReadoutCounts));
+    fSpillOn = beam;
+    if (!close)
+        return kFALSE;
+
+    for (Int_t t = 0; t < kNumTypes; t++)
+        for (Int_t ch = 0; ch < kNumChannels; ch++)
+            fRunCounts[t][ch] += fCurrent.counts[t][ch];
+    fSpills[fNumSpills % fSpills.size()] = fCurrent;
+    fNumSpills++;
+    memset(&fCurrent, 0, sizeof(fCurrent));
+    return kTRUE;
+}
+
+Double_t R3BSofTrloiiSpillRates::GetLiveTime(Int_t i, UShort_t trloii, UShort_t channel) const
+{
+    const Spill& spill = GetStored(i);
+    ULong64_t bdt = spill.counts[kNumKinds * trloii + kBdt][channel - 1];
+    return bdt ? (Double_t)spill.counts[kNumKinds * trloii + kAdt][channel - 1] / bdt : 0.;
+}
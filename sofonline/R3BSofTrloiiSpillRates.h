@@ -0,0 +1,93 @@
+// --------------------------------------------------------------
+// -----               R3BSofTrloiiSpillRates               -----
+// -----    Spill-aware accumulator of the Trloii scalers:    -----
+// -----    detects the spill on/off from the counts of one   -----
+// -----    scaler channel, sums the counts of the spill for  -----
+// -----    each channel and keeps the last N spills          -----
+// --------------------------------------------------------------
+
+#ifndef R3BSofTrloiiSpillRates_H
+#define R3BSofTrloiiSpillRates_H
+
+#include "Rtypes.h"
+
+#include <vector>
+
+class R3BSofTrloiiSpillRates
+{
+  public:
+    // Scalers of each Trloii: type = 4 * trloii + kind + 1, trloii 0 = MAIN, 1 = S2, 2 = S8
+    enum Kind
+    {
+        kRaw,
+        kBdt, // before dead time
+        kAdt, // after dead time
+        kArd, // after reduction
+        kNumKinds
+    };
+    static const Int_t kNumTypes = 16;
+    static const Int_t kNumChannels = 16;
+
+    /** Default constructor, ring buffer of the last nSpills spills **/
+    R3BSofTrloiiSpillRates(Int_t nSpills = 100);
+
+    /** Destructor **/
+    virtual ~R3BSofTrloiiSpillRates() {}
+
+    /** Beam on while the channel counts at least threshold between two readouts,
+     *  default MAIN ADT channel 1 (accepted triggers) **/
+    void SetSpillChannel(UShort_t type, UShort_t channel, UInt_t threshold = 10);
+
+    /** kTRUE (default) when the scalers are read at the end of each spill: every readout with beam closes a
+     *  spill. kFALSE for periodic readouts during the spill: the spill closes at the first readout without beam **/
+    void SetSpillEndReadout(Bool_t option) { fSpillEndReadout = option; }
+
+    void Reset();
+
+    /** Event by event: Fill for each scaler read, returns the counts since the previous readout of the
+     *  channel (0 at the first readout), then EndEvent. EndEvent returns kTRUE when the readout closes a spill **/
+    ULong64_t Fill(UShort_t type, UShort_t channel, ULong64_t value);
+    Bool_t EndEvent();
+
+    // Getters
+    inline Bool_t IsSpillOn() const { return fSpillOn; }
+    inline UInt_t GetNumSpills() const { return fNumSpills; }
+    // Number of spills in the ring buffer
+    inline Int_t GetNumStored() const { return fNumSpills < fSpills.size() ? fNumSpills : fSpills.size(); }
+    // Spill number and counts of the i-th stored spill, i = 0 for the oldest one
+    UInt_t GetSpillNumber(Int_t i) const { return fNumSpills - GetNumStored() + i + 1; }
+    ULong64_t GetCounts(Int_t i, UShort_t type, UShort_t channel) const
+    {
+        return GetStored(i).counts[type - 1][channel - 1];
+    }
+    // Fraction of the triggers of the channel accepted by the DAQ, ADT / BDT, during the i-th stored spill
+    Double_t GetLiveTime(Int_t i, UShort_t trloii, UShort_t channel) const;
+    // Counts per spill over the run
+    Double_t GetRatePerSpill(UShort_t type, UShort_t channel) const
+    {
+        return fNumSpills ? (Double_t)fRunCounts[type - 1][channel - 1] / fNumSpills : 0.;
+    }
+
+  private:
+    struct Spill
+    {
+        ULong64_t counts[kNumTypes][kNumChannels];
+    };
+    const Spill& GetStored(Int_t i) const { return fSpills[(fNumSpills - GetNumStored() + i) % fSpills.size()]; }
+
+    UShort_t fSpillType;
+    UShort_t fSpillChannel;
+    UInt_t fSpillThreshold;
+    Bool_t fSpillEndReadout;
+
+    Bool_t fReadout;    // scalers read in the current event
+    Bool_t fSpillOn;    // beam on at the last readout
+    UInt_t fNumSpills;  // closed spills since the last Reset
+    ULong64_t fLast[kNumTypes][kNumChannels];
+    ULong64_t fReadoutCounts[kNumTypes][kNumChannels]; // since the previous readout
+    Spill fCurrent;
+    ULong64_t fRunCounts[kNumTypes][kNumChannels];
+    std::vector<Spill> fSpills; // ring buffer
+};
+
+#endif
@@ -209,17 +209,7 @@ void R3BSofTwimvsMusicOnlineSpectra::Exec(Option_t* option)
     fNEvents += 1;
 }
 
-void R3BSofTwimvsMusicOnlineSpectra::FinishEvent()
-{
-    if (fHitItemsMusic)
-    {
-        fHitItemsMusic->Clear();
-    }
-    if (fHitItemsTwim)
-    {
-        fHitItemsTwim->Clear();
-    }
-}
+void R3BSofTwimvsMusicOnlineSpectra::FinishEvent() {}
 
 void R3BSofTwimvsMusicOnlineSpectra::FinishTask()
 {
@@ -186,17 +186,7 @@ void R3BSofTwimvsTrimOnlineSpectra::Exec(Option_t* option)
     }
 }
 
-void R3BSofTwimvsTrimOnlineSpectra::FinishEvent()
-{
-    if (fHitItemsTrim)
-    {
-        fHitItemsTrim->Clear();
-    }
-    if (fHitItemsTwim)
-    {
-        fHitItemsTwim->Clear();
-    }
-}
+void R3BSofTwimvsTrimOnlineSpectra::FinishEvent() {}
 
 void R3BSofTwimvsTrimOnlineSpectra::FinishTask()
 {
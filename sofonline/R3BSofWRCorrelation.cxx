@@ -0,0 +1,129 @@
+// --------------------------------------------------------------
+// -----                R3BSofWRCorrelation                 -----
+// --------------------------------------------------------------
+
+#include "R3BSofWRCorrelation.h"
+
+#include "FairLogger.h"
+#include "R3BWRData.h"
+#include "TClonesArray.h"
+
+#include <algorithm>
+#include <cmath>
+
+R3BSofWRCorrelation::R3BSofWRCorrelation()
+    : fNumSigmas(5.)
+    , fMinWindow(50.)
+    , fGain(0.01)
+    , fNumWarmUp(100)
+    , fDriftInterval(1.e10)
+    , fMisbuilt(kFALSE)
+{
+}
+
+Int_t R3BSofWRCorrelation::AddStream(const char* name, TClonesArray* items, Int_t item)
+{
+    Stream s;
+    s.name = name;
+    s.items = items;
+    s.item = item;
+    fStreams.push_back(s);
+    Reset();
+    return fStreams.size() - 1;
+}
+
+void R3BSofWRCorrelation::Reset()
+{
+    fMisbuilt = kFALSE;
+    for (auto& s : fStreams)
+    {
+        s.locked = kFALSE;
+        s.warmUp.clear();
+        s.offset = 0.;
+        s.sigma = 0.;
+        s.drift = 0.;
+        s.driftOffset = 0.;
+        s.driftTime = 0;
+        s.nOutliersInRow = 0;
+        s.nEvents = 0;
+        s.nMissing = 0;
+        s.nOutliers = 0;
+    }
+}
+
+void R3BSofWRCorrelation::Lock(Stream& s, ULong64_t time)
+{
+    // median and median absolute deviation of the first differences
+    std::vector<Double_t>& v = s.warmUp;
+    std::nth_element(v.begin(), v.begin() + v.size() / 2, v.end());
+    s.offset = v[v.size() / 2];
+    for (auto& x : v)
+        x = std::fabs(x - s.offset);
+    std::nth_element(v.begin(), v.begin() + v.size() / 2, v.end());
+    s.sigma = 1.4826 * v[v.size() / 2];
+    v.clear();
+
+    s.locked = kTRUE;
+    s.nOutliersInRow = 0;
+    s.driftOffset = s.offset;
+    s.driftTime = time;
+    LOG(info) << "R3BSofWRCorrelation: WR SOFIA - " << s.name << " offset " << s.offset << " ns, sigma " << s.sigma
+              << " ns";
+}
+
+Bool_t R3BSofWRCorrelation::Process(const TClonesArray* reference)
+{
+    fMisbuilt = kFALSE;
+    if (!reference || reference->GetEntriesFast() == 0)
+        return kFALSE;
+    ULong64_t time = ((R3BWRData*)reference->At(0))->GetTimeStamp();
+
+    for (auto& s : fStreams)
+    {
+        if (!s.items)
+            continue;
+        s.nEvents++;
+        if (s.items->GetEntriesFast() <= s.item)
+        {
+            s.nMissing++;
+            continue;
+        }
+        Double_t diff = (Long64_t)(time - ((R3BWRData*)s.items->At(s.item))->GetTimeStamp());
+
+        if (!s.locked)
+        {
+            s.warmUp.push_back(diff);
+            if (s.warmUp.size() >= fNumWarmUp)
+                Lock(s, time);
+            continue;
+        }
+
+        Double_t res = diff - s.offset;
+        if (std::fabs(res) > std::max(fNumSigmas * s.sigma, fMinWindow))
+        {
+            s.nOutliers++;
+            fMisbuilt = kTRUE;
+            // a jump of the offset rather than mis-built events, start again
+            if (++s.nOutliersInRow > fNumWarmUp)
+            {
+                LOG(warn) << "R3BSofWRCorrelation: WR SOFIA - " << s.name << " offset moved away from " << s.offset
+                          << " ns";
+                s.locked = kFALSE;
+            }
+            continue;
+        }
+        s.nOutliersInRow = 0;
+
+        // exponentially weighted mean and mean absolute deviation of the accepted differences
+        s.offset += fGain * res;
+        s.sigma += fGain * (std::sqrt(M_PI / 2.) * std::fabs(res) - s.sigma);
+
+        if (time - s.driftTime >= fDriftInterval)
+        {
+            s.drift = (s.offset - s.driftOffset) / (time - s.driftTime) * 1.e9;
+            s.driftOffset = s.offset;
+            s.driftTime = time;
+        }
+    }
+    return fMisbuilt;
+}
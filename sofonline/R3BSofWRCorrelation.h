@@ -0,0 +1,89 @@
+// --------------------------------------------------------------
+// -----                R3BSofWRCorrelation                 -----
+// -----    White Rabbit correlation of the subsystems with   -----
+// -----    SOFIA: running robust estimate of the offset,     -----
+// -----    width and drift of WR(SOFIA) - WR(subsystem) for  -----
+// -----    each subsystem, and flag of the mis-built events  -----
+// --------------------------------------------------------------
+
+#ifndef R3BSofWRCorrelation_H
+#define R3BSofWRCorrelation_H
+
+#include "Rtypes.h"
+#include "TString.h"
+
+#include <vector>
+
+class TClonesArray;
+
+class R3BSofWRCorrelation
+{
+  public:
+    /** Default constructor **/
+    R3BSofWRCorrelation();
+
+    /** Destructor **/
+    virtual ~R3BSofWRCorrelation() {}
+
+    /** Timestamp stream of a subsystem: R3BWRData item number "item" of the array, returns its index **/
+    Int_t AddStream(const char* name, TClonesArray* items, Int_t item = 0);
+
+    // The event is mis-built when |WR difference - offset| > max(nSigmas * sigma, window)
+    void SetNumSigmas(Double_t n) { fNumSigmas = n; }
+    void SetMinWindow(Double_t ns) { fMinWindow = ns; }
+    // Weight of each event in the running estimates, after the first nWarmUp events of each stream
+    void SetGain(Double_t gain) { fGain = gain; }
+    void SetNumWarmUp(Int_t n) { fNumWarmUp = n; }
+    // Drift computed every interval ns of SOFIA WR time
+    void SetDriftInterval(Double_t ns) { fDriftInterval = ns; }
+
+    void Reset();
+
+    /** Compares the streams with the first item of the SOFIA WR array, returns kTRUE for a mis-built event **/
+    Bool_t Process(const TClonesArray* reference);
+
+    // Getters
+    inline Bool_t IsMisbuilt() const { return fMisbuilt; }
+    inline Int_t GetNumStreams() const { return fStreams.size(); }
+    inline const char* GetName(Int_t i) const { return fStreams[i].name.Data(); }
+    // Offset and width (ns) of WR(SOFIA) - WR(subsystem), drift in ns per second
+    inline Double_t GetOffset(Int_t i) const { return fStreams[i].offset; }
+    inline Double_t GetSigma(Int_t i) const { return fStreams[i].sigma; }
+    inline Double_t GetDrift(Int_t i) const { return fStreams[i].drift; }
+    inline Bool_t IsLocked(Int_t i) const { return fStreams[i].locked; }
+    // Events with SOFIA WR, without timestamp of the subsystem, and with a mis-built timestamp
+    inline ULong64_t GetNumEvents(Int_t i) const { return fStreams[i].nEvents; }
+    inline ULong64_t GetNumMissing(Int_t i) const { return fStreams[i].nMissing; }
+    inline ULong64_t GetNumOutliers(Int_t i) const { return fStreams[i].nOutliers; }
+
+  private:
+    struct Stream
+    {
+        TString name;
+        TClonesArray* items;
+        Int_t item;
+        Bool_t locked; // offset known, after the warm-up
+        std::vector<Double_t> warmUp;
+        Double_t offset;
+        Double_t sigma;
+        Double_t drift;
+        Double_t driftOffset; // offset and SOFIA WR time at the last drift update
+        ULong64_t driftTime;
+        Int_t nOutliersInRow;
+        ULong64_t nEvents;
+        ULong64_t nMissing;
+        ULong64_t nOutliers;
+    };
+
+    void Lock(Stream& s, ULong64_t time);
+
+    Double_t fNumSigmas;
+    Double_t fMinWindow;
+    Double_t fGain;
+    Int_t fNumWarmUp;
+    Double_t fDriftInterval;
+    Bool_t fMisbuilt;
+    std::vector<Stream> fStreams;
+};
+
+#endif
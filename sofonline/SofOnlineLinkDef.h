@@ -26,5 +26,8 @@
 #pragma link C++ class R3BSofScalersOnlineSpectra+;
 #pragma link C++ class R3BSofCorrOnlineSpectra+;
 #pragma link C++ class R3BSofSciVsPspxOnlineSpectra+;
+#pragma link C++ class R3BSofEventSummary+;
+#pragma link C++ class R3BSofEventSummaryData+;
+#pragma link C++ class R3BSofSnapshotPublisher+;
 
 #endif
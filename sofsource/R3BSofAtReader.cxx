@@ -67,43 +67,26 @@ Bool_t R3BSofAtReader::Read()
 
 Bool_t R3BSofAtReader::ReadData(EXT_STR_h101_SOFAT_onion* data)
 {
-    Bool_t pileupFLAG;
-    Bool_t overflowFLAG;
-
     // --- number of entries in energy and time
-    UShort_t nAnodesEnergy = data->SOFAT_EM;
-    UShort_t nAnodesTime = data->SOFAT_TM;
-    if (nAnodesEnergy != nAnodesTime)
+    if (data->SOFAT_EM != data->SOFAT_TM)
         LOG(error) << "R3BSofAtReader::ReadData error ! NOT THE SAME NUMBER OF ANODES HITTED IN ENERGY ("
-                   << nAnodesEnergy << ") AND TIME (" << nAnodesTime << ")";
-
-    // --- energy and time are sorted
-    uint32_t curAnodeTimeStart = 0;
-    uint32_t curAnodeEnergyStart = 0;
-    for (UShort_t a = 0; a < nAnodesTime; a++)
+                   << data->SOFAT_EM << ") AND TIME (" << data->SOFAT_TM << ")";
+    else if (!R3BSofMdppColumns::SameLayout(
+                 data->SOFAT_EM, data->SOFAT_EMI, data->SOFAT_EME, data->SOFAT_TM, data->SOFAT_TMI, data->SOFAT_TME))
+        LOG(error) << "R3BSofAtReader::ReadData error ! MISMATCH FOR ANODE ID OR MULTIPLICITY PER ANODE IN ENERGY AND "
+                      "TIME";
+
+    // --- energy and time are sorted, EMI gives the 1-based anode number
+    const UInt_t nHitsEnergy =
+        fEnergy.Decode(data->SOFAT_EM, data->SOFAT_EMI, data->SOFAT_EME, data->SOFAT_E, data->SOFAT_Ev);
+    const UInt_t nHitsTime =
+        fTime.Decode(data->SOFAT_TM, data->SOFAT_TMI, data->SOFAT_TME, data->SOFAT_T, data->SOFAT_Tv);
+    const UInt_t nHits = nHitsEnergy < nHitsTime ? nHitsEnergy : nHitsTime;
+    for (UInt_t i = 0; i < nHits; i++)
     {
-        // EMI and TMI give the 1-based anode number
-        UShort_t idAnodeTime = data->SOFAT_TMI[a];
-        UShort_t idAnodeEnergy = data->SOFAT_EMI[a];
-        if (idAnodeEnergy != idAnodeTime)
-        {
-            LOG(error) << "R3BSofAtReader::ReadData error ! MISMATCH FOR ANODE ID ";
-            LOG(error) << "IN ENERGY #" << idAnodeEnergy << " AND TIME #" << idAnodeTime;
-        }
-        uint32_t nextAnodeTimeStart = data->SOFAT_TME[a];
-        uint32_t nextAnodeEnergyStart = data->SOFAT_EME[a];
-        if ((nextAnodeTimeStart - curAnodeTimeStart) != (nextAnodeEnergyStart - curAnodeEnergyStart))
-            LOG(error) << "R3BSofAtReader::ReadData error ! MISMATCH FOR MULTIPLICITY PER ANODE IN ENERGY AND TIME";
-        for (int hit = curAnodeTimeStart; hit < nextAnodeTimeStart; hit++)
-        {
-            pileupFLAG = (data->SOFAT_Ev[hit] & 0x00040000) >> 18;
-            overflowFLAG = (data->SOFAT_Ev[hit] & 0x00080000) >> 19;
-            new ((*fArray)[fArray->GetEntriesFast()])
-                R3BSofAtMappedData(idAnodeEnergy, data->SOFAT_Ev[hit], data->SOFAT_Tv[hit], pileupFLAG, overflowFLAG);
-        }
-        curAnodeEnergyStart = nextAnodeEnergyStart;
-        curAnodeTimeStart = nextAnodeTimeStart;
-    } // end of loop over the anodes from 1 to 6
+        new ((*fArray)[fArray->GetEntriesFast()]) R3BSofAtMappedData(
+            fEnergy.GetId(i), fEnergy.GetValue(i), fTime.GetValue(i), fEnergy.GetPileup(i), fEnergy.GetOverflow(i));
+    } // end of loop over the hits of the anodes from 1 to 4
 
     return kTRUE;
 }
@@ -2,6 +2,7 @@
 #define R3BSOFATREADER_H
 
 #include "R3BReader.h"
+#include "R3BSofMdppColumns.h"
 #include "TClonesArray.h"
 
 #include <Rtypes.h>
@@ -42,6 +43,9 @@ class R3BSofAtReader : public R3BReader
     Bool_t fOnline;
     // R3BSofAtMappedData Item
     TClonesArray* fArray; /**< Output array. */
+    // Hits decoded in columns
+    R3BSofMdppColumns fEnergy; //!
+    R3BSofMdppColumns fTime;   //!
 
   public:
     ClassDefOverride(R3BSofAtReader, 0);
@@ -0,0 +1,66 @@
+// --------------------------------------------------------------
+// -----                R3BSofMdppColumns                   -----
+// --------------------------------------------------------------
+
+#include "R3BSofMdppColumns.h"
+
+#include <algorithm>
+#include <string.h>
+
+R3BSofMdppColumns::R3BSofMdppColumns()
+    : fNumHits(0)
+{
+}
+
+R3BSofMdppColumns::~R3BSofMdppColumns() {}
+
+UInt_t R3BSofMdppColumns::Decode(uint32_t nCh,
+                                 const uint32_t* chId,
+                                 const uint32_t* chEnd,
+                                 uint32_t nv,
+                                 const uint32_t* v)
+{
+    // the hits of the channels are contiguous: the end of the last channel is the number of hits
+    fNumHits = 0;
+    if (nCh == 0)
+        return 0;
+    const uint32_t nHits = std::min(chEnd[nCh - 1], nv);
+    if (fId.size() < nHits)
+    {
+        fId.resize(nHits);
+        fValue.resize(nHits);
+        fFlags.resize(nHits);
+    }
+
+    // channel id of each hit, one range per channel
+    uint32_t cur = 0;
+    for (uint32_t c = 0; c < nCh; c++)
+    {
+        const uint32_t next = std::min(chEnd[c], nHits);
+        if (next > cur)
+        {
+            std::fill(fId.begin() + cur, fId.begin() + next, (UShort_t)chId[c]);
+            cur = next;
+        }
+    }
+    fNumHits = cur;
+
+    // values and flags of all the hits at once, branch-free loops over contiguous words
+    memcpy(fValue.data(), v, fNumHits * sizeof(uint32_t));
+    UChar_t* flags = fFlags.data();
+    for (UInt_t i = 0; i < fNumHits; i++)
+        flags[i] = (UChar_t)((v[i] >> 18) & 0x3);
+
+    return fNumHits;
+}
+
+Bool_t R3BSofMdppColumns::SameLayout(uint32_t nCh1,
+                                     const uint32_t* chId1,
+                                     const uint32_t* chEnd1,
+                                     uint32_t nCh2,
+                                     const uint32_t* chId2,
+                                     const uint32_t* chEnd2)
+{
+    return nCh1 == nCh2 && memcmp(chId1, chId2, nCh1 * sizeof(uint32_t)) == 0 &&
+           memcmp(chEnd1, chEnd2, nCh1 * sizeof(uint32_t)) == 0;
+}
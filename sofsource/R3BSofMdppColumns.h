@@ -0,0 +1,54 @@
+// --------------------------------------------------------------
+// -----                R3BSofMdppColumns                   -----
+// -----    Bulk decoder of a zero-suppressed multi-hit       -----
+// -----    ucesb list of MDPP words into columns: 1-based    -----
+// -----    channel id, value and pileup/overflow flags       -----
+// --------------------------------------------------------------
+
+#ifndef R3BSofMdppColumns_H
+#define R3BSofMdppColumns_H
+
+#include "Rtypes.h"
+
+#include <stdint.h>
+#include <vector>
+
+class R3BSofMdppColumns
+{
+  public:
+    // bit 18 of the MDPP word: pileup, bit 19: overflow
+    static const UChar_t kPileup = 0x1;
+    static const UChar_t kOverflow = 0x2;
+
+    /** Default constructor **/
+    R3BSofMdppColumns();
+
+    /** Destructor **/
+    virtual ~R3BSofMdppColumns();
+
+    /** nCh channels with hits, chId[c] the 1-based channel id and chEnd[c] the end of its hits in the
+     *  nv words of v. Returns the number of hits **/
+    UInt_t Decode(uint32_t nCh, const uint32_t* chId, const uint32_t* chEnd, uint32_t nv, const uint32_t* v);
+
+    /** Same channels and same number of hits per channel in both lists (energy and time of an anode) **/
+    static Bool_t SameLayout(uint32_t nCh1,
+                             const uint32_t* chId1,
+                             const uint32_t* chEnd1,
+                             uint32_t nCh2,
+                             const uint32_t* chId2,
+                             const uint32_t* chEnd2);
+
+    inline UInt_t GetNumHits() const { return fNumHits; }
+    inline UShort_t GetId(UInt_t i) const { return fId[i]; }
+    inline uint32_t GetValue(UInt_t i) const { return fValue[i]; }
+    inline Bool_t GetPileup(UInt_t i) const { return fFlags[i] & kPileup; }
+    inline Bool_t GetOverflow(UInt_t i) const { return (fFlags[i] & kOverflow) >> 1; }
+
+  private:
+    UInt_t fNumHits;
+    std::vector<UShort_t> fId;
+    std::vector<uint32_t> fValue;
+    std::vector<UChar_t> fFlags;
+};
+
+#endif /* R3BSofMdppColumns_H */
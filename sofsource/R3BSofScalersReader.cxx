@@ -23,6 +23,9 @@ R3BSofScalersReader::R3BSofScalersReader(EXT_STR_h101_SOFSCALERS* data, size_t o
     , fOffset(offset)
     , fOnline(kFALSE)
     , fArray(new TClonesArray("R3BSofScalersMappedData")) // class name
+    , fChangeOnly(kFALSE)
+    , fLastValues(NUM_CHANNELS_SOFSCALERS_UPSTREAM + NUM_CHANNELS_SOFSCALERS_TOFW, 0)
+    , fSpillData(new R3BSofScalersSpillData({ NUM_CHANNELS_SOFSCALERS_UPSTREAM, NUM_CHANNELS_SOFSCALERS_TOFW }))
 {
 }
 
@@ -33,6 +36,10 @@ R3BSofScalersReader::~R3BSofScalersReader()
     {
         delete fArray;
     }
+    if (fSpillData)
+    {
+        delete fSpillData;
+    }
 }
 
 Bool_t R3BSofScalersReader::Init(ext_data_struct_info* a_struct_info)
@@ -50,6 +57,10 @@ Bool_t R3BSofScalersReader::Init(ext_data_struct_info* a_struct_info)
     // Register output array in tree
     FairRootManager::Instance()->Register("SofScalersMappedData", "SofScalers", fArray, !fOnline);
     fArray->Clear();
+    // Counts per spill, for the online spectra
+    FairRootManager::Instance()->Register("SofScalersSpillData", "SofScalers", fSpillData, kFALSE);
+    if (fChangeOnly)
+        LOG(info) << "R3BSofScalersReader::Init() Only the scaler channels which changed are stored";
 
     // clear struct_writer's output struct. Seems ucesb doesn't do that
     // for channels that are unknown to the current ucesb config.
@@ -71,21 +82,33 @@ Bool_t R3BSofScalersReader::Read()
     // Convert plain raw data to multi-dimensional array
     EXT_STR_h101_SOFSCALERS_onion* data = (EXT_STR_h101_SOFSCALERS_onion*)fData;
 
+    fSpillData->BeginEvent();
     for (Int_t ch = 0; ch < NUM_CHANNELS_SOFSCALERS_UPSTREAM; ch++)
     {
-        auto item =
-            new ((*fArray)[fArray->GetEntriesFast()]) R3BSofScalersMappedData(1, ch + 1, data->SOFSCALERS_UPSTREAM[ch]);
+        AddChannel(1, ch + 1, data->SOFSCALERS_UPSTREAM[ch], fLastValues[ch]);
     }
 
     for (Int_t ch = 0; ch < NUM_CHANNELS_SOFSCALERS_TOFW; ch++)
     {
-        auto item =
-            new ((*fArray)[fArray->GetEntriesFast()]) R3BSofScalersMappedData(2, ch + 1, data->SOFSCALERS_TOFW[ch]);
+        AddChannel(2, ch + 1, data->SOFSCALERS_TOFW[ch], fLastValues[NUM_CHANNELS_SOFSCALERS_UPSTREAM + ch]);
     }
+    fSpillData->EndEvent();
 
     return kTRUE;
 }
 
+void R3BSofScalersReader::AddChannel(UShort_t scaler, UShort_t channel, UInt_t value, UInt_t& last)
+{
+    fSpillData->Fill(scaler, channel, value);
+    // The scalers are only read on the scaler readout triggers, the value is 0 in the other events.
+    // A module cleared at each readout gives new counts even when the value repeats
+    if (fChangeOnly && (value == 0 || (value == last && !fSpillData->IsCleared())))
+        return;
+    if (value != 0)
+        last = value;
+    new ((*fArray)[fArray->GetEntriesFast()]) R3BSofScalersMappedData(scaler, channel, value);
+}
+
 void R3BSofScalersReader::Reset()
 {
     // Reset the output array
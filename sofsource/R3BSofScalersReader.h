@@ -2,9 +2,11 @@
 #define R3BSOFSCALERSREADER_H
 
 #include "R3BReader.h"
+#include "R3BSofScalersSpillData.h"
 #include "TClonesArray.h"
 
 #include <Rtypes.h>
+#include <vector>
 
 struct EXT_STR_h101_SOFSCALERS_t;
 typedef struct EXT_STR_h101_SOFSCALERS_t EXT_STR_h101_SOFSCALERS;
@@ -30,6 +32,13 @@ class R3BSofScalersReader : public R3BReader
     // Accessor to select online mode
     void SetOnline(Bool_t option) { fOnline = option; }
 
+    // Only the channels which changed since their last readout are stored in SofScalersMappedData,
+    // the counts per spill are in SofScalersSpillData
+    void SetChangeOnly(Bool_t option) { fChangeOnly = option; }
+
+    // Scaler modules cleared at each readout
+    void SetCleared(Bool_t option) { fSpillData->SetCleared(option); }
+
   private:
     // Reader specific data structure from ucesb
     EXT_STR_h101_SOFSCALERS* fData;
@@ -40,6 +49,14 @@ class R3BSofScalersReader : public R3BReader
     // R3BSofSciMapped Item
     TClonesArray* fArray; /* Output array. */
     UInt_t fNumEntries;
+    // Keep only the channels which changed
+    Bool_t fChangeOnly;
+    // Last value of the channels, fOffsets[scaler - 1] + channel - 1
+    std::vector<UInt_t> fLastValues; //!
+    // Counts per spill
+    R3BSofScalersSpillData* fSpillData;
+
+    void AddChannel(UShort_t scaler, UShort_t channel, UInt_t value, UInt_t& last);
 
   public:
     ClassDefOverride(R3BSofScalersReader, 0);
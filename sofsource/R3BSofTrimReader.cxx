@@ -87,127 +87,59 @@ void R3BSofTrimReader::Reset()
 
 Bool_t R3BSofTrimReader::ReadData(EXT_STR_h101_SOFTRIM_onion* data, UShort_t section)
 {
-    Bool_t pileupFLAG;
-    Bool_t overflowFLAG;
-
-    // --- ------------------------------------- --- //
-    // --- NUMBER OF CHANNELS TREF, TRIG, ANODES --- //
-    // --- ------------------------------------- --- //
-    UShort_t nAnodesTref = data->SOFTRIM_S[section].TREFM;
-    UShort_t nAnodesTtrig = data->SOFTRIM_S[section].TTRIGM;
-    UShort_t nAnodesEnergy = data->SOFTRIM_S[section].EM;
-    UShort_t nAnodesTime = data->SOFTRIM_S[section].TM;
-
-    /*
-        if ((nAnodesEnergy>0)||(nAnodesTref>0)) {
-        std::cout << std::endl;
-        std::cout << "------------------------------" << std::endl;
-        std::cout << "R3BSofTrimReader::ReadData section = " << section <<std::endl;
-        std::cout << "------------------------------" << std::endl;
-        LOG(info) << "nAnodesTref = " << nAnodesTref;
-        LOG(info) << "nAnodesTtrig = " << nAnodesTtrig;
-        LOG(info) << "nAnodesEnergy = " << nAnodesEnergy;
-        LOG(info) << "nAnodesTime = " << nAnodesTime;
-        std::cout << "------------------------------" << std::endl;
-        }
-        for (UShort_t a = 0; a < nAnodesEnergy; a++)
-        {
-          // EMI gives the 1-based anode number
-          LOG(info) << " idAnodeEnergy = " << data->SOFTRIM_S[section].EMI[a] ;
-       }
-     */
-
     // --- ----------------- --- //
     // --- TRIM MAPPED DATA --- //
     // --- ----------------- --- //
+    auto& raw = data->SOFTRIM_S[section];
 
-    // --- TIME OF THE REFERENCE SIGNAL --- //
-    uint32_t curTref = 0;
-    uint32_t nextTref = 0;
-    UShort_t idAnodeTref = 0;
-
-    // TREF id Anode = 7
+    // --- TIME OF THE REFERENCE AND TRIGGER SIGNALS --- //
+    // TREFMI and TTRIGMI give the 1-based channel number: TREF id Anode = 7, TTRIG id Anode = 8
     // Attention section 1 and 2 are connected to the same MDPP16
-    // Therefore, it is mandatory to duplicate the section 1 Tref
-    for (UShort_t a = 0; a < nAnodesTref; a++)
-    {
-        // TREFMI gives the 1-based Tref number
-        idAnodeTref = data->SOFTRIM_S[section].TREFMI[a] + 6; // idAnodeTref = 7
-        nextTref = data->SOFTRIM_S[section].TREFME[a];
-        for (int hit = curTref; hit < nextTref; hit++)
-        {
-            pileupFLAG = (data->SOFTRIM_S[section].TREFv[hit] & 0x00040000) >> 18;
-            overflowFLAG = (data->SOFTRIM_S[section].TREFv[hit] & 0x00080000) >> 19;
-            // section is 0-based
-            new ((*fArray)[fArray->GetEntriesFast()]) R3BSofTrimMappedData(
-                section + 1, idAnodeTref, data->SOFTRIM_S[section].TREFv[hit], 0, pileupFLAG, overflowFLAG);
-            if (section == 0)
-                new ((*fArray)[fArray->GetEntriesFast()]) R3BSofTrimMappedData(
-                    section + 2, idAnodeTref, data->SOFTRIM_S[section].TREFv[hit], 0, pileupFLAG, overflowFLAG);
-        }
-        curTref = nextTref;
-    }
-
-    // --- TIME OF THE TRIGGER SIGNAL --- //
-    uint32_t curTtrig = 0;
-    uint32_t nextTtrig = 0;
-    UShort_t idAnodeTtrig = 0;
-
-    // TTRIG id Anode = 8
-    for (UShort_t a = 0; a < nAnodesTtrig; a++)
-    {
-        // again TTRIGMI is 1 based
-        idAnodeTtrig = data->SOFTRIM_S[section].TTRIGMI[a] + 7; // idAnodeTtrig = 8
-        nextTtrig = data->SOFTRIM_S[section].TTRIGME[a];
-        for (int hit = curTtrig; hit < nextTtrig; hit++)
-        {
-            pileupFLAG = (data->SOFTRIM_S[section].TTRIGv[hit] & 0x00040000) >> 18;
-            overflowFLAG = (data->SOFTRIM_S[section].TTRIGv[hit] & 0x00080000) >> 19;
-            new ((*fArray)[fArray->GetEntriesFast()]) R3BSofTrimMappedData(
-                section + 1, idAnodeTtrig, data->SOFTRIM_S[section].TTRIGv[hit], 0, pileupFLAG, overflowFLAG);
-            if (section == 0)
-                new ((*fArray)[fArray->GetEntriesFast()]) R3BSofTrimMappedData(
-                    section + 2, idAnodeTtrig, data->SOFTRIM_S[section].TTRIGv[hit], 0, pileupFLAG, overflowFLAG);
-        }
-        curTtrig = nextTtrig;
-    }
+    // Therefore, the section 1 Tref and Ttrig are decoded once and given to both sections
+    fTref.Decode(raw.TREFM, raw.TREFMI, raw.TREFME, raw.TREF, raw.TREFv);
+    fTtrig.Decode(raw.TTRIGM, raw.TTRIGMI, raw.TTRIGME, raw.TTRIG, raw.TTRIGv);
+    AddTimeSignals(section, fTref, 6);
+    if (section == 0)
+        AddTimeSignals(section + 1, fTref, 6);
+    AddTimeSignals(section, fTtrig, 7);
+    if (section == 0)
+        AddTimeSignals(section + 1, fTtrig, 7);
 
     // --- ENERGY and TIME OF THE ANODE SIGNALS --- //
-    if (nAnodesEnergy != nAnodesTime)
-        LOG(error) << "R3BSofTrimReader::ReadData error ! NOT THE SAME NUMBER OF ANODES HITTED IN ENERGY ("
-                   << nAnodesEnergy << ") AND TIME (" << nAnodesTime << ")";
-
-    // ENERGY AND TIME ARE SORTED
-    uint32_t curAnodeTimeStart = 0;
-    uint32_t curAnodeEnergyStart = 0;
-    for (UShort_t a = 0; a < nAnodesTime; a++)
+    if (raw.EM != raw.TM)
+        LOG(error) << "R3BSofTrimReader::ReadData error ! NOT THE SAME NUMBER OF ANODES HITTED IN ENERGY (" << raw.EM
+                   << ") AND TIME (" << raw.TM << ")";
+    else if (!R3BSofMdppColumns::SameLayout(raw.EM, raw.EMI, raw.EME, raw.TM, raw.TMI, raw.TME))
+        LOG(error) << "R3BSofTrimReader::ReadData error ! MISMATCH FOR ANODE ID OR MULTIPLICITY PER ANODE IN ENERGY "
+                      "AND TIME";
+
+    // ENERGY AND TIME ARE SORTED, EMI gives the 1-based anode number
+    const UInt_t nHitsEnergy = fEnergy.Decode(raw.EM, raw.EMI, raw.EME, raw.E, raw.Ev);
+    const UInt_t nHitsTime = fTime.Decode(raw.TM, raw.TMI, raw.TME, raw.T, raw.Tv);
+    const UInt_t nHits = nHitsEnergy < nHitsTime ? nHitsEnergy : nHitsTime;
+    for (UInt_t i = 0; i < nHits; i++)
     {
-        // EMI and TMI give the 1-based anode number
-        UShort_t idAnodeTime = data->SOFTRIM_S[section].TMI[a];
-        UShort_t idAnodeEnergy = data->SOFTRIM_S[section].EMI[a];
-        if (idAnodeEnergy != idAnodeTime)
-            LOG(error) << "R3BSofTrimReader::ReadData error ! MISMATCH FOR ANODE ID IN ENERGY #" << idAnodeEnergy
-                       << " AND TIME #" << idAnodeTime;
-        uint32_t nextAnodeTimeStart = data->SOFTRIM_S[section].TME[a];
-        uint32_t nextAnodeEnergyStart = data->SOFTRIM_S[section].EME[a];
-        if ((nextAnodeTimeStart - curAnodeTimeStart) != (nextAnodeEnergyStart - curAnodeEnergyStart))
-            LOG(error) << "R3BSofTrimReader::ReadData error ! MISMATCH FOR MULTIPLICITY PER ANODE IN ENERGY AND TIME";
-        for (int hit = curAnodeTimeStart; hit < nextAnodeTimeStart; hit++)
-        {
-            pileupFLAG = (data->SOFTRIM_S[section].Ev[hit] & 0x00040000) >> 18;
-            overflowFLAG = (data->SOFTRIM_S[section].Ev[hit] & 0x00080000) >> 19;
-            new ((*fArray)[fArray->GetEntriesFast()]) R3BSofTrimMappedData(section + 1,
-                                                                           idAnodeEnergy,
-                                                                           data->SOFTRIM_S[section].Tv[hit],
-                                                                           data->SOFTRIM_S[section].Ev[hit],
-                                                                           pileupFLAG,
-                                                                           overflowFLAG);
-        }
-        curAnodeEnergyStart = nextAnodeEnergyStart;
-        curAnodeTimeStart = nextAnodeTimeStart;
-    } // end of loop over the anodes from 1 to 6
+        new ((*fArray)[fArray->GetEntriesFast()]) R3BSofTrimMappedData(section + 1,
+                                                                       fEnergy.GetId(i),
+                                                                       fTime.GetValue(i),
+                                                                       fEnergy.GetValue(i),
+                                                                       fEnergy.GetPileup(i),
+                                                                       fEnergy.GetOverflow(i));
+    } // end of loop over the hits of the anodes from 1 to 6
 
     return kTRUE;
 }
 
+void R3BSofTrimReader::AddTimeSignals(UShort_t section, const R3BSofMdppColumns& signals, UShort_t idOffset)
+{
+    // section is 0-based, no energy for the time signals
+    for (UInt_t i = 0; i < signals.GetNumHits(); i++)
+        new ((*fArray)[fArray->GetEntriesFast()]) R3BSofTrimMappedData(section + 1,
+                                                                       signals.GetId(i) + idOffset,
+                                                                       signals.GetValue(i),
+                                                                       0,
+                                                                       signals.GetPileup(i),
+                                                                       signals.GetOverflow(i));
+}
+
 ClassImp(R3BSofTrimReader);
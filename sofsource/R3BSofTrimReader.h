@@ -2,6 +2,7 @@
 #define R3BSOFTRIMREADER_H
 
 #include "R3BReader.h"
+#include "R3BSofMdppColumns.h"
 #include "TClonesArray.h"
 
 #include <Rtypes.h>
@@ -45,6 +46,7 @@ class R3BSofTrimReader : public R3BReader
 
   private:
     Bool_t ReadData(EXT_STR_h101_SOFTRIM_onion*, UShort_t);
+    void AddTimeSignals(UShort_t, const R3BSofMdppColumns&, UShort_t);
     /* Reader specific data structure from ucesb */
     EXT_STR_h101_SOFTRIM* fData;
     /* Data offset */
@@ -55,6 +57,11 @@ class R3BSofTrimReader : public R3BReader
     TClonesArray* fArray; /**< Output array. */
     /* Number of Sections */
     Int_t fSections;
+    /* Hits of one section decoded in columns */
+    R3BSofMdppColumns fEnergy; //!
+    R3BSofMdppColumns fTime;   //!
+    R3BSofMdppColumns fTref;   //!
+    R3BSofMdppColumns fTtrig;  //!
 
   public:
     ClassDefOverride(R3BSofTrimReader, 0);
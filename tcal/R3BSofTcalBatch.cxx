@@ -0,0 +1,96 @@
+#include "R3BSofTcalBatch.h"
+
+// Run time dispatch of the vectorised pass over the hits
+#if defined(__x86_64__) && (defined(__clang__) ? (__clang_major__ >= 14) : defined(__GNUC__))
+#define R3BSOFTCAL_BATCH_DISPATCH __attribute__((target_clones("avx512f", "avx2", "default")))
+#else
+#define R3BSOFTCAL_BATCH_DISPATCH
+#endif
+
+namespace
+{
+    // hits are processed by blocks of 8: fixed trip count, no scalar epilogue
+    const Int_t kBlock = 8;
+
+    template <Bool_t Spread>
+    R3BSOFTCAL_BATCH_DISPATCH void TcalKernel(const Double_t* __restrict centre,
+                                              const Double_t* __restrict low,
+                                              const Double_t* __restrict up,
+                                              const Double_t* __restrict tcNs,
+                                              const UInt_t* __restrict hit,
+                                              UInt_t key,
+                                              Double_t* __restrict tns,
+                                              Int_t n)
+    {
+        for (Int_t b = 0; b < n; b += kBlock)
+        {
+            for (Int_t i = b; i < b + kBlock; i++)
+            {
+                Double_t u = Spread ? R3BSofTcalRandom::SymmetricFromKey(key, hit[i]) : 0.;
+                Double_t tf_ns = centre[i] + (u < 0. ? u : 0.) * low[i] + (u > 0. ? u : 0.) * up[i];
+                tns[i] = tcNs[i] - tf_ns;
+            }
+        }
+    }
+} // namespace
+
+R3BSofTcalBatch::R3BSofTcalBatch() {}
+
+R3BSofTcalBatch::~R3BSofTcalBatch() {}
+
+void R3BSofTcalBatch::Clear()
+{
+    fDet.clear();
+    fCh.clear();
+    fTf.clear();
+    fTc.clear();
+    fHit.clear();
+}
+
+void R3BSofTcalBatch::LookUp(const R3BSofTcalPar* par)
+{
+    Int_t nHits = fDet.size();
+    Int_t nPad = ((nHits + kBlock - 1) / kBlock) * kBlock;
+    // the padding hits use the values of the previous event, their result is never read
+    if ((Int_t)fCentre.size() < nPad)
+    {
+        fCentre.resize(nPad, 0.);
+        fLow.resize(nPad, 0.);
+        fUp.resize(nPad, 0.);
+        fTcNs.resize(nPad, 0.);
+        fHitPad.resize(nPad, 0);
+        fTns.resize(nPad, 0.);
+    }
+
+    UInt_t nChs = (UInt_t)par->GetNumChannels();
+    for (Int_t i = 0; i < nHits; i++)
+    {
+        UInt_t sig = (fDet[i] - 1) * nChs + (fCh[i] - 1);
+        const Double_t* bin = par->GetTimeBin(sig, fTf[i]);
+        fCentre[i] = bin[0];
+        fLow[i] = bin[1];
+        fUp[i] = bin[2];
+        fTcNs[i] = 5. * (Double_t)fTc[i] - par->GetClockOffsetNs(sig);
+        fHitPad[i] = fHit[i];
+    }
+}
+
+void R3BSofTcalBatch::Convert(const R3BSofTcalPar* par)
+{
+    LookUp(par);
+    TcalKernel<kFALSE>(
+        fCentre.data(), fLow.data(), fUp.data(), fTcNs.data(), fHitPad.data(), 0, fTns.data(), fDet.size());
+}
+
+void R3BSofTcalBatch::Convert(const R3BSofTcalPar* par, const R3BSofTcalRandom& rnd, ULong64_t event)
+{
+    LookUp(par);
+    TcalKernel<kTRUE>(fCentre.data(),
+                      fLow.data(),
+                      fUp.data(),
+                      fTcNs.data(),
+                      fHitPad.data(),
+                      rnd.GetEventKey(event),
+                      fTns.data(),
+                      fDet.size());
+}
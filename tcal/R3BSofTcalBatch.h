@@ -0,0 +1,100 @@
+// *** *************************************************************** *** //
+// ***                  R3BSofTcalBatch                                *** //
+// *** ---> VFTX Mapped to Tcal conversion of all the hits of an event *** //
+// ***      in one pass, shared by SofSci and SofTofW                  *** //
+// ***      1. gather (det, ch, tf, tc) from the Mapped TClonesArray   *** //
+// ***      2. look up the fine time bins and clock offsets            *** //
+// ***      3. random spreading and time in ns, vectorised and         *** //
+// ***         dispatched at run time (AVX-512, AVX2, default)         *** //
+// *** *************************************************************** *** //
+
+#ifndef R3BSOFTCAL_BATCH
+#define R3BSOFTCAL_BATCH
+
+#include "FairLogger.h"
+#include "R3BSofTcalPar.h"
+#include "R3BSofTcalRandom.h"
+#include "TClonesArray.h"
+
+#include <vector>
+
+class R3BSofTcalBatch
+{
+  public:
+    // --- Default constructor --- //
+    R3BSofTcalBatch();
+
+    // --- Destructor --- //
+    virtual ~R3BSofTcalBatch();
+
+    void Clear();
+
+    // --- Add one hit, det and ch are 1-based, hit is its index in the Mapped TClonesArray --- //
+    void AddHit(UShort_t det, UShort_t ch, UInt_t tf, UInt_t tc, UInt_t hit)
+    {
+        fDet.push_back(det);
+        fCh.push_back(ch);
+        fTf.push_back(tf);
+        fTc.push_back(tc);
+        fHit.push_back(hit);
+    }
+
+    // --- Gather the hits of a Mapped TClonesArray, items out of the range of the parameters are skipped --- //
+    template <class TMappedData>
+    void Gather(TClonesArray* mapped, Int_t nDets, Int_t nChs, const char* name)
+    {
+        Clear();
+        Int_t nHits = mapped->GetEntriesFast();
+        for (Int_t ihit = 0; ihit < nHits; ihit++)
+        {
+            TMappedData* hit = (TMappedData*)mapped->At(ihit);
+            if (!hit)
+                continue;
+            if ((hit->GetDetector() < 1) || (hit->GetDetector() > nDets))
+            {
+                LOG(info) << name << "::Exec() : iDet = " << hit->GetDetector() << " is out of range, item skipped ";
+                continue;
+            }
+            if ((hit->GetPmt() < 1) || (hit->GetPmt() > nChs))
+            {
+                LOG(info) << name << "::Exec() : iCh = " << hit->GetPmt() << " is out of range, item skipped ";
+                continue;
+            }
+            AddHit(hit->GetDetector(), hit->GetPmt(), hit->GetTimeFine(), hit->GetTimeCoarse(), ihit);
+        }
+    }
+
+    // --- Time in ns of all the hits, at the centre of the fine time bin --- //
+    void Convert(const R3BSofTcalPar* par);
+
+    // --- Time in ns of all the hits, spread within the fine time bin, keyed on (event, hit) --- //
+    void Convert(const R3BSofTcalPar* par, const R3BSofTcalRandom& rnd, ULong64_t event);
+
+    /** Accessor functions **/
+    Int_t GetNumHits() const { return fDet.size(); }
+    UShort_t GetDetector(Int_t i) const { return fDet[i]; }
+    UShort_t GetChannel(Int_t i) const { return fCh[i]; }
+    UInt_t GetTimeFine(Int_t i) const { return fTf[i]; }
+    UInt_t GetTimeCoarse(Int_t i) const { return fTc[i]; }
+    Double_t GetTimeNs(Int_t i) const { return fTns[i]; }
+
+  private:
+    void LookUp(const R3BSofTcalPar* par);
+
+    // gathered hits
+    std::vector<UShort_t> fDet;
+    std::vector<UShort_t> fCh;
+    std::vector<UInt_t> fTf;
+    std::vector<UInt_t> fTc;
+    std::vector<UInt_t> fHit;
+
+    // looked up per hit, padded to a multiple of the vector width
+    std::vector<Double_t> fCentre;
+    std::vector<Double_t> fLow;
+    std::vector<Double_t> fUp;
+    std::vector<Double_t> fTcNs; // 5*tc - clock offset
+    std::vector<UInt_t> fHitPad;
+    std::vector<Double_t> fTns;
+};
+
+#endif // R3BSOFTCAL_BATCH
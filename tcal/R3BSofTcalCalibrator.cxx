@@ -0,0 +1,95 @@
+#include "R3BSofTcalCalibrator.h"
+
+#include "R3BSofTcalPar.h"
+#include "TArrayF.h"
+#include "TMath.h"
+
+R3BSofTcalCalibrator::R3BSofTcalCalibrator()
+    : fNumChannels(0)
+    , fNumSignals(0)
+    , fNumTcalParsPerSignal(0)
+    , fTolerance(0.005)
+{
+}
+
+R3BSofTcalCalibrator::~R3BSofTcalCalibrator() {}
+
+void R3BSofTcalCalibrator::Init(Int_t nDets, Int_t nChs, Int_t nTcalParsPerSignal)
+{
+    fNumChannels = nChs > 0 ? nChs : 0;
+    fNumSignals = nDets > 0 ? nDets * fNumChannels : 0;
+    fNumTcalParsPerSignal = nTcalParsPerSignal > 0 ? nTcalParsPerSignal : 0;
+    Reset();
+}
+
+void R3BSofTcalCalibrator::Reset()
+{
+    fCounts.assign(fNumSignals * fNumTcalParsPerSignal, 0);
+    fEntries.assign(fNumSignals, 0);
+    fTable.assign(fNumSignals * fNumTcalParsPerSignal, 0.);
+    fPublishedEntries.assign(fNumSignals, 0);
+    fMaxChange.assign(fNumSignals, -1.);
+}
+
+Int_t R3BSofTcalCalibrator::Publish(R3BSofTcalPar* par, ULong64_t minStatistics)
+{
+    Int_t nDets = fNumChannels > 0 ? fNumSignals / fNumChannels : 0;
+    par->SetNumDetectors(nDets);
+    par->SetNumChannels(fNumChannels);
+    par->SetNumTcalParsPerSignal(fNumTcalParsPerSignal);
+    if (par->GetAllSignalsTcalParams()->GetSize() < fNumSignals * fNumTcalParsPerSignal)
+        par->GetAllSignalsTcalParams()->Set(fNumSignals * fNumTcalParsPerSignal);
+    if (par->GetAllClockOffsets()->GetSize() < fNumSignals)
+        par->GetAllClockOffsets()->Set(fNumSignals);
+
+    Int_t nPublished = 0;
+    for (Int_t sig = 0; sig < fNumSignals; sig++)
+    {
+        if (fEntries[sig] <= minStatistics)
+            continue;
+
+        // cumulative distribution of the fine time, upper edge of each bin in ns
+        const UInt_t* counts = &fCounts[sig * fNumTcalParsPerSignal];
+        Double_t* table = &fTable[sig * fNumTcalParsPerSignal];
+        Double_t norm = 5. / (Double_t)fEntries[sig];
+        Double_t maxChange = 0.;
+        ULong64_t partial = 0;
+        for (Int_t bin = 0; bin < fNumTcalParsPerSignal; bin++)
+        {
+            partial += counts[bin];
+            Double_t ns = norm * (Double_t)partial;
+            maxChange = TMath::Max(maxChange, TMath::Abs(ns - table[bin]));
+            table[bin] = ns;
+            par->SetSignalTcalParams(ns, sig * fNumTcalParsPerSignal + bin);
+        }
+        par->SetClockOffset(0.0, sig);
+        fMaxChange[sig] = fPublishedEntries[sig] > 0 ? maxChange : -1.;
+        fPublishedEntries[sig] = fEntries[sig];
+        nPublished++;
+    }
+    par->FillTimeTables();
+    par->setChanged();
+    return nPublished;
+}
+
+Double_t R3BSofTcalCalibrator::GetStatError(Int_t sig) const
+{
+    // binomial uncertainty of a cumulative distribution, largest at the median
+    if (fPublishedEntries[sig] == 0)
+        return -1.;
+    return 2.5 / TMath::Sqrt((Double_t)fPublishedEntries[sig]);
+}
+
+Bool_t R3BSofTcalCalibrator::IsConverged(Int_t sig) const
+{
+    return fMaxChange[sig] >= 0. && fMaxChange[sig] < fTolerance && GetStatError(sig) < fTolerance;
+}
+
+Int_t R3BSofTcalCalibrator::GetNumConverged() const
+{
+    Int_t n = 0;
+    for (Int_t sig = 0; sig < fNumSignals; sig++)
+        if (IsConverged(sig))
+            n++;
+    return n;
+}
@@ -0,0 +1,88 @@
+// *** *************************************************************** *** //
+// ***                  R3BSofTcalCalibrator                           *** //
+// *** ---> streaming VFTX Tcal calibration shared by SofSci and       *** //
+// ***      SofTofW: fine time counts in plain integer arrays, the     *** //
+// ***      cumulative fine-time-to-ns table can be published into     *** //
+// ***      R3BSofTcalPar at any time during the run                   *** //
+// *** ---> convergence per signal:                                    *** //
+// ***      - statistical uncertainty of the table 2.5ns/sqrt(N)       *** //
+// ***      - largest change of the table since the last publication   *** //
+// ***      both below the tolerance                                   *** //
+// *** *************************************************************** *** //
+
+#ifndef R3BSOFTCAL_CALIBRATOR
+#define R3BSOFTCAL_CALIBRATOR
+
+#include "Rtypes.h"
+
+#include <vector>
+
+class R3BSofTcalPar;
+
+class R3BSofTcalCalibrator
+{
+  public:
+    // --- Default constructor --- //
+    R3BSofTcalCalibrator();
+
+    // --- Destructor --- //
+    virtual ~R3BSofTcalCalibrator();
+
+    // --- Set the dimensions and reset the counts --- //
+    void Init(Int_t nDets, Int_t nChs, Int_t nTcalParsPerSignal);
+
+    // --- Reset the counts and the convergence status --- //
+    void Reset();
+
+    // --- Count one hit, det and ch are 1-based, returns kFALSE if out of range --- //
+    Bool_t AddHit(UShort_t det, UShort_t ch, UInt_t tf)
+    {
+        UInt_t sig = (UInt_t)(det - 1) * fNumChannels + (ch - 1);
+        if (det < 1 || ch < 1 || ch > fNumChannels || sig >= (UInt_t)fNumSignals ||
+            tf >= (UInt_t)fNumTcalParsPerSignal)
+            return kFALSE;
+        fCounts[sig * fNumTcalParsPerSignal + tf]++;
+        fEntries[sig]++;
+        return kTRUE;
+    }
+
+    // --- Write the tables of the signals above minStatistics into par, returns the number of signals written --- //
+    Int_t Publish(R3BSofTcalPar* par, ULong64_t minStatistics);
+
+    /** Accessor functions **/
+    Int_t GetNumSignals() const { return fNumSignals; }
+    Int_t GetNumTcalParsPerSignal() const { return fNumTcalParsPerSignal; }
+    ULong64_t GetEntries(Int_t sig) const { return fEntries[sig]; }
+    UInt_t GetCount(Int_t sig, Int_t tf) const { return fCounts[sig * fNumTcalParsPerSignal + tf]; }
+
+    // table in ns as of the last publication
+    Double_t GetTableNs(Int_t sig, Int_t tf) const { return fTable[sig * fNumTcalParsPerSignal + tf]; }
+
+    // largest change in ns of the table at the last publication, -1 before the second one
+    Double_t GetMaxChange(Int_t sig) const { return fMaxChange[sig]; }
+
+    // statistical uncertainty in ns of the table, as of the last publication
+    Double_t GetStatError(Int_t sig) const;
+
+    Bool_t IsConverged(Int_t sig) const;
+    Int_t GetNumConverged() const;
+
+    void SetTolerance(Double_t ns) { fTolerance = ns; }
+    Double_t GetTolerance() const { return fTolerance; }
+
+  private:
+    Int_t fNumChannels;
+    Int_t fNumSignals;
+    Int_t fNumTcalParsPerSignal;
+    Double_t fTolerance; // in ns
+
+    std::vector<UInt_t> fCounts; // per (signal, fine time)
+    std::vector<ULong64_t> fEntries;
+
+    // status of the last publication
+    std::vector<Double_t> fTable;
+    std::vector<ULong64_t> fPublishedEntries;
+    std::vector<Double_t> fMaxChange;
+};
+
+#endif // R3BSOFTCAL_CALIBRATOR
@@ -0,0 +1,42 @@
+#include "R3BSofTcalHitBuffer.h"
+
+R3BSofTcalHitBuffer::R3BSofTcalHitBuffer()
+    : fNumChannels(0)
+    , fMultMax(0)
+    , fOffset(1, 0)
+{
+}
+
+R3BSofTcalHitBuffer::~R3BSofTcalHitBuffer() {}
+
+void R3BSofTcalHitBuffer::Clear(Int_t nChannels)
+{
+    fNumChannels = nChannels > 0 ? nChannels : 0;
+    fMultMax = 0;
+    fOffset.assign(fNumChannels + 1, 0);
+    fTime.clear();
+    fUsed.clear();
+    fStageChannel.clear();
+    fStageTime.clear();
+}
+
+void R3BSofTcalHitBuffer::Build()
+{
+    // counting sort of the hits on the channel number
+    fOffset.assign(fNumChannels + 1, 0);
+    for (Int_t ch : fStageChannel)
+        fOffset[ch + 1]++;
+    fMultMax = 0;
+    for (Int_t ch = 0; ch < fNumChannels; ch++)
+    {
+        if (fOffset[ch + 1] > fMultMax)
+            fMultMax = fOffset[ch + 1];
+        fOffset[ch + 1] += fOffset[ch];
+    }
+
+    fFill.assign(fOffset.begin(), fOffset.end() - 1);
+    fTime.resize(fStageTime.size());
+    for (UInt_t i = 0; i < fStageTime.size(); i++)
+        fTime[fFill[fStageChannel[i]]++] = fStageTime[i];
+    fUsed.assign(fTime.size(), 0);
+}
@@ -0,0 +1,64 @@
+// *** *************************************************************** *** //
+// ***                  R3BSofTcalHitBuffer                            *** //
+// *** ---> Tcal hit times of one event grouped per channel            *** //
+// ***      no limit on the multiplicity, the storage is grown on      *** //
+// ***      demand and kept from one event to the next                 *** //
+// *** *************************************************************** *** //
+
+#ifndef R3BSOFTCAL_HITBUFFER
+#define R3BSOFTCAL_HITBUFFER
+
+#include "Rtypes.h"
+
+#include <vector>
+
+class R3BSofTcalHitBuffer
+{
+  public:
+    // --- Default constructor --- //
+    R3BSofTcalHitBuffer();
+
+    // --- Destructor --- //
+    virtual ~R3BSofTcalHitBuffer();
+
+    // --- Start a new event with nChannels channels (0-based) --- //
+    void Clear(Int_t nChannels);
+
+    // --- Add one hit, channels out of range are ignored --- //
+    void AddHit(Int_t ch, Double_t time)
+    {
+        if (ch < 0 || ch >= fNumChannels)
+            return;
+        fStageChannel.push_back(ch);
+        fStageTime.push_back(time);
+    }
+
+    // --- Group the hits per channel, keeping their order within a channel --- //
+    void Build();
+
+    /** Accessor functions, valid after Build() **/
+    Int_t GetNumChannels() const { return fNumChannels; }
+    Int_t GetNumHits() const { return fTime.size(); }
+    Int_t GetMultMax() const { return fMultMax; }
+    Int_t GetMult(Int_t ch) const { return fOffset[ch + 1] - fOffset[ch]; }
+    const Double_t* GetTimes(Int_t ch) const { return fTime.data() + fOffset[ch]; }
+    Double_t GetTime(Int_t ch, Int_t hit) const { return fTime[fOffset[ch] + hit]; }
+
+    /** Flag the hits already used in a combination, reset by Build() **/
+    void SetUsed(Int_t ch, Int_t hit) { fUsed[fOffset[ch] + hit] = 1; }
+    Bool_t IsUsed(Int_t ch, Int_t hit) const { return fUsed[fOffset[ch] + hit] != 0; }
+
+  private:
+    Int_t fNumChannels;
+    Int_t fMultMax;
+    std::vector<Int_t> fOffset; // first hit of each channel, fNumChannels+1 entries
+    std::vector<Int_t> fFill;
+    std::vector<Double_t> fTime;
+    std::vector<UChar_t> fUsed;
+
+    // hits in the order of the input TClonesArray
+    std::vector<Int_t> fStageChannel;
+    std::vector<Double_t> fStageTime;
+};
+
+#endif // R3BSOFTCAL_HITBUFFER
@@ -15,6 +15,7 @@ R3BSofTcalPar::R3BSofTcalPar(const char* name, const char* title, const char* co
     , fNumDetectors(30)
     , fNumChannels(3)
     , fNumTcalParsPerSignal(1000)
+    , fMaxFineTime(0)
 {
     fAllSignalsTcalParams = new TArrayF(fNumDetectors * fNumChannels * fNumTcalParsPerSignal);
     fAllClockOffsets = new TArrayF(fNumDetectors * fNumChannels);
@@ -111,6 +112,42 @@ Bool_t R3BSofTcalPar::getParams(FairParamList* list)
     return kTRUE;
 }
 
+// ----  Method FillTimeTables -------------------------------------------------
+Bool_t R3BSofTcalPar::FillTimeTables()
+{
+    Int_t nSignals = fNumDetectors * fNumChannels;
+    fTimeTable.clear();
+    fClockOffsetsNs.clear();
+    fMaxFineTime = 0;
+    if (nSignals <= 0 || fNumTcalParsPerSignal <= 0 ||
+        fAllSignalsTcalParams->GetSize() < nSignals * fNumTcalParsPerSignal)
+    {
+        LOG(error) << "R3BSofTcalPar::FillTimeTables() : the Tcal parameters do not cover " << nSignals
+                   << " signals, time tables left empty";
+        return kFALSE;
+    }
+
+    fTimeTable.assign(3 * nSignals * fNumTcalParsPerSignal, 0.);
+    fClockOffsetsNs.assign(nSignals, 0.);
+    fMaxFineTime = fNumTcalParsPerSignal - 1;
+
+    for (Int_t sig = 0; sig < nSignals; sig++)
+    {
+        const Float_t* par = fAllSignalsTcalParams->GetArray() + sig * fNumTcalParsPerSignal;
+        Double_t* bin = &fTimeTable[3 * sig * fNumTcalParsPerSignal];
+        for (Int_t tf = 0; tf < fNumTcalParsPerSignal; tf++)
+        {
+            // the edges of the signal have no neighbour: no spreading outside of the bin centre
+            bin[3 * tf] = (Double_t)par[tf];
+            bin[3 * tf + 1] = tf > 0 ? 0.5 * ((Double_t)par[tf] - (Double_t)par[tf - 1]) : 0.;
+            bin[3 * tf + 2] = tf < fNumTcalParsPerSignal - 1 ? 0.5 * ((Double_t)par[tf + 1] - (Double_t)par[tf]) : 0.;
+        }
+        if (sig < fAllClockOffsets->GetSize())
+            fClockOffsetsNs[sig] = 5. * (Double_t)fAllClockOffsets->GetAt(sig);
+    }
+    return kTRUE;
+}
+
 // ----  Method printParams ----------------------------------------------------
 void R3BSofTcalPar::printParams()
 {
@@ -8,6 +8,9 @@
 
 #include <TObjString.h>
 
+#include <algorithm>
+#include <vector>
+
 class FairParamList;
 
 class R3BSofTcalPar : public FairParGenericSet
@@ -53,16 +56,38 @@ class R3BSofTcalPar : public FairParGenericSet
 
     void SetClockOffset(Double_t offset, UInt_t rank) { fAllClockOffsets->AddAt(offset, rank); }
 
-    const Double_t GetNumChannels() { return fNumChannels; }
-    const Double_t GetNumTcalParsPerSignal() { return fNumTcalParsPerSignal; }
-    const Double_t GetNumDetectors() { return fNumDetectors; }
+    const Double_t GetNumChannels() const { return fNumChannels; }
+    const Double_t GetNumTcalParsPerSignal() const { return fNumTcalParsPerSignal; }
+    const Double_t GetNumDetectors() const { return fNumDetectors; }
 
     TArrayF* GetAllSignalsTcalParams() { return fAllSignalsTcalParams; }
     TArrayF* GetAllClockOffsets() { return fAllClockOffsets; }
 
-    Double_t GetSignalTcalParams(UInt_t rank) { return (Double_t)fAllSignalsTcalParams->GetAt(rank); }
+    Double_t GetSignalTcalParams(UInt_t rank) const { return (Double_t)fAllSignalsTcalParams->GetAt(rank); }
+
+    Double_t GetClockOffset(UInt_t rank) const { return (Double_t)fAllClockOffsets->GetAt(rank); }
+
+    // Flat lookup tables derived from the parameters, to be called at Init/ReInit of the tasks
+    //  per (signal, fine time): bin centre, lower half-width and upper half-width in ns
+    //  per signal             : clock offset in ns
+    //  returns kFALSE, and leaves the tables empty, if the parameters do not cover all the signals
+    Bool_t FillTimeTables();
+    Bool_t HasTimeTables() const { return !fClockOffsetsNs.empty(); }
 
-    Double_t GetClockOffset(UInt_t rank) { return (Double_t)fAllClockOffsets->GetAt(rank); }
+    // (centre, lower half-width, upper half-width) in ns of the fine time bin, sig = (det-1)*nChannels + (ch-1)
+    const Double_t* GetTimeBin(UInt_t sig, UInt_t tf) const
+    {
+        return &fTimeTable[3 * (sig * fNumTcalParsPerSignal + std::min(tf, fMaxFineTime))];
+    }
+    Double_t GetClockOffsetNs(UInt_t sig) const { return fClockOffsetsNs[sig]; }
+
+    // Raw time in ns, u in [-1,1) spreads the time within the fine time bin, u=0 gives the bin centre
+    Double_t GetTimeNs(UInt_t sig, UInt_t tf, UInt_t tc, Double_t u) const
+    {
+        const Double_t* bin = GetTimeBin(sig, tf);
+        Double_t tf_ns = bin[0] + std::min(u, 0.) * bin[1] + std::max(u, 0.) * bin[2];
+        return (5. * (Double_t)tc - fClockOffsetsNs[sig]) - tf_ns;
+    }
 
     /** Create more Methods if you need them! **/
 
@@ -74,6 +99,10 @@ class R3BSofTcalPar : public FairParGenericSet
     Int_t fNumSignals;              // fNumDetectors * fNumChannels
     Int_t fNumTcalParsPerSignal;
 
+    std::vector<Double_t> fTimeTable;      //! (centre, lower half-width, upper half-width) per fine time
+    std::vector<Double_t> fClockOffsetsNs; //! clock offsets in ns
+    UInt_t fMaxFineTime;                   //! last fine time bin of the table
+
     const R3BSofTcalPar& operator=(const R3BSofTcalPar&);
     R3BSofTcalPar(const R3BSofTcalPar&);
 
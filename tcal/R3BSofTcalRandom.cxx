@@ -0,0 +1,8 @@
+#include "R3BSofTcalRandom.h"
+
+R3BSofTcalRandom::R3BSofTcalRandom(ULong64_t seed)
+    : fSeed(seed)
+{
+}
+
+R3BSofTcalRandom::~R3BSofTcalRandom() {}
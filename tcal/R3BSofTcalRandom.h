@@ -0,0 +1,58 @@
+// *** *************************************************************** *** //
+// ***                  R3BSofTcalRandom                               *** //
+// *** ---> counter-based random numbers used to spread the VFTX times *** //
+// ***      within a fine time bin                                     *** //
+// ***      the value depends only on (seed, event, hit): reproducible *** //
+// ***      whatever the order in which the hits are processed         *** //
+// *** *************************************************************** *** //
+
+#ifndef R3BSOFTCAL_RANDOM
+#define R3BSOFTCAL_RANDOM
+
+#include "Rtypes.h"
+
+class R3BSofTcalRandom
+{
+  public:
+    // --- Standard constructor --- //
+    R3BSofTcalRandom(ULong64_t seed = 0);
+
+    // --- Destructor --- //
+    virtual ~R3BSofTcalRandom();
+
+    void SetSeed(ULong64_t seed) { fSeed = seed; }
+    ULong64_t GetSeed() const { return fSeed; }
+
+    // --- 32-bit key of one event (splitmix64 finalizer), to be computed once per event --- //
+    UInt_t GetEventKey(ULong64_t event) const
+    {
+        ULong64_t z = fSeed + (event + 1) * 0x9E3779B97F4A7C15ULL;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return (UInt_t)((z ^ (z >> 31)) >> 32);
+    }
+
+    // --- Uniform in [-1,1) with 24 random bits (murmur3 finalizer of the hit index) --- //
+    // --- 32-bit integer arithmetic only, so that loops over the hits vectorise      --- //
+    static Double_t SymmetricFromKey(UInt_t key, UInt_t hit)
+    {
+        UInt_t z = key + (hit + 1) * 0x9E3779B1U;
+        z ^= z >> 16;
+        z *= 0x85EBCA6BU;
+        z ^= z >> 13;
+        z *= 0xC2B2AE35U;
+        z ^= z >> 16;
+        return (Double_t)(Int_t)(z >> 8) * (1. / 8388608.) - 1.;
+    }
+
+    // --- Uniform in [-1,1) --- //
+    Double_t Symmetric(ULong64_t event, UInt_t hit) const { return SymmetricFromKey(GetEventKey(event), hit); }
+
+    // --- Uniform in [0,1) --- //
+    Double_t Uniform(ULong64_t event, UInt_t hit) const { return 0.5 * (Symmetric(event, hit) + 1.); }
+
+  private:
+    ULong64_t fSeed;
+};
+
+#endif // R3BSOFTCAL_RANDOM
@@ -52,6 +52,13 @@ InitStatus R3BSofTofWMapped2Tcal::Init()
     fTcal = new TClonesArray("R3BSofTofWTcalData", 10);
     rm->Register("SofTofWTcalData", "SofTofW", fTcal, !fOnline);
 
+    // Lookup tables for the conversion of the fine and coarse times
+    if (!fTcalPar->FillTimeTables())
+    {
+        LOG(error) << "R3BSofTofWMapped2Tcal::Init() Couldn't build the time tables from the Tcal parameters";
+        return kFATAL;
+    }
+
     return kSUCCESS;
 }
 
@@ -78,6 +85,11 @@ void R3BSofTofWMapped2Tcal::SetParContainers()
 InitStatus R3BSofTofWMapped2Tcal::ReInit()
 {
     SetParContainers();
+    if (!fTcalPar->FillTimeTables())
+    {
+        LOG(error) << "R3BSofTofWMapped2Tcal::ReInit() Couldn't build the time tables from the Tcal parameters";
+        return kFATAL;
+    }
     return kSUCCESS;
 }
 
@@ -86,38 +98,14 @@ void R3BSofTofWMapped2Tcal::Exec(Option_t* option)
     // Reset entries in output arrays, local arrays
     Reset();
 
-    UShort_t iDet;
-    UShort_t iCh;
-    UInt_t iTf;
-    UInt_t iTc;
-    Double_t tns = 0.0;
+    // Gather the Mapped hits and calculate all the times in ns in one pass
+    // no spreading of the fine time within its bin for the ToF-Wall (bin centre only)
+    fBatch.Gather<R3BSofTofWMappedData>(
+        fMapped, fTcalPar->GetNumDetectors(), fTcalPar->GetNumChannels(), "R3BSofTofWMapped2Tcal");
+    fBatch.Convert(fTcalPar);
 
-    Int_t nHitsPerEvent_SofTofW = fMapped->GetEntriesFast();
-    for (int ihit = 0; ihit < nHitsPerEvent_SofTofW; ihit++)
-    {
-        R3BSofTofWMappedData* hit = (R3BSofTofWMappedData*)fMapped->At(ihit);
-        if (!hit)
-            continue;
-        iDet = hit->GetDetector();
-        iCh = hit->GetPmt();
-        iTf = hit->GetTimeFine();
-        iTc = hit->GetTimeCoarse();
-
-        if ((iDet < 1) || (iDet > fTcalPar->GetNumDetectors()))
-        {
-            LOG(info) << "R3BSofTofWMapped2Tcal::Exec() : In SofTofWMappedData, iDet = " << iDet
-                      << "is out of range, item skipped ";
-            continue;
-        }
-        if ((iCh < 1) || (iCh > fTcalPar->GetNumChannels()))
-        {
-            LOG(info) << "R3BSofTofWMapped2Tcal::Exec() : In SofTofWMappedData, iCh = " << iCh
-                      << "is out of range, item skipped ";
-            continue;
-        }
-        tns = CalculateTimeNs(iDet, iCh, iTf, iTc);
-        AddTCalData(iDet, iCh, tns);
-    }
+    for (Int_t i = 0; i < fBatch.GetNumHits(); i++)
+        AddTCalData(fBatch.GetDetector(i), fBatch.GetChannel(i), fBatch.GetTimeNs(i));
 
     ++fNevent;
     return;
@@ -133,30 +121,6 @@ void R3BSofTofWMapped2Tcal::Reset()
 // -----   Public method Finish   -----------------------------------------------
 void R3BSofTofWMapped2Tcal::Finish() {}
 
-// -----   Private method to calculate the time in ns  --------------------------
-Double_t R3BSofTofWMapped2Tcal::CalculateTimeNs(UShort_t iDet, UShort_t iCh, UInt_t iTf, UInt_t iTc)
-{
-    UInt_t rank = iTf + fTcalPar->GetNumTcalParsPerSignal() * ((iDet - 1) * fTcalPar->GetNumChannels() + (iCh - 1));
-    Double_t iPar = (Double_t)fTcalPar->GetSignalTcalParams(rank);
-    Double_t iClock = (Double_t)fTcalPar->GetClockOffset((iDet - 1) * fTcalPar->GetNumChannels() + (iCh - 1));
-    Double_t r = (Double_t)rand.Rndm() - 0.5;
-    // Double_t iTf_ns;
-    Double_t iTc_ns = ((Double_t)iTc - iClock) * 5.;
-    /*
-        if (r < 0)
-        {
-            Double_t iParPrev = fTcalPar->GetSignalTcalParams(rank - 1);
-            iTf_ns = iPar + r * (iPar - iParPrev);
-        }
-        else
-        {
-            Double_t iParNext = fTcalPar->GetSignalTcalParams(rank + 1);
-            iTf_ns = iPar + r * (iParNext - iPar);
-        }
-        return (iTc_ns - iTf_ns);*/
-    return (iTc_ns - iPar);
-}
-
 // -----   Private method AddTCalData  --------------------------------------------
 R3BSofTofWTcalData* R3BSofTofWMapped2Tcal::AddTCalData(UShort_t detector, UShort_t pmt, Double_t t)
 {
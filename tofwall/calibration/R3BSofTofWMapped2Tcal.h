@@ -8,14 +8,13 @@
 #define R3BSOFTOFW_MAPPED2TCAL_H
 
 #include "FairTask.h"
+#include "R3BSofTcalBatch.h"
 #include "R3BSofTofWTcalData.h"
 
 // ROOT headers
 #include "TClonesArray.h"
 #include "TMath.h"
-#include "TRandom3.h"
 
-class TRandom3;
 class R3BSofTcalPar;
 
 class R3BSofTofWMapped2Tcal : public FairTask
@@ -57,9 +56,7 @@ class R3BSofTofWMapped2Tcal : public FairTask
     UInt_t fNumTcal; // number of Tcal items per event
 
     UInt_t fNevent;
-    TRandom3 rand;
-
-    Double_t CalculateTimeNs(UShort_t det, UShort_t pmt, UInt_t tf, UInt_t tc);
+    R3BSofTcalBatch fBatch; //! hits of the event
 
     /** Private method AddTCalData **/
     R3BSofTofWTcalData* AddTCalData(UShort_t detector, UShort_t pmt, Double_t t);
@@ -2,15 +2,15 @@
 
 #include "FairLogger.h"
 #include "FairRootManager.h"
+#include "FairRunOnline.h"
 #include "FairRuntimeDb.h"
 #include "R3BSofTcalPar.h"
 #include "R3BSofTofWMappedData.h"
 #include "TClonesArray.h"
-#include "TF1.h"
 #include "TH1F.h"
+#include "THttpServer.h"
 #include "TMath.h"
 #include "TObjArray.h"
-#include "TRandom.h"
 
 #include <iostream>
 #include <stdlib.h>
@@ -24,6 +24,8 @@ R3BSofTofWMapped2TcalPar::R3BSofTofWMapped2TcalPar()
     , fMinStatistics(100)
     , fMappedTofW(NULL)
     , fTcalPar(NULL)
+    , fPublishEvents(0)
+    , fNevent(0)
     , fOutputFile(NULL)
 {
 }
@@ -37,6 +39,8 @@ R3BSofTofWMapped2TcalPar::R3BSofTofWMapped2TcalPar(const char* name, Int_t iVerb
     , fMinStatistics(100)
     , fMappedTofW(NULL)
     , fTcalPar(NULL)
+    , fPublishEvents(0)
+    , fNevent(0)
     , fOutputFile(NULL)
 
 {
@@ -91,24 +95,18 @@ InitStatus R3BSofTofWMapped2TcalPar::Init()
         return kFATAL;
     }
 
-    // --- ---------------------- --- //
-    // --- HISTOGRAMS DECLARATION --- //
-    // --- ---------------------- --- //
+    // --- -------------------------- --- //
+    // --- FINE TIME COUNTS PER SIGNAL --- //
+    // --- -------------------------- --- //
+    fCalibrator.Init(fNumDetectors, fNumChannels, fNumTcalParsPerSignal);
+    fNevent = 0;
 
-    char name[100];
-    fh_TimeFineBin = new TH1F*[fNumDetectors * fNumChannels];
-    fh_TimeFineNs = new TH1F*[fNumDetectors * fNumChannels];
-    for (Int_t det = 0; det < fNumDetectors; det++)
+    // Register command to publish the parameters during an online calibration
+    FairRunOnline* run = FairRunOnline::Instance();
+    if (run && run->GetHttpServer())
     {
-        for (Int_t ch = 0; ch < fNumChannels; ch++)
-        {
-            sprintf(name, "TimeFineBin_TofW_P%i_Pmt%i_Sig%i", det + 1, ch + 1, det * fNumChannels + ch);
-            fh_TimeFineBin[det * fNumChannels + ch] =
-                new TH1F(name, name, fNumTcalParsPerSignal, 0, fNumTcalParsPerSignal);
-            sprintf(name, "TimeFineNs_TofW_P%i_Pmt%i_Sig%i", det + 1, ch + 1, det * fNumChannels + ch);
-            fh_TimeFineNs[det * fNumChannels + ch] =
-                new TH1F(name, name, fNumTcalParsPerSignal, 0, fNumTcalParsPerSignal);
-        }
+        run->GetHttpServer()->Register("", this);
+        run->GetHttpServer()->RegisterCommand("Publish_SOFTOFW_TCALPAR", Form("/Objects/%s/->Publish()", GetName()));
     }
 
     return kSUCCESS;
@@ -151,16 +149,16 @@ void R3BSofTofWMapped2TcalPar::Exec(Option_t* opt)
         // *** SofTofW PmtDown SIGNAL for P28 is 54  *** //
         // *** SofTofW PmtUp SIGNAL for P28 is 55    *** //
         // *** ************************************* *** //
-        UInt_t iSignal = (hit->GetDetector() - 1) * fNumChannels + (hit->GetPmt() - 1);
-        if ((0 <= iSignal) && (iSignal < fNumDetectors * fNumChannels))
-            fh_TimeFineBin[iSignal]->Fill(hit->GetTimeFine());
-        else
-            LOG(error) << "R3BSofTofWMapped2TcalPar::Exec() Number of signals out of range: " << iSignal
-                       << " instead of [0," << fNumDetectors * fNumChannels << "] "
+        if (!fCalibrator.AddHit(hit->GetDetector(), hit->GetPmt(), hit->GetTimeFine()))
+            LOG(error) << "R3BSofTofWMapped2TcalPar::Exec() Number of signals out of range:"
                        << " det = " << hit->GetDetector() << " fNumChannels = " << fNumChannels
-                       << " pmt = " << hit->GetPmt();
+                       << " pmt = " << hit->GetPmt() << " tf = " << hit->GetTimeFine();
 
     } // end of loop over the number of hits per event in MappedTofW
+
+    fNevent++;
+    if (fPublishEvents > 0 && fNevent % fPublishEvents == 0)
+        Publish();
 }
 
 // ---- Public method Reset   --------------------------------------------------
@@ -175,38 +173,50 @@ void R3BSofTofWMapped2TcalPar::FinishTask()
     fTcalPar->printParams();
 }
 
+//------------------
+void R3BSofTofWMapped2TcalPar::Publish()
+{
+    Int_t nPublished = fCalibrator.Publish(fTcalPar, fMinStatistics);
+    LOG(info) << "R3BSofTofWMapped2TcalPar::Publish() after " << fNevent << " events: " << nPublished << " of "
+              << fCalibrator.GetNumSignals() << " signals published, " << fCalibrator.GetNumConverged()
+              << " converged";
+    for (Int_t sig = 0; sig < fCalibrator.GetNumSignals(); sig++)
+        LOG(debug) << "R3BSofTofWMapped2TcalPar::Publish() signal " << sig << ": " << fCalibrator.GetEntries(sig)
+                   << " entries, max change " << fCalibrator.GetMaxChange(sig) << " ns, stat. error "
+                   << fCalibrator.GetStatError(sig) << " ns";
+}
+
 //------------------
 void R3BSofTofWMapped2TcalPar::CalculateVftxTcalParams()
 {
     LOG(info) << "R3BSofTofWMapped2TcalPar: CalculateVftxTcalParams()";
 
-    fTcalPar->SetNumDetectors(fNumDetectors);
-    fTcalPar->SetNumChannels(fNumChannels);
-    fTcalPar->SetNumTcalParsPerSignal(fNumTcalParsPerSignal);
-
-    UInt_t IntegralTot;
-    UInt_t IntegralPartial;
-    Double_t Bin2Ns[fNumTcalParsPerSignal];
+    Publish();
 
-    for (Int_t sig = 0; sig < fNumDetectors * fNumChannels; sig++)
+    // fine time distributions and tables, kept in the output file
+    char name[100];
+    for (Int_t det = 0; det < fNumDetectors; det++)
     {
-        if (fh_TimeFineBin[sig]->GetEntries() > fMinStatistics)
+        for (Int_t ch = 0; ch < fNumChannels; ch++)
         {
-            IntegralTot = fh_TimeFineBin[sig]->Integral();
-            IntegralPartial = 0;
-            for (Int_t bin = 0; bin < fNumTcalParsPerSignal; bin++)
+            Int_t sig = det * fNumChannels + ch;
+            sprintf(name, "TimeFineBin_TofW_P%i_Pmt%i_Sig%i", det + 1, ch + 1, sig);
+            TH1F hTimeFineBin(name, name, fNumTcalParsPerSignal, 0, fNumTcalParsPerSignal);
+            sprintf(name, "TimeFineNs_TofW_P%i_Pmt%i_Sig%i", det + 1, ch + 1, sig);
+            TH1F hTimeFineNs(name, name, fNumTcalParsPerSignal, 0, fNumTcalParsPerSignal);
+            if (fCalibrator.GetEntries(sig) > (ULong64_t)fMinStatistics)
             {
-                IntegralPartial += fh_TimeFineBin[sig]->GetBinContent(bin + 1);
-                Bin2Ns[bin] = 5. * ((Double_t)IntegralPartial) / (Double_t)IntegralTot;
-                fh_TimeFineNs[sig]->SetBinContent(bin + 1, Bin2Ns[bin]);
-                fTcalPar->SetSignalTcalParams(Bin2Ns[bin], sig * fNumTcalParsPerSignal + bin);
+                for (Int_t bin = 0; bin < fNumTcalParsPerSignal; bin++)
+                {
+                    hTimeFineBin.SetBinContent(bin + 1, fCalibrator.GetCount(sig, bin));
+                    hTimeFineNs.SetBinContent(bin + 1, fCalibrator.GetTableNs(sig, bin));
+                }
+                hTimeFineBin.SetEntries(fCalibrator.GetEntries(sig));
             }
-            fTcalPar->SetClockOffset(0.0, sig);
+            hTimeFineNs.Write(); // will be empty if the statistics is below fMinStatistics
+            hTimeFineBin.Write();
         }
-        fh_TimeFineNs[sig]->Write(); // will be empty if fh_TimeFineBin[sig]->GetEntries()<fMinStatistics
-        fh_TimeFineBin[sig]->Write();
     }
-    fTcalPar->setChanged();
     return;
 }
 
@@ -140,16 +140,15 @@ void R3BSofTofWSingleTCal2Hit::S455()
         return;
 
     // Data from cal level
-    R3BSofTofWSingleTcalData** calDat = new R3BSofTofWSingleTcalData*[nHits];
     Int_t fPaddleId = 0; // from 1 to 28
     Double_t tofw = 0., posx = 0., posy = 0.;
 
     for (Int_t i = 0; i < nHits; i++)
     {
-        calDat[i] = (R3BSofTofWSingleTcalData*)(fTCalDataCA->At(i));
-        fPaddleId = calDat[i]->GetDetector();
-        tofw = calDat[i]->GetRawTofNs();
-        posy = calDat[i]->GetRawPosNs();
+        R3BSofTofWSingleTcalData* calDat = (R3BSofTofWSingleTcalData*)(fTCalDataCA->At(i));
+        fPaddleId = calDat->GetDetector();
+        tofw = calDat->GetRawTofNs();
+        posy = calDat->GetRawPosNs();
 
         posx = fTofWGeoPar->GetDimX() / 2.0 - 15. - (Double_t)(fPaddleId - 1) * 30.;
         posy = posy - fTofWHitPar->GetPosOffsetPar(fPaddleId);
@@ -157,8 +156,6 @@ void R3BSofTofWSingleTCal2Hit::S455()
 
         AddHitData(fPaddleId, posx, posy * fTofWHitPar->GetPosSlopePar(fPaddleId), tofw);
     }
-    if (calDat)
-        delete calDat;
     return;
 }
 
@@ -174,20 +171,19 @@ void R3BSofTofWSingleTCal2Hit::S467()
         return;
 
     // Data from cal level
-    R3BSofTofWSingleTcalData** calDat = new R3BSofTofWSingleTcalData*[nHits];
     Int_t fPaddleId = 0; // from 1 to 28
     Double_t tofw = 0., posx = 0., posy = 0.;
     Int_t mult = 0;
 
     for (Int_t i = 0; i < nHits; i++)
     {
-        calDat[i] = (R3BSofTofWSingleTcalData*)(fTCalDataCA->At(i));
-        fPaddleId = calDat[i]->GetDetector();
+        R3BSofTofWSingleTcalData* calDat = (R3BSofTofWSingleTcalData*)(fTCalDataCA->At(i));
+        fPaddleId = calDat->GetDetector();
         if (fTofWHitPar->GetInUse(fPaddleId) != 1)
             continue;
         mult++;
-        tofw = calDat[i]->GetRawTofNs();
-        posy = calDat[i]->GetRawPosNs();
+        tofw = calDat->GetRawTofNs();
+        posy = calDat->GetRawPosNs();
     }
 
     if (mult == 1)
@@ -199,8 +195,6 @@ void R3BSofTofWSingleTCal2Hit::S467()
         // And the Tof_lise is to adjust the difference of the flight path from sofsci to target setting-by-setting.
         AddHitData(fPaddleId, posx, posy, tofw);
     }
-    if (calDat)
-        delete calDat;
     return;
 }
 
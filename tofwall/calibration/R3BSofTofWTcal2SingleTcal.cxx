@@ -124,12 +124,6 @@ void R3BSofTofWTcal2SingleTcal::Exec(Option_t* option)
 
     UShort_t iDet; // 0-based
     UShort_t iPmt; // 0-based
-    Double_t iTraw[fNumPaddles * fNumPmts][16];
-    UShort_t mult[fNumPaddles * fNumPmts];
-    UShort_t mult_max = 0;
-
-    for (UShort_t i = 0; i < fNumPaddles * fNumPmts; i++)
-        mult[i] = 0;
 
     // --- ------------------------------------------- --- //
     // --- SOFSCI: GET THE Traw FROM THE SCI AT CAVE C --- //
@@ -154,7 +148,8 @@ void R3BSofTofWTcal2SingleTcal::Exec(Option_t* option)
     if (mult_SofSciCaveC == 1)
     {
         Int_t nHitsPerEvent_SofTofW = fTofWTcal->GetEntriesFast();
-        // get the multiplicity per PMT
+        // get the multiplicity per PMT, no limit on the multiplicity
+        fHits.Clear(fNumPaddles * fNumPmts);
         for (int ihit = 0; ihit < nHitsPerEvent_SofTofW; ihit++)
         {
             R3BSofTofWTcalData* hit = (R3BSofTofWTcalData*)fTofWTcal->At(ihit);
@@ -162,13 +157,9 @@ void R3BSofTofWTcal2SingleTcal::Exec(Option_t* option)
                 continue;
             iDet = hit->GetDetector() - 1;
             iPmt = hit->GetPmt() - 1;
-            if (mult_max >= 16)
-                continue; // if multiplicity in a Pmt is higher than 16 are discarded, this code cannot handle it
-            iTraw[iDet * fNumPmts + iPmt][mult[iDet * fNumPmts + iPmt]] = hit->GetRawTimeNs();
-            mult[iDet * fNumPmts + iPmt]++;
-            if (mult[iDet * fNumPmts + iPmt] > mult_max)
-                mult_max = mult[iDet * fNumPmts + iPmt];
+            fHits.AddHit(iDet * fNumPmts + iPmt, hit->GetRawTimeNs());
         } // end of loop over the TClonesArray of Tcal data
+        fHits.Build();
 
         if (nHitsPerEvent_SofTofW > 0)
         {
@@ -181,13 +172,15 @@ void R3BSofTofWTcal2SingleTcal::Exec(Option_t* option)
                 iRawTime = -1000000.;
                 iRawTof = -1000000.;
                 // check mult==1 for the PMTup and PMTdown
-                if ((mult[d * fNumPmts + 1] == 1) && (mult[d * fNumPmts] == 1))
+                if ((fHits.GetMult(d * fNumPmts + 1) == 1) && (fHits.GetMult(d * fNumPmts) == 1))
                 {
-                    // Traw down is iTraw[d * fNumPmts]
-                    // Traw up   is iTraw[d * fNumPmts + 1]
+                    // Traw down is fHits.GetTime(d * fNumPmts, 0)
+                    // Traw up   is fHits.GetTime(d * fNumPmts + 1, 0)
                     // To have a raw position which increases from down to up : RawPos = Tdown - Tup
-                    iRawPos = fTimeStitch->GetTime(iTraw[d * fNumPmts][0] - iTraw[d * fNumPmts + 1][0], "vftx", "vftx");
-                    iRawTime = 0.5 * (iTraw[d * fNumPmts][0] + iTraw[d * fNumPmts + 1][0]);
+                    Double_t iTdown = fHits.GetTime(d * fNumPmts, 0);
+                    Double_t iTup = fHits.GetTime(d * fNumPmts + 1, 0);
+                    iRawPos = fTimeStitch->GetTime(iTdown - iTup, "vftx", "vftx");
+                    iRawTime = 0.5 * (iTdown + iTup);
                     iRawTof = fTimeStitch->GetTime(iRawTime - iRawTime_SofSci, "vftx", "vftx");
                     AddHitData(d + 1, iRawTime, iRawTof, iRawPos);
                 }
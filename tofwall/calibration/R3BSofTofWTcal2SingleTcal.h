@@ -8,6 +8,7 @@
 #include "FairTask.h"
 #include "R3BSofSciRawTofPar.h"
 #include "R3BSofSciSingleTcalData.h"
+#include "R3BSofTcalHitBuffer.h"
 #include "R3BSofTofWSingleTcalData.h"
 #include "R3BSofTofWTcalData.h"
 #include "TClonesArray.h"
@@ -52,6 +53,7 @@ class R3BSofTofWTcal2SingleTcal : public FairTask
     TClonesArray* fTofWTcal;           // input data
     TClonesArray* fTofWSingleTcal;     // output data
     R3BSofSciRawTofPar* fSciRawTofPar; // needed to get the Cave C Sci ID
+    R3BSofTcalHitBuffer fHits;         //! Tcal hits per PMT
 
     Bool_t fOnline; // Don't store data for online
 
@@ -40,12 +40,12 @@ class R3BSofTofWHitPar : public FairParGenericSet
     void printParams();
 
     /** Accessor functions **/
-    const Int_t GetNumSci() { return fNumSci; }
-    const Float_t GetTofAlign() { return fTofAlign; }
-    const Int_t GetInUse(Int_t sci) { return fIn_use->GetAt(sci - 1); }
-    const Float_t GetTofPar(Int_t sci) { return fSci_tof->GetAt(sci - 1); }
-    const Float_t GetPosOffsetPar(Int_t sci) { return fSci_posoffset->GetAt(sci - 1); }
-    const Float_t GetPosSlopePar(Int_t sci) { return fSci_posslope->GetAt(sci - 1); }
+    const Int_t GetNumSci() const { return fNumSci; }
+    const Float_t GetTofAlign() const { return fTofAlign; }
+    const Int_t GetInUse(Int_t sci) const { return fIn_use->GetAt(sci - 1); }
+    const Float_t GetTofPar(Int_t sci) const { return fSci_tof->GetAt(sci - 1); }
+    const Float_t GetPosOffsetPar(Int_t sci) const { return fSci_posoffset->GetAt(sci - 1); }
+    const Float_t GetPosSlopePar(Int_t sci) const { return fSci_posslope->GetAt(sci - 1); }
 
     void SetNumSci(Int_t nb) { fNumSci = nb; }
     void SetTofAlign(Float_t f) { fTofAlign = f; }
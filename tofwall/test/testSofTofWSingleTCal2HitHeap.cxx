@@ -0,0 +1,164 @@
+/******************************************************************************
+ *   Copyright (C) 2019 GSI Helmholtzzentrum für Schwerionenforschung GmbH    *
+ *   Copyright (C) 2019-2023 Members of R3B Collaboration                     *
+ *                                                                            *
+ *             This software is distributed under the terms of the            *
+ *                 GNU General Public Licence (GPL) version 3,                *
+ *                    copied verbatim in the file "LICENSE".                  *
+ *                                                                            *
+ * In applying this license GSI does not waive the privileges and immunities  *
+ * granted to it by virtue of its status as an Intergovernmental Organization *
+ * or submit itself to any jurisdiction.                                      *
+ ******************************************************************************/
+
+// Allocation test of R3BSofTofWSingleTCal2Hit: after a warm-up, processing
+// further events (S455 and S467 reconstruction) must not call the allocator.
+// Compiled executable: the global operator new and malloc/calloc/realloc of
+// glibc are replaced by counting versions, which also sees the allocations
+// made inside the libraries (a net heap measurement misses paired new/delete)
+
+#include "FairLogger.h"
+#include "FairRootManager.h"
+#include "R3BSofTofWSingleTCal2Hit.h"
+#include "R3BSofTofWSingleTcalData.h"
+#include "TClonesArray.h"
+#include "TRandom3.h"
+#include "TStopwatch.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <new>
+
+extern "C"
+{
+    void* __libc_malloc(size_t size);
+    void* __libc_calloc(size_t n, size_t size);
+    void* __libc_realloc(void* ptr, size_t size);
+}
+
+namespace
+{
+    bool gCount = false;
+    long gNumAllocs = 0;
+
+    void* CountedMalloc(size_t size)
+    {
+        if (gCount)
+            gNumAllocs++;
+        return __libc_malloc(size);
+    }
+} // namespace
+
+extern "C"
+{
+    void* malloc(size_t size) { return CountedMalloc(size); }
+
+    void* calloc(size_t n, size_t size)
+    {
+        if (gCount)
+            gNumAllocs++;
+        return __libc_calloc(n, size);
+    }
+
+    void* realloc(void* ptr, size_t size)
+    {
+        if (gCount)
+            gNumAllocs++;
+        return __libc_realloc(ptr, size);
+    }
+}
+
+void* operator new(size_t size)
+{
+    void* p = CountedMalloc(size ? size : 1);
+    if (!p)
+        throw std::bad_alloc();
+    return p;
+}
+
+void* operator new[](size_t size) { return operator new(size); }
+void* operator new(size_t size, const std::nothrow_t&) noexcept { return CountedMalloc(size ? size : 1); }
+void* operator new[](size_t size, const std::nothrow_t&) noexcept { return CountedMalloc(size ? size : 1); }
+void operator delete(void* p) noexcept { free(p); }
+void operator delete[](void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+void operator delete[](void* p, size_t) noexcept { free(p); }
+
+namespace
+{
+    void FillEvent(TClonesArray* cal, TRandom3& rnd)
+    {
+        cal->Clear();
+        Int_t mult = 1 + rnd.Integer(4);
+        for (Int_t i = 0; i < mult; i++)
+            new ((*cal)[i]) R3BSofTofWSingleTcalData(
+                1 + rnd.Integer(28), rnd.Uniform(0., 1000.), rnd.Uniform(30., 60.), rnd.Gaus(0., 2.));
+    }
+} // namespace
+
+int main(int argc, char** argv)
+{
+    Int_t nbevents = argc > 1 ? atoi(argv[1]) : 100000;
+
+    TStopwatch timer;
+    timer.Start();
+
+    auto logger = FairLogger::GetLogger();
+    logger->SetLogScreenLevel("error");
+
+    // Input SingleTcal data, kept in memory
+    FairRootManager* rm = FairRootManager::Instance();
+    TClonesArray* cal = new TClonesArray("R3BSofTofWSingleTcalData", 28);
+    rm->Register("SofTofWSingleTcalData", "SofTofW", cal, kFALSE);
+
+    R3BSofTofWSingleTCal2Hit* task = new R3BSofTofWSingleTCal2Hit();
+    task->SetOnline(kTRUE);
+    task->SetParContainers();
+    if (task->Init() != kSUCCESS)
+    {
+        std::cout << "R3BSofTofWSingleTCal2Hit::Init() failed" << std::endl;
+        return 1;
+    }
+
+    TRandom3 rnd(455);
+    Int_t nErrors = 0;
+    const Int_t expIds[2] = { 455, 467 };
+    for (Int_t e = 0; e < 2; e++)
+    {
+        task->SetExpId(expIds[e]);
+
+        // warm-up: the TClonesArrays reach their largest size
+        for (Int_t evt = 0; evt < 1000; evt++)
+        {
+            FillEvent(cal, rnd);
+            task->Exec("");
+        }
+
+        // only the task is counted, the input is filled outside of the counting
+        long nAllocs = 0;
+        for (Int_t evt = 0; evt < nbevents; evt++)
+        {
+            FillEvent(cal, rnd);
+            gNumAllocs = 0;
+            gCount = true;
+            task->Exec("");
+            gCount = false;
+            nAllocs += gNumAllocs;
+        }
+
+        std::cout << "S" << expIds[e] << ": " << nAllocs << " allocations over " << nbevents << " events"
+                  << std::endl;
+        if (nAllocs != 0)
+            nErrors++;
+    }
+
+    timer.Stop();
+    std::cout << "Real time: " << timer.RealTime() << "s, CPU time: " << timer.CpuTime() << "s" << std::endl;
+    if (nErrors > 0)
+    {
+        std::cout << "Heap allocations in R3BSofTofWSingleTCal2Hit::Exec" << std::endl;
+        return 1;
+    }
+    std::cout << "Test finished successfully." << std::endl;
+    return 0;
+}
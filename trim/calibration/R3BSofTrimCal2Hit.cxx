@@ -13,6 +13,7 @@
 #include "FairRunAna.h"
 #include "FairRuntimeDb.h"
 
+#include <algorithm>
 #include <iomanip>
 
 // Trim headers
@@ -35,8 +36,12 @@ R3BSofTrimCal2Hit::R3BSofTrimCal2Hit()
     , fOnline(kFALSE)
     , fTrimHitPar(NULL)
     , fTrimCalData(NULL)
+    , fTrimCalEvent(NULL)
+    , fOwnCalEvent(kFALSE)
     , fSciCalData(NULL)
     , fTrimHitData(NULL)
+    , fStrategyChecked(kFALSE)
+    , fStrategyReady(kFALSE)
 {
 }
 
@@ -52,8 +57,12 @@ R3BSofTrimCal2Hit::R3BSofTrimCal2Hit(const char* name, Int_t iVerbose)
     , fOnline(kFALSE)
     , fTrimHitPar(NULL)
     , fTrimCalData(NULL)
+    , fTrimCalEvent(NULL)
+    , fOwnCalEvent(kFALSE)
     , fSciCalData(NULL)
     , fTrimHitData(NULL)
+    , fStrategyChecked(kFALSE)
+    , fStrategyReady(kFALSE)
 {
 }
 
@@ -63,6 +72,8 @@ R3BSofTrimCal2Hit::~R3BSofTrimCal2Hit()
     LOG(info) << "R3BSofTrimCal2Hit: Delete instance";
     if (fTrimCalData)
         delete fTrimCalData;
+    if (fOwnCalEvent && fTrimCalEvent)
+        delete fTrimCalEvent;
     if (fTrimHitData)
         delete fTrimHitData;
     if (fSciCalData)
@@ -117,10 +128,28 @@ InitStatus R3BSofTrimCal2Hit::Init()
     // --- ------------------------------- --- //
     // --- INPUT CAL DATA FOR TRIPLE-MUSIC --- //
     // --- ------------------------------- --- //
-    fTrimCalData = (TClonesArray*)rootManager->GetObject("TrimCalData");
-    if (!fTrimCalData)
+    // Record per anode of R3BSofTrimMapped2Cal, or built here from the cal data of the input file
+    fTrimCalEvent = (R3BSofTrimCalEvent*)rootManager->GetObject("TrimCalEvent");
+    if (!fTrimCalEvent)
     {
-        LOG(warn) << "R3BSofTrimCal2Hit::Init() TrimCalData not found";
+        fTrimCalData = (TClonesArray*)rootManager->GetObject("TrimCalData");
+        if (!fTrimCalData)
+        {
+            LOG(warn) << "R3BSofTrimCal2Hit::Init() TrimCalData not found";
+        }
+        else
+        {
+            fTrimCalEvent = new R3BSofTrimCalEvent(fNumSections, fNumAnodes);
+            fOwnCalEvent = kTRUE;
+        }
+    }
+    if (fTrimCalEvent &&
+        (fTrimCalEvent->GetNumSections() < fNumSections || fTrimCalEvent->GetNumAnodes() < fNumAnodes))
+    {
+        LOG(error) << "R3BSofTrimCal2Hit::Init() TrimCalEvent of " << fTrimCalEvent->GetNumSections()
+                   << " sections and " << fTrimCalEvent->GetNumAnodes() << " anodes, " << fNumSections << " and "
+                   << fNumAnodes << " expected";
+        return kFATAL;
     }
 
     // --- ---------------------- --- //
@@ -138,6 +167,12 @@ InitStatus R3BSofTrimCal2Hit::Init()
     fTrimHitData = new TClonesArray("R3BSofTrimHitData", fNumSections);
     rootManager->Register("TrimHitData", "Trim Hit", fTrimHitData, !fOnline);
 
+    fEal.resize(fNumSections * fNumAnodes);
+
+    // Without experiment ID the one of the first event is used
+    if (fExpId != 0)
+        SelectStrategy(fExpId);
+
     return kSUCCESS;
 }
 
@@ -145,38 +180,55 @@ InitStatus R3BSofTrimCal2Hit::Init()
 InitStatus R3BSofTrimCal2Hit::ReInit()
 {
     SetParContainers();
+    if (fStrategyChecked)
+        SelectStrategy(fStrategy.GetExpId());
     return kSUCCESS;
 }
 
-// -----   Public method Execution   --------------------------------------------
-void R3BSofTrimCal2Hit::Exec(Option_t* option)
+// -----   Private method SelectStrategy   --------------------------------------
+Bool_t R3BSofTrimCal2Hit::SelectStrategy(Int_t expid)
 {
-    int expid = fExpId != 0 ? fExpId : header->GetExpId();
-    if (expid == 455 && fCoulex)
-        S455_Coulex();
-    else if (expid == 455 && !fCoulex)
-        S455_P2p();
+    fStrategyChecked = kTRUE;
+    fStrategyReady = kFALSE;
+    if (!fStrategy.Select(expid, fCoulex))
+    {
+        LOG(warn) << "R3BSofTrimCal2Hit::SelectStrategy() No hit reconstruction for experiment " << expid
+                  << (fCoulex ? " (Coulex)" : " (p2p)");
+        return kFALSE;
+    }
+    if (!fTrimHitPar)
+    {
+        LOG(error) << "R3BSofTrimCal2Hit::SelectStrategy() TrimHitPar Container not found";
+        return kFALSE;
+    }
+    Int_t nAligned = fTriShape == kTRUE ? fNumAnodes / 2 : fNumAnodes;
+    if (fTrimHitPar->GetNumSections() < fNumSections || fTrimHitPar->GetNumSignalsPerSection() < nAligned)
+    {
+        LOG(error) << "R3BSofTrimCal2Hit::SelectStrategy() TrimHitPar has " << fTrimHitPar->GetNumSections()
+                   << " sections of " << fTrimHitPar->GetNumSignalsPerSection() << " signals, " << fNumSections
+                   << " sections of " << nAligned << " signals expected";
+        return kFALSE;
+    }
+    if (!fStrategy.SetParameters(fTrimHitPar))
+        return kFALSE;
 
-    return;
+    LOG(info) << "R3BSofTrimCal2Hit::SelectStrategy() Hit reconstruction " << fStrategy.GetName();
+    fStrategyReady = kTRUE;
+    return kTRUE;
 }
 
-// -----   Coulex experiment with exotic beams   --------------------------------
-void R3BSofTrimCal2Hit::S455_Coulex()
+// -----   Public method Execution   --------------------------------------------
+void R3BSofTrimCal2Hit::Exec(Option_t* option)
 {
+    if (!fStrategyChecked)
+        SelectStrategy(fExpId != 0 ? fExpId : header->GetExpId());
+    if (!fStrategyReady)
+        return;
+
     // Reset entries in output arrays, local arrays
     Reset();
 
-    // Get the parameters
-    if (!fTrimHitPar)
-    {
-        LOG(error) << "R3BSofTrimCal2Hit::Exec() TrimHitPar Container not found";
-    }
-
     // Local variables at Cal Level
-    Int_t iSec, iAnode;
-    UInt_t mult[fNumSections * fNumAnodes];
-    Float_t e[fNumSections * fNumAnodes];
-    Double_t dt[fNumSections * fNumAnodes];
     Double_t betaFromS2 = 0.;
 
     // Local variables at Hit Level
@@ -185,29 +237,13 @@ void R3BSofTrimCal2Hit::S455_Coulex()
         nAligned = fNumAnodes / 2;
     else
         nAligned = fNumAnodes;
-    Float_t eal[fNumSections * nAligned];
-    Float_t dtal[fNumSections * nAligned];
-    Float_t sumRaw, sumBeta, sumDT, sumTheta, zval, dtSection, Ddt;
-    Double_t correction;
+    Float_t sumRaw, sumBeta, sumDT, sumTheta, zval, Ddt;
 
     // Initialization of the local variables
-    for (Int_t s = 0; s < fNumSections; s++)
-    {
-        for (Int_t a = 0; a < fNumAnodes; a++)
-        {
-            mult[a + s * fNumAnodes] = 0.;
-            e[a + s * fNumAnodes] = 0.;
-            dt[a + s * fNumAnodes] = -1000000.;
-        }
-        for (Int_t ch = 0; ch < nAligned; ch++)
-        {
-            eal[ch + s * nAligned] = 0;
-            dtal[ch + s * nAligned] = 0;
-        }
-    }
+    std::fill(fEal.begin(), fEal.end(), 0.);
 
     // Get the number of entries of the SciCalData TClonesArray and extract the beam velocity
-    if (fSciCalData)
+    if (fStrategy.UseBeta() && fSciCalData)
     {
         Int_t nHitsCalSci = fSciCalData->GetEntries();
         if (!nHitsCalSci)
@@ -224,275 +260,75 @@ void R3BSofTrimCal2Hit::S455_Coulex()
         }
     }
 
-    // Get the number of entries of the TrimCalData TClonesArray and loop over it
-    if (fTrimCalData)
+    // Cal data per anode
+    if (!fTrimCalEvent)
+        return;
+    if (fOwnCalEvent)
+        fTrimCalEvent->Fill(fTrimCalData);
+    if (!fTrimCalEvent->GetNumHits())
     {
-        Int_t nHitsCalTrim = fTrimCalData->GetEntries();
-        if (!nHitsCalTrim)
-        {
-            return;
-        }
-        for (Int_t entry = 0; entry < nHitsCalTrim; entry++)
-        {
-            R3BSofTrimCalData* iCalData = (R3BSofTrimCalData*)fTrimCalData->At(entry);
-            iSec = iCalData->GetSecID() - 1;
-            iAnode = iCalData->GetAnodeID() - 1;
-            mult[iAnode + iSec * fNumAnodes]++;
-            e[iAnode + iSec * fNumAnodes] = iCalData->GetEnergyMatch();
-            dt[iAnode + iSec * fNumAnodes] = iCalData->GetDriftTimeAligned();
-        }
+        return;
+    }
+    const R3BSofTrimCalEvent& cal = *fTrimCalEvent;
 
-        // --- Fill the HIT level --- //
-        Ddt = 0.5 * (dt[14] + dt[15]) - 0.5 * (dt[2] + dt[3]);
-        for (Int_t s = 0; s < fNumSections; s++)
-        {
-            dtSection = 0.5 * (dt[2 + s * fNumAnodes] + dt[3 + s * fNumAnodes]);
+    // --- Fill the HIT level --- //
+    // Drift time difference between the central anodes of the last and first sections
+    const Int_t last = fNumSections - 1;
+    Ddt = 0.5 * (cal.GetDriftTimeAligned(last, 2) + cal.GetDriftTimeAligned(last, 3)) -
+          0.5 * (cal.GetDriftTimeAligned(0, 2) + cal.GetDriftTimeAligned(0, 3));
+    for (Int_t s = 0; s < fNumSections; s++)
+    {
+        const UInt_t valid = cal.GetValidMask(s);
+        Float_t* eal = &fEal[s * nAligned];
 
-            // === fEnergyRaw: sum of CorrDeltaDT Energy === //
-            sumRaw = 0.;
-            nRaw = 0;
-            // if Rectangular shape:
-            if (fTriShape == kFALSE)
-            {
-                for (Int_t a = 0; a < fNumAnodes; a++)
-                {
-                    if (mult[a + s * fNumAnodes] == 1)
-                    {
-                        eal[a + s * fNumAnodes] = e[a + s * fNumAnodes];
-                        sumRaw += eal[a + s * fNumAnodes];
-                        nRaw++;
-                    }
-                } // end of loop over the anodes
-            }     // end calculation of fEnergyRaw for rectangular shape anodes
-            else
+        // === fEnergyRaw: sum of CorrDeltaDT Energy === //
+        sumRaw = 0.;
+        nRaw = 0;
+        if (fTriShape == kFALSE)
+        {
+            // rectangular shape: energy per anode
+            for (Int_t a = 0; a < fNumAnodes; a++)
             {
-                for (Int_t ch = 0; ch < nAligned; ch++)
+                if ((valid >> a) & 1u)
                 {
-                    if (mult[2 * ch + s * fNumAnodes] == 1 && mult[2 * ch + 1 + s * fNumAnodes] == 1)
-                    {
-                        // raw energy per pair: mean value of the match gain anodes
-                        eal[ch + s * nAligned] = 0.5 * (e[2 * ch + s * fNumAnodes] + e[2 * ch + 1 + s * fNumAnodes]);
-                        // correction of the DeltaDT dependency per pair
-                        correction = 0;
-                        for (Int_t deg = 0; deg < fTrimHitPar->GetNumCorrDeltaDTParsPerSignal(); deg++)
-                        {
-                            correction +=
-                                TMath::Power(Ddt, deg) * fTrimHitPar->GetEnergyCorrDeltaDTPar(s + 1, ch + 1, deg);
-                        }
-                        if (correction != 0 && fTrimHitPar->GetEnergyCorrDeltaDTPar(s + 1, ch + 1, 0) != 0)
-                        {
-                            eal[ch + s * nAligned] = fTrimHitPar->GetEnergyCorrDeltaDTPar(s + 1, ch + 1, 0) *
-                                                     eal[ch + s * nAligned] / correction;
-                        }
-                        dtal[ch + s * nAligned] = 0.5 * (dt[2 * ch + s * fNumAnodes] + dt[2 * ch + 1 + s * fNumAnodes]);
-                        // sum Raw per section
-                        sumRaw += eal[ch + s * nAligned];
-                        nRaw++;
-                    }
-                } // end of loop over the pairs
-            }     // end of calculation of fEnergyRaw for triangular shape anodes
-            if (nRaw > 0)
-                sumRaw = fTrimHitPar->GetEnergyAlignOffset(s + 1) +
-                         fTrimHitPar->GetEnergyAlignGain(s + 1) * (sumRaw / (Float_t)nRaw);
-
-            // === fEnergyBeta: fEnergyRaw corrected from the beam velocity === //
-            correction = 0;
-            double p0[3];
-            double p1[3];
-            // Run 228Th Zmax=92
-            /*p0[0] = 48.58;
-            p0[1] = 28.5266;
-            p0[2] = 43.60;
-            p1[0] = 0.2484;
-            p1[1] = 0.365484;
-            p1[2] = 0.27658;*/
-            // Run 228Th Zmax=91
-            /*
-            p0[0] = 47.58;
-            p0[1] = 27.5161;
-            p0[2] = 42.60;
-            p1[0] = 0.2484;
-            p1[1] = 0.3655;
-            p1[2] = 0.27658;
-                */
-            // Run 228Th +run 392 using Hg data for calibration
-            p0[0] = 11.78;
-            p0[1] = 9.706;
-            p0[2] = 11.690;
-            p1[0] = 0.463;
-            p1[1] = 0.47543;
-            p1[2] = 0.4622;
-
-            for (Int_t deg = 0; deg < fTrimHitPar->GetNumCorrBetaParsPerSection(); deg++)
-            {
-                correction += TMath::Power(betaFromS2, deg) * fTrimHitPar->GetEnergyCorrBetaPar(s + 1, deg);
+                    eal[a] = cal.GetEnergyMatch(s, a);
+                    sumRaw += eal[a];
+                    nRaw++;
+                }
             }
-            if (correction != 0 && fTrimHitPar->GetEnergyCorrBetaPar(s + 1, 0) != 0)
-            {
-                sumBeta = 30000. * sumRaw / correction;
-            }
-            else
+        }
+        else
+        {
+            // triangular shape: mean value of the match gain anodes per pair, corrected from DeltaDT
+            for (Int_t ch = 0; ch < nAligned; ch++)
             {
-                sumBeta = sumRaw;
+                if (((valid >> (2 * ch)) & 3u) == 3u)
+                {
+                    eal[ch] = fStrategy.CorrectDeltaDT(
+                        s, ch, Ddt, 0.5 * (cal.GetEnergyMatch(s, 2 * ch) + cal.GetEnergyMatch(s, 2 * ch + 1)));
+                    sumRaw += eal[ch];
+                    nRaw++;
+                }
             }
+        }
+        if (nRaw > 0)
+            sumRaw = fStrategy.Align(s, sumRaw / (Float_t)nRaw);
 
-            // TO DO : === fEnergyTheta: fEnergyBeta corrected from the theta angle in the Triple-MUSIC ===
-            sumTheta = sumBeta;
-
-            // TO DO : === fEnergyDT: fEnergyDT corrected from the X position in the Triple-MUSIC ===
-            sumDT = sumTheta;
-
-            // TO DO : === fZ ===
-            zval = p0[s] + p1[s] * TMath::Sqrt(sumDT);
-
-            // FILL HIT DATA
-            AddHitData(s + 1, eal[0], eal[1], eal[2], sumRaw, sumBeta, sumTheta, sumDT, zval);
-        } // end of loop over the sections
-    }
-    return;
-}
-
-// -----   Primary beam   -------------------------------------------------------
-void R3BSofTrimCal2Hit::S455_P2p()
-{
-    // Reset entries in output arrays, local arrays
-    Reset();
-
-    // Get the parameters
-    if (!fTrimHitPar)
-    {
-        LOG(error) << "R3BSofTrimCal2Hit::Exec() TrimHitPar Container not found";
-    }
-
-    // Local variables at Cal Level
-    Int_t iSec, iAnode;
-    UInt_t mult[fNumSections * fNumAnodes];
-    Float_t e[fNumSections * fNumAnodes];
-    Double_t dt[fNumSections * fNumAnodes];
-    Double_t betaFromS2 = 0.;
-
-    // Local variables at Hit Level
-    Int_t nAligned, nRaw;
-    if (fTriShape == kTRUE)
-        nAligned = fNumAnodes / 2;
-    else
-        nAligned = fNumAnodes;
-    Float_t eal[fNumSections * nAligned];
-    Float_t dtal[fNumSections * nAligned];
-    Float_t sumRaw, sumDT, sumTheta, zval, dtSection, Ddt;
-    Double_t correction;
+        // === fEnergyBeta: fEnergyRaw corrected from the beam velocity, if used by the experiment === //
+        sumBeta = fStrategy.CorrectBeta(s, betaFromS2, sumRaw);
 
-    // Initialization of the local variables
-    for (Int_t s = 0; s < fNumSections; s++)
-    {
-        for (Int_t a = 0; a < fNumAnodes; a++)
-        {
-            mult[a + s * fNumAnodes] = 0.;
-            e[a + s * fNumAnodes] = 0.;
-            dt[a + s * fNumAnodes] = -1000000.;
-        }
-        for (Int_t ch = 0; ch < nAligned; ch++)
-        {
-            eal[ch + s * nAligned] = 0;
-            dtal[ch + s * nAligned] = 0;
-        }
-    }
+        // TO DO : === fEnergyTheta: fEnergyBeta corrected from the theta angle in the Triple-MUSIC ===
+        sumTheta = sumBeta;
 
-    // Get the number of entries of the TrimCalData TClonesArray and loop over it
-    if (fTrimCalData)
-    {
-        Int_t nHitsCalTrim = fTrimCalData->GetEntries();
-        if (!nHitsCalTrim)
-        {
-            return;
-        }
-        for (Int_t entry = 0; entry < nHitsCalTrim; entry++)
-        {
-            R3BSofTrimCalData* iCalData = (R3BSofTrimCalData*)fTrimCalData->At(entry);
-            iSec = iCalData->GetSecID() - 1;
-            iAnode = iCalData->GetAnodeID() - 1;
-            mult[iAnode + iSec * fNumAnodes]++;
-            e[iAnode + iSec * fNumAnodes] = iCalData->GetEnergyMatch();
-            dt[iAnode + iSec * fNumAnodes] = iCalData->GetDriftTimeAligned();
-        }
+        // TO DO : === fEnergyDT: fEnergyDT corrected from the X position in the Triple-MUSIC ===
+        sumDT = sumTheta;
 
-        // --- Fill the HIT level --- //
-        Ddt = 0.5 * (dt[14] + dt[15]) - 0.5 * (dt[2] + dt[3]);
-        for (Int_t s = 0; s < fNumSections; s++)
-        {
-            dtSection = 0.5 * (dt[2 + s * fNumAnodes] + dt[3 + s * fNumAnodes]);
+        // === fZ === //
+        zval = fStrategy.GetZ(s, sumDT);
 
-            // === fEnergyRaw: sum of CorrDeltaDT Energy === //
-            sumRaw = 0.;
-            nRaw = 0;
-            // if Rectangular shape:
-            if (fTriShape == kFALSE)
-            {
-                for (Int_t a = 0; a < fNumAnodes; a++)
-                {
-                    if (mult[a + s * fNumAnodes] == 1)
-                    {
-                        eal[a + s * fNumAnodes] = e[a + s * fNumAnodes];
-                        sumRaw += eal[a + s * fNumAnodes];
-                        nRaw++;
-                    }
-                } // end of loop over the anodes
-            }     // end calculation of fEnergyRaw for rectangular shape anodes
-            else
-            {
-                for (Int_t ch = 0; ch < nAligned; ch++)
-                {
-                    if (mult[2 * ch + s * fNumAnodes] == 1 && mult[2 * ch + 1 + s * fNumAnodes] == 1)
-                    {
-                        // raw energy per pair: mean value of the match gain anodes
-                        eal[ch + s * nAligned] = 0.5 * (e[2 * ch + s * fNumAnodes] + e[2 * ch + 1 + s * fNumAnodes]);
-                        // correction of the DeltaDT dependency per pair
-                        correction = 0;
-                        for (Int_t deg = 0; deg < fTrimHitPar->GetNumCorrDeltaDTParsPerSignal(); deg++)
-                        {
-                            correction +=
-                                TMath::Power(Ddt, deg) * fTrimHitPar->GetEnergyCorrDeltaDTPar(s + 1, ch + 1, deg);
-                        }
-                        if (correction != 0 && fTrimHitPar->GetEnergyCorrDeltaDTPar(s + 1, ch + 1, 0) != 0)
-                        {
-                            eal[ch + s * nAligned] = fTrimHitPar->GetEnergyCorrDeltaDTPar(s + 1, ch + 1, 0) *
-                                                     eal[ch + s * nAligned] / correction;
-                        }
-                        dtal[ch + s * nAligned] = 0.5 * (dt[2 * ch + s * fNumAnodes] + dt[2 * ch + 1 + s * fNumAnodes]);
-                        // sum Raw per section
-                        sumRaw += eal[ch + s * nAligned];
-                        nRaw++;
-                    }
-                } // end of loop over the pairs
-            }     // end of calculation of fEnergyRaw for triangular shape anodes
-            if (nRaw > 0)
-                sumRaw = fTrimHitPar->GetEnergyAlignOffset(s + 1) +
-                         fTrimHitPar->GetEnergyAlignGain(s + 1) * (sumRaw / (Float_t)nRaw);
-
-            double p0[3];
-            double p1[3];
-
-            // FIXME
-            p0[0] = 11.78;
-            p0[1] = 9.706;
-            p0[2] = 11.690;
-            p1[0] = 0.463;
-            p1[1] = 0.47543;
-            p1[2] = 0.4622;
-
-            // TO DO : === fEnergyTheta: fEnergyBeta corrected from the theta angle in the Triple-MUSIC ===
-            sumTheta = sumRaw;
-
-            // TO DO : === fEnergyDT: fEnergyDT corrected from the X position in the Triple-MUSIC ===
-            sumDT = sumTheta;
-
-            // TO DO : === fZ ===
-            zval = p0[s] + p1[s] * TMath::Sqrt(sumDT);
-
-            // FILL HIT DATA
-            AddHitData(s + 1, eal[0], eal[1], eal[2], sumRaw, sumRaw, sumTheta, sumDT, zval);
-        } // end of loop over the sections
-    }
+        // FILL HIT DATA
+        AddHitData(s + 1, eal[0], eal[1], eal[2], sumRaw, sumBeta, sumTheta, sumDT, zval);
+    } // end of loop over the sections
 
     return;
 }
@@ -7,12 +7,16 @@
 
 #include "FairTask.h"
 #include "R3BEventHeader.h"
+#include "R3BSofTrimCalEvent.h"
 #include "R3BSofTrimHitData.h"
 #include "R3BSofTrimHitPar.h"
+#include "R3BSofTrimHitStrategy.h"
 #include "TH1F.h"
 
 #include <TRandom.h>
 
+#include <vector>
+
 class TClonesArray;
 class R3BEventHeader;
 class R3BSofTrimHitPar;
@@ -70,11 +74,18 @@ class R3BSofTrimCal2Hit : public FairTask
     R3BEventHeader* header;        /**< Event header. */
     R3BSofTrimHitPar* fTrimHitPar; // Parameter container
     TClonesArray* fTrimCalData;    // Array with Cal input data for Triple-MUSIC
+    R3BSofTrimCalEvent* fTrimCalEvent; // Cal input data per anode
+    Bool_t fOwnCalEvent;               // fTrimCalEvent built here from fTrimCalData
     TClonesArray* fSciCalData;     // Array with Cal input data for incoming beam velocity
     TClonesArray* fTrimHitData;    // Array with Hit output data for Triple-MUSIC
 
-    void S455_Coulex();
-    void S455_P2p();
+    // Reconstruction of the experiment, chosen once from fExpId (or the event header) and fCoulex
+    R3BSofTrimHitStrategy fStrategy; //!
+    Bool_t fStrategyChecked;
+    Bool_t fStrategyReady;
+    Bool_t SelectStrategy(Int_t expid);
+
+    std::vector<Float_t> fEal; // energy per pair (triangular) or per anode (rectangular)
 
     // --- Private method --- //
     R3BSofTrimHitData* AddHitData(Int_t secID,
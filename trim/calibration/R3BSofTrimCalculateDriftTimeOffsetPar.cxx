@@ -8,7 +8,6 @@
 #include "R3BMwpcHitData.h"
 #include "R3BSofTrimCalData.h"
 #include "TClonesArray.h"
-#include "TF1.h"
 #include "TGeoManager.h"
 #include "TGeoMatrix.h"
 #include "TMath.h"
@@ -25,13 +24,24 @@ R3BSofTrimCalculateDriftTimeOffsetPar::R3BSofTrimCalculateDriftTimeOffsetPar()
     , fNumSections(3)
     , fNumAnodes(6)
     , fMinStatistics(0)
+    , fPrecision(2.)
+    , fCheckInterval(10000)
+    , fNumEvents(0)
+    , fConverged(kFALSE)
     , fTrimCalData(NULL)
+    , fTrimCalEvent(NULL)
+    , fOwnCalEvent(kFALSE)
     , fMwpc0HitData(NULL)
     , fMwpc1HitData(NULL)
     , fCalPar(NULL)
     , fMwpc0GeoPar(NULL)
     , fMwpc1GeoPar(NULL)
     , fTrimGeoPar(NULL)
+    , fGeoX0(0.)
+    , fGeoX1(0.)
+    , fGeoZ0(0.)
+    , fGeoZ1(0.)
+    , fGeoZfirstanode(0.)
     , fWidthAnode(25)       // mm
     , fDistInterSection(50) // mm 2*edge anodes of 20 mm + 1*10 mm gap
     , fDriftVelocity(60)    // mm/micros, distance from anode to FG: 80 mm with a difference of V = 2700V
@@ -45,13 +55,24 @@ R3BSofTrimCalculateDriftTimeOffsetPar::R3BSofTrimCalculateDriftTimeOffsetPar(con
     , fNumSections(0)
     , fNumAnodes(0)
     , fMinStatistics(0)
+    , fPrecision(2.)
+    , fCheckInterval(10000)
+    , fNumEvents(0)
+    , fConverged(kFALSE)
     , fTrimCalData(NULL)
+    , fTrimCalEvent(NULL)
+    , fOwnCalEvent(kFALSE)
     , fMwpc0HitData(NULL)
     , fMwpc1HitData(NULL)
     , fCalPar(NULL)
     , fMwpc0GeoPar(NULL)
     , fMwpc1GeoPar(NULL)
     , fTrimGeoPar(NULL)
+    , fGeoX0(0.)
+    , fGeoX1(0.)
+    , fGeoZ0(0.)
+    , fGeoZ1(0.)
+    , fGeoZfirstanode(0.)
     , fWidthAnode(25)       // mm
     , fDistInterSection(50) // mm
     , fDriftVelocity(60)    // mm/micros
@@ -73,6 +94,9 @@ R3BSofTrimCalculateDriftTimeOffsetPar::~R3BSofTrimCalculateDriftTimeOffsetPar()
 
     if (fTrimGeoPar)
         delete fTrimGeoPar;
+
+    if (fOwnCalEvent && fTrimCalEvent)
+        delete fTrimCalEvent;
 }
 
 // -----   Public method Init   --------------------------------------------
@@ -91,11 +115,17 @@ InitStatus R3BSofTrimCalculateDriftTimeOffsetPar::Init()
     // --- INPUT TRIM CAL DATA --- //
     // --- ------------------- --- //
 
-    fTrimCalData = (TClonesArray*)rm->GetObject("TrimCalData");
-    if (!fTrimCalData)
+    // Record per anode of R3BSofTrimMapped2Cal, or built here from the cal data of the input file
+    fTrimCalEvent = (R3BSofTrimCalEvent*)rm->GetObject("TrimCalEvent");
+    if (!fTrimCalEvent)
     {
-        LOG(error) << "R3BSofTrimCalculateDriftTimeOffsetPar::Init() Couldn't get handle on TrimCalData";
-        return kFATAL;
+        fTrimCalData = (TClonesArray*)rm->GetObject("TrimCalData");
+        if (!fTrimCalData)
+        {
+            LOG(error) << "R3BSofTrimCalculateDriftTimeOffsetPar::Init() Couldn't get handle on TrimCalData";
+            return kFATAL;
+        }
+        fOwnCalEvent = kTRUE;
     }
 
     // --- -------------------- --- //
@@ -148,6 +178,14 @@ InitStatus R3BSofTrimCalculateDriftTimeOffsetPar::Init()
                   << fNumSections;
     }
 
+    if (fOwnCalEvent)
+        fTrimCalEvent = new R3BSofTrimCalEvent(fNumSections, fNumAnodes);
+    if (fTrimCalEvent->GetNumSections() < fNumSections || fTrimCalEvent->GetNumAnodes() < fNumAnodes)
+    {
+        LOG(error) << "R3BSofTrimCalculateDriftTimeOffsetPar::Init() TrimCalEvent smaller than trimCalPar";
+        return kFATAL;
+    }
+
     // --- ---------------------- --- //
     // ---  GEOMETRY OF THE MWPC0 --- //
     // --- ---------------------- --- //
@@ -187,22 +225,35 @@ InitStatus R3BSofTrimCalculateDriftTimeOffsetPar::Init()
     else
         LOG(info) << "R3BSofSciCalculateDriftTimeOffsetPar::SetParContainers() : Container trimGeoPar found.";
 
-    // --- ---------------------- --- //
-    // --- HISTOGRAMS DECLARATION --- //
-    // --- ---------------------- --- //
-
-    char name[100];
-    fh1_DeltaDT = new TH1D*[fNumSections * fNumAnodes];
-    for (Int_t section = 0; section < fNumSections; section++)
+    // --- ------------------------------------------------ --- //
+    // --- GEOMETRY IN mm (GetPos in cm), READ ONCE FOR THE RUN --- //
+    // --- ------------------------------------------------ --- //
+    fGeoX0 = 10. * fMwpc0GeoPar->GetPosX();
+    fGeoX1 = 10. * fMwpc1GeoPar->GetPosX();
+    fGeoZ0 = 10. * fMwpc0GeoPar->GetPosZ();
+    fGeoZ1 = 10. * fMwpc1GeoPar->GetPosZ();
+    if (fGeoZ1 == fGeoZ0)
     {
-        for (Int_t anode = 0; anode < fNumAnodes; anode++)
-        {
-            sprintf(name, "DeltaDT_S%iA%i", section + 1, anode + 1);
-            fh1_DeltaDT[anode + section * fNumAnodes] = new TH1D(name, name, 4000, -20000, 20000);
-            fh1_DeltaDT[anode + section * fNumAnodes]->GetXaxis()->SetTitle(
-                "Delta Drift Time [channels, 100 ps TDC resolution]");
-        }
+        LOG(error) << "R3BSofTrimCalculateDriftTimeOffsetPar::Init() Mwpc0 and Mwpc1 at the same Z";
+        return kFATAL;
     }
+    // The position of the Triple-MUSIC is its center
+    // The active volume of the Triple-MUSIC is 590 mm
+    // The width of the screening anode is 20 mm each
+    // Therefore, the rim of the first anode of the first section is located 275 mm upstream of the center
+    fGeoZfirstanode = 10. * fTrimGeoPar->GetPosZ() - 275. + 0.5 * fWidthAnode;
+    LOG(info) << "R3BSofTrimCalculateDriftTimeOffsetPar::Init() Mwpc0 at (X,Z) = (" << fGeoX0 << "," << fGeoZ0
+              << ") mm, Mwpc1 at (" << fGeoX1 << "," << fGeoZ1 << ") mm, first anode at Z = " << fGeoZfirstanode
+              << " mm";
+
+    // --- ------------------------ --- //
+    // --- RESIDUALS DECLARATION --- //
+    // --- ------------------------ --- //
+
+    // Delta drift time [channels, 100 ps TDC resolution]
+    fDeltaDT.assign(fNumSections * fNumAnodes, R3BSofTrimResidualPeak(4000, -20000., 20000.));
+    fNumEvents = 0;
+    fConverged = kFALSE;
 
     return kSUCCESS;
 }
@@ -213,70 +264,56 @@ InitStatus R3BSofTrimCalculateDriftTimeOffsetPar::ReInit() { return kSUCCESS; }
 // -----   Public method Exec   --------------------------------------------
 void R3BSofTrimCalculateDriftTimeOffsetPar::Exec(Option_t* opt)
 {
+    // The offsets are known with the requested precision: the rest of the run is not needed
+    if (fConverged)
+        return;
 
-    Int_t iSec, iAnode;
-    Double_t geoX0, geoX1, geoZ0, geoZ1, geoDZ;
-    Double_t X0, X1, DX;
-    Double_t geoZtrim, geoZfirstanode, Xanode, DTraw, ZposAnode;
-    UInt_t nHitsMw0, nHitsMw1, nHits;
-
-    // FIX ME:
-    geoX0 = 3;      // mm
-    geoX1 = 0.;     // mm
-    geoZ0 = -2620.; // mm
-    geoZ1 = 300.;   // mm
-    geoDZ = geoZ1 - geoZ0;
-    geoZtrim = -2175; // mm
-    // geoX0 = 10. * (Double_t)fMwpc0GeoPar->GetPosX();
-    // geoX1 = 10. * (Double_t)fMwpc1GeoPar->GetPosX();
-    // geoZ0 = 10. * (Double_t)fMwpc0GeoPar->GetPosZ();
-    // geoZ1 = 10. * (Double_t)fMwpc1GeoPar->GetPosZ();
-    // geoZtrim = 10. * (Double_t)fTrimGeoPar->GetPosZ();
-    // geoZtrim is the center of the Triple-MUSIC in cm
-    // The active volume of the Triple-MUSIC is 590 mm = 59 cm
-    // The width of the screening anode is 20 mm = 2 cm each
-    // Therefore, the rim of the first anode of the first section is located 275 mm downstream
-    geoZfirstanode = geoZtrim - 275 + 0.5 * fWidthAnode;
+    Double_t X0, X1, slope;
+    Double_t Xanode, DTraw, ZposAnode;
+    UInt_t nHitsMw0, nHitsMw1;
 
     // --- -------------- --- //
     // --- MWPCs HIT DATA --- //
     // --- -------------- --- //
     nHitsMw0 = fMwpc0HitData->GetEntries();
     nHitsMw1 = fMwpc1HitData->GetEntries();
-    // if (nHitsMw0 != 0)
-    //{
-    //    std::cout << std::endl;
-    //    std::cout << "nHitsMw0=" << nHitsMw0 << ", nHitsMw1=" << nHitsMw1 << std::endl;
-    //}
     if (nHitsMw0 == 1 && nHitsMw1 == 1)
     {
         R3BMwpcHitData* hitMwpc0 = (R3BMwpcHitData*)fMwpc0HitData->At(0);
         R3BMwpcHitData* hitMwpc1 = (R3BMwpcHitData*)fMwpc1HitData->At(0);
-        X0 = hitMwpc0->GetX() + geoX0;
-        X1 = hitMwpc1->GetX() + geoX1;
-        DX = X1 - X0;
-
-        // --- --------------------------------------- --- //
-        // --- LOOP OVER TRIANGLE CAL HITS FOR SofTrim --- //
-        // --- --------------------------------------- --- //
-        nHits = fTrimCalData->GetEntries();
-        if (!nHits)
+        X0 = hitMwpc0->GetX() + fGeoX0;
+        X1 = hitMwpc1->GetX() + fGeoX1;
+        slope = (X1 - X0) / (fGeoZ1 - fGeoZ0);
+
+        // --- ---------------------------------------------- --- //
+        // --- LOOP OVER THE ANODES WITH CAL DATA FOR SofTrim --- //
+        // --- ---------------------------------------------- --- //
+        if (fOwnCalEvent)
+            fTrimCalEvent->Fill(fTrimCalData);
+        if (!fTrimCalEvent->GetNumHits())
             return;
-        for (Int_t ihit = 0; ihit < nHits; ihit++)
+        for (Int_t iSec = 0; iSec < fNumSections; iSec++)
         {
-            R3BSofTrimCalData* hit = (R3BSofTrimCalData*)fTrimCalData->At(ihit);
-            iSec = hit->GetSecID() - 1;
-            iAnode = hit->GetAnodeID() - 1;
-            DTraw = hit->GetDriftTimeRaw();
-            // std::cout << "Section:" << iSec + 1 << ", Anode:" << iAnode + 1 << ", DTraw=" << DTraw << std::endl;
-            ZposAnode = geoZfirstanode + (Double_t)(iAnode + iSec * fNumAnodes) * fWidthAnode +
-                        (Double_t)iSec * fDistInterSection;
-            Xanode = (ZposAnode * DX) / geoDZ;
-            // std::cout << "ZposAnode=" << ZposAnode << " mm, Xanode=" << Xanode << " mm or "
-            //          << 1000. * Xanode / fDriftVelocity << " [100 ps]" << std::endl;
-            fh1_DeltaDT[iAnode + iSec * fNumAnodes]->Fill(10000. * Xanode / fDriftVelocity -
+            for (Int_t iAnode = 0; iAnode < fNumAnodes; iAnode++)
+            {
+                if (fTrimCalEvent->GetMult(iSec, iAnode) == 0)
+                    continue;
+                DTraw = fTrimCalEvent->GetDriftTimeRaw(iSec, iAnode); // first hit
+                ZposAnode = fGeoZfirstanode + (Double_t)(iAnode + iSec * fNumAnodes) * fWidthAnode +
+                            (Double_t)iSec * fDistInterSection;
+                Xanode = X0 + (ZposAnode - fGeoZ0) * slope;
+                fDeltaDT[iAnode + iSec * fNumAnodes].Fill(10000. * Xanode / fDriftVelocity -
                                                           DTraw); // 10000 : mm/micros -> mm/100ps
-        }                                                         // end of loop over the mapped data
+            }
+        } // end of loop over the anodes
+    }
+
+    fNumEvents++;
+    if (fCheckInterval > 0 && fNumEvents % fCheckInterval == 0 && CalculateOffsets())
+    {
+        fConverged = kTRUE;
+        LOG(info) << "R3BSofTrimCalculateDriftTimeOffsetPar: all the offsets converged after " << fNumEvents
+                  << " events, the remaining events are skipped";
     }
 }
 
@@ -288,45 +325,41 @@ void R3BSofTrimCalculateDriftTimeOffsetPar::FinishEvent() {}
 // ---- Public method Finish   --------------------------------------------------
 void R3BSofTrimCalculateDriftTimeOffsetPar::FinishTask()
 {
-    CalculateOffsets();
+    if (!fConverged && !CalculateOffsets())
+        LOG(warn) << "R3BSofTrimCalculateDriftTimeOffsetPar: not all the offsets reached a precision of "
+                  << fPrecision << " channels in " << fNumEvents << " events";
     fCalPar->printParams();
 }
 
 // ------------------------------
-void R3BSofTrimCalculateDriftTimeOffsetPar::CalculateOffsets()
+Bool_t R3BSofTrimCalculateDriftTimeOffsetPar::CalculateOffsets()
 {
-    LOG(info) << "R3BSofTrimCalculateDriftTimeOffsetPar: CalculateOffsets()";
-
-    Double_t BinMax, X_BinMax;
-    TF1** fit_max = new TF1*[fNumSections * fNumAnodes];
+    LOG(debug) << "R3BSofTrimCalculateDriftTimeOffsetPar: CalculateOffsets()";
 
+    // Peak of the residual fitted within +/- 500 channels of its maximum, then +/- 2.5 sigma
+    Double_t mean, error, sigma;
+    UInt_t nPeak;
+    Bool_t converged = kTRUE;
     for (Int_t section = 0; section < fNumSections; section++)
     {
         for (Int_t anode = 0; anode < fNumAnodes; anode++)
         {
-            fh1_DeltaDT[anode + section * fNumAnodes]->Write();
-            if (fh1_DeltaDT[anode + section * fNumAnodes]->Integral() > fMinStatistics)
+            if (!fDeltaDT[anode + section * fNumAnodes].Fit(500., 2.5, fMinStatistics, mean, error, sigma, nPeak))
             {
-                BinMax = fh1_DeltaDT[anode + section * fNumAnodes]->GetMaximumBin();
-                X_BinMax = fh1_DeltaDT[anode + section * fNumAnodes]->GetBinCenter(BinMax);
-                fit_max[anode + section * fNumAnodes] = new TF1("fit_gaus", "gaus", X_BinMax - 500, X_BinMax + 500);
-                fh1_DeltaDT[anode + section * fNumAnodes]->Fit(fit_max[anode + section * fNumAnodes], "R");
-                fCalPar->SetDriftTimeOffset(
-                    section + 1, anode + 1, fit_max[anode + section * fNumAnodes]->GetParameter(1));
+                converged = kFALSE;
+                continue;
             }
+            fCalPar->SetDriftTimeOffset(mean, section + 1, anode + 1);
+            if (error > fPrecision)
+                converged = kFALSE;
+            LOG(debug) << "R3BSofTrimCalculateDriftTimeOffsetPar: section " << section + 1 << ", anode "
+                       << anode + 1 << ", offset = " << mean << " +/- " << error << " (sigma " << sigma << ", "
+                       << nPeak << " events)";
         }
     }
 
     fCalPar->setChanged();
-    fCalPar->printParams();
-    for (Int_t section = 0; section < fNumSections; section++)
-    {
-        for (Int_t anode = 0; anode < fNumAnodes; anode++)
-        {
-            std::cout << fit_max[anode + section * fNumAnodes]->GetParameter(1) << std::endl;
-        }
-    }
-    return;
+    return converged;
 }
 
 ClassImp(R3BSofTrimCalculateDriftTimeOffsetPar)
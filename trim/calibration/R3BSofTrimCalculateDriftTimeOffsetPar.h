@@ -2,10 +2,13 @@
 #define __R3BSofTrimDTOffsetPar_H__
 
 #include "FairTask.h"
+#include "R3BSofTrimCalEvent.h"
 #include "R3BSofTrimCalPar.h"
+#include "R3BSofTrimResidualPeak.h"
 #include "R3BTGeoPar.h"
 #include "TClonesArray.h"
-#include "TH1.h"
+
+#include <vector>
 
 class R3BEventHeader;
 
@@ -40,8 +43,8 @@ class R3BSofTrimCalculateDriftTimeOffsetPar : public FairTask
     /** Virtual method ReInit **/
     virtual InitStatus ReInit();
 
-    /** Virtual method calculate the gain matching of both anodes  **/
-    virtual void CalculateOffsets();
+    /** Virtual method calculate the drift time offsets, returns kTRUE if all the anodes converged **/
+    virtual Bool_t CalculateOffsets();
 
     void SetOutputFile(const char* outFile);
 
@@ -49,6 +52,9 @@ class R3BSofTrimCalculateDriftTimeOffsetPar : public FairTask
     const Int_t GetNumSections() { return fNumSections; }
     const Int_t GetNumAnodes() { return fNumAnodes; }
     const Int_t GetMinStatistics() { return fMinStatistics; }
+    const Double_t GetPrecision() { return fPrecision; }
+    const Int_t GetCheckInterval() { return fCheckInterval; }
+    const Bool_t IsConverged() { return fConverged; }
 
     const Double_t GetWidthAnode() { return fWidthAnode; }
     const Double_t GetDistInterSection() { return fDistInterSection; }
@@ -57,6 +63,10 @@ class R3BSofTrimCalculateDriftTimeOffsetPar : public FairTask
     void SetNumSections(Int_t n) { fNumSections = n; }
     void SetNumAnodes(Int_t n) { fNumAnodes = n; }
     void SetMinStatistics(Int_t minstat) { fMinStatistics = minstat; }
+    /** Convergence: error on the offset of every anode below prec, in channels of 100 ps **/
+    void SetPrecision(Double_t prec) { fPrecision = prec; }
+    /** Number of events between two fits of the offsets, 0 fits only at the end of the run **/
+    void SetCheckInterval(Int_t n) { fCheckInterval = n; }
 
     void SetWidthAnode(Double_t w) { fWidthAnode = w; }
     void SetDistInterSection(Double_t d) { fDistInterSection = d; }
@@ -66,12 +76,23 @@ class R3BSofTrimCalculateDriftTimeOffsetPar : public FairTask
     Int_t fNumSections;
     Int_t fNumAnodes;
     Int_t fMinStatistics; // minimum statistics to proceed to the calibration
+    Double_t fPrecision;  // channels
+    Int_t fCheckInterval; // events
+    Int_t fNumEvents;
+    Bool_t fConverged;
 
     // Geometry for Mwpc0 and Mwpc1
     R3BTGeoPar* fMwpc0GeoPar;
     R3BTGeoPar* fMwpc1GeoPar;
     R3BTGeoPar* fTrimGeoPar;
 
+    // Geometry read in Init, mm
+    Double_t fGeoX0;
+    Double_t fGeoX1;
+    Double_t fGeoZ0;
+    Double_t fGeoZ1;
+    Double_t fGeoZfirstanode;
+
     Double_t fWidthAnode;
     Double_t fDistInterSection;
     Double_t fDriftVelocity;
@@ -81,11 +102,13 @@ class R3BSofTrimCalculateDriftTimeOffsetPar : public FairTask
 
     // input data
     TClonesArray* fTrimCalData;
+    R3BSofTrimCalEvent* fTrimCalEvent; // per anode, built here from fTrimCalData if fOwnCalEvent
+    Bool_t fOwnCalEvent;
     TClonesArray* fMwpc0HitData;
     TClonesArray* fMwpc1HitData;
 
-    // histograms
-    TH1D** fh1_DeltaDT;
+    // residual distributions, anode + section * fNumAnodes
+    std::vector<R3BSofTrimResidualPeak> fDeltaDT; //!
 
     char* fOutputFile;
 
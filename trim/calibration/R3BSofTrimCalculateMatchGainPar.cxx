@@ -6,6 +6,7 @@
 #include "FairRuntimeDb.h"
 #include "R3BEventHeader.h"
 #include "R3BSofTrimCalData.h"
+#include "R3BSofTrimCalEvent.h"
 #include "R3BSofTrimCalPar.h"
 #include "TClonesArray.h"
 #include "TGeoManager.h"
@@ -24,12 +25,16 @@ R3BSofTrimCalculateMatchGainPar::R3BSofTrimCalculateMatchGainPar()
     , fNumSections(3)
     , fNumAnodes(6)
     , fNumPairsPerSection(3)
+    , fNumYBins(16)
+    , fYMin(-0.4)
+    , fYMax(0.4)
+    , fMinStatistics(100)
     , fCalData(NULL)
+    , fCalEvent(NULL)
+    , fOwnCalEvent(kFALSE)
     , fCalPar(NULL)
-    , fEpsilon(0.01)
     , fOutputFile(NULL)
 {
-    fGainMin = new TArrayF(9);
 }
 
 // R3BSofTrimCalculateMatchGainPar: Standard Constructor --------------------------
@@ -38,12 +43,16 @@ R3BSofTrimCalculateMatchGainPar::R3BSofTrimCalculateMatchGainPar(const char* nam
     , fNumSections(3)
     , fNumAnodes(6)
     , fNumPairsPerSection(3)
+    , fNumYBins(16)
+    , fYMin(-0.4)
+    , fYMax(0.4)
+    , fMinStatistics(100)
     , fCalData(NULL)
+    , fCalEvent(NULL)
+    , fOwnCalEvent(kFALSE)
     , fCalPar(NULL)
-    , fEpsilon(0.01)
     , fOutputFile(NULL)
 {
-    fGainMin = new TArrayF(9);
 }
 
 // R3BSofTrimCalculateMatchGainPar: Destructor ----------------------------------------
@@ -51,6 +60,8 @@ R3BSofTrimCalculateMatchGainPar::~R3BSofTrimCalculateMatchGainPar()
 {
     if (fCalPar)
         delete fCalPar;
+    if (fOwnCalEvent && fCalEvent)
+        delete fCalEvent;
 }
 
 // -----   Public method Init   --------------------------------------------
@@ -69,11 +80,17 @@ InitStatus R3BSofTrimCalculateMatchGainPar::Init()
     // --- INPUT CAL DATA --- //
     // --- -------------- --- //
 
-    fCalData = (TClonesArray*)rm->GetObject("TrimCalData");
-    if (!fCalData)
+    // Record per anode of R3BSofTrimMapped2Cal, or built here from the cal data of the input file
+    fCalEvent = (R3BSofTrimCalEvent*)rm->GetObject("TrimCalEvent");
+    if (!fCalEvent)
     {
-        LOG(error) << "R3BSofTrimCalculateMatchGainPar::Init() Couldn't get handle on TrimCalData";
-        return kFATAL;
+        fCalData = (TClonesArray*)rm->GetObject("TrimCalData");
+        if (!fCalData)
+        {
+            LOG(error) << "R3BSofTrimCalculateMatchGainPar::Init() Couldn't get handle on TrimCalData";
+            return kFATAL;
+        }
+        fOwnCalEvent = kTRUE;
     }
 
     // --- ------------------------------------------ --- //
@@ -100,30 +117,22 @@ InitStatus R3BSofTrimCalculateMatchGainPar::Init()
                   << fNumSections;
     }
 
-    // --- ---------------------- --- //
-    // --- HISTOGRAMS DECLARATION --- //
-    // --- ---------------------- --- //
-
-    char name[100];
-    fh2_TrimPerPair_Esub_vs_Y = new TH2D*[fNumSections * fNumPairsPerSection * 9];
-    for (Int_t sec = 0; sec < fNumSections; sec++)
+    if (fOwnCalEvent)
+        fCalEvent = new R3BSofTrimCalEvent(fNumSections, fNumAnodes);
+    if (fCalEvent->GetNumSections() < fNumSections || fCalEvent->GetNumAnodes() < fNumAnodes)
     {
-        for (Int_t pair = 0; pair < 3; pair++)
-        {
-            for (Int_t k = 0; k < 9; k++)
-            {
-                sprintf(name, "Trim_Esub_vs_Y_Sec%i_Pair%i_k%i", sec + 1, pair + 1, k + 1);
-                fh2_TrimPerPair_Esub_vs_Y[k + pair * 9 + sec * 9 * fNumPairsPerSection] =
-                    new TH2D(name, name, 640, -0.4, 0.4, 1000, 0, 10000);
-                fh2_TrimPerPair_Esub_vs_Y[k + pair * 9 + sec * 9 * fNumPairsPerSection]->GetXaxis()->SetTitle(
-                    "Ratio between EsubDiff and EsubSum <=> Y [channels]");
-                fh2_TrimPerPair_Esub_vs_Y[k + pair * 9 + sec * 9 * fNumPairsPerSection]->GetYaxis()->SetTitle(
-                    "EsubSum [channels]");
-                fh2_TrimPerPair_Esub_vs_Y[k + pair * 9 + sec * 9 * fNumPairsPerSection]->ls();
-            }
-        }
+        LOG(error) << "R3BSofTrimCalculateMatchGainPar::Init() TrimCalEvent smaller than trimCalPar";
+        return kFATAL;
     }
 
+    // --- ------------------------- --- //
+    // --- ACCUMULATORS DECLARATION --- //
+    // --- ------------------------- --- //
+
+    fNumPairsPerSection = fNumAnodes / 2;
+    fAccumulators.assign(fNumSections * fNumPairsPerSection,
+                         R3BSofTrimMatchGainAccumulator(fNumYBins, fYMin, fYMax));
+
     return kSUCCESS;
 }
 
@@ -134,56 +143,29 @@ InitStatus R3BSofTrimCalculateMatchGainPar::ReInit() { return kSUCCESS; }
 void R3BSofTrimCalculateMatchGainPar::Exec(Option_t* opt)
 {
 
-    Int_t iSec, iAnode, iPair;
-    Double_t Esub[fNumSections * fNumAnodes];
-    Double_t EsubDown;
-    Double_t EsubUp;
-    UInt_t mult[fNumSections * fNumAnodes];
-    Double_t Esum, Ediff, gain_match_local;
-
-    for (UShort_t anode = 0; anode < fNumSections * fNumAnodes; anode++)
-        mult[anode] = 0;
-
-    // --- ------------------------------ --- //
-    // --- LOOP OVER CAL DATA FOR SofTrim --- //
-    // --- ------------------------------ --- //
-    UInt_t nHits = fCalData->GetEntries();
-    if (!nHits)
+    // --- -------------------------- --- //
+    // --- CAL DATA PER ANODE FOR SofTrim --- //
+    // --- -------------------------- --- //
+    if (fOwnCalEvent)
+        fCalEvent->Fill(fCalData);
+    if (!fCalEvent->GetNumHits())
         return;
-    for (Int_t ihit = 0; ihit < nHits; ihit++)
-    {
-        R3BSofTrimCalData* hit = (R3BSofTrimCalData*)fCalData->At(ihit);
-        iSec = hit->GetSecID() - 1;
-        iAnode = hit->GetAnodeID() - 1;
-        mult[iAnode + iSec * fNumAnodes]++;
-        Esub[iAnode + iSec * fNumAnodes] = (Double_t)hit->GetEnergySub();
-    } // end of loop over the cal data
-
-    // --- --------------------------------------------- --- //
-    // --- FILL THE HISTOGRAMS WITH CLEAN DATA (mult==1) --- //
-    // --- --------------------------------------------- --- //
+
+    // --- ----------------------------------------------- --- //
+    // --- FILL THE ACCUMULATORS WITH CLEAN DATA (mult==1) --- //
+    // --- ----------------------------------------------- --- //
     for (Int_t section = 0; section < fNumSections; section++)
     {
-        for (Int_t pair = 0; pair < 3; pair++)
+        const UInt_t valid = fCalEvent->GetValidMask(section);
+        for (Int_t pair = 0; pair < fNumPairsPerSection; pair++)
         {
-            if ((mult[pair * 2 + section * fNumAnodes] == mult[pair * 2 + 1 + section * fNumAnodes]) &&
-                (mult[pair * 2 + section * fNumAnodes] == 1))
+            if (((valid >> (pair * 2)) & 3u) == 3u)
             {
-                for (Int_t k = 0; k < 9; k++)
-                {
-                    gain_match_local = GetGainMin(pair + section * 3) + (Double_t)k * (Double_t)fEpsilon;
-                    EsubDown = (Double_t)Esub[pair * 2 + 1 + section * fNumAnodes];
-                    EsubUp = (Double_t)Esub[pair * 2 + section * fNumAnodes];
-                    Esum = EsubUp + gain_match_local * (Double_t)EsubDown;
-                    Ediff = (Double_t)EsubUp - gain_match_local * (Double_t)EsubDown;
-                    if (Esum != 0)
-                    {
-                        fh2_TrimPerPair_Esub_vs_Y[k + pair * 9 + section * 9 * 3]->Fill(Ediff / Esum, 0.1 * Esum);
-                    }
-                }
-            } // end of check mult up = mult down
-        }     // end of loop over the pairs
-    }         // end of loop over the sections
+                fAccumulators[pair + section * fNumPairsPerSection].Fill(
+                    fCalEvent->GetEnergySub(section, pair * 2), fCalEvent->GetEnergySub(section, pair * 2 + 1));
+            }
+        } // end of loop over the pairs
+    }     // end of loop over the sections
 }
 
 // ---- Public method Reset   --------------------------------------------------
@@ -194,33 +176,37 @@ void R3BSofTrimCalculateMatchGainPar::FinishEvent() {}
 // ---- Public method Finish   --------------------------------------------------
 void R3BSofTrimCalculateMatchGainPar::FinishTask()
 {
-    PlotEvsY();
+    CalculateGains();
     fCalPar->printParams();
 }
 
 // ------------------------------
-void R3BSofTrimCalculateMatchGainPar::PlotEvsY()
+void R3BSofTrimCalculateMatchGainPar::CalculateGains()
 {
-    LOG(info) << "R3BSofTrimCalculateMatchGainPar: PlotEvsY()";
-    char name[100];
+    LOG(info) << "R3BSofTrimCalculateMatchGainPar: CalculateGains()";
 
-    TCanvas* can[9];
-    for (int i = 0; i < 9; i++)
+    // The gain of the up anode of a pair makes gain * Esub(up) + Esub(down) independent of Y,
+    // the down anode keeps a gain 1. Pairs without enough statistics keep their parameters
+    Double_t gain, error;
+    for (Int_t section = 0; section < fNumSections; section++)
     {
-        sprintf(name, "Pair%i", i + 1);
-        can[i] = new TCanvas(name, name, 0, 0, 800, 700);
-        can[i]->Divide(3, 3);
-        for (int j = 0; j < 9; j++)
+        for (Int_t pair = 0; pair < fNumPairsPerSection; pair++)
         {
-            can[i]->cd(j + 1);
-            gPad->SetGridy();
-            fh2_TrimPerPair_Esub_vs_Y[j + 9 * i]->Draw("colz");
-            fh2_TrimPerPair_Esub_vs_Y[j + 9 * i]->SetDirectory(0);
-            fh2_TrimPerPair_Esub_vs_Y[j + 9 * i]->Write();
+            const R3BSofTrimMatchGainAccumulator& acc = fAccumulators[pair + section * fNumPairsPerSection];
+            if (!acc.Solve(fMinStatistics, gain, error))
+            {
+                LOG(warn) << "R3BSofTrimCalculateMatchGainPar: section " << section + 1 << ", pair " << pair + 1
+                          << " not calibrated, " << acc.GetEntries() << " events";
+                continue;
+            }
+            LOG(info) << "R3BSofTrimCalculateMatchGainPar: section " << section + 1 << ", pair " << pair + 1
+                      << ", gain = " << gain << " +/- " << error << " from " << acc.GetEntries() << " events";
+            fCalPar->SetEnergyMatchGain(gain, section + 1, pair * 2 + 1);
+            fCalPar->SetEnergyMatchGain(1., section + 1, pair * 2 + 2);
         }
-        can[i]->Write();
     }
 
+    fCalPar->setChanged();
     return;
 }
 
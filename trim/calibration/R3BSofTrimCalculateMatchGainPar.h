@@ -2,13 +2,12 @@
 #define __R3BSOFTRIMMATCHGAINPAR_H__
 
 #include "FairTask.h"
-#include "TCanvas.h"
-#include "TF1.h"
-#include "TGraph.h"
-#include "TH1D.h"
-#include "TH2D.h"
+#include "R3BSofTrimMatchGainAccumulator.h"
+
+#include <vector>
 
 class TClonesArray;
+class R3BSofTrimCalEvent;
 class R3BSofTrimCalPar;
 class R3BEventHeader;
 
@@ -44,29 +43,40 @@ class R3BSofTrimCalculateMatchGainPar : public FairTask
     virtual InitStatus ReInit();
 
     /** Virtual method calculate the gain matching of both anodes  **/
-    virtual void PlotEvsY();
+    virtual void CalculateGains();
 
     void SetOutputFile(const char* outFile);
 
-    void SetEpsilon(Float_t e) { fEpsilon = e; }
-    void SetGainMin(Float_t gain, Int_t rank) { fGainMin->AddAt(gain, rank); }
-    Float_t GetGainMin(Int_t rank) { return fGainMin->GetAt(rank); }
+    /** Binning of the position Y = (Esub up - Esub down) / (Esub up + Esub down) **/
+    void SetYBinning(Int_t nbins, Double_t ymin, Double_t ymax)
+    {
+        fNumYBins = nbins;
+        fYMin = ymin;
+        fYMax = ymax;
+    }
+
+    /** Minimum number of events in a Y bin to use it **/
+    void SetMinStatistics(Int_t minstat) { fMinStatistics = minstat; }
 
   protected:
     Int_t fNumSections;
     Int_t fNumAnodes;
     Int_t fNumPairsPerSection;
-    Float_t fEpsilon;
-    TArrayF* fGainMin;
+    Int_t fNumYBins;
+    Double_t fYMin;
+    Double_t fYMax;
+    Int_t fMinStatistics;
 
     // calibration parameters
     R3BSofTrimCalPar* fCalPar;
 
     // input data
     TClonesArray* fCalData;
+    R3BSofTrimCalEvent* fCalEvent; // per anode, built here from fCalData if fOwnCalEvent
+    Bool_t fOwnCalEvent;
 
-    // histograms
-    TH2D** fh2_TrimPerPair_Esub_vs_Y;
+    // moments of Esub up and down per pair, pair + section * fNumPairsPerSection
+    std::vector<R3BSofTrimMatchGainAccumulator> fAccumulators; //!
     char* fOutputFile;
 
   public:
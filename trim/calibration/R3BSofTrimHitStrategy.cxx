@@ -0,0 +1,115 @@
+// --------------------------------------------------------------
+// -----              R3BSofTrimHitStrategy                 -----
+// --------------------------------------------------------------
+
+#include "R3BSofTrimHitStrategy.h"
+
+#include "FairLogger.h"
+#include "R3BSofTrimHitPar.h"
+
+namespace
+{
+    // Known experiments. A new experiment needs its line here and its parameter set, not new code
+    struct Experiment
+    {
+        Int_t expId;
+        Bool_t coulex;
+        const char* name;
+        Bool_t useBeta;
+    };
+
+    const Experiment kExperiments[] = {
+        { 455, kTRUE, "s455 Coulex", kTRUE }, // exotic beams, energy corrected from beta at Cave C
+        { 455, kFALSE, "s455 p2p", kFALSE },  // primary beam
+    };
+} // namespace
+
+R3BSofTrimHitStrategy::R3BSofTrimHitStrategy()
+    : fName(nullptr)
+    , fExpId(0)
+    , fUseBeta(kFALSE)
+    , fNumSignals(0)
+    , fNumDeltaDT(0)
+    , fNumBeta(0)
+    , fNumZ(0)
+{
+}
+
+R3BSofTrimHitStrategy::~R3BSofTrimHitStrategy() {}
+
+Bool_t R3BSofTrimHitStrategy::Select(Int_t expId, Bool_t coulex)
+{
+    fName = nullptr;
+    fExpId = expId;
+    for (const Experiment& exp : kExperiments)
+    {
+        if (exp.expId == expId && exp.coulex == coulex)
+        {
+            fName = exp.name;
+            fUseBeta = exp.useBeta;
+            return kTRUE;
+        }
+    }
+    return kFALSE;
+}
+
+Bool_t R3BSofTrimHitStrategy::SetParameters(R3BSofTrimHitPar* par)
+{
+    if (!par)
+        return kFALSE;
+
+    const Int_t nSections = par->GetNumSections();
+    fNumSignals = par->GetNumSignalsPerSection();
+    fNumDeltaDT = par->GetNumCorrDeltaDTParsPerSignal();
+    fNumBeta = par->GetNumCorrBetaParsPerSection();
+    fNumZ = par->GetNumZParsPerSection();
+    if (par->GetEnergyCorrDeltaDTPars()->GetSize() < nSections * fNumSignals * fNumDeltaDT ||
+        par->GetEnergyCorrBetaPars()->GetSize() < nSections * fNumBeta ||
+        par->GetZPars()->GetSize() < nSections * fNumZ || fNumDeltaDT < 1 || fNumBeta < 1)
+    {
+        LOG(error) << "R3BSofTrimHitStrategy::SetParameters() Size of the arrays of trimHitPar inconsistent";
+        return kFALSE;
+    }
+
+    // DeltaDT: E * P0 / pol(DeltaDT), P0 = 0 means no correction
+    fDeltaDT.assign(nSections * fNumSignals * fNumDeltaDT, 0.);
+    for (Int_t s = 0; s < nSections; s++)
+        for (Int_t ch = 0; ch < fNumSignals; ch++)
+        {
+            Double_t* c = &fDeltaDT[(s * fNumSignals + ch) * fNumDeltaDT];
+            Double_t p0 = par->GetEnergyCorrDeltaDTPar(s + 1, ch + 1, 0);
+            c[0] = 1.;
+            if (p0 == 0.)
+                continue;
+            for (Int_t deg = 1; deg < fNumDeltaDT; deg++)
+                c[deg] = par->GetEnergyCorrDeltaDTPar(s + 1, ch + 1, deg) / p0;
+        }
+
+    fAlignOffset.resize(nSections);
+    fAlignGain.resize(nSections);
+    for (Int_t s = 0; s < nSections; s++)
+    {
+        fAlignOffset[s] = par->GetEnergyAlignOffset(s + 1);
+        fAlignGain[s] = par->GetEnergyAlignGain(s + 1);
+    }
+
+    // Beta: E * Eref / pol(beta), P0 = 0 means no correction
+    const Double_t ref = par->GetEnergyCorrBetaRef();
+    fBeta.assign(nSections * fNumBeta, 0.);
+    for (Int_t s = 0; s < nSections; s++)
+    {
+        Double_t* c = &fBeta[s * fNumBeta];
+        c[0] = 1.;
+        if (!fUseBeta || par->GetEnergyCorrBetaPar(s + 1, 0) == 0. || ref == 0.)
+            continue;
+        for (Int_t deg = 0; deg < fNumBeta; deg++)
+            c[deg] = par->GetEnergyCorrBetaPar(s + 1, deg) / ref;
+    }
+
+    fZ.resize(nSections * fNumZ);
+    for (Int_t s = 0; s < nSections; s++)
+        for (Int_t deg = 0; deg < fNumZ; deg++)
+            fZ[s * fNumZ + deg] = par->GetZPar(s + 1, deg);
+
+    return kTRUE;
+}
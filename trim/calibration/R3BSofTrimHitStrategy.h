@@ -0,0 +1,94 @@
+// --------------------------------------------------------------
+// -----              R3BSofTrimHitStrategy                 -----
+// -----    Hit reconstruction of the Triple-MUSIC for one    -----
+// -----    experiment: which corrections are applied, and    -----
+// -----    the coefficients of R3BSofTrimHitPar in flat      -----
+// -----    arrays evaluated with Horner                      -----
+// --------------------------------------------------------------
+
+#ifndef R3BSofTrimHitStrategy_H
+#define R3BSofTrimHitStrategy_H
+
+#include "Rtypes.h"
+
+#include <cmath>
+#include <vector>
+
+class R3BSofTrimHitPar;
+
+class R3BSofTrimHitStrategy
+{
+  public:
+    /** Default constructor **/
+    R3BSofTrimHitStrategy();
+
+    /** Destructor **/
+    virtual ~R3BSofTrimHitStrategy();
+
+    /** Chooses the reconstruction of an experiment in the table of the known ones, kFALSE if not known **/
+    Bool_t Select(Int_t expId, Bool_t coulex);
+
+    /** Copies the coefficients of the parameter container, to be called again when it changes **/
+    Bool_t SetParameters(R3BSofTrimHitPar* par);
+
+    Bool_t IsSelected() const { return fName != nullptr; }
+    const char* GetName() const { return fName ? fName : "none"; }
+    Int_t GetExpId() const { return fExpId; }
+
+    /** The energy of a section is corrected from the beam velocity measured at Cave C **/
+    Bool_t UseBeta() const { return fUseBeta; }
+
+    // --- Corrections, section and signal are 0-based --- //
+
+    /** Energy of a signal corrected from the drift time difference between the first and last sections **/
+    inline Double_t CorrectDeltaDT(Int_t section, Int_t signal, Double_t deltaDT, Double_t e) const
+    {
+        Double_t correction = Horner(&fDeltaDT[(section * fNumSignals + signal) * fNumDeltaDT], fNumDeltaDT, deltaDT);
+        return correction != 0. ? e / correction : e;
+    }
+
+    /** Energy of a section from the mean energy of its signals **/
+    inline Double_t Align(Int_t section, Double_t mean) const
+    {
+        return fAlignOffset[section] + fAlignGain[section] * mean;
+    }
+
+    /** Energy of a section corrected from the beam velocity **/
+    inline Double_t CorrectBeta(Int_t section, Double_t beta, Double_t e) const
+    {
+        Double_t correction = Horner(&fBeta[section * fNumBeta], fNumBeta, beta);
+        return correction != 0. ? e / correction : e;
+    }
+
+    /** Atomic number from the corrected energy of a section **/
+    inline Double_t GetZ(Int_t section, Double_t e) const
+    {
+        return Horner(&fZ[section * fNumZ], fNumZ, std::sqrt(e));
+    }
+
+  private:
+    static inline Double_t Horner(const Double_t* c, Int_t n, Double_t x)
+    {
+        Double_t r = 0.;
+        for (Int_t deg = n - 1; deg >= 0; deg--)
+            r = r * x + c[deg];
+        return r;
+    }
+
+    const char* fName;
+    Int_t fExpId;
+    Bool_t fUseBeta;
+
+    // Corrections not applied have the coefficients of the constant 1
+    Int_t fNumSignals;
+    Int_t fNumDeltaDT;
+    Int_t fNumBeta;
+    Int_t fNumZ;
+    std::vector<Double_t> fDeltaDT; // per signal, divided by P0
+    std::vector<Double_t> fAlignOffset;
+    std::vector<Double_t> fAlignGain;
+    std::vector<Double_t> fBeta; // per section, divided by the reference energy
+    std::vector<Double_t> fZ;
+};
+
+#endif /* R3BSofTrimHitStrategy_H */
@@ -13,6 +13,7 @@
 #include "FairRunAna.h"
 #include "FairRuntimeDb.h"
 
+#include <algorithm>
 #include <iomanip>
 
 // Trim headers
@@ -26,6 +27,7 @@ R3BSofTrimMapped2Cal::R3BSofTrimMapped2Cal()
     , fCal_Par(NULL)
     , fTrimMappedData(NULL)
     , fTrimCalData(NULL)
+    , fTrimCalEvent(NULL)
     , fOnline(kFALSE)
     , fNumSections(3)
     , fNumAnodes(6)
@@ -39,6 +41,7 @@ R3BSofTrimMapped2Cal::R3BSofTrimMapped2Cal(const char* name, Int_t iVerbose)
     , fCal_Par(NULL)
     , fTrimMappedData(NULL)
     , fTrimCalData(NULL)
+    , fTrimCalEvent(NULL)
     , fOnline(kFALSE)
     , fNumSections(3)
     , fNumAnodes(6)
@@ -54,6 +57,8 @@ R3BSofTrimMapped2Cal::~R3BSofTrimMapped2Cal()
         delete fTrimMappedData;
     if (fTrimCalData)
         delete fTrimCalData;
+    if (fTrimCalEvent)
+        delete fTrimCalEvent;
 }
 
 void R3BSofTrimMapped2Cal::SetParContainers()
@@ -109,6 +114,16 @@ InitStatus R3BSofTrimMapped2Cal::Init()
     fTrimCalData = new TClonesArray("R3BSofTrimCalData", MAX_MULT_TRIM_CAL * 8);
     rootManager->Register("TrimCalData", "Trim Cal", fTrimCalData, !fOnline);
 
+    // --- ---------------------------------- --- //
+    // --- OUTPUT CAL EVENT FOR THE TRIM TASKS --- //
+    // --- ---------------------------------- --- //
+    fTrimCalEvent = new R3BSofTrimCalEvent(fNumSections, fNumAnodes);
+    rootManager->Register("TrimCalEvent", "Trim Cal", fTrimCalEvent, kFALSE);
+
+    fMult.resize(fNumSections * fNumChannels);
+    fTraw.resize(fNumSections * fNumChannels * MAX_MULT_TRIM_CAL);
+    fEraw.resize(fNumSections * fNumChannels * MAX_MULT_TRIM_CAL);
+
     return kSUCCESS;
 }
 
@@ -138,64 +153,45 @@ void R3BSofTrimMapped2Cal::Exec(Option_t* option)
     Int_t nHits = fTrimMappedData->GetEntries();
     if (!nHits)
         return;
-    // FIX ME TO BE MOVED TO Init()
-    UInt_t mult[fNumSections * fNumChannels];
-    UShort_t iTraw[fNumSections * fNumChannels][MAX_MULT_TRIM_CAL];
-    UShort_t iEraw[fNumSections * fNumChannels][MAX_MULT_TRIM_CAL];
+    std::fill(fMult.begin(), fMult.end(), 0);
     Int_t iSec;
     Int_t iCh;
-    for (UInt_t sec = 0; sec < fNumSections; sec++)
-    {
-        for (UInt_t a = 0; a < fNumChannels; a++)
-        {
-            mult[a + fNumChannels * sec] = 0;
-            for (UShort_t m = 0; m < MAX_MULT_TRIM_CAL; m++)
-            {
-                iTraw[a + fNumChannels * sec][m] = 0;
-                iEraw[a + fNumChannels * sec][m] = 0;
-            }
-        }
-    }
-
     for (Int_t ihit = 0; ihit < nHits; ihit++)
     {
         R3BSofTrimMappedData* hit = (R3BSofTrimMappedData*)fTrimMappedData->At(ihit);
         if (hit->GetPileupStatus() || hit->GetOverflowStatus())
             continue;
         iSec = hit->GetSecID() - 1;
-        iCh = hit->GetAnodeID() - 1;
-        if (mult[iCh + fNumChannels * iSec] > MAX_MULT_TRIM_CAL)
+        iCh = iSec * fNumChannels + hit->GetAnodeID() - 1;
+        if (fMult[iCh] >= MAX_MULT_TRIM_CAL)
             continue;
-        iTraw[iCh + fNumChannels * iSec][mult[iCh + fNumChannels * iSec]] = hit->GetTime();
-        iEraw[iCh + fNumChannels * iSec][mult[iCh + fNumChannels * iSec]] = hit->GetEnergy();
-        mult[iCh + fNumChannels * iSec]++;
+        fTraw[iCh * MAX_MULT_TRIM_CAL + fMult[iCh]] = hit->GetTime();
+        fEraw[iCh * MAX_MULT_TRIM_CAL + fMult[iCh]] = hit->GetEnergy();
+        fMult[iCh]++;
     } // end of loop over the mapped data
 
     // Fill data only if there is a unique TREF signal
     Double_t dtraw, dtal;
-    Float_t esub, ematch, eal;
+    Float_t esub, ematch;
     for (Int_t s = 0; s < fNumSections; s++)
     {
-        if (mult[fNumAnodes + fNumChannels * s] == 1)
+        const Int_t iRef = fNumAnodes + fNumChannels * s;
+        if (fMult[iRef] != 1)
+            continue;
+        for (Int_t a = 0; a < fNumAnodes; a++)
         {
-            for (Int_t a = 0; a < fNumAnodes; a++)
+            const Int_t ch = a + fNumChannels * s;
+            for (Int_t i = 0; i < fMult[ch]; i++)
             {
-                if (mult[a + fNumChannels * s] > 0)
-                {
-                    for (Int_t i = 0; i < mult[a + fNumChannels * s]; i++)
-                    {
-                        dtraw = (Double_t)iTraw[a + fNumChannels * s][i] -
-                                (Double_t)iTraw[fNumAnodes + fNumChannels * s][0];
-                        dtal = dtraw + fCal_Par->GetDriftTimeOffset(s + 1, a + 1);
-                        esub = (Float_t)iEraw[a + fNumChannels * s][i] - fCal_Par->GetEnergyPedestal(s + 1, a + 1);
-                        ematch = esub * fCal_Par->GetEnergyMatchGain(s + 1, a + 1);
-                        AddCalData(s + 1, a + 1, dtraw, dtal, esub, ematch);
-                        // std::cout << "Add Cal Data: s=" << s+1 << ", a=" << a+1<< ", ematch=" << ematch << std::endl;
-                    }
-                } // end of check that anode has data
-            }     // end of loop over the anodes
-        }         // end of one Tref per Section
-    }             // end of loop over section
+                dtraw = (Double_t)fTraw[ch * MAX_MULT_TRIM_CAL + i] - (Double_t)fTraw[iRef * MAX_MULT_TRIM_CAL];
+                dtal = dtraw + fCal_Par->GetDriftTimeOffset(s + 1, a + 1);
+                esub = (Float_t)fEraw[ch * MAX_MULT_TRIM_CAL + i] - fCal_Par->GetEnergyPedestal(s + 1, a + 1);
+                ematch = esub * fCal_Par->GetEnergyMatchGain(s + 1, a + 1);
+                fTrimCalEvent->AddHit(s, a, dtraw, dtal, esub, ematch);
+                AddCalData(s + 1, a + 1, dtraw, dtal, esub, ematch);
+            }
+        } // end of loop over the anodes
+    }     // end of loop over section
 
     return;
 }
@@ -209,6 +205,8 @@ void R3BSofTrimMapped2Cal::Reset()
     LOG(debug) << "Clearing TrimCalData Structure";
     if (fTrimCalData)
         fTrimCalData->Clear();
+    if (fTrimCalEvent)
+        fTrimCalEvent->Clear();
 }
 
 // -----   Private method AddCalData  --------------------------------------------
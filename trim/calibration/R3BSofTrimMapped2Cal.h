@@ -7,11 +7,14 @@
 
 #include "FairTask.h"
 #include "R3BSofTrimCalData.h"
+#include "R3BSofTrimCalEvent.h"
 #include "R3BSofTrimMappedData.h"
 #include "TH1F.h"
 
 #include <TRandom.h>
 
+#include <vector>
+
 #define MAX_MULT_TRIM_CAL 10
 
 class TClonesArray;
@@ -56,11 +59,17 @@ class R3BSofTrimMapped2Cal : public FairTask
     R3BSofTrimCalPar* fCal_Par;    /**< Parameter container. >*/
     TClonesArray* fTrimMappedData; /**< Array with Mapped-input data. >*/
     TClonesArray* fTrimCalData;    /**< Array with Cal-output data. >*/
+    R3BSofTrimCalEvent* fTrimCalEvent; /**< Cal-output per anode for the Trim tasks, not stored. >*/
 
     Int_t fNumSections;
     Int_t fNumAnodes;
     Int_t fNumChannels;
 
+    // Mapped hits per channel, channel * MAX_MULT_TRIM_CAL + hit
+    std::vector<UInt_t> fMult;
+    std::vector<UShort_t> fTraw;
+    std::vector<UShort_t> fEraw;
+
     /** Private method AddCalData **/
     R3BSofTrimCalData* AddCalData(Int_t secID,
                                   Int_t anodeID,
@@ -0,0 +1,96 @@
+// --------------------------------------------------------------
+// -----          R3BSofTrimMatchGainAccumulator            -----
+// --------------------------------------------------------------
+
+#include "R3BSofTrimMatchGainAccumulator.h"
+
+#include "TMath.h"
+
+R3BSofTrimMatchGainAccumulator::R3BSofTrimMatchGainAccumulator(Int_t nYBins, Double_t yMin, Double_t yMax)
+    : fNumYBins(nYBins)
+    , fYMin(yMin)
+    , fInvBinWidth(nYBins / (yMax - yMin))
+    , fBins(nYBins)
+{
+    Reset();
+}
+
+R3BSofTrimMatchGainAccumulator::~R3BSofTrimMatchGainAccumulator() {}
+
+void R3BSofTrimMatchGainAccumulator::Reset()
+{
+    Moments zero = { 0., 0., 0., 0., 0., 0. };
+    fBins.assign(fNumYBins, zero);
+}
+
+Double_t R3BSofTrimMatchGainAccumulator::GetEntries() const
+{
+    Double_t n = 0.;
+    for (const Moments& m : fBins)
+        n += m.n;
+    return n;
+}
+
+Bool_t R3BSofTrimMatchGainAccumulator::Solve(Double_t minEntries, Double_t& gain, Double_t& error) const
+{
+    // With the right gain h, the mean of h * up + down is the same in all the Y bins:
+    //    <down>_b = c - h * <up>_b
+    // h is the slope of a straight line fit of the bin means, weighted by the inverse of the variance of
+    // <h * up + down>_b from the second moments. The weights depend on h: start with the number of
+    // entries, then iterate
+    const Int_t nIterations = 3;
+    minEntries = TMath::Max(minEntries, 2.);
+
+    std::vector<Double_t> mu, md, vu, vd, cud;
+    for (const Moments& m : fBins)
+    {
+        if (m.n < minEntries)
+            continue;
+        Double_t u = m.u / m.n, d = m.d / m.n;
+        mu.push_back(u);
+        md.push_back(d);
+        vu.push_back(TMath::Max(m.uu / m.n - u * u, 0.) / m.n); // variances of the means
+        vd.push_back(TMath::Max(m.dd / m.n - d * d, 0.) / m.n);
+        cud.push_back((m.ud / m.n - u * d) / m.n);
+    }
+    const Int_t nb = mu.size();
+    if (nb < 3)
+        return kFALSE;
+
+    Double_t h = 1.;
+    Double_t sxx = 0., chi2 = 0.;
+    for (Int_t it = 0; it <= nIterations; it++)
+    {
+        Double_t sw = 0., sx = 0., sy = 0.;
+        std::vector<Double_t> w(nb);
+        for (Int_t b = 0; b < nb; b++)
+        {
+            Double_t var = h * h * vu[b] + 2. * h * cud[b] + vd[b];
+            w[b] = it == 0 || var <= 0. ? 1. : 1. / var;
+            sw += w[b];
+            sx += w[b] * mu[b];
+            sy += w[b] * md[b];
+        }
+        Double_t xm = sx / sw, ym = sy / sw, sxy = 0.;
+        sxx = 0.;
+        for (Int_t b = 0; b < nb; b++)
+        {
+            sxx += w[b] * (mu[b] - xm) * (mu[b] - xm);
+            sxy += w[b] * (mu[b] - xm) * (md[b] - ym);
+        }
+        if (sxx <= 0.)
+            return kFALSE;
+        h = -sxy / sxx;
+
+        chi2 = 0.;
+        for (Int_t b = 0; b < nb; b++)
+        {
+            Double_t r = md[b] - ym + h * (mu[b] - xm);
+            chi2 += w[b] * r * r;
+        }
+    }
+
+    gain = h;
+    error = TMath::Sqrt(TMath::Max(1., chi2 / (nb - 2)) / sxx);
+    return h > 0.;
+}
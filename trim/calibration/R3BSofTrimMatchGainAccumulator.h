@@ -0,0 +1,65 @@
+// --------------------------------------------------------------
+// -----          R3BSofTrimMatchGainAccumulator            -----
+// -----    Gain matching of a pair of triangular anodes:     -----
+// -----    moments of Esub(up) and Esub(down) in bins of     -----
+// -----    the position Y = (up - down) / (up + down), and   -----
+// -----    closed-form gain h for which h * up + down does   -----
+// -----    not depend on Y                                   -----
+// --------------------------------------------------------------
+
+#ifndef R3BSofTrimMatchGainAccumulator_H
+#define R3BSofTrimMatchGainAccumulator_H
+
+#include "Rtypes.h"
+
+#include <vector>
+
+class R3BSofTrimMatchGainAccumulator
+{
+  public:
+    /** Default constructor **/
+    R3BSofTrimMatchGainAccumulator(Int_t nYBins = 16, Double_t yMin = -0.4, Double_t yMax = 0.4);
+
+    /** Destructor **/
+    virtual ~R3BSofTrimMatchGainAccumulator();
+
+    void Reset();
+
+    /** Pair with one hit on each anode, pedestal subtracted energies **/
+    inline void Fill(Double_t up, Double_t down)
+    {
+        Double_t sum = up + down;
+        if (sum <= 0.)
+            return;
+        Int_t bin = (Int_t)(((up - down) / sum - fYMin) * fInvBinWidth);
+        if (bin < 0 || bin >= fNumYBins)
+            return;
+        Moments& m = fBins[bin];
+        m.n += 1.;
+        m.u += up;
+        m.d += down;
+        m.uu += up * up;
+        m.dd += down * down;
+        m.ud += up * down;
+    }
+
+    Int_t GetNumYBins() const { return fNumYBins; }
+    Double_t GetEntries() const;
+
+    /** Gain of the up anode, the down anode keeping a gain 1, and its statistical error. The bins with less
+     *  than minEntries are not used, returns kFALSE with less than 3 bins left **/
+    Bool_t Solve(Double_t minEntries, Double_t& gain, Double_t& error) const;
+
+  private:
+    struct Moments
+    {
+        Double_t n, u, d, uu, dd, ud;
+    };
+
+    Int_t fNumYBins;
+    Double_t fYMin;
+    Double_t fInvBinWidth;
+    std::vector<Moments> fBins;
+};
+
+#endif /* R3BSofTrimMatchGainAccumulator_H */
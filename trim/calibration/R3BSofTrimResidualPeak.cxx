@@ -0,0 +1,85 @@
+// --------------------------------------------------------------
+// -----              R3BSofTrimResidualPeak                -----
+// --------------------------------------------------------------
+
+#include "R3BSofTrimResidualPeak.h"
+
+#include "TMath.h"
+
+#include <algorithm>
+
+R3BSofTrimResidualPeak::R3BSofTrimResidualPeak(Int_t nbins, Double_t xmin, Double_t xmax)
+    : fNumBins(nbins)
+    , fXMin(xmin)
+    , fBinWidth((xmax - xmin) / nbins)
+    , fInvBinWidth(nbins / (xmax - xmin))
+    , fEntries(0)
+    , fCounts(nbins, 0)
+{
+}
+
+R3BSofTrimResidualPeak::~R3BSofTrimResidualPeak() {}
+
+void R3BSofTrimResidualPeak::Reset()
+{
+    std::fill(fCounts.begin(), fCounts.end(), 0);
+    fEntries = 0;
+}
+
+Bool_t R3BSofTrimResidualPeak::Fit(Double_t window,
+                                   Double_t nSigma,
+                                   UInt_t minEntries,
+                                   Double_t& mean,
+                                   Double_t& error,
+                                   Double_t& sigma,
+                                   UInt_t& nPeak) const
+{
+    const Int_t nIterationsMax = 20;
+    nPeak = 0;
+    if (fEntries < minEntries || fEntries < 2)
+        return kFALSE;
+
+    // Highest bin, smoothed over 3 bins against single-bin fluctuations
+    Int_t binMax = 0;
+    UInt_t countMax = 0;
+    for (Int_t bin = 1; bin < fNumBins - 1; bin++)
+    {
+        UInt_t count = fCounts[bin - 1] + fCounts[bin] + fCounts[bin + 1];
+        if (count > countMax)
+        {
+            countMax = count;
+            binMax = bin;
+        }
+    }
+
+    mean = fXMin + (binMax + 0.5) * fBinWidth;
+    Double_t lo = mean - window, hi = mean + window;
+    for (Int_t it = 0; it < nIterationsMax; it++)
+    {
+        const Int_t first = TMath::Max(0, (Int_t)((lo - fXMin) * fInvBinWidth));
+        const Int_t last = TMath::Min(fNumBins - 1, (Int_t)((hi - fXMin) * fInvBinWidth));
+        Double_t n = 0., sx = 0., sxx = 0.;
+        for (Int_t bin = first; bin <= last; bin++)
+        {
+            const Double_t x = fXMin + (bin + 0.5) * fBinWidth;
+            n += fCounts[bin];
+            sx += fCounts[bin] * x;
+            sxx += fCounts[bin] * x * x;
+        }
+        if (n < 2.)
+            return kFALSE;
+        const Double_t previous = mean;
+        mean = sx / n;
+        // rms of the bin centres, corrected for the binning
+        sigma = TMath::Sqrt(TMath::Max(sxx / n - mean * mean - fBinWidth * fBinWidth / 12., 0.));
+        nPeak = (UInt_t)n;
+        Double_t halfWidth = TMath::Max(nSigma * sigma, 2. * fBinWidth);
+        lo = mean - halfWidth;
+        hi = mean + halfWidth;
+        if (it > 0 && TMath::Abs(mean - previous) < 0.1 * fBinWidth)
+            break;
+    }
+
+    error = TMath::Sqrt((sigma * sigma + fBinWidth * fBinWidth / 12.) / nPeak);
+    return nPeak >= minEntries;
+}
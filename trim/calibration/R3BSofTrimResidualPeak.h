@@ -0,0 +1,58 @@
+// --------------------------------------------------------------
+// -----              R3BSofTrimResidualPeak                -----
+// -----    Streaming histogram of a residual (counts only,   -----
+// -----    no ROOT object) and fit of the position of its    -----
+// -----    main peak by an iterative truncated mean          -----
+// --------------------------------------------------------------
+
+#ifndef R3BSofTrimResidualPeak_H
+#define R3BSofTrimResidualPeak_H
+
+#include "Rtypes.h"
+
+#include <vector>
+
+class R3BSofTrimResidualPeak
+{
+  public:
+    /** Default constructor **/
+    R3BSofTrimResidualPeak(Int_t nbins = 4000, Double_t xmin = -20000., Double_t xmax = 20000.);
+
+    /** Destructor **/
+    virtual ~R3BSofTrimResidualPeak();
+
+    void Reset();
+
+    inline void Fill(Double_t x)
+    {
+        const Double_t pos = (x - fXMin) * fInvBinWidth;
+        if (pos < 0. || pos >= fNumBins)
+            return;
+        fCounts[(Int_t)pos]++;
+        fEntries++;
+    }
+
+    Int_t GetNumBins() const { return fNumBins; }
+    UInt_t GetEntries() const { return fEntries; }
+
+    /** Position of the main peak and its statistical error. Starts from the highest bin in a window of
+     *  +/- window, then iterates on mean +/- nSigma * rms until the mean moves by less than a tenth of
+     *  a bin. Returns kFALSE if the peak holds less than minEntries **/
+    Bool_t Fit(Double_t window,
+               Double_t nSigma,
+               UInt_t minEntries,
+               Double_t& mean,
+               Double_t& error,
+               Double_t& sigma,
+               UInt_t& nPeak) const;
+
+  private:
+    Int_t fNumBins;
+    Double_t fXMin;
+    Double_t fBinWidth;
+    Double_t fInvBinWidth;
+    UInt_t fEntries;
+    std::vector<UInt_t> fCounts;
+};
+
+#endif /* R3BSofTrimResidualPeak_H */
@@ -40,17 +40,17 @@ class R3BSofTrimCalPar : public FairParGenericSet
     void printParams();
 
     /** Accessor functions **/
-    const Int_t GetNumSections() { return fNumSections; }
-    const Int_t GetNumAnodes() { return fNumAnodes; }
-    Double_t GetDriftTimeOffset(Int_t section, Int_t anode)
+    const Int_t GetNumSections() const { return fNumSections; }
+    const Int_t GetNumAnodes() const { return fNumAnodes; }
+    Double_t GetDriftTimeOffset(Int_t section, Int_t anode) const
     {
         return fDriftTimeOffsets->GetAt((anode - 1) + (section - 1) * 6);
     }
-    Float_t GetEnergyPedestal(Int_t section, Int_t anode)
+    Float_t GetEnergyPedestal(Int_t section, Int_t anode) const
     {
         return fEnergyPedestals->GetAt((anode - 1) + (section - 1) * 6);
     }
-    Float_t GetEnergyMatchGain(Int_t section, Int_t anode)
+    Float_t GetEnergyMatchGain(Int_t section, Int_t anode) const
     {
         return fEnergyMatchGains->GetAt((anode - 1) + (section - 1) * 6);
     }
@@ -20,11 +20,17 @@ R3BSofTrimHitPar::R3BSofTrimHitPar(const char* name, const char* title, const ch
     , fNumSignalsPerSection(3) // 3 if triangular, 6 if rectangular
     , fNumCorrDeltaDTParsPerSignal(4)
     , fNumCorrBetaParsPerSection(3)
+    , fNumZParsPerSection(2)
+    , fEnergyCorrBetaRef(30000.)
 {
     fEnergyAlignOffsets = new TArrayF(fNumSections);
     fEnergyAlignGains = new TArrayF(fNumSections);
     fEnergyCorrBetaPars = new TArrayF(fNumSections * fNumCorrBetaParsPerSection);
     fEnergyCorrDeltaDTPars = new TArrayF(fNumSections * fNumSignalsPerSection * fNumCorrDeltaDTParsPerSignal);
+
+    // Default Z calibration for the parameter files without it: s455, run 228Th + run 392 with Hg data
+    const Float_t zpars[6] = { 11.78, 0.463, 9.706, 0.47543, 11.690, 0.4622 };
+    fZPars = new TArrayF(fNumSections * fNumZParsPerSection, zpars);
 }
 
 // ----  Destructor ------------------------------------------------------------
@@ -39,6 +45,8 @@ R3BSofTrimHitPar::~R3BSofTrimHitPar()
         delete fEnergyAlignGains;
     if (fEnergyCorrBetaPars)
         delete fEnergyCorrBetaPars;
+    if (fZPars)
+        delete fZPars;
 }
 
 // ----  Method clear ----------------------------------------------------------
@@ -74,6 +82,10 @@ void R3BSofTrimHitPar::putParams(FairParamList* list)
     LOG(info) << "Array Size corr deltaDT parameters: " << array_size;
     fEnergyCorrDeltaDTPars->Set(array_size);
 
+    array_size = fNumSections * fNumZParsPerSection;
+    LOG(info) << "Array Size Z parameters: " << array_size;
+    fZPars->Set(array_size);
+
     list->add("trimNumSections", fNumSections);
     list->add("trimNumCorrDeltaDTParsPerSignal", fNumCorrDeltaDTParsPerSignal);
     list->add("trimNumSignalsPerSection", fNumSignalsPerSection);
@@ -82,6 +94,9 @@ void R3BSofTrimHitPar::putParams(FairParamList* list)
     list->add("trimEnergyAlignOffsets", *fEnergyAlignOffsets);
     list->add("trimEnergyAlignGains", *fEnergyAlignGains);
     list->add("trimEnergyCorrBetaPars", *fEnergyCorrBetaPars);
+    list->add("trimEnergyCorrBetaRef", fEnergyCorrBetaRef);
+    list->add("trimNumZParsPerSection", fNumZParsPerSection);
+    list->add("trimZPars", *fZPars);
 }
 
 // ----  Method getParams ------------------------------------------------------
@@ -149,6 +164,28 @@ Bool_t R3BSofTrimHitPar::getParams(FairParamList* list)
         return kFALSE;
     }
 
+    // Beta reference and Z calibration are optional: the defaults are kept if not given
+    if (!list->fill("trimEnergyCorrBetaRef", &fEnergyCorrBetaRef))
+    {
+        LOG(warn) << "---Could not initialize trimEnergyCorrBetaRef, default " << fEnergyCorrBetaRef << " used";
+    }
+
+    Int_t numZPars = fNumZParsPerSection;
+    if (!list->fill("trimNumZParsPerSection", &numZPars))
+    {
+        LOG(warn) << "---Could not initialize trimNumZParsPerSection, default Z calibration used";
+        return kTRUE;
+    }
+    TArrayF zpars(fNumSections * numZPars);
+    if (!(list->fill("trimZPars", &zpars)))
+    {
+        LOG(info) << "---Could not initialize trimZPars";
+        return kFALSE;
+    }
+    fNumZParsPerSection = numZPars;
+    LOG(info) << "Array Size for Z calibration in use: " << zpars.GetSize();
+    fZPars->Set(zpars.GetSize(), zpars.GetArray());
+
     return kTRUE;
 }
 
@@ -184,6 +221,17 @@ void R3BSofTrimHitPar::printParams()
             LOG(info) << "P" << deg << " = " << GetEnergyCorrBetaPar(s + 1, deg);
         }
     }
+    LOG(info) << "R3BSofTrimHitPar: reference energy of the beta correction = " << fEnergyCorrBetaRef;
+
+    LOG(info) << "R3BSofTrimHitPar: Triple MUSIC Z calibration per section, polynomial of sqrt(E): ";
+    for (Int_t s = 0; s < fNumSections; s++)
+    {
+        LOG(info) << "Trim section: " << s + 1;
+        for (Int_t deg = 0; deg < fNumZParsPerSection; deg++)
+        {
+            LOG(info) << "P" << deg << " = " << GetZPar(s + 1, deg);
+        }
+    }
 }
 
 ClassImp(R3BSofTrimHitPar)
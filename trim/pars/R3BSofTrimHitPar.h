@@ -45,7 +45,7 @@ class R3BSofTrimHitPar : public FairParGenericSet
     // === NUMBER OF SECTIONS === //
     // === ================== === //
 
-    const Int_t GetNumSections() { return fNumSections; }
+    const Int_t GetNumSections() const { return fNumSections; }
 
     void SetNumSections(Int_t num) { fNumSections = num; }
 
@@ -53,7 +53,7 @@ class R3BSofTrimHitPar : public FairParGenericSet
     // === NUMBER OF SIGNALS PER SECTION === //
     // === ============================= === //
 
-    const Int_t GetNumSignalsPerSection() { return fNumSignalsPerSection; }
+    const Int_t GetNumSignalsPerSection() const { return fNumSignalsPerSection; }
 
     void SetNumSignalsPerSection(Int_t num) { fNumSignalsPerSection = num; }
 
@@ -61,11 +61,11 @@ class R3BSofTrimHitPar : public FairParGenericSet
     // === CORRECTION E[signal] VERSUS DeltaDT === //
     // === =================================== === //
 
-    const Int_t GetNumCorrDeltaDTParsPerSignal() { return fNumCorrDeltaDTParsPerSignal; }
+    const Int_t GetNumCorrDeltaDTParsPerSignal() const { return fNumCorrDeltaDTParsPerSignal; }
 
     void SetNumCorrDeltaDTParsPerSignal(Int_t num) { fNumCorrDeltaDTParsPerSignal = num; }
 
-    Float_t GetEnergyCorrDeltaDTPar(Int_t section, Int_t signal, Int_t degree)
+    Float_t GetEnergyCorrDeltaDTPar(Int_t section, Int_t signal, Int_t degree) const
     {
         return fEnergyCorrDeltaDTPars->GetAt((section - 1) * (fNumCorrDeltaDTParsPerSignal * fNumSignalsPerSection) +
                                              (signal - 1) * fNumCorrDeltaDTParsPerSignal + degree);
@@ -84,8 +84,8 @@ class R3BSofTrimHitPar : public FairParGenericSet
     // === ALIGNEMENT OF THE ENERGY PER SECTION === //
     // === ==================================== === //
 
-    Float_t GetEnergyAlignOffset(Int_t section) { return fEnergyAlignOffsets->GetAt(section - 1); }
-    Float_t GetEnergyAlignGain(Int_t section) { return fEnergyAlignGains->GetAt(section - 1); }
+    Float_t GetEnergyAlignOffset(Int_t section) const { return fEnergyAlignOffsets->GetAt(section - 1); }
+    Float_t GetEnergyAlignGain(Int_t section) const { return fEnergyAlignGains->GetAt(section - 1); }
 
     TArrayF* GetEnergyAlignOffsets() { return fEnergyAlignOffsets; }
     TArrayF* GetEnergyAlignGains() { return fEnergyAlignGains; }
@@ -97,11 +97,11 @@ class R3BSofTrimHitPar : public FairParGenericSet
     // === CORRECTION IN BETA OF THE ENERGY LOSS PER SECTION === //
     // === ================================================= === //
 
-    const Int_t GetNumCorrBetaParsPerSection() { return fNumCorrBetaParsPerSection; }
+    const Int_t GetNumCorrBetaParsPerSection() const { return fNumCorrBetaParsPerSection; }
 
     void SetNumCorrBetaParsPerSection(Int_t num) { fNumCorrBetaParsPerSection = num; }
 
-    Float_t GetEnergyCorrBetaPar(Int_t section, Int_t degree)
+    Float_t GetEnergyCorrBetaPar(Int_t section, Int_t degree) const
     {
         return fEnergyCorrBetaPars->GetAt((section - 1) * fNumCorrBetaParsPerSection + degree);
     } // degree is 0-based
@@ -113,22 +113,50 @@ class R3BSofTrimHitPar : public FairParGenericSet
         fEnergyCorrBetaPars->AddAt(val, (section - 1) * fNumCorrBetaParsPerSection + degree);
     } // section is 1-based, degree is 0-based
 
+    // Energy loss of the beta corrected energy: E(beta) is scaled to this reference
+    Float_t GetEnergyCorrBetaRef() const { return fEnergyCorrBetaRef; }
+
+    void SetEnergyCorrBetaRef(Float_t val) { fEnergyCorrBetaRef = val; }
+
+    // === ================================== === //
+    // === Z CALIBRATION: POLYNOMIAL OF SQRT(E) === //
+    // === ================================== === //
+
+    const Int_t GetNumZParsPerSection() const { return fNumZParsPerSection; }
+
+    void SetNumZParsPerSection(Int_t num) { fNumZParsPerSection = num; }
+
+    Float_t GetZPar(Int_t section, Int_t degree) const
+    {
+        return fZPars->GetAt((section - 1) * fNumZParsPerSection + degree);
+    } // section is 1-based, degree is 0-based
+
+    TArrayF* GetZPars() { return fZPars; }
+
+    void SetZPar(Float_t val, Int_t section, Int_t degree)
+    {
+        fZPars->AddAt(val, (section - 1) * fNumZParsPerSection + degree);
+    } // section is 1-based, degree is 0-based
+
   private:
     Int_t fNumSections;                 // number of sections
     Int_t fNumSignalsPerSection;        // 6 if Rectangular anodes, 3 if Triangular anodes
     Int_t fNumCorrDeltaDTParsPerSignal; // if pol3 -> 4 parameters (P0, P1, P2, P3)
     Int_t fNumCorrBetaParsPerSection;   // if pol2 -> 3 parameters (P0, P1, P2)
+    Int_t fNumZParsPerSection;          // Z = P0 + P1 * sqrt(E) -> 2 parameters
+    Float_t fEnergyCorrBetaRef;
 
     TArrayF* fEnergyCorrDeltaDTPars;
     TArrayF* fEnergyAlignOffsets;
     TArrayF* fEnergyAlignGains;
     TArrayF* fEnergyCorrBetaPars;
+    TArrayF* fZPars;
 
     const R3BSofTrimHitPar& operator=(const R3BSofTrimHitPar&); /*< an assignment operator>*/
 
     R3BSofTrimHitPar(const R3BSofTrimHitPar&); /*< a copy constructor >*/
 
-    ClassDef(R3BSofTrimHitPar, 1);
+    ClassDef(R3BSofTrimHitPar, 2);
 };
 
 #endif